@@ -0,0 +1,376 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/aho.h"
+#include "simd.h"
+#include "grow.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AHO_ROOT 0
+#define AHO_MISS UINT32_MAX
+#define AHO_DENSE 256       // root transitions held in a direct table
+#define AHO_LINEAR 8        // edge lists up to this size are scanned, not bisected
+
+typedef struct {
+    uint32_t symbol;
+    uint32_t target;
+} _aho_edge;
+
+// Trie node used while patterns are being added
+typedef struct {
+    _aho_edge *edges;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t output; // first pattern ending here, plus one; 0 for none
+} _aho_trie;
+
+typedef struct {
+    size_t length;
+    size_t id;
+    uint32_t next; // next pattern ending at the same node, plus one
+} _aho_pattern;
+
+/*
+ * Compiled state. States are numbered breadth first, so the shallow states
+ * every scan keeps returning to sit together at the front of the array,
+ * and each state's edges are one sorted run in the shared edge array.
+ */
+typedef struct {
+    uint32_t edge_first;
+    uint32_t edge_count;
+    uint32_t fail;      // longest proper suffix that is also a state
+    uint32_t dict;      // nearest state on the fail chain with outputs, 0 for none
+    uint32_t out_first;
+    uint32_t out_count;
+} _aho_state;
+
+struct fossil_aho {
+    _aho_trie *trie;
+    size_t trie_count;
+    size_t trie_capacity;
+    _aho_pattern *patterns;
+    size_t pattern_count;
+    size_t pattern_capacity;
+
+    _aho_state *states;
+    _aho_edge *edges;
+    uint32_t *outputs;
+    uint32_t root[AHO_DENSE];
+};
+
+fossil_aho_t *fossil_aho_create(void) {
+    fossil_aho_t *aho = calloc(1, sizeof(fossil_aho_t));
+    if (!aho) {
+        return NULL;
+    }
+    aho->trie = calloc(16, sizeof(_aho_trie));
+    if (!aho->trie) {
+        free(aho);
+        return NULL;
+    }
+    aho->trie_capacity = 16;
+    aho->trie_count = 1; // the root
+    return aho;
+}
+
+static void _aho_release_compiled(fossil_aho_t *aho) {
+    free(aho->states);
+    free(aho->edges);
+    free(aho->outputs);
+    aho->states = NULL;
+    aho->edges = NULL;
+    aho->outputs = NULL;
+}
+
+void fossil_aho_erase(fossil_aho_t *aho) {
+    if (!aho) {
+        return;
+    }
+    for (size_t i = 0; i < aho->trie_count; i++) {
+        free(aho->trie[i].edges);
+    }
+    free(aho->trie);
+    free(aho->patterns);
+    _aho_release_compiled(aho);
+    free(aho);
+}
+
+static uint32_t _aho_trie_child(fossil_aho_t *aho, uint32_t node, uint32_t symbol) {
+    _aho_trie *parent = &aho->trie[node];
+    for (uint32_t i = 0; i < parent->count; i++) {
+        if (parent->edges[i].symbol == symbol) {
+            return parent->edges[i].target;
+        }
+    }
+
+    size_t edge_capacity = parent->capacity;
+    _aho_edge *edges = _fossil_grow(parent->edges, &edge_capacity, parent->count, sizeof(_aho_edge), 4);
+    if (!edges) {
+        return AHO_MISS;
+    }
+    parent->edges = edges;
+    parent->capacity = (uint32_t)edge_capacity;
+    _aho_trie *trie = aho->trie_count < AHO_MISS ? _fossil_grow(aho->trie, &aho->trie_capacity, aho->trie_count, sizeof(_aho_trie), 4) : NULL;
+    if (!trie) {
+        return AHO_MISS;
+    }
+    aho->trie = trie;
+    parent = &aho->trie[node]; // the trie may have moved
+
+    uint32_t child = (uint32_t)aho->trie_count++;
+    memset(&aho->trie[child], 0, sizeof(_aho_trie));
+    parent->edges[parent->count].symbol = symbol;
+    parent->edges[parent->count].target = child;
+    parent->count++;
+    return child;
+}
+
+static int _aho_add(fossil_aho_t *aho, const void *pattern, size_t unit, size_t id) {
+    if (!aho || !pattern) {
+        return -1;
+    }
+    size_t length = _fossil_simd_length(pattern, unit);
+    if (length == 0) {
+        return -1;
+    }
+    _aho_pattern *patterns = _fossil_grow(aho->patterns, &aho->pattern_capacity, aho->pattern_count, sizeof(_aho_pattern), 4);
+    if (!patterns) {
+        return -1;
+    }
+    aho->patterns = patterns;
+
+    uint32_t node = AHO_ROOT;
+    for (size_t i = 0; i < length; i++) {
+        uint32_t symbol = unit == 1 ? ((const unsigned char *)pattern)[i] : ((const bletter *)pattern)[i];
+        node = _aho_trie_child(aho, node, symbol);
+        if (node == AHO_MISS) {
+            return -1;
+        }
+    }
+
+    _aho_pattern *entry = &aho->patterns[aho->pattern_count];
+    entry->length = length;
+    entry->id = id;
+    entry->next = aho->trie[node].output;
+    aho->trie[node].output = (uint32_t)++aho->pattern_count;
+    return 0;
+}
+
+int fossil_aho_add_cstr(fossil_aho_t *aho, const_cstring pattern, size_t id) {
+    return _aho_add(aho, pattern, sizeof(cletter), id);
+}
+
+int fossil_aho_add_bstr(fossil_aho_t *aho, const_bstring pattern, size_t id) {
+    return _aho_add(aho, pattern, sizeof(bletter), id);
+}
+
+size_t fossil_aho_count(const fossil_aho_t *aho) {
+    return aho ? aho->pattern_count : 0;
+}
+
+static uint32_t _aho_edge_find(const fossil_aho_t *aho, uint32_t state, uint32_t symbol) {
+    const _aho_edge *edges = aho->edges + aho->states[state].edge_first;
+    uint32_t count = aho->states[state].edge_count;
+    if (count <= AHO_LINEAR) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (edges[i].symbol == symbol) {
+                return edges[i].target;
+            }
+        }
+        return AHO_MISS;
+    }
+    uint32_t low = 0, high = count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (edges[mid].symbol < symbol) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < count && edges[low].symbol == symbol ? edges[low].target : AHO_MISS;
+}
+
+// Follow fail links until some state takes 'symbol'; the root takes everything
+static uint32_t _aho_step(const fossil_aho_t *aho, uint32_t state, uint32_t symbol) {
+    for (;;) {
+        if (state == AHO_ROOT) {
+            if (symbol < AHO_DENSE) {
+                return aho->root[symbol];
+            }
+            uint32_t target = _aho_edge_find(aho, AHO_ROOT, symbol);
+            return target == AHO_MISS ? AHO_ROOT : target;
+        }
+        uint32_t target = _aho_edge_find(aho, state, symbol);
+        if (target != AHO_MISS) {
+            return target;
+        }
+        state = aho->states[state].fail;
+    }
+}
+
+static int _aho_edge_compare(const void *a, const void *b) {
+    uint32_t x = ((const _aho_edge *)a)->symbol;
+    uint32_t y = ((const _aho_edge *)b)->symbol;
+    return (x > y) - (x < y);
+}
+
+int fossil_aho_compile(fossil_aho_t *aho) {
+    if (!aho) {
+        return -1;
+    }
+    _aho_release_compiled(aho);
+    size_t count = aho->trie_count;
+    uint32_t *order = malloc(count * sizeof(uint32_t)); // breadth-first trie nodes
+    uint32_t *number = malloc(count * sizeof(uint32_t)); // trie node to state
+    aho->states = calloc(count, sizeof(_aho_state));
+    aho->edges = malloc((count > 1 ? count - 1 : 1) * sizeof(_aho_edge));
+    aho->outputs = malloc((aho->pattern_count ? aho->pattern_count : 1) * sizeof(uint32_t));
+    if (!order || !number || !aho->states || !aho->edges || !aho->outputs) {
+        free(order);
+        free(number);
+        _aho_release_compiled(aho);
+        return -1;
+    }
+
+    size_t tail = 1;
+    order[0] = AHO_ROOT;
+    number[AHO_ROOT] = AHO_ROOT;
+    for (size_t head = 0; head < tail; head++) {
+        _aho_trie *node = &aho->trie[order[head]];
+        if (node->count > 1) {
+            qsort(node->edges, node->count, sizeof(_aho_edge), _aho_edge_compare);
+        }
+        for (uint32_t i = 0; i < node->count; i++) {
+            number[node->edges[i].target] = (uint32_t)tail;
+            order[tail++] = node->edges[i].target;
+        }
+    }
+
+    uint32_t edge_count = 0, out_count = 0;
+    for (size_t state = 0; state < count; state++) {
+        _aho_trie *node = &aho->trie[order[state]];
+        _aho_state *compiled = &aho->states[state];
+        compiled->edge_first = edge_count;
+        compiled->edge_count = node->count;
+        for (uint32_t i = 0; i < node->count; i++) {
+            aho->edges[edge_count].symbol = node->edges[i].symbol;
+            aho->edges[edge_count].target = number[node->edges[i].target];
+            edge_count++;
+        }
+        compiled->out_first = out_count;
+        for (uint32_t p = node->output; p; p = aho->patterns[p - 1].next) {
+            aho->outputs[out_count++] = p - 1;
+        }
+        compiled->out_count = out_count - compiled->out_first;
+    }
+    free(order);
+    free(number);
+
+    for (uint32_t symbol = 0; symbol < AHO_DENSE; symbol++) {
+        aho->root[symbol] = AHO_ROOT;
+    }
+    const _aho_state *root = &aho->states[AHO_ROOT];
+    for (uint32_t i = 0; i < root->edge_count; i++) {
+        const _aho_edge *edge = &aho->edges[root->edge_first + i];
+        if (edge->symbol < AHO_DENSE) {
+            aho->root[edge->symbol] = edge->target;
+        }
+    }
+
+    // Breadth-first order settles every fail target before it is needed
+    for (size_t state = 0; state < count; state++) {
+        const _aho_state *parent = &aho->states[state];
+        for (uint32_t i = 0; i < parent->edge_count; i++) {
+            const _aho_edge *edge = &aho->edges[parent->edge_first + i];
+            _aho_state *child = &aho->states[edge->target];
+            child->fail = state == AHO_ROOT ? AHO_ROOT : _aho_step(aho, parent->fail, edge->symbol);
+            const _aho_state *fail = &aho->states[child->fail];
+            child->dict = fail->out_count ? child->fail : fail->dict;
+        }
+    }
+    return 0;
+}
+
+// Report the matches ending just before 'end'; returns nonzero to stop
+static int _aho_report(const fossil_aho_t *aho, uint32_t state, size_t end, size_t *found,
+                       fossil_aho_callback_t callback, void *user) {
+    uint32_t at = aho->states[state].out_count ? state : aho->states[state].dict;
+    while (at != AHO_ROOT) {
+        const _aho_state *hit = &aho->states[at];
+        for (uint32_t i = 0; i < hit->out_count; i++) {
+            const _aho_pattern *pattern = &aho->patterns[aho->outputs[hit->out_first + i]];
+            fossil_aho_match_t match = { end - pattern->length, pattern->length, pattern->id };
+            (*found)++;
+            if (callback && callback(&match, user)) {
+                return 1;
+            }
+        }
+        at = hit->dict;
+    }
+    return 0;
+}
+
+static size_t _aho_scan(const fossil_aho_t *aho, fossil_aho_stream_t *stream, const void *text, size_t len,
+                        size_t unit, fossil_aho_callback_t callback, void *user) {
+    if (!aho || !aho->states || !stream || !text) {
+        return 0;
+    }
+    size_t found = 0;
+    uint32_t state = (uint32_t)stream->state;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t symbol = unit == 1 ? ((const unsigned char *)text)[i] : ((const bletter *)text)[i];
+        state = _aho_step(aho, state, symbol);
+        if (aho->states[state].out_count | aho->states[state].dict) {
+            if (_aho_report(aho, state, stream->offset + i + 1, &found, callback, user)) {
+                len = i + 1;
+                break;
+            }
+        }
+    }
+    stream->state = state;
+    stream->offset += len;
+    return found;
+}
+
+size_t fossil_aho_match_cstr(const fossil_aho_t *aho, const_cstring text, fossil_aho_callback_t callback, void *user) {
+    fossil_aho_stream_t stream;
+    fossil_aho_stream_init(&stream);
+    return text ? _aho_scan(aho, &stream, text, _fossil_simd_length(text, sizeof(cletter)), sizeof(cletter), callback, user) : 0;
+}
+
+size_t fossil_aho_match_bstr(const fossil_aho_t *aho, const_bstring text, fossil_aho_callback_t callback, void *user) {
+    fossil_aho_stream_t stream;
+    fossil_aho_stream_init(&stream);
+    return text ? _aho_scan(aho, &stream, text, _fossil_simd_length(text, sizeof(bletter)), sizeof(bletter), callback, user) : 0;
+}
+
+void fossil_aho_stream_init(fossil_aho_stream_t *stream) {
+    if (stream) {
+        stream->state = AHO_ROOT;
+        stream->offset = 0;
+    }
+}
+
+size_t fossil_aho_feed_cstr(const fossil_aho_t *aho, fossil_aho_stream_t *stream, const_cstring chunk, size_t len,
+                            fossil_aho_callback_t callback, void *user) {
+    return _aho_scan(aho, stream, chunk, len, sizeof(cletter), callback, user);
+}
+
+size_t fossil_aho_feed_bstr(const fossil_aho_t *aho, fossil_aho_stream_t *stream, const_bstring chunk, size_t len,
+                            fossil_aho_callback_t callback, void *user) {
+    return _aho_scan(aho, stream, chunk, len, sizeof(bletter), callback, user);
+}
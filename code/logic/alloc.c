@@ -0,0 +1,239 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/alloc.h"
+#include "sync.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void *_system_alloc(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *_system_resize(void *context, void *ptr, size_t size) {
+    (void)context;
+    return realloc(ptr, size);
+}
+
+static void _system_release(void *context, void *ptr) {
+    (void)context;
+    free(ptr);
+}
+
+static const fossil_allocator_t _system_allocator = {
+    _system_alloc, _system_resize, _system_release, NULL
+};
+
+/*
+ * Caching allocator. Each block carries a small header holding its size
+ * class so a release needs no size from the caller. Classes double from 16
+ * to 512 payload bytes; a thread keeps up to CACHE_DEPTH free blocks per
+ * class and hands the rest back to the heap. Blocks released on another
+ * thread simply join that thread's lists.
+ */
+
+#define CACHE_CLASSES 6
+#define CACHE_MIN_SHIFT 4
+#define CACHE_DEPTH 64
+#define CACHE_LARGE ((size_t)-1)
+
+typedef union {
+    size_t size_class;
+    long double align; // keeps the payload aligned like malloc
+    void *ptr;
+} _cache_header;
+
+typedef struct _cache_free {
+    struct _cache_free *next;
+} _cache_free;
+
+typedef struct {
+    _cache_free *head[CACHE_CLASSES];
+    unsigned count[CACHE_CLASSES];
+} _cache_lists;
+
+static _FOSSIL_THREAD_LOCAL _cache_lists *_cache_local = NULL;
+static _fossil_once_flag _cache_once = _FOSSIL_ONCE_INIT;
+static _fossil_tls_key _cache_key;
+static int _cache_key_ready = 0;
+
+static size_t _cache_class_size(size_t size_class) {
+    return (size_t)1 << (size_class + CACHE_MIN_SHIFT);
+}
+
+static size_t _cache_class(size_t size) {
+    for (size_t size_class = 0; size_class < CACHE_CLASSES; size_class++) {
+        if (size <= _cache_class_size(size_class)) {
+            return size_class;
+        }
+    }
+    return CACHE_LARGE;
+}
+
+// Thread exit: return every cached block to the heap
+static void _FOSSIL_TLS_CALLBACK _cache_flush(void *value) {
+    _cache_lists *lists = value;
+    if (!lists) {
+        return;
+    }
+    for (size_t i = 0; i < CACHE_CLASSES; i++) {
+        while (lists->head[i]) {
+            _cache_free *next = lists->head[i]->next;
+            free((_cache_header *)(void *)lists->head[i] - 1);
+            lists->head[i] = next;
+        }
+    }
+    if (_cache_local == lists) {
+        _cache_local = NULL;
+    }
+    free(lists);
+}
+
+static void _cache_init_key(void) {
+    _cache_key_ready = _fossil_tls_create(&_cache_key, _cache_flush) == 0;
+}
+
+// Lists for the calling thread, or NULL when caching is unavailable
+static _cache_lists *_cache_thread(void) {
+    if (_cache_local) {
+        return _cache_local;
+    }
+    _fossil_once(&_cache_once, _cache_init_key);
+    if (!_cache_key_ready) {
+        return NULL; // Without an exit hook the cache would leak
+    }
+    _cache_lists *lists = calloc(1, sizeof(_cache_lists));
+    if (lists) {
+        _fossil_tls_set(_cache_key, lists);
+        _cache_local = lists;
+    }
+    return lists;
+}
+
+static void *_cached_alloc(void *context, size_t size) {
+    (void)context;
+    size_t size_class = _cache_class(size);
+    if (size_class != CACHE_LARGE) {
+        _cache_lists *lists = _cache_thread();
+        if (lists && lists->head[size_class]) {
+            _cache_free *block = lists->head[size_class];
+            lists->head[size_class] = block->next;
+            lists->count[size_class]--;
+            return block;
+        }
+        size = _cache_class_size(size_class);
+    }
+    if (size > SIZE_MAX - sizeof(_cache_header)) {
+        return NULL;
+    }
+    _cache_header *header = malloc(sizeof(_cache_header) + size);
+    if (!header) {
+        return NULL;
+    }
+    header->size_class = size_class;
+    return header + 1;
+}
+
+static void _cached_release(void *context, void *ptr) {
+    (void)context;
+    if (!ptr) {
+        return;
+    }
+    _cache_header *header = (_cache_header *)ptr - 1;
+    size_t size_class = header->size_class;
+    if (size_class != CACHE_LARGE) {
+        _cache_lists *lists = _cache_thread();
+        if (lists && lists->count[size_class] < CACHE_DEPTH) {
+            _cache_free *block = ptr;
+            block->next = lists->head[size_class];
+            lists->head[size_class] = block;
+            lists->count[size_class]++;
+            return;
+        }
+    }
+    free(header);
+}
+
+static void *_cached_resize(void *context, void *ptr, size_t size) {
+    if (!ptr) {
+        return _cached_alloc(context, size);
+    }
+    _cache_header *header = (_cache_header *)ptr - 1;
+    if (header->size_class == CACHE_LARGE && _cache_class(size) == CACHE_LARGE) {
+        if (size > SIZE_MAX - sizeof(_cache_header)) {
+            return NULL;
+        }
+        _cache_header *moved = realloc(header, sizeof(_cache_header) + size);
+        return moved ? moved + 1 : NULL;
+    }
+    if (header->size_class != CACHE_LARGE && size <= _cache_class_size(header->size_class)) {
+        return ptr; // Still fits its class
+    }
+
+    void *grown = _cached_alloc(context, size);
+    if (!grown) {
+        return NULL;
+    }
+    size_t old_size = header->size_class == CACHE_LARGE ? size : _cache_class_size(header->size_class);
+    memcpy(grown, ptr, old_size < size ? old_size : size);
+    _cached_release(context, ptr);
+    return grown;
+}
+
+static const fossil_allocator_t _cached_allocator = {
+    _cached_alloc, _cached_resize, _cached_release, NULL
+};
+
+static _fossil_atomic_ptr _global_allocator = (void *)&_system_allocator;
+
+const fossil_allocator_t *fossil_allocator_system(void) {
+    return &_system_allocator;
+}
+
+const fossil_allocator_t *fossil_allocator_cached(void) {
+    return &_cached_allocator;
+}
+
+void fossil_allocator_set(const fossil_allocator_t *allocator) {
+    _fossil_atomic_ptr_store(&_global_allocator, (void *)(allocator ? allocator : &_system_allocator));
+}
+
+const fossil_allocator_t *fossil_allocator_get(void) {
+    return _fossil_atomic_ptr_load(&_global_allocator);
+}
+
+void *fossil_allocator_alloc(const fossil_allocator_t *allocator, size_t size) {
+    if (!allocator) {
+        allocator = fossil_allocator_get();
+    }
+    return allocator->alloc(allocator->context, size);
+}
+
+void *fossil_allocator_resize(const fossil_allocator_t *allocator, void *ptr, size_t size) {
+    if (!allocator) {
+        allocator = fossil_allocator_get();
+    }
+    return allocator->resize(allocator->context, ptr, size);
+}
+
+void fossil_allocator_release(const fossil_allocator_t *allocator, void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    if (!allocator) {
+        allocator = fossil_allocator_get();
+    }
+    allocator->release(allocator->context, ptr);
+}
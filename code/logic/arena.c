@@ -0,0 +1,617 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // For mmap and MADV_HUGEPAGE under strict C modes
+#endif
+
+#include "fossil/string/arena.h"
+#include "fossil/string/sstring.h"
+
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#define ARENA_ALIGN 16
+#define ARENA_ROUND(n) (((n) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+#define ARENA_HUGE_PAGE 2097152
+
+typedef struct _arena_block {
+    struct _arena_block *next;
+    size_t size;   // usable bytes after the header
+    size_t used;
+    size_t mapped; // bytes mapped with mmap, or 0 when allocated with malloc
+} _arena_block;
+
+#define ARENA_HEADER ARENA_ROUND(sizeof(_arena_block))
+
+struct fossil_arena {
+    _arena_block *first;
+    _arena_block *current;
+    void *last;          // the latest allocation, which can grow in place
+    _arena_block *last_block;
+    size_t block_size;
+    int flags;
+};
+
+static unsigned char *_arena_block_data(_arena_block *block) {
+    return (unsigned char *)block + ARENA_HEADER;
+}
+
+static _arena_block *_arena_block_new(const fossil_arena_t *arena, size_t size) {
+    if (size > SIZE_MAX - ARENA_HEADER - 2 * ARENA_HUGE_PAGE) {
+        return NULL; // Size overflow
+    }
+    size_t bytes = ARENA_HEADER + size;
+    _arena_block *block = NULL;
+    size_t mapped = 0;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (arena->flags & FOSSIL_ARENA_HUGE_PAGES) {
+        // Round to whole huge pages and ask the kernel to back them transparently.
+        // Huge pages need 2 MiB aligned addresses, so map one extra huge page and
+        // trim the unaligned head and the tail around an aligned run.
+        size_t length = (bytes + ARENA_HUGE_PAGE - 1) / ARENA_HUGE_PAGE * ARENA_HUGE_PAGE;
+        void *map = mmap(NULL, length + ARENA_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map != MAP_FAILED) {
+            uintptr_t aligned = ((uintptr_t)map + ARENA_HUGE_PAGE - 1) & ~(uintptr_t)(ARENA_HUGE_PAGE - 1);
+            size_t head = (size_t)(aligned - (uintptr_t)map);
+            if (head > 0) {
+                munmap(map, head);
+            }
+            munmap((void *)(aligned + length), ARENA_HUGE_PAGE - head);
+            madvise((void *)aligned, length, MADV_HUGEPAGE);
+            block = (_arena_block *)aligned;
+            mapped = length;
+            size = length - ARENA_HEADER;
+        }
+    }
+#else
+    (void)arena;
+#endif
+
+    if (!block) {
+        block = malloc(bytes);
+        if (!block) {
+            return NULL;
+        }
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    block->mapped = mapped;
+    return block;
+}
+
+static void _arena_block_free(_arena_block *block) {
+#if defined(__linux__)
+    if (block->mapped) {
+        munmap(block, block->mapped);
+        return;
+    }
+#endif
+    free(block);
+}
+
+fossil_arena_t *fossil_arena_create(size_t block_size, int flags) {
+    fossil_arena_t *arena = malloc(sizeof(fossil_arena_t));
+    if (!arena) {
+        return NULL;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->last = NULL;
+    arena->last_block = NULL;
+    arena->block_size = block_size ? ARENA_ROUND(block_size) : FOSSIL_ARENA_DEFAULT_BLOCK;
+    arena->flags = flags;
+    return arena;
+}
+
+void fossil_arena_erase(fossil_arena_t *arena) {
+    if (!arena) {
+        return;
+    }
+    while (arena->first) {
+        _arena_block *next = arena->first->next;
+        _arena_block_free(arena->first);
+        arena->first = next;
+    }
+    free(arena);
+}
+
+void fossil_arena_reset(fossil_arena_t *arena) {
+    if (!arena) {
+        return;
+    }
+    for (_arena_block *block = arena->first; block; block = block->next) {
+        block->used = 0;
+    }
+    arena->current = arena->first;
+    arena->last = NULL;
+    arena->last_block = NULL;
+}
+
+size_t fossil_arena_used(const fossil_arena_t *arena) {
+    size_t total = 0;
+    if (arena) {
+        for (_arena_block *block = arena->first; block; block = block->next) {
+            total += block->used;
+        }
+    }
+    return total;
+}
+
+void *fossil_arena_alloc(fossil_arena_t *arena, size_t size) {
+    if (!arena || size > SIZE_MAX - ARENA_ALIGN) {
+        return NULL;
+    }
+    size = size ? ARENA_ROUND(size) : ARENA_ALIGN;
+
+    // Walk forward through blocks kept from before the last reset
+    _arena_block *block = arena->current;
+    while (block && block->size - block->used < size) {
+        block = block->next;
+    }
+    if (!block) {
+        block = _arena_block_new(arena, size > arena->block_size ? size : arena->block_size);
+        if (!block) {
+            return NULL;
+        }
+        if (arena->current) {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else {
+            block->next = arena->first;
+            arena->first = block;
+        }
+    }
+    // Oversized requests do not move the bump pointer away from a roomy block
+    if (!arena->current || block->size - size >= arena->current->size - arena->current->used) {
+        arena->current = block;
+    }
+
+    void *ptr = _arena_block_data(block) + block->used;
+    block->used += size;
+    arena->last = ptr;
+    arena->last_block = block;
+    return ptr;
+}
+
+static void *_arena_allocator_alloc(void *context, size_t size) {
+    return fossil_arena_alloc(context, size);
+}
+
+/*
+ * The arena does not record allocation sizes, so a moved allocation takes
+ * everything from 'ptr' to the end of its block's used bytes, which covers
+ * the old allocation. The latest allocation grows in place while its block
+ * has room.
+ */
+static void *_arena_allocator_resize(void *context, void *ptr, size_t size) {
+    fossil_arena_t *arena = context;
+    if (!ptr) {
+        return fossil_arena_alloc(arena, size);
+    }
+    _arena_block *block = arena->first;
+    uintptr_t at = (uintptr_t)ptr;
+    while (block && !(at >= (uintptr_t)_arena_block_data(block) &&
+                      at < (uintptr_t)_arena_block_data(block) + block->used)) {
+        block = block->next;
+    }
+    if (!block || size > SIZE_MAX - ARENA_ALIGN) {
+        return NULL;
+    }
+    size_t offset = (size_t)(at - (uintptr_t)_arena_block_data(block));
+    size_t rounded = size ? ARENA_ROUND(size) : ARENA_ALIGN;
+    if (ptr == arena->last && block == arena->last_block && rounded <= block->size - offset) {
+        block->used = offset + rounded;
+        return ptr;
+    }
+    size_t available = block->used - offset;
+    void *moved = fossil_arena_alloc(arena, size);
+    if (moved) {
+        memcpy(moved, ptr, available < size ? available : size);
+    }
+    return moved;
+}
+
+static void _arena_allocator_release(void *context, void *ptr) {
+    (void)context;
+    (void)ptr; // returned all at once by fossil_arena_reset or fossil_arena_erase
+}
+
+fossil_allocator_t fossil_arena_allocator(fossil_arena_t *arena) {
+    fossil_allocator_t allocator = {
+        _arena_allocator_alloc, _arena_allocator_resize, _arena_allocator_release, arena
+    };
+    return allocator;
+}
+
+static cstring _arena_copy(fossil_arena_t *arena, const_cstring str, size_t len) {
+    cstring out = fossil_arena_alloc(arena, len + 1);
+    if (!out) {
+        return NULL;
+    }
+    memcpy(out, str, len);
+    out[len] = '\0';
+    return out;
+}
+
+cstring fossil_arena_cstr_create(fossil_arena_t *arena, const_cstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return _arena_copy(arena, str, strlen(str));
+}
+
+cstring fossil_arena_cstr_substr(fossil_arena_t *arena, const_cstring str, size_t start, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    size_t str_len = strlen(str);
+    if (start >= str_len) {
+        return NULL;
+    }
+    if (len > str_len - start) {
+        len = str_len - start;
+    }
+    return _arena_copy(arena, str + start, len);
+}
+
+cstrings fossil_arena_cstr_split(fossil_arena_t *arena, const_cstring str, cletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = strlen(str);
+    size_t count = 1;
+    for (const cletter *hit = memchr(str, delimiter, len); hit;
+         hit = memchr(hit + 1, delimiter, len - (size_t)(hit + 1 - str))) {
+        count++;
+    }
+
+    // One copy of the input holds every token; delimiters become terminators
+    cstrings splits = fossil_arena_alloc(arena, (count + 1) * sizeof(cstring));
+    cstring data = splits ? _arena_copy(arena, str, len) : NULL;
+    if (!data) {
+        return NULL;
+    }
+    size_t index = 0;
+    splits[index++] = data;
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == delimiter) {
+            data[i] = '\0';
+            splits[index++] = data + i + 1;
+        }
+    }
+    splits[count] = NULL;
+    return splits;
+}
+
+cstring fossil_arena_cstr_vformat(fossil_arena_t *arena, const_cstring format, va_list args) {
+    if (!arena || !format) {
+        return NULL; // Input validation
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    // Format straight into the free tail of the current block when it fits
+    _arena_block *block = arena->current;
+    size_t avail = block ? block->size - block->used : 0;
+    cstring tail = block ? (cstring)_arena_block_data(block) + block->used : NULL;
+    int size = vsnprintf(tail, avail, format, args);
+    if (size < 0) {
+        va_end(args_copy);
+        return NULL; // Error handling
+    }
+
+    cstring out;
+    if ((size_t)size < avail) {
+        block->used += ARENA_ROUND((size_t)size + 1);
+        out = tail;
+    } else {
+        out = fossil_arena_alloc(arena, (size_t)size + 1);
+        if (out) {
+            vsnprintf(out, (size_t)size + 1, format, args_copy);
+        }
+    }
+    va_end(args_copy);
+    return out;
+}
+
+cstring fossil_arena_cstr_format(fossil_arena_t *arena, const_cstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    cstring out = fossil_arena_cstr_vformat(arena, format, args);
+    va_end(args);
+    return out;
+}
+
+// Move a small string into the arena; short results never touch malloc
+static cstring _arena_take(fossil_arena_t *arena, sstring *tmp, const_cstring result) {
+    cstring out = result ? _arena_copy(arena, result, fossil_sstr_length(tmp)) : NULL;
+    fossil_sstr_erase(tmp);
+    return out;
+}
+
+cstring fossil_arena_cstr_format_phone(fossil_arena_t *arena, const_cstring phone) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_phone(&tmp, phone));
+}
+
+cstring fossil_arena_cstr_format_date(fossil_arena_t *arena, const_cstring date) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_date(&tmp, date));
+}
+
+cstring fossil_arena_cstr_format_time(fossil_arena_t *arena, const_cstring time) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_time(&tmp, time));
+}
+
+cstring fossil_arena_cstr_format_currency(fossil_arena_t *arena, const_cstring currency) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_currency(&tmp, currency));
+}
+
+cstring fossil_arena_cstr_format_percentage(fossil_arena_t *arena, const_cstring percentage) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_percentage(&tmp, percentage));
+}
+
+cstring fossil_arena_cstr_format_postal_code(fossil_arena_t *arena, const_cstring postal_code) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_postal_code(&tmp, postal_code));
+}
+
+cstring fossil_arena_cstr_format_ssn(fossil_arena_t *arena, const_cstring ssn) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_format_ssn(&tmp, ssn));
+}
+
+cstring fossil_arena_cstr_from_int(fossil_arena_t *arena, int num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_int(&tmp, num));
+}
+
+cstring fossil_arena_cstr_from_long(fossil_arena_t *arena, long num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_long(&tmp, num));
+}
+
+cstring fossil_arena_cstr_from_llong(fossil_arena_t *arena, long long num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_llong(&tmp, num));
+}
+
+cstring fossil_arena_cstr_from_ulong(fossil_arena_t *arena, unsigned long num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_ulong(&tmp, num));
+}
+
+cstring fossil_arena_cstr_from_ullong(fossil_arena_t *arena, unsigned long long num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_ullong(&tmp, num));
+}
+
+cstring fossil_arena_cstr_from_double(fossil_arena_t *arena, double num) {
+    sstring tmp;
+    fossil_sstr_init(&tmp);
+    return _arena_take(arena, &tmp, fossil_sstr_from_double(&tmp, num));
+}
+
+// Count bletter units up to the zero terminator
+static size_t _arena_bstr_units(const_bstring str) {
+    size_t len = 0;
+    while (str[len] != 0) {
+        len++;
+    }
+    return len;
+}
+
+static bstring _arena_bstr_copy(fossil_arena_t *arena, const_bstring str, size_t len) {
+    bstring out = fossil_arena_alloc(arena, (len + 1) * sizeof(bletter));
+    if (!out) {
+        return NULL;
+    }
+    memcpy(out, str, len * sizeof(bletter));
+    out[len] = 0;
+    return out;
+}
+
+bstring fossil_arena_bstr_create(fossil_arena_t *arena, const_bstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return _arena_bstr_copy(arena, str, _arena_bstr_units(str));
+}
+
+bstring fossil_arena_bstr_substr(fossil_arena_t *arena, const_bstring str, size_t start, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    size_t str_len = _arena_bstr_units(str);
+    if (start >= str_len) {
+        return NULL;
+    }
+    if (len > str_len - start) {
+        len = str_len - start;
+    }
+    return _arena_bstr_copy(arena, str + start, len);
+}
+
+bstrings fossil_arena_bstr_split(fossil_arena_t *arena, const_bstring str, bletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _arena_bstr_units(str);
+    size_t count = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (str[i] == delimiter) {
+            count++;
+        }
+    }
+
+    bstrings splits = fossil_arena_alloc(arena, (count + 1) * sizeof(bstring));
+    bstring data = splits ? _arena_bstr_copy(arena, str, len) : NULL;
+    if (!data) {
+        return NULL;
+    }
+    size_t index = 0;
+    splits[index++] = data;
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == delimiter) {
+            data[i] = 0;
+            splits[index++] = data + i + 1;
+        }
+    }
+    splits[count] = NULL;
+    return splits;
+}
+
+bstring fossil_arena_bstr_format(fossil_arena_t *arena, const_bstring format, ...) {
+    if (!arena || !format) {
+        return NULL; // Input validation
+    }
+
+    // Narrow the format to bytes, format it, then widen the result to bletter units
+    size_t format_len = _arena_bstr_units(format);
+    cstring narrow = fossil_arena_alloc(arena, format_len + 1);
+    if (!narrow) {
+        return NULL;
+    }
+    for (size_t i = 0; i <= format_len; i++) {
+        if (format[i] > 0xFF) {
+            return NULL; // not a byte, as in fossil_bstr_format
+        }
+        narrow[i] = (cletter)format[i];
+    }
+
+    va_list args;
+    va_start(args, format);
+    cstring bytes = fossil_arena_cstr_vformat(arena, narrow, args);
+    va_end(args);
+    if (!bytes) {
+        return NULL;
+    }
+
+    size_t len = strlen(bytes);
+    bstring out = fossil_arena_alloc(arena, (len + 1) * sizeof(bletter));
+    if (!out) {
+        return NULL;
+    }
+    for (size_t i = 0; i <= len; i++) {
+        out[i] = (bletter)(unsigned char)bytes[i];
+    }
+    return out;
+}
+
+static wstring _arena_wstr_copy(fossil_arena_t *arena, const_wstring str, size_t len) {
+    wstring out = fossil_arena_alloc(arena, (len + 1) * sizeof(wletter));
+    if (!out) {
+        return NULL;
+    }
+    wmemcpy(out, str, len);
+    out[len] = L'\0';
+    return out;
+}
+
+wstring fossil_arena_wstr_create(fossil_arena_t *arena, const_wstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return _arena_wstr_copy(arena, str, wcslen(str));
+}
+
+wstring fossil_arena_wstr_substr(fossil_arena_t *arena, const_wstring str, size_t start, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    size_t str_len = wcslen(str);
+    if (start >= str_len) {
+        return NULL;
+    }
+    if (len > str_len - start) {
+        len = str_len - start;
+    }
+    return _arena_wstr_copy(arena, str + start, len);
+}
+
+wstrings fossil_arena_wstr_split(fossil_arena_t *arena, const_wstring str, wletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = wcslen(str);
+    size_t count = 1;
+    for (const wletter *hit = wmemchr(str, delimiter, len); hit;
+         hit = wmemchr(hit + 1, delimiter, len - (size_t)(hit + 1 - str))) {
+        count++;
+    }
+
+    wstrings splits = fossil_arena_alloc(arena, (count + 1) * sizeof(wstring));
+    wstring data = splits ? _arena_wstr_copy(arena, str, len) : NULL;
+    if (!data) {
+        return NULL;
+    }
+    size_t index = 0;
+    splits[index++] = data;
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == delimiter) {
+            data[i] = L'\0';
+            splits[index++] = data + i + 1;
+        }
+    }
+    splits[count] = NULL;
+    return splits;
+}
+
+wstring fossil_arena_wstr_format(fossil_arena_t *arena, const_wstring format, ...) {
+    if (!arena || !format) {
+        return NULL; // Input validation
+    }
+
+    // vswprintf cannot report the size it needs, so grow a scratch buffer until it fits
+    size_t cap = 64;
+    wstring scratch = NULL;
+    int size = -1;
+    while (size < 0 && cap <= ((size_t)INT_MAX) / sizeof(wletter)) {
+        wstring grown = realloc(scratch, cap * sizeof(wletter));
+        if (!grown) {
+            break;
+        }
+        scratch = grown;
+        va_list args;
+        va_start(args, format);
+        size = vswprintf(scratch, cap, format, args);
+        va_end(args);
+        cap *= 2;
+    }
+
+    wstring out = size >= 0 ? _arena_wstr_copy(arena, scratch, (size_t)size) : NULL;
+    free(scratch);
+    return out;
+}
@@ -0,0 +1,292 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/bktree.h"
+#include "edit.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Nodes are stored breadth first, so the children of a node sit next to
+ * each other, sorted by their distance from it, and a query finds the
+ * ones in range by bisection. A child at distance 0 is a duplicate of its
+ * parent and shares the parent's distance from the query.
+ */
+
+#define BKTREE_STACK 128              // query stack entries kept on the C stack
+#define BKTREE_UNKNOWN ((size_t)-1)    // no distance yet, or no node
+
+typedef struct {
+    size_t key;      // offset of the key in 'text'
+    size_t length;
+    size_t id;
+    size_t edge;     // distance from the parent
+    size_t children; // first child
+    size_t child_count;
+} _bktree_node;
+
+struct fossil_bktree {
+    char *text;       // the keys, each NUL-terminated
+    size_t *offsets;  // key offset by id
+    _bktree_node *nodes;
+    size_t count;
+};
+
+// A node waiting to be visited, with its distance from the query when already known
+typedef struct {
+    size_t node;
+    size_t distance;
+} _bktree_visit;
+
+// ---- building ----
+
+// Insert key 'i' under the root of the linked tree; returns 0 if memory runs out
+static int _bktree_insert(const fossil_bktree_t *tree, _bktree_node *nodes, size_t *first, size_t *next, size_t i) {
+    const char *key = tree->text + nodes[i].key;
+    size_t at = 0;
+    for (;;) {
+        size_t d = _fossil_edit_distance(key, nodes[i].length, tree->text + nodes[at].key, nodes[at].length, 1,
+                                         SIZE_MAX - 2);
+        if (d == SIZE_MAX) {
+            return 0;
+        }
+        size_t child = first[at];
+        while (child != BKTREE_UNKNOWN && nodes[child].edge != d) {
+            child = next[child];
+        }
+        if (child == BKTREE_UNKNOWN) {
+            nodes[i].edge = d;
+            next[i] = first[at];
+            first[at] = i;
+            return 1;
+        }
+        at = child;
+    }
+}
+
+static int _bktree_edge_order(const void *a, const void *b) {
+    const _bktree_node *x = a, *y = b;
+    if (x->edge != y->edge) {
+        return (x->edge > y->edge) - (x->edge < y->edge);
+    }
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Lay the linked tree out breadth first into 'tree->nodes'
+static void _bktree_layout(fossil_bktree_t *tree, const _bktree_node *linked, const size_t *first, const size_t *next,
+                           size_t *origin) {
+    // origin[k] is the linked index of laid-out node k
+    tree->nodes[0] = linked[0];
+    origin[0] = 0;
+    size_t filled = 1;
+    for (size_t k = 0; k < filled; k++) {
+        size_t begin = filled;
+        for (size_t child = first[origin[k]]; child != BKTREE_UNKNOWN; child = next[child]) {
+            tree->nodes[filled] = linked[child];
+            tree->nodes[filled].children = child; // stash the linked index while sorting
+            filled++;
+        }
+        qsort(tree->nodes + begin, filled - begin, sizeof(_bktree_node), _bktree_edge_order);
+        for (size_t j = begin; j < filled; j++) {
+            origin[j] = tree->nodes[j].children;
+        }
+        tree->nodes[k].children = begin;
+        tree->nodes[k].child_count = filled - begin;
+    }
+}
+
+fossil_bktree_t *fossil_bktree_create(cstrings keys) {
+    if (!keys) {
+        return NULL;
+    }
+    fossil_bktree_t *tree = calloc(1, sizeof(fossil_bktree_t));
+    if (!tree) {
+        return NULL;
+    }
+    size_t bytes = 0;
+    while (keys[tree->count]) {
+        bytes += _fossil_simd_length(keys[tree->count], 1) + 1;
+        tree->count++;
+    }
+
+    size_t n = tree->count;
+    tree->text = malloc(bytes ? bytes : 1);
+    tree->offsets = malloc((n ? n : 1) * sizeof(size_t));
+    tree->nodes = malloc((n ? n : 1) * sizeof(_bktree_node));
+    _bktree_node *linked = malloc((n ? n : 1) * sizeof(_bktree_node));
+    size_t *first = malloc((n ? n : 1) * sizeof(size_t));
+    size_t *next = malloc((n ? n : 1) * sizeof(size_t));
+    size_t *origin = malloc((n ? n : 1) * sizeof(size_t));
+    int ok = tree->text && tree->offsets && tree->nodes && linked && first && next && origin;
+
+    size_t offset = 0;
+    for (size_t i = 0; ok && i < n; i++) {
+        size_t length = _fossil_simd_length(keys[i], 1);
+        memcpy(tree->text + offset, keys[i], length + 1);
+        tree->offsets[i] = offset;
+        linked[i].key = offset;
+        linked[i].length = length;
+        linked[i].id = i;
+        linked[i].edge = 0;
+        linked[i].children = 0;
+        linked[i].child_count = 0;
+        first[i] = next[i] = BKTREE_UNKNOWN;
+        offset += length + 1;
+    }
+    for (size_t i = 1; ok && i < n; i++) {
+        ok = _bktree_insert(tree, linked, first, next, i);
+    }
+    if (ok && n > 0) {
+        _bktree_layout(tree, linked, first, next, origin);
+
+        // Store the keys in node order too, so siblings' keys share cache lines
+        char *text = malloc(bytes);
+        ok = text != NULL;
+        offset = 0;
+        for (size_t k = 0; ok && k < n; k++) {
+            _bktree_node *node = &tree->nodes[k];
+            memcpy(text + offset, tree->text + node->key, node->length + 1);
+            node->key = tree->offsets[node->id] = offset;
+            offset += node->length + 1;
+        }
+        if (ok) {
+            free(tree->text);
+            tree->text = text;
+        }
+    }
+    free(linked);
+    free(first);
+    free(next);
+    free(origin);
+    if (!ok) {
+        fossil_bktree_erase(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+void fossil_bktree_erase(fossil_bktree_t *tree) {
+    if (!tree) {
+        return;
+    }
+    free(tree->text);
+    free(tree->offsets);
+    free(tree->nodes);
+    free(tree);
+}
+
+size_t fossil_bktree_count(const fossil_bktree_t *tree) {
+    return tree ? tree->count : 0;
+}
+
+const_cstring fossil_bktree_key(const fossil_bktree_t *tree, size_t id) {
+    return tree && id < tree->count ? tree->text + tree->offsets[id] : NULL;
+}
+
+// ---- querying ----
+
+/*
+ * Keep the 'capacity' closest matches in 'matches', ordered by distance
+ * and then id. Returns the new number stored.
+ */
+static size_t _bktree_keep(fossil_bktree_match_t *matches, size_t stored, size_t capacity, size_t id, size_t distance) {
+    size_t at = stored;
+    while (at > 0 && (matches[at - 1].distance > distance ||
+                      (matches[at - 1].distance == distance && matches[at - 1].id > id))) {
+        at--;
+    }
+    if (at >= capacity) {
+        return stored;
+    }
+    size_t moved = (stored < capacity ? stored : capacity - 1) - at;
+    memmove(matches + at + 1, matches + at, moved * sizeof(*matches));
+    matches[at].id = id;
+    matches[at].distance = distance;
+    return stored < capacity ? stored + 1 : stored;
+}
+
+size_t fossil_bktree_find(const fossil_bktree_t *tree, const_cstring query, size_t max,
+                          fossil_bktree_match_t *matches, size_t capacity) {
+    if (!tree || !query || tree->count == 0 || (matches && capacity == 0)) {
+        return 0;
+    }
+    if (max > SIZE_MAX / 4) {
+        max = SIZE_MAX / 4; // keeps the bounds below from overflowing
+    }
+    _fossil_edit_pattern pattern;
+    if (!_fossil_edit_pattern_init(&pattern, query, _fossil_simd_length(query, 1), 1, 0)) {
+        return FOSSIL_FUZZY_ERROR;
+    }
+
+    _bktree_visit local[BKTREE_STACK];
+    _bktree_visit *stack = local;
+    size_t depth = 0, room = BKTREE_STACK, found = 0;
+    stack[depth].node = 0;
+    stack[depth++].distance = BKTREE_UNKNOWN;
+
+    while (depth > 0) {
+        _bktree_visit visit = stack[--depth];
+        const _bktree_node *node = &tree->nodes[visit.node];
+        const _bktree_node *children = tree->nodes + node->children;
+
+        // Once 'matches' is full only closer keys can get in
+        size_t radius = matches && found == capacity ? matches[capacity - 1].distance : max;
+        size_t widest = node->child_count ? children[node->child_count - 1].edge : 0;
+        size_t d = visit.distance;
+        if (d == BKTREE_UNKNOWN) {
+            // Past radius + widest neither the node nor any child can qualify
+            size_t limit = radius + (widest < SIZE_MAX / 4 ? widest : SIZE_MAX / 4);
+            d = _fossil_edit_pattern_distance(&pattern, tree->text + node->key, node->length, limit);
+        }
+        if (d <= radius) {
+            found = matches ? _bktree_keep(matches, found, capacity, node->id, d) : found + 1;
+        }
+
+        // Children from d - radius to d + radius away from this node may be within radius of the query
+        size_t low = d > radius ? d - radius : 0, lo = 0, hi = node->child_count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (children[mid].edge < low) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        for (size_t c = lo; c < node->child_count && children[c].edge <= d + radius; c++) {
+            if (depth == room) {
+                _bktree_visit *grown = malloc(room * 2 * sizeof(_bktree_visit));
+                if (!grown) {
+                    found = FOSSIL_FUZZY_ERROR;
+                    depth = 0;
+                    break;
+                }
+                memcpy(grown, stack, depth * sizeof(_bktree_visit));
+                if (stack != local) {
+                    free(stack);
+                }
+                stack = grown;
+                room *= 2;
+            }
+            stack[depth].node = node->children + c;
+            stack[depth++].distance = children[c].edge == 0 ? d : BKTREE_UNKNOWN;
+        }
+    }
+    if (stack != local) {
+        free(stack);
+    }
+    _fossil_edit_pattern_release(&pattern);
+    return found;
+}
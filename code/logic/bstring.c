@@ -12,21 +12,11 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/string/bstring.h"
+#include "simd.h"
+#include "search.h"
+#include "fold.h"
 
-// Helper function to calculate the number of digits in an integer
-int _bstr_num_digits(long long num) {
-    int count = 0;
-    if (num == 0) return 1; // Handle special case for zero
-    if (num < 0) {
-        count++; // Account for negative sign
-        num = -num; // Convert negative number to positive
-    }
-    while (num > 0) {
-        count++;
-        num /= 10;
-    }
-    return count;
-}
+#define BSTR_SCRATCH 256 // strings shorter than this are narrowed or formatted on the stack
 
 bstring fossil_bstr_create(const_bstring str) {
     if (!str) {
@@ -35,10 +25,25 @@ bstring fossil_bstr_create(const_bstring str) {
     return fossil_bstr_strdup(str); // Allocate memory and copy string using strdup
 }
 
+bstring fossil_bstr_create_with(const fossil_allocator_t *allocator, const_bstring str) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = fossil_bstr_length(str);
+    bstring dup = fossil_allocator_alloc(allocator, (len + 1) * sizeof(bletter));
+    if (!dup) {
+        return NULL;
+    }
+    return (bstring)memcpy(dup, str, (len + 1) * sizeof(bletter));
+}
+
 void fossil_bstr_erase(bstring str) {
+    fossil_bstr_erase_with(NULL, str);
+}
+
+void fossil_bstr_erase_with(const fossil_allocator_t *allocator, bstring str) {
     if (str) {
-        free(str); // Free memory allocated for the byte string
-        str = NULL; // Reset the pointer to NULL
+        fossil_allocator_release(allocator, str); // Free memory allocated for the byte string
     }
 }
 
@@ -46,34 +51,111 @@ size_t fossil_bstr_length(const_bstring str) {
     if (!str) {
         return 0;
     }
-    return strlen((const char *)str); // Calculate byte string length using strlen
+    return _fossil_simd_length(str, sizeof(bletter)); // Length in bletter units
 }
 
-bstring fossil_bstr_format(const_bstring format, ...) {
+// Widen 'len' bytes and their terminator into a new string of bletter units
+static bstring _bstr_widen(const fossil_allocator_t *allocator, const char *bytes, size_t len) {
+    bstring out = fossil_allocator_alloc(allocator, (len + 1) * sizeof(bletter));
+    if (!out) {
+        return NULL;
+    }
+    for (size_t i = 0; i <= len; i++) {
+        out[i] = (bletter)(unsigned char)bytes[i];
+    }
+    return out;
+}
+
+// Free bytes from _bstr_narrow or _bstr_vformat unless they live in the caller's scratch
+static void _bstr_release_bytes(char *bytes, const char *scratch) {
+    if (bytes != scratch) {
+        free(bytes);
+    }
+}
+
+// Narrow bletter units into bytes for the C library, in 'scratch' (BSTR_SCRATCH bytes) when they fit; NULL if a unit needs more than a byte
+static char *_bstr_narrow(const_bstring str, char *scratch) {
+    size_t len = fossil_bstr_length(str);
+    char *out = len < BSTR_SCRATCH ? scratch : malloc(len + 1);
+    if (!out) {
+        return NULL;
+    }
+    for (size_t i = 0; i <= len; i++) {
+        if (str[i] > 0xFF) {
+            _bstr_release_bytes(out, scratch);
+            return NULL;
+        }
+        out[i] = (char)str[i];
+    }
+    return out;
+}
+
+// Format with a byte format string, then widen the result to bletter units
+static bstring _bstr_vformat(const fossil_allocator_t *allocator, const char *format, va_list args) {
     if (!format) {
         return NULL; // Input validation
     }
 
-    va_list args, args_copy;
-    va_start(args, format);
+    va_list args_copy;
     va_copy(args_copy, args);
 
-    // Calculate required size
-    int size = vsnprintf(NULL, 0, (const char *)format, args);
-    va_end(args);
-
+    // Short results are built on the stack; the first pass also measures long ones
+    char scratch[BSTR_SCRATCH];
+    int size = vsnprintf(scratch, sizeof(scratch), format, args);
     if (size < 0) {
+        va_end(args_copy);
         return NULL; // Error handling
     }
 
-    bstring buffer = malloc((size_t)size + 1);
-    if (!buffer) {
-        return NULL; // Memory management
+    char *bytes = scratch;
+    if ((size_t)size >= sizeof(scratch)) {
+        bytes = malloc((size_t)size + 1);
+        if (!bytes) {
+            va_end(args_copy);
+            return NULL; // Memory management
+        }
+        vsnprintf(bytes, (size_t)size + 1, format, args_copy);
     }
-
-    vsnprintf((char *)buffer, (size_t)size + 1, (const char *)format, args_copy);
     va_end(args_copy);
 
+    bstring buffer = _bstr_widen(allocator, bytes, (size_t)size);
+    _bstr_release_bytes(bytes, scratch);
+    return buffer;
+}
+
+static bstring _bstr_format_bytes(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    bstring buffer = _bstr_vformat(NULL, format, args);
+    va_end(args);
+    return buffer;
+}
+
+bstring fossil_bstr_format(const_bstring format, ...) {
+    char scratch[BSTR_SCRATCH];
+    char *narrow = format ? _bstr_narrow(format, scratch) : NULL;
+    if (!narrow) {
+        return NULL;
+    }
+    va_list args;
+    va_start(args, format);
+    bstring buffer = _bstr_vformat(NULL, narrow, args);
+    va_end(args);
+    _bstr_release_bytes(narrow, scratch);
+    return buffer;
+}
+
+bstring fossil_bstr_format_with(const fossil_allocator_t *allocator, const_bstring format, ...) {
+    char scratch[BSTR_SCRATCH];
+    char *narrow = format ? _bstr_narrow(format, scratch) : NULL;
+    if (!narrow) {
+        return NULL;
+    }
+    va_list args;
+    va_start(args, format);
+    bstring buffer = _bstr_vformat(allocator, narrow, args);
+    va_end(args);
+    _bstr_release_bytes(narrow, scratch);
     return buffer;
 }
 
@@ -82,7 +164,7 @@ bstring fossil_bstr_format_phone(const_bstring phone) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("(%c%c%c) %c%c%c-%c%c%c%c"),
+    return _bstr_format_bytes("(%c%c%c) %c%c%c-%c%c%c%c",
                             phone[0], phone[1], phone[2],
                             phone[3], phone[4], phone[5],
                             phone[6], phone[7], phone[8], phone[9]);
@@ -93,7 +175,7 @@ bstring fossil_bstr_format_date(const_bstring date) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("%c%c/%c%c/%c%c%c%c"),
+    return _bstr_format_bytes("%c%c/%c%c/%c%c%c%c",
                             date[0], date[1],
                             date[2], date[3],
                             date[4], date[5], date[6], date[7]);
@@ -104,7 +186,7 @@ bstring fossil_bstr_format_time(const_bstring time) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("%c%c:%c%c:%c%c"),
+    return _bstr_format_bytes("%c%c:%c%c:%c%c",
                             time[0], time[1],
                             time[2], time[3],
                             time[4], time[5]);
@@ -115,7 +197,14 @@ bstring fossil_bstr_format_currency(const_bstring currency) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("$%s"), currency);
+    char scratch[BSTR_SCRATCH];
+    char *narrow = _bstr_narrow(currency, scratch);
+    if (!narrow) {
+        return NULL;
+    }
+    bstring buffer = _bstr_format_bytes("$%s", narrow);
+    _bstr_release_bytes(narrow, scratch);
+    return buffer;
 }
 
 bstring fossil_bstr_format_percentage(const_bstring percentage) {
@@ -123,7 +212,14 @@ bstring fossil_bstr_format_percentage(const_bstring percentage) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("%s%%"), percentage);
+    char scratch[BSTR_SCRATCH];
+    char *narrow = _bstr_narrow(percentage, scratch);
+    if (!narrow) {
+        return NULL;
+    }
+    bstring buffer = _bstr_format_bytes("%s%%", narrow);
+    _bstr_release_bytes(narrow, scratch);
+    return buffer;
 }
 
 bstring fossil_bstr_format_postal_code(const_bstring postal_code) {
@@ -131,7 +227,7 @@ bstring fossil_bstr_format_postal_code(const_bstring postal_code) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("%c%c%c%c%c"),
+    return _bstr_format_bytes("%c%c%c%c%c",
                             postal_code[0], postal_code[1],
                             postal_code[2], postal_code[3],
                             postal_code[4]);
@@ -142,18 +238,55 @@ bstring fossil_bstr_format_ssn(const_bstring ssn) {
         return NULL;
     }
 
-    return fossil_bstr_format(BSTR("%c%c%c-%c%c-%c%c%c%c"),
+    return _bstr_format_bytes("%c%c%c-%c%c-%c%c%c%c",
                             ssn[0], ssn[1], ssn[2],
                             ssn[3], ssn[4],
                             ssn[5], ssn[6], ssn[7], ssn[8]);
 }
 
 int fossil_bstr_compare(const_bstring str1, const_bstring str2) {
-    return (str1 && str2) ? memcmp(str1, str2, fossil_bstr_length(str1) + 1) : -1;
+    if (!str1 || !str2) {
+        return -1;
+    }
+    while (*str1 && *str1 == *str2) {
+        str1++;
+        str2++;
+    }
+    return (*str1 > *str2) - (*str1 < *str2); // Order by whole bletter units
+
+}
+
+int fossil_bstr_icompare(const_bstring str1, const_bstring str2) {
+    if (!str1 || !str2) {
+        return -1;
+    }
+    return _fossil_fold_compare(str1, str2, sizeof(bletter), 0);
+}
+
+int fossil_bstr_iequals(const_bstring str1, const_bstring str2) {
+    return str1 && str2 && _fossil_fold_equals(str1, str2, sizeof(bletter), 0);
+}
+
+int fossil_bstr_istarts_with(const_bstring str, const_bstring prefix) {
+    return str && prefix && _fossil_fold_starts_with(str, prefix, sizeof(bletter), 0);
+}
+
+const_bstring fossil_bstr_ifind_str(const_bstring str, const_bstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(bletter)), sizeof(bletter), _FOSSIL_FOLD_ASCII);
+    size_t i = _fossil_search_plan_find(&plan, str, _fossil_simd_length(str, sizeof(bletter)), 0);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+uint64_t fossil_bstr_ihash(const_bstring str) {
+    return str ? _fossil_fold_hash(str, sizeof(bletter), 0) : 0;
 }
 
 bstring fossil_bstr_copy(bstring dest, const_bstring src) {
-    return (dest && src) ? (bstring)memcpy(dest, src, fossil_bstr_length(src) + 1) : NULL;
+    return (dest && src) ? (bstring)memcpy(dest, src, (fossil_bstr_length(src) + 1) * sizeof(bletter)) : NULL;
 }
 
 bstring fossil_bstr_concat(bstring dest, const_bstring src) {
@@ -162,16 +295,87 @@ bstring fossil_bstr_concat(bstring dest, const_bstring src) {
     }
     size_t dest_len = fossil_bstr_length(dest);
     size_t src_len = fossil_bstr_length(src);
-    bstring new_dest = realloc(dest, dest_len + src_len + 1);
+    bstring new_dest = fossil_allocator_resize(NULL, dest, (dest_len + src_len + 1) * sizeof(bletter));
     if (!new_dest) {
         return NULL;
     }
-    memcpy(new_dest + dest_len, src, src_len + 1);
+    memcpy(new_dest + dest_len, src, (src_len + 1) * sizeof(bletter));
     return new_dest;
 }
 
 const_bstring fossil_bstr_find(const_bstring str, bletter ch) {
-    return str ? memchr(str, ch, fossil_bstr_length(str)) : NULL;
+    if (!str) {
+        return NULL;
+    }
+    size_t i = _fossil_simd_chr(str, ch, sizeof(bletter));
+    return str[i] == ch ? str + i : NULL;
+}
+
+const_bstring fossil_bstr_rfind(const_bstring str, bletter ch) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _fossil_simd_length(str, sizeof(bletter));
+    if (ch == 0) {
+        return str + len; // The terminator, as with strrchr
+    }
+    size_t i = _fossil_simd_rfind(str, len, ch, sizeof(bletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_bstring fossil_bstr_find_any(const_bstring str, const_bstring set) {
+    if (!str || !set) {
+        return NULL;
+    }
+    size_t i = _fossil_simd_find_any(str, _fossil_simd_length(str, sizeof(bletter)), set, _fossil_simd_length(set, sizeof(bletter)), sizeof(bletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_bstr_count(const_bstring str, bletter ch) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_count(str, _fossil_simd_length(str, sizeof(bletter)), ch, sizeof(bletter));
+}
+
+const_bstring fossil_bstr_find_str(const_bstring str, const_bstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_find(str, _fossil_simd_length(str, sizeof(bletter)), needle, _fossil_simd_length(needle, sizeof(bletter)), sizeof(bletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_bstring fossil_bstr_rfind_str(const_bstring str, const_bstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_rfind(str, _fossil_simd_length(str, sizeof(bletter)), needle, _fossil_simd_length(needle, sizeof(bletter)), sizeof(bletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+int fossil_bstr_contains(const_bstring str, const_bstring needle) {
+    return fossil_bstr_find_str(str, needle) != NULL;
+}
+
+size_t fossil_bstr_find_all(const_bstring str, bletter ch, size_t *offsets, size_t capacity) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_find_all(str, _fossil_simd_length(str, sizeof(bletter)), ch, sizeof(bletter), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_bstr_find_all_str(const_bstring str, const_bstring needle, size_t *offsets, size_t capacity) {
+    if (!str || !needle) {
+        return 0;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(bletter)), sizeof(bletter), _FOSSIL_FOLD_NONE);
+    return _fossil_search_plan_find_all(&plan, str, _fossil_simd_length(str, sizeof(bletter)), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_bstr_count_str(const_bstring str, const_bstring needle) {
+    return fossil_bstr_find_all_str(str, needle, NULL, 0);
 }
 
 const_bstring fossil_bstr_reverse(const_bstring str) {
@@ -179,28 +383,36 @@ const_bstring fossil_bstr_reverse(const_bstring str) {
         return NULL;
     }
     size_t len = fossil_bstr_length(str);
-    bstring rev = malloc(len + 1);
+    bstring rev = fossil_allocator_alloc(NULL, (len + 1) * sizeof(bletter));
     if (!rev) {
         return NULL;
     }
     for (size_t i = 0; i < len; i++) {
         rev[i] = str[len - i - 1];
     }
-    rev[len] = '\0';
+    rev[len] = 0;
     return rev;
 }
 
 void fossil_bstr_erase_splits(bstrings splits) {
+    fossil_bstr_erase_splits_with(NULL, splits);
+}
+
+void fossil_bstr_erase_splits_with(const fossil_allocator_t *allocator, bstrings splits) {
     if (!splits) {
         return;
     }
     for (size_t i = 0; splits[i] != NULL; i++) {
-        free(splits[i]);
+        fossil_allocator_release(allocator, splits[i]);
     }
-    free(splits);
+    fossil_allocator_release(allocator, splits);
 }
 
 bstrings fossil_bstr_split(const_bstring str, bletter delimiter) {
+    return fossil_bstr_split_with(NULL, str, delimiter);
+}
+
+bstrings fossil_bstr_split_with(const fossil_allocator_t *allocator, const_bstring str, bletter delimiter) {
     if (!str) {
         return NULL;
     }
@@ -215,7 +427,7 @@ bstrings fossil_bstr_split(const_bstring str, bletter delimiter) {
     }
     
     // Allocate memory for the array of byte strings
-    bstrings splits = malloc((count + 1) * sizeof(bstring));
+    bstrings splits = fossil_allocator_alloc(allocator, (count + 1) * sizeof(bstring));
     if (!splits) {
         return NULL;
     }
@@ -227,13 +439,13 @@ bstrings fossil_bstr_split(const_bstring str, bletter delimiter) {
     for (size_t i = 0; i <= len; i++) {
         if (str[i] == delimiter || str[i] == '\0') {
             size_t sublen = i - start;
-            splits[index] = malloc(sublen + 1);
+            splits[index] = fossil_allocator_alloc(allocator, (sublen + 1) * sizeof(bletter));
             if (!splits[index]) {
-                fossil_bstr_erase_splits((bstrings)splits);
+                fossil_bstr_erase_splits_with(allocator, splits);
                 return NULL;
             }
-            memcpy(splits[index], str + start, sublen);
-            splits[index][sublen] = '\0';
+            memcpy(splits[index], str + start, sublen * sizeof(bletter));
+            splits[index][sublen] = 0;
             start = i + 1;
             index++;
         }
@@ -244,18 +456,14 @@ bstrings fossil_bstr_split(const_bstring str, bletter delimiter) {
 }
 
 bstring fossil_bstr_strdup(const_bstring str) {
-    if (!str) {
-        return NULL;
-    }
-    size_t len = fossil_bstr_length(str);
-    bstring dup = malloc(len + 1);
-    if (!dup) {
-        return NULL;
-    }
-    return (bstring)memcpy(dup, str, len + 1);
+    return fossil_bstr_create_with(NULL, str);
 }
 
 bstring fossil_bstr_substr(const_bstring str, size_t start, size_t len) {
+    return fossil_bstr_substr_with(NULL, str, start, len);
+}
+
+bstring fossil_bstr_substr_with(const fossil_allocator_t *allocator, const_bstring str, size_t start, size_t len) {
     // Check if the input string is NULL
     if (str == NULL) return NULL;
 
@@ -271,14 +479,15 @@ bstring fossil_bstr_substr(const_bstring str, size_t start, size_t len) {
     }
 
     // Allocate memory for the substring
-    bstring substr = fossil_bstr_create(str);
+    bstring substr = fossil_allocator_alloc(allocator, (len + 1) * sizeof(bletter));
     if (substr == NULL) {
         // Handle memory allocation failure
         return NULL;
     }
 
-    // Copy the substring using the provided fossil_bstr_copy function
-    fossil_bstr_copy(substr, str + start);
+    // Copy the substring and terminate it
+    memcpy(substr, str + start, len * sizeof(bletter));
+    substr[len] = 0;
 
     // Return the substring
     return substr;
@@ -369,73 +578,46 @@ size_t fossil_bstrstream_tell(const_bstring str, size_t pos) {
 }
 
 bstring fossil_bstr_from_int(int num) {
-    int digits = _bstr_num_digits(num);
-    bstring str = malloc(digits + 1); // Allocate memory dynamically
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
-    snprintf((char *)str, digits + 1, "%d", num); // Use snprintf with dynamically calculated buffer size
-    return str;
+    char digits[24]; // Enough for any 64-bit value and its sign
+    int len = snprintf(digits, sizeof(digits), "%d", num);
+    return len < 0 ? NULL : _bstr_widen(NULL, digits, (size_t)len);
 }
 
 bstring fossil_bstr_from_long(long num) {
-    int digits = _bstr_num_digits(num);
-    bstring str = malloc(digits + 1); // Allocate memory dynamically
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
-    snprintf((char *)str, digits + 1, "%ld", num); // Use snprintf with dynamically calculated buffer size
-    return str;
+    char digits[24]; // Enough for any 64-bit value and its sign
+    int len = snprintf(digits, sizeof(digits), "%ld", num);
+    return len < 0 ? NULL : _bstr_widen(NULL, digits, (size_t)len);
 }
 
 bstring fossil_bstr_from_llong(long long num) {
-    int digits = _bstr_num_digits(num);
-    bstring str = malloc(digits + 1); // Allocate memory dynamically
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
-    snprintf((char *)str, digits + 1, "%ld", (long int)num); // Use snprintf with dynamically calculated buffer size
-    return str;
+    char digits[24]; // Enough for any 64-bit value and its sign
+    int len = snprintf(digits, sizeof(digits), "%lld", num);
+    return len < 0 ? NULL : _bstr_widen(NULL, digits, (size_t)len);
 }
 
 bstring fossil_bstr_from_ulong(unsigned long num) {
-    int digits = _bstr_num_digits(num);
-    bstring str = malloc(digits + 1); // Allocate memory dynamically
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
-    snprintf((char *)str, digits + 1, "%lu", num); // Use snprintf with dynamically calculated buffer size
-    return str;
+    char digits[24]; // Enough for any 64-bit value and its sign
+    int len = snprintf(digits, sizeof(digits), "%lu", num);
+    return len < 0 ? NULL : _bstr_widen(NULL, digits, (size_t)len);
 }
 
 bstring fossil_bstr_from_ullong(unsigned long long num) {
-    int digits = _bstr_num_digits(num);
-    bstring str = malloc(digits + 1); // Allocate memory dynamically
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
-    snprintf((char *)str, digits + 1, "%lu", (long unsigned int)num); // Use snprintf with dynamically calculated buffer size
-    return str;
+    char digits[24]; // Enough for any 64-bit value and its sign
+    int len = snprintf(digits, sizeof(digits), "%llu", num);
+    return len < 0 ? NULL : _bstr_widen(NULL, digits, (size_t)len);
 }
 
 bstring fossil_bstr_from_double(double num) {
     // Decide the maximum possible length of the string
-    int max_length = 50; // Arbitrarily chosen
-
-    // Allocate memory for the string
-    bstring str = malloc(max_length);
-    if (!str) {
-        return NULL; // Return NULL if memory allocation fails
-    }
+    char buffer[50]; // Arbitrarily chosen
 
     // Convert the double to string
-    int written = snprintf((char *)str, max_length, "%lf", num);
-    if (written < 0 || written >= max_length) {
-        free(str); // Free the allocated memory
+    int written = snprintf(buffer, sizeof(buffer), "%lf", num);
+    if (written < 0 || (size_t)written >= sizeof(buffer)) {
         return NULL; // Return NULL if snprintf failed or buffer overflow
     }
 
-    return str;
+    return _bstr_widen(NULL, buffer, (size_t)written);
 }
 
 int fossil_bstr_to_int(const_bstring str) {
@@ -443,10 +625,18 @@ int fossil_bstr_to_int(const_bstring str) {
         return 0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    long result = strtol((const char *)str, &endptr, 10);
-    if (errno == ERANGE || *endptr != '\0' || result > INT_MAX || result < INT_MIN) {
+    long result = strtol(bytes, &endptr, 10);
+    int failed = errno == ERANGE || *endptr != '\0' || result > INT_MAX || result < INT_MIN;
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error or overflow/underflow
         return 0; // Return a default value or indicate error
     }
@@ -459,10 +649,18 @@ double fossil_bstr_to_double(const_bstring str) {
         return 0.0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0.0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    double result = strtod((const char *)str, &endptr);
-    if (errno == ERANGE || *endptr != '\0') {
+    double result = strtod(bytes, &endptr);
+    int failed = errno == ERANGE || *endptr != '\0';
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error
         return 0.0; // Return a default value or indicate error
     }
@@ -475,10 +673,18 @@ long fossil_bstr_to_long(const_bstring str) {
         return 0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    long result = strtol((const char *)str, &endptr, 10);
-    if (errno == ERANGE || *endptr != '\0') {
+    long result = strtol(bytes, &endptr, 10);
+    int failed = errno == ERANGE || *endptr != '\0';
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error
         return 0; // Return a default value or indicate error
     }
@@ -491,10 +697,18 @@ unsigned long fossil_bstr_to_ulong(const_bstring str) {
         return 0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    unsigned long result = strtoul((const char *)str, &endptr, 10);
-    if (errno == ERANGE || *endptr != '\0') {
+    unsigned long result = strtoul(bytes, &endptr, 10);
+    int failed = errno == ERANGE || *endptr != '\0';
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error
         return 0; // Return a default value or indicate error
     }
@@ -507,10 +721,18 @@ long long fossil_bstr_to_llong(const_bstring str) {
         return 0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    long long result = strtoll((const char *)str, &endptr, 10);
-    if (errno == ERANGE || *endptr != '\0') {
+    long long result = strtoll(bytes, &endptr, 10);
+    int failed = errno == ERANGE || *endptr != '\0';
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error
         return 0; // Return a default value or indicate error
     }
@@ -523,10 +745,18 @@ unsigned long long fossil_bstr_to_ullong(const_bstring str) {
         return 0; // Handle invalid input (NULL pointer or empty string)
     }
 
+    char scratch[BSTR_SCRATCH];
+    char *bytes = _bstr_narrow(str, scratch);
+    if (!bytes) {
+        return 0; // Units beyond a byte are never digits
+    }
+
     char *endptr;
     errno = 0;
-    unsigned long long result = strtoull((const char *)str, &endptr, 10);
-    if (errno == ERANGE || *endptr != '\0') {
+    unsigned long long result = strtoull(bytes, &endptr, 10);
+    int failed = errno == ERANGE || *endptr != '\0';
+    _bstr_release_bytes(bytes, scratch);
+    if (failed) {
         // Handle conversion error
         return 0; // Return a default value or indicate error
     }
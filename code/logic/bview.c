@@ -0,0 +1,107 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/bview.h"
+#include "simd.h"
+
+// Count bletter units up to the zero terminator
+static size_t _bview_units(const_bstring str) {
+    return _fossil_simd_length(str, sizeof(bletter));
+}
+
+bview fossil_bview_make(const_bstring data, size_t length) {
+    bview view = { data, data ? length : 0 };
+    return view;
+}
+
+bview fossil_bview_from(const_bstring str) {
+    return fossil_bview_make(str, str ? _bview_units(str) : 0);
+}
+
+bview fossil_bview_substr(bview view, size_t start, size_t len) {
+    if (start > view.length) {
+        start = view.length;
+    }
+    if (len > view.length - start) {
+        len = view.length - start;
+    }
+    return fossil_bview_make(view.data ? view.data + start : NULL, len);
+}
+
+size_t fossil_bview_find(bview view, bletter ch) {
+    if (!view.data) {
+        return FOSSIL_VIEW_NPOS;
+    }
+    return _fossil_simd_find(view.data, view.length, ch, sizeof(bletter)); // NONE equals NPOS
+}
+
+int fossil_bview_compare(bview view1, bview view2) {
+    size_t len = view1.length < view2.length ? view1.length : view2.length;
+    for (size_t i = 0; i < len; i++) {
+        if (view1.data[i] != view2.data[i]) {
+            return view1.data[i] < view2.data[i] ? -1 : 1;
+        }
+    }
+    return (view1.length > view2.length) - (view1.length < view2.length);
+}
+
+int fossil_bview_equals(bview view1, bview view2) {
+    return view1.length == view2.length &&
+           (view1.length == 0 || memcmp(view1.data, view2.data, view1.length * sizeof(bletter)) == 0);
+}
+
+int fossil_bview_starts_with(bview view, bview prefix) {
+    return prefix.length <= view.length &&
+           (prefix.length == 0 || memcmp(view.data, prefix.data, prefix.length * sizeof(bletter)) == 0);
+}
+
+int fossil_bview_ends_with(bview view, bview suffix) {
+    return suffix.length <= view.length &&
+           (suffix.length == 0 ||
+            memcmp(view.data + view.length - suffix.length, suffix.data, suffix.length * sizeof(bletter)) == 0);
+}
+
+size_t fossil_bview_split(bview view, bletter delimiter, bview *out, size_t max) {
+    size_t count = 0;
+    size_t start = 0;
+    if (!out) {
+        max = 0;
+    }
+    if (!view.data) {
+        return 0;
+    }
+
+    // Single pass: each delimiter closes the current token
+    for (size_t i = 0; i <= view.length; i++) {
+        if (i == view.length || view.data[i] == delimiter) {
+            if (count < max) {
+                out[count] = fossil_bview_make(view.data + start, i - start);
+            }
+            count++;
+            start = i + 1;
+        }
+    }
+    return count;
+}
+
+bstring fossil_bview_to_bstr(bview view) {
+    bstring str = fossil_allocator_alloc(NULL, (view.length + 1) * sizeof(bletter));
+    if (!str) {
+        return NULL;
+    }
+    if (view.length) {
+        memcpy(str, view.data, view.length * sizeof(bletter));
+    }
+    str[view.length] = 0;
+    return str;
+}
@@ -0,0 +1,334 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/charset.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A classic C set keeps two more classes beside its members, both holding
+ * the terminator so the zero-terminated class kernel stops at the end of
+ * the string: the members (where cspan and find stop) and the non-members
+ * (where span stops).
+ */
+struct fossil_cstr_charset {
+    _fossil_simd_class members;
+    _fossil_simd_class stops;
+    _fossil_simd_class others;
+};
+
+typedef struct {
+    uint32_t first;
+    uint32_t last;
+} _charset_range;
+
+struct fossil_wstr_charset {
+    uint64_t ascii[2];
+    _charset_range *ranges; // members from 128 up, sorted, disjoint and not touching
+    size_t range_count;
+    size_t range_room;
+};
+
+// ---- classic C sets ----
+
+static void _cstr_charset_refresh(fossil_cstr_charset_t *set) {
+    set->stops = set->members;
+    _fossil_simd_class_add(&set->stops, 0);
+    for (size_t l = 0; l < 16; l++) {
+        set->others.low[l] = (uint8_t)~set->members.low[l]; // 0 is never a member, so it lands here
+        set->others.high[l] = (uint8_t)~set->members.high[l];
+    }
+}
+
+fossil_cstr_charset_t *fossil_cstr_charset_create(const_cstring members) {
+    fossil_cstr_charset_t *set = calloc(1, sizeof(fossil_cstr_charset_t));
+    if (!set) {
+        return NULL;
+    }
+    for (size_t i = 0; members && members[i]; i++) {
+        _fossil_simd_class_add(&set->members, (uint8_t)members[i]);
+    }
+    _cstr_charset_refresh(set);
+    return set;
+}
+
+void fossil_cstr_charset_erase(fossil_cstr_charset_t *set) {
+    free(set);
+}
+
+int fossil_cstr_charset_add_range(fossil_cstr_charset_t *set, cletter first, cletter last) {
+    if (!set || (uint8_t)first > (uint8_t)last) {
+        return -1;
+    }
+    for (unsigned c = (uint8_t)first ? (uint8_t)first : 1; c <= (uint8_t)last; c++) {
+        _fossil_simd_class_add(&set->members, (uint8_t)c);
+    }
+    _cstr_charset_refresh(set);
+    return 0;
+}
+
+int fossil_cstr_charset_contains(const fossil_cstr_charset_t *set, cletter ch) {
+    return set && _fossil_simd_class_has(&set->members, (uint8_t)ch);
+}
+
+size_t fossil_cstr_charset_span(const fossil_cstr_charset_t *set, const_cstring str) {
+    return set && str ? _fossil_simd_class_chr(str, &set->others) : 0;
+}
+
+size_t fossil_cstr_charset_cspan(const fossil_cstr_charset_t *set, const_cstring str) {
+    if (!str) {
+        return 0;
+    }
+    return set ? _fossil_simd_class_chr(str, &set->stops) : _fossil_simd_length(str, 1);
+}
+
+const_cstring fossil_cstr_charset_find(const fossil_cstr_charset_t *set, const_cstring str) {
+    if (!set || !str) {
+        return NULL;
+    }
+    str += _fossil_simd_class_chr(str, &set->stops);
+    return *str ? str : NULL;
+}
+
+// The next token from 'at', as in the split iterators; returns 0 when there are no more
+static int _cstr_charset_token(const fossil_cstr_charset_t *set, const char *str, size_t *at, int *done,
+                               unsigned flags, size_t *start, size_t *end) {
+    if (*done) {
+        return 0;
+    }
+    size_t i = *at;
+    if (flags & FOSSIL_SPLIT_SKIP_EMPTY) {
+        i += _fossil_simd_class_chr(str + i, &set->others);
+        if (!str[i]) {
+            *done = 1;
+            return 0;
+        }
+    }
+    *start = i;
+    *end = i + _fossil_simd_class_chr(str + i, &set->stops);
+    if (str[*end]) {
+        *at = *end + 1;
+    } else {
+        *done = 1;
+    }
+    return 1;
+}
+
+cstrings fossil_cstr_charset_split(const fossil_cstr_charset_t *set, const_cstring str, unsigned flags) {
+    if (!set || !str) {
+        return NULL;
+    }
+    size_t tokens = 0, at = 0, start, end, length = 0;
+    int done = 0;
+    while (_cstr_charset_token(set, str, &at, &done, flags, &start, &end)) {
+        tokens++;
+        length = end;
+    }
+    length += _fossil_simd_length(str + length, 1); // skipped delimiters may trail the last token
+
+    size_t head = (tokens + 1) * sizeof(cstring);
+    cstrings splits = fossil_allocator_alloc(NULL, head + length + 1);
+    if (!splits) {
+        return NULL;
+    }
+    char *data = (char *)splits + head;
+    memcpy(data, str, length + 1);
+    at = 0;
+    done = 0;
+    for (size_t t = 0; _cstr_charset_token(set, data, &at, &done, flags, &start, &end); t++) {
+        splits[t] = data + start;
+        data[end] = '\0'; // after reading it: the next token starts past it
+    }
+    splits[tokens] = NULL;
+    return splits;
+}
+
+// ---- wide sets ----
+
+static void _wstr_charset_ascii(fossil_wstr_charset_t *set, uint32_t first, uint32_t last) {
+    for (uint32_t c = first; c <= last && c < 128; c++) {
+        set->ascii[c >> 6] |= (uint64_t)1 << (c & 63);
+    }
+}
+
+// Merge [first, last], all from 128 up, into the range table; returns 0 if memory runs out
+static int _wstr_charset_insert(fossil_wstr_charset_t *set, uint32_t first, uint32_t last) {
+    _charset_range *ranges = set->ranges;
+    size_t lo = 0, hi = set->range_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uint64_t)ranges[mid].last + 1 < first) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    size_t end = lo;
+    while (end < set->range_count && ranges[end].first <= (uint64_t)last + 1) {
+        first = ranges[end].first < first ? ranges[end].first : first;
+        last = ranges[end].last > last ? ranges[end].last : last;
+        end++;
+    }
+    if (end == lo) {
+        if (set->range_count == set->range_room) {
+            size_t room = set->range_room ? set->range_room * 2 : 4;
+            ranges = realloc(set->ranges, room * sizeof(_charset_range));
+            if (!ranges) {
+                return 0;
+            }
+            set->ranges = ranges;
+            set->range_room = room;
+        }
+        memmove(ranges + lo + 1, ranges + lo, (set->range_count - lo) * sizeof(_charset_range));
+        set->range_count++;
+    } else {
+        memmove(ranges + lo + 1, ranges + end, (set->range_count - end) * sizeof(_charset_range));
+        set->range_count -= end - lo - 1;
+    }
+    ranges[lo].first = first;
+    ranges[lo].last = last;
+    return 1;
+}
+
+static int _wstr_charset_has(const fossil_wstr_charset_t *set, uint32_t c) {
+    if (c < 128) {
+        return (set->ascii[c >> 6] >> (c & 63)) & 1;
+    }
+    size_t lo = 0, hi = set->range_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (set->ranges[mid].last < c) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < set->range_count && set->ranges[lo].first <= c;
+}
+
+fossil_wstr_charset_t *fossil_wstr_charset_create(const_wstring members) {
+    fossil_wstr_charset_t *set = calloc(1, sizeof(fossil_wstr_charset_t));
+    if (!set) {
+        return NULL;
+    }
+    for (size_t i = 0; members && members[i]; i++) {
+        if (fossil_wstr_charset_add_range(set, members[i], members[i]) != 0) {
+            fossil_wstr_charset_erase(set);
+            return NULL;
+        }
+    }
+    return set;
+}
+
+void fossil_wstr_charset_erase(fossil_wstr_charset_t *set) {
+    if (!set) {
+        return;
+    }
+    free(set->ranges);
+    free(set);
+}
+
+int fossil_wstr_charset_add_range(fossil_wstr_charset_t *set, wletter first, wletter last) {
+    uint32_t lo = (uint32_t)first, hi = (uint32_t)last;
+    if (!set || lo > hi) {
+        return -1;
+    }
+    _wstr_charset_ascii(set, lo ? lo : 1, hi);
+    if (hi >= 128 && !_wstr_charset_insert(set, lo > 128 ? lo : 128, hi)) {
+        return -1;
+    }
+    return 0;
+}
+
+int fossil_wstr_charset_contains(const fossil_wstr_charset_t *set, wletter ch) {
+    return set && _wstr_charset_has(set, (uint32_t)ch);
+}
+
+size_t fossil_wstr_charset_span(const fossil_wstr_charset_t *set, const_wstring str) {
+    size_t i = 0;
+    while (set && str && str[i] && _wstr_charset_has(set, (uint32_t)str[i])) {
+        i++;
+    }
+    return i;
+}
+
+size_t fossil_wstr_charset_cspan(const fossil_wstr_charset_t *set, const_wstring str) {
+    size_t i = 0;
+    while (str && str[i] && !(set && _wstr_charset_has(set, (uint32_t)str[i]))) {
+        i++;
+    }
+    return i;
+}
+
+const_wstring fossil_wstr_charset_find(const fossil_wstr_charset_t *set, const_wstring str) {
+    if (!set || !str) {
+        return NULL;
+    }
+    str += fossil_wstr_charset_cspan(set, str);
+    return *str ? str : NULL;
+}
+
+static int _wstr_charset_token(const fossil_wstr_charset_t *set, const wletter *str, size_t *at, int *done,
+                               unsigned flags, size_t *start, size_t *end) {
+    if (*done) {
+        return 0;
+    }
+    size_t i = *at;
+    if (flags & FOSSIL_SPLIT_SKIP_EMPTY) {
+        i += fossil_wstr_charset_span(set, str + i);
+        if (!str[i]) {
+            *done = 1;
+            return 0;
+        }
+    }
+    *start = i;
+    *end = i + fossil_wstr_charset_cspan(set, str + i);
+    if (str[*end]) {
+        *at = *end + 1;
+    } else {
+        *done = 1;
+    }
+    return 1;
+}
+
+wstrings fossil_wstr_charset_split(const fossil_wstr_charset_t *set, const_wstring str, unsigned flags) {
+    if (!set || !str) {
+        return NULL;
+    }
+    size_t tokens = 0, at = 0, start, end, length = 0;
+    int done = 0;
+    while (_wstr_charset_token(set, str, &at, &done, flags, &start, &end)) {
+        tokens++;
+        length = end;
+    }
+    length += _fossil_simd_length(str + length, sizeof(wletter));
+
+    size_t head = (tokens + 1) * sizeof(wstring);
+    wstrings splits = fossil_allocator_alloc(NULL, head + (length + 1) * sizeof(wletter));
+    if (!splits) {
+        return NULL;
+    }
+    wstring data = (wstring)(void *)((char *)splits + head);
+    memcpy(data, str, (length + 1) * sizeof(wletter));
+    at = 0;
+    done = 0;
+    for (size_t t = 0; _wstr_charset_token(set, data, &at, &done, flags, &start, &end); t++) {
+        splits[t] = data + start;
+        data[end] = L'\0';
+    }
+    splits[tokens] = NULL;
+    return splits;
+}
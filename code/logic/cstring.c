@@ -12,6 +12,9 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/string/cstring.h"
+#include "simd.h"
+#include "search.h"
+#include "fold.h"
 
 // Helper function to calculate the number of digits in an integer
 int _cstr_num_digits(long long num) {
@@ -35,10 +38,25 @@ cstring fossil_cstr_create(const_cstring str) {
     return fossil_cstr_strdup(str); // Allocate memory and copy string using strdup
 }
 
+cstring fossil_cstr_create_with(const fossil_allocator_t *allocator, const_cstring str) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = fossil_cstr_length(str);
+    cstring dup = fossil_allocator_alloc(allocator, len + 1);
+    if (!dup) {
+        return NULL;
+    }
+    return memcpy(dup, str, len + 1);
+}
+
 void fossil_cstr_erase(cstring str) {
+    fossil_cstr_erase_with(NULL, str);
+}
+
+void fossil_cstr_erase_with(const fossil_allocator_t *allocator, cstring str) {
     if (str) {
-        free(str); // Free memory allocated by strdup
-        str = NULL; // Reset the pointer to NULL
+        fossil_allocator_release(allocator, str); // Free memory allocated by strdup
     }
 }
 
@@ -49,25 +67,24 @@ size_t fossil_cstr_length(const_cstring str) {
     return strlen(str); // Calculate string length using strlen
 }
 
-cstring fossil_cstr_format(const_cstring format, ...) {
+static cstring _cstr_vformat(const fossil_allocator_t *allocator, const_cstring format, va_list args) {
     if (!format) {
         return NULL; // Input validation
     }
 
-    va_list args, args_copy;
-    va_start(args, format);
+    va_list args_copy;
     va_copy(args_copy, args);
 
     // Calculate required size
     int size = vsnprintf(NULL, 0, format, args);
-    va_end(args);
-
     if (size < 0) {
+        va_end(args_copy);
         return NULL; // Error handling
     }
 
-    cstring buffer = malloc((size_t)size + 1);
+    cstring buffer = fossil_allocator_alloc(allocator, (size_t)size + 1);
     if (!buffer) {
+        va_end(args_copy);
         return NULL; // Memory management
     }
 
@@ -77,6 +94,22 @@ cstring fossil_cstr_format(const_cstring format, ...) {
     return buffer;
 }
 
+cstring fossil_cstr_format(const_cstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    cstring buffer = _cstr_vformat(NULL, format, args);
+    va_end(args);
+    return buffer;
+}
+
+cstring fossil_cstr_format_with(const fossil_allocator_t *allocator, const_cstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    cstring buffer = _cstr_vformat(allocator, format, args);
+    va_end(args);
+    return buffer;
+}
+
 cstring fossil_cstr_format_phone(const_cstring phone) {
     if (!phone || strlen(phone) != 10) {
         return NULL;
@@ -155,6 +188,35 @@ int fossil_cstr_compare(const_cstring str1, const_cstring str2) {
     return strcmp(str1, str2);
 }
 
+int fossil_cstr_icompare(const_cstring str1, const_cstring str2) {
+    if (!str1 || !str2) {
+        return -1;
+    }
+    return _fossil_fold_compare(str1, str2, sizeof(cletter), 0);
+}
+
+int fossil_cstr_iequals(const_cstring str1, const_cstring str2) {
+    return str1 && str2 && _fossil_fold_equals(str1, str2, sizeof(cletter), 0);
+}
+
+int fossil_cstr_istarts_with(const_cstring str, const_cstring prefix) {
+    return str && prefix && _fossil_fold_starts_with(str, prefix, sizeof(cletter), 0);
+}
+
+const_cstring fossil_cstr_ifind_str(const_cstring str, const_cstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(cletter)), sizeof(cletter), _FOSSIL_FOLD_ASCII);
+    size_t i = _fossil_search_plan_find(&plan, str, _fossil_simd_length(str, sizeof(cletter)), 0);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+uint64_t fossil_cstr_ihash(const_cstring str) {
+    return str ? _fossil_fold_hash(str, sizeof(cletter), 0) : 0;
+}
+
 cstring fossil_cstr_copy(cstring dest, const_cstring src) {
     if (!dest || !src) {
         return NULL;
@@ -182,7 +244,75 @@ const_cstring fossil_cstr_find(const_cstring str, cletter ch) {
     if (!str) {
         return NULL;
     }
-    return strchr(str, ch);
+    size_t i = _fossil_simd_chr(str, (unsigned char)ch, sizeof(cletter));
+    return str[i] == ch ? str + i : NULL;
+}
+
+const_cstring fossil_cstr_rfind(const_cstring str, cletter ch) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _fossil_simd_length(str, sizeof(cletter));
+    if (ch == 0) {
+        return str + len; // The terminator, as with strrchr
+    }
+    size_t i = _fossil_simd_rfind(str, len, (unsigned char)ch, sizeof(cletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_cstring fossil_cstr_find_any(const_cstring str, const_cstring set) {
+    if (!str || !set) {
+        return NULL;
+    }
+    size_t i = _fossil_simd_find_any(str, _fossil_simd_length(str, sizeof(cletter)), set, _fossil_simd_length(set, sizeof(cletter)), sizeof(cletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_cstr_count(const_cstring str, cletter ch) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_count(str, _fossil_simd_length(str, sizeof(cletter)), (unsigned char)ch, sizeof(cletter));
+}
+
+const_cstring fossil_cstr_find_str(const_cstring str, const_cstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_find(str, _fossil_simd_length(str, sizeof(cletter)), needle, _fossil_simd_length(needle, sizeof(cletter)), sizeof(cletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_cstring fossil_cstr_rfind_str(const_cstring str, const_cstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_rfind(str, _fossil_simd_length(str, sizeof(cletter)), needle, _fossil_simd_length(needle, sizeof(cletter)), sizeof(cletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+int fossil_cstr_contains(const_cstring str, const_cstring needle) {
+    return fossil_cstr_find_str(str, needle) != NULL;
+}
+
+size_t fossil_cstr_find_all(const_cstring str, cletter ch, size_t *offsets, size_t capacity) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_find_all(str, _fossil_simd_length(str, sizeof(cletter)), (unsigned char)ch, sizeof(cletter), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_cstr_find_all_str(const_cstring str, const_cstring needle, size_t *offsets, size_t capacity) {
+    if (!str || !needle) {
+        return 0;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(cletter)), sizeof(cletter), _FOSSIL_FOLD_NONE);
+    return _fossil_search_plan_find_all(&plan, str, _fossil_simd_length(str, sizeof(cletter)), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_cstr_count_str(const_cstring str, const_cstring needle) {
+    return fossil_cstr_find_all_str(str, needle, NULL, 0);
 }
 
 const_cstring fossil_cstr_reverse(const_cstring str) {
@@ -190,7 +320,7 @@ const_cstring fossil_cstr_reverse(const_cstring str) {
         return NULL;
     }
     size_t len = fossil_cstr_length(str);
-    cstring rev = malloc(len + 1);
+    cstring rev = fossil_allocator_alloc(NULL, len + 1);
     if (!rev) {
         return NULL;
     }
@@ -202,16 +332,24 @@ const_cstring fossil_cstr_reverse(const_cstring str) {
 }
 
 void fossil_cstr_erase_splits(cstrings splits) {
+    fossil_cstr_erase_splits_with(NULL, splits);
+}
+
+void fossil_cstr_erase_splits_with(const fossil_allocator_t *allocator, cstrings splits) {
     if (!splits) {
         return;
     }
     for (size_t i = 0; splits[i] != NULL; i++) {
-        free(splits[i]);
+        fossil_allocator_release(allocator, splits[i]);
     }
-    free(splits);
+    fossil_allocator_release(allocator, splits);
 }
 
 cstrings fossil_cstr_split(const_cstring str, cletter delimiter) {
+    return fossil_cstr_split_with(NULL, str, delimiter);
+}
+
+cstrings fossil_cstr_split_with(const fossil_allocator_t *allocator, const_cstring str, cletter delimiter) {
     if (!str) {
         return NULL;
     }
@@ -226,7 +364,7 @@ cstrings fossil_cstr_split(const_cstring str, cletter delimiter) {
     }
     
     // Allocate memory for the array of strings
-    cstrings splits = malloc((count + 1) * sizeof(cstring));
+    cstrings splits = fossil_allocator_alloc(allocator, (count + 1) * sizeof(cstring));
     if (!splits) {
         return NULL;
     }
@@ -238,9 +376,9 @@ cstrings fossil_cstr_split(const_cstring str, cletter delimiter) {
     for (size_t i = 0; i <= len; i++) {
         if (str[i] == delimiter || str[i] == '\0') {
             size_t sublen = i - start;
-            splits[index] = malloc(sublen + 1);
+            splits[index] = fossil_allocator_alloc(allocator, sublen + 1);
             if (!splits[index]) {
-                fossil_cstr_erase_splits(splits);
+                fossil_cstr_erase_splits_with(allocator, splits);
                 return NULL;
             }
             memcpy(splits[index], str + start, sublen);
@@ -255,18 +393,14 @@ cstrings fossil_cstr_split(const_cstring str, cletter delimiter) {
 }
 
 cstring fossil_cstr_strdup(const_cstring str) {
-    if (!str) {
-        return NULL;
-    }
-    size_t len = fossil_cstr_length(str);
-    cstring dup = malloc(len + 1);
-    if (!dup) {
-        return NULL;
-    }
-    return strcpy(dup, str);
+    return fossil_cstr_create_with(NULL, str);
 }
 
 cstring fossil_cstr_substr(const_cstring str, size_t start, size_t len) {
+    return fossil_cstr_substr_with(NULL, str, start, len);
+}
+
+cstring fossil_cstr_substr_with(const fossil_allocator_t *allocator, const_cstring str, size_t start, size_t len) {
     if (str == NULL) return NULL;
 
     size_t str_len = strlen(str);
@@ -277,7 +411,7 @@ cstring fossil_cstr_substr(const_cstring str, size_t start, size_t len) {
         len = str_len - start;
     }
 
-    cstring substr = (cstring)malloc(len + 1);
+    cstring substr = (cstring)fossil_allocator_alloc(allocator, len + 1);
     if (substr == NULL) {
         // Handle memory allocation failure
         return NULL;
@@ -342,7 +476,7 @@ void fossil_cstrstream_append(cstring dest, size_t *pos, const_cstring src) {
         return; // Invalid input
     }
     size_t srcLen = strlen(src);
-    dest = realloc(dest, *pos + srcLen + 1);
+    dest = fossil_allocator_resize(NULL, dest, *pos + srcLen + 1);
     if (!dest) {
         return; // Memory allocation failure
     }
@@ -381,7 +515,7 @@ size_t fossil_cstrstream_tell(const_cstring str, size_t pos) {
 // Convert integer to string
 cstring fossil_cstr_from_int(int num) {
     int digits = _cstr_num_digits(num);
-    cstring str = malloc(digits + 1); // Allocate memory dynamically
+    cstring str = fossil_allocator_alloc(NULL, digits + 1); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -392,7 +526,7 @@ cstring fossil_cstr_from_int(int num) {
 // Convert long to string
 cstring fossil_cstr_from_long(long num) {
     int digits = _cstr_num_digits(num);
-    cstring str = malloc(digits + 1); // Allocate memory dynamically
+    cstring str = fossil_allocator_alloc(NULL, digits + 1); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -403,7 +537,7 @@ cstring fossil_cstr_from_long(long num) {
 // Convert long long to string
 cstring fossil_cstr_from_llong(long long num) {
     int digits = _cstr_num_digits(num);
-    cstring str = malloc(digits + 1); // Allocate memory dynamically
+    cstring str = fossil_allocator_alloc(NULL, digits + 1); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -414,7 +548,7 @@ cstring fossil_cstr_from_llong(long long num) {
 // Convert unsigned long to string
 cstring fossil_cstr_from_ulong(unsigned long num) {
     int digits = _cstr_num_digits(num);
-    cstring str = malloc(digits + 1); // Allocate memory dynamically
+    cstring str = fossil_allocator_alloc(NULL, digits + 1); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -425,7 +559,7 @@ cstring fossil_cstr_from_ulong(unsigned long num) {
 // Convert unsigned long long to string
 cstring fossil_cstr_from_ullong(unsigned long long num) {
     int digits = _cstr_num_digits(num);
-    cstring str = malloc(digits + 1); // Allocate memory dynamically
+    cstring str = fossil_allocator_alloc(NULL, digits + 1); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -438,7 +572,7 @@ cstring fossil_cstr_from_double(double num) {
     int max_length = 50; // Arbitrarily chosen
 
     // Allocate memory for the string
-    cstring str = malloc(max_length);
+    cstring str = fossil_allocator_alloc(NULL, max_length);
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -446,7 +580,7 @@ cstring fossil_cstr_from_double(double num) {
     // Convert the double to string
     int written = snprintf(str, max_length, "%lf", num);
     if (written < 0 || written >= max_length) {
-        free(str); // Free the allocated memory
+        fossil_allocator_release(NULL, str); // Free the allocated memory
         return NULL; // Return NULL if snprintf failed or buffer overflow
     }
 
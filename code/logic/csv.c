@@ -0,0 +1,310 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/csv.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_WINDOW 16384        // bytes handed to the scan kernel at a time
+#define CSV_INLINE ((size_t)-1) // a field that views the row's own bytes
+
+/*
+ * Rows are tokenized straight out of the fed chunk. Only the unfinished row
+ * at the end of a chunk is copied, into 'pending', and it is tokenized from
+ * there once a later chunk supplies its line end. Fields whose quotes need
+ * decoding are written to 'decoded'; since that buffer may move as it grows,
+ * such fields keep an offset in 'spills' until the row is reported.
+ */
+struct fossil_csv {
+    uint8_t separator;
+    uint8_t quote;
+    int quoted;  // whether the pending bytes end inside quotes
+    int stopped; // 1 once a callback stops the stream, -1 once memory runs out
+    size_t rows;
+
+    char *pending;
+    size_t pending_length;
+    size_t pending_room;
+
+    cview *fields;
+    size_t *spills;
+    size_t field_count;
+    size_t field_room;
+
+    char *decoded;
+    size_t decoded_length;
+    size_t decoded_room;
+
+    size_t offsets[CSV_WINDOW];
+};
+
+// The room to grow a buffer to so it holds 'need' entries, or 0 if it already does
+static size_t _csv_grown(size_t room, size_t need) {
+    if (need <= room) {
+        return 0;
+    }
+    size_t grown = room ? room : 64;
+    while (grown < need) {
+        grown *= 2;
+    }
+    return grown;
+}
+
+static int _csv_append(fossil_csv_t *csv, const char *data, size_t length) {
+    if (length == 0) {
+        return 1;
+    }
+    size_t room = _csv_grown(csv->pending_room, csv->pending_length + length);
+    if (room) {
+        char *pending = realloc(csv->pending, room);
+        if (!pending) {
+            return 0;
+        }
+        csv->pending = pending;
+        csv->pending_room = room;
+    }
+    memcpy(csv->pending + csv->pending_length, data, length);
+    csv->pending_length += length;
+    return 1;
+}
+
+// Decode the quotes of a field into 'decoded' and return where it starts there, or CSV_INLINE on failure
+static size_t _csv_decode(fossil_csv_t *csv, const char *text, size_t length) {
+    size_t room = _csv_grown(csv->decoded_room, csv->decoded_length + length);
+    if (room) {
+        char *decoded = realloc(csv->decoded, room);
+        if (!decoded) {
+            return CSV_INLINE;
+        }
+        csv->decoded = decoded;
+        csv->decoded_room = room;
+    }
+    char quote = (char)csv->quote;
+    char *out = csv->decoded + csv->decoded_length;
+    size_t start = csv->decoded_length, n = 0;
+    int inside = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] != quote) {
+            out[n++] = text[i];
+        } else if (inside && i + 1 < length && text[i + 1] == quote) {
+            out[n++] = quote;
+            i++;
+        } else {
+            inside = !inside;
+        }
+    }
+    csv->decoded_length += n;
+    csv->fields[csv->field_count].length = n;
+    return start;
+}
+
+// Add the field 'text' to the current row; 'last' drops the "\r" of a "\r\n" line end
+static int _csv_field(fossil_csv_t *csv, const char *text, size_t length, int last) {
+    if (last && length > 0 && text[length - 1] == '\r') {
+        length--;
+    }
+    size_t room = _csv_grown(csv->field_room, csv->field_count + 1);
+    if (room) {
+        cview *fields = realloc(csv->fields, room * sizeof(cview));
+        if (!fields) {
+            return 0;
+        }
+        csv->fields = fields;
+        size_t *spills = realloc(csv->spills, room * sizeof(size_t));
+        if (!spills) {
+            return 0;
+        }
+        csv->spills = spills;
+        csv->field_room = room;
+    }
+    cview *field = &csv->fields[csv->field_count];
+    size_t *spill = &csv->spills[csv->field_count];
+    *spill = CSV_INLINE;
+    field->data = text;
+    field->length = length;
+
+    char quote = (char)csv->quote;
+    if (quote && length > 0 && memchr(text, quote, length)) {
+        if (length >= 2 && text[0] == quote && text[length - 1] == quote && !memchr(text + 1, quote, length - 2)) {
+            field->data = text + 1; // a plainly quoted field still views the row
+            field->length = length - 2;
+        } else if ((*spill = _csv_decode(csv, text, length)) == CSV_INLINE) {
+            return 0;
+        }
+    }
+    csv->field_count++;
+    return 1;
+}
+
+// Report the current row; returns 0 once the stream has stopped
+static int _csv_emit(fossil_csv_t *csv, fossil_csv_callback_t callback, void *user, size_t *reported) {
+    for (size_t f = 0; f < csv->field_count; f++) {
+        if (csv->spills[f] != CSV_INLINE) {
+            csv->fields[f].data = csv->decoded + csv->spills[f];
+        }
+    }
+    fossil_csv_row_t row = {csv->fields, csv->field_count, csv->rows};
+    csv->rows++;
+    (*reported)++;
+    csv->field_count = 0;
+    csv->decoded_length = 0;
+    if (callback && callback(&row, user)) {
+        csv->stopped = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Tokenize the rows of 'data', which starts at the start of a row, and
+ * return where the unfinished row at its end starts. With 'final' the end
+ * of 'data' ends the last row instead.
+ */
+static size_t _csv_rows(fossil_csv_t *csv, const char *data, size_t length, int final,
+                        fossil_csv_callback_t callback, void *user, size_t *reported) {
+    size_t field = 0, row = 0;
+    int quoted = 0;
+    for (size_t base = 0; base < length; base += CSV_WINDOW) {
+        size_t window = length - base < CSV_WINDOW ? length - base : CSV_WINDOW;
+        size_t found = _fossil_simd_quoted_scan(data + base, window, csv->separator, '\n', csv->quote, &quoted,
+                                                csv->offsets);
+        for (size_t k = 0; k < found; k++) {
+            size_t at = base + csv->offsets[k];
+            int last = data[at] == '\n';
+            if (!_csv_field(csv, data + field, at - field, last)) {
+                csv->stopped = -1;
+                return length;
+            }
+            field = at + 1;
+            if (last) {
+                row = field;
+                if (!_csv_emit(csv, callback, user, reported)) {
+                    return length;
+                }
+            }
+        }
+    }
+    if (final) {
+        if (!_csv_field(csv, data + field, length - field, 1)) {
+            csv->stopped = -1;
+        } else {
+            _csv_emit(csv, callback, user, reported);
+        }
+        return length;
+    }
+    csv->field_count = 0; // the unfinished row is tokenized again once it is complete
+    csv->decoded_length = 0;
+    csv->quoted = quoted;
+    return row;
+}
+
+// Offset of the first line end outside quotes, continuing the pending row, or CSV_INLINE
+static size_t _csv_row_end(fossil_csv_t *csv, const char *data, size_t length) {
+    int quoted = csv->quoted;
+    for (size_t base = 0; base < length; base += CSV_WINDOW) {
+        size_t window = length - base < CSV_WINDOW ? length - base : CSV_WINDOW;
+        size_t found = _fossil_simd_quoted_scan(data + base, window, csv->separator, '\n', csv->quote, &quoted,
+                                                csv->offsets);
+        for (size_t k = 0; k < found; k++) {
+            if (data[base + csv->offsets[k]] == '\n') {
+                return base + csv->offsets[k];
+            }
+        }
+    }
+    csv->quoted = quoted;
+    return CSV_INLINE;
+}
+
+fossil_csv_t *fossil_csv_create(cletter separator, cletter quote) {
+    if (separator == '\0' || separator == '\n' || separator == '\r' || separator == quote || quote == '\n' ||
+        quote == '\r') {
+        return NULL;
+    }
+    fossil_csv_t *csv = calloc(1, sizeof(fossil_csv_t));
+    if (!csv) {
+        return NULL;
+    }
+    csv->separator = (uint8_t)separator;
+    csv->quote = (uint8_t)quote;
+    return csv;
+}
+
+void fossil_csv_erase(fossil_csv_t *csv) {
+    if (!csv) {
+        return;
+    }
+    free(csv->pending);
+    free(csv->fields);
+    free(csv->spills);
+    free(csv->decoded);
+    free(csv);
+}
+
+void fossil_csv_reset(fossil_csv_t *csv) {
+    if (!csv) {
+        return;
+    }
+    csv->quoted = 0;
+    csv->stopped = 0;
+    csv->rows = 0;
+    csv->pending_length = 0;
+    csv->field_count = 0;
+    csv->decoded_length = 0;
+}
+
+size_t fossil_csv_feed(fossil_csv_t *csv, const char *chunk, size_t length, fossil_csv_callback_t callback, void *user) {
+    if (!csv || (!chunk && length > 0)) {
+        return FOSSIL_CSV_ERROR;
+    }
+    if (csv->stopped) {
+        return csv->stopped < 0 ? FOSSIL_CSV_ERROR : 0;
+    }
+    size_t reported = 0, start = 0;
+    if (csv->pending_length > 0) {
+        size_t end = _csv_row_end(csv, chunk, length);
+        if (!_csv_append(csv, chunk, end == CSV_INLINE ? length : end)) {
+            csv->stopped = -1;
+            return FOSSIL_CSV_ERROR;
+        }
+        if (end == CSV_INLINE) {
+            return 0;
+        }
+        _csv_rows(csv, csv->pending, csv->pending_length, 1, callback, user, &reported);
+        csv->pending_length = 0;
+        csv->quoted = 0;
+        start = end + 1;
+    }
+    if (!csv->stopped) {
+        size_t rest = start + _csv_rows(csv, chunk + start, length - start, 0, callback, user, &reported);
+        if (!csv->stopped && !_csv_append(csv, chunk + rest, length - rest)) {
+            csv->stopped = -1;
+        }
+    }
+    return csv->stopped < 0 ? FOSSIL_CSV_ERROR : reported;
+}
+
+size_t fossil_csv_finish(fossil_csv_t *csv, fossil_csv_callback_t callback, void *user) {
+    if (!csv) {
+        return FOSSIL_CSV_ERROR;
+    }
+    size_t reported = 0;
+    if (!csv->stopped && csv->pending_length > 0) {
+        _csv_rows(csv, csv->pending, csv->pending_length, 1, callback, user, &reported);
+    }
+    int failed = csv->stopped < 0;
+    fossil_csv_reset(csv);
+    return failed ? FOSSIL_CSV_ERROR : reported;
+}
@@ -0,0 +1,101 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/cview.h"
+
+cview fossil_cview_make(const_cstring data, size_t length) {
+    cview view = { data, data ? length : 0 };
+    return view;
+}
+
+cview fossil_cview_from(const_cstring str) {
+    return fossil_cview_make(str, str ? strlen(str) : 0);
+}
+
+cview fossil_cview_substr(cview view, size_t start, size_t len) {
+    if (start > view.length) {
+        start = view.length;
+    }
+    if (len > view.length - start) {
+        len = view.length - start;
+    }
+    return fossil_cview_make(view.data ? view.data + start : NULL, len);
+}
+
+size_t fossil_cview_find(cview view, cletter ch) {
+    if (!view.data) {
+        return FOSSIL_VIEW_NPOS;
+    }
+    const cletter *hit = memchr(view.data, ch, view.length);
+    return hit ? (size_t)(hit - view.data) : FOSSIL_VIEW_NPOS;
+}
+
+int fossil_cview_compare(cview view1, cview view2) {
+    size_t len = view1.length < view2.length ? view1.length : view2.length;
+    int cmp = len ? memcmp(view1.data, view2.data, len) : 0;
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (view1.length > view2.length) - (view1.length < view2.length);
+}
+
+int fossil_cview_equals(cview view1, cview view2) {
+    return view1.length == view2.length &&
+           (view1.length == 0 || memcmp(view1.data, view2.data, view1.length) == 0);
+}
+
+int fossil_cview_starts_with(cview view, cview prefix) {
+    return prefix.length <= view.length &&
+           (prefix.length == 0 || memcmp(view.data, prefix.data, prefix.length) == 0);
+}
+
+int fossil_cview_ends_with(cview view, cview suffix) {
+    return suffix.length <= view.length &&
+           (suffix.length == 0 ||
+            memcmp(view.data + view.length - suffix.length, suffix.data, suffix.length) == 0);
+}
+
+size_t fossil_cview_split(cview view, cletter delimiter, cview *out, size_t max) {
+    size_t count = 0;
+    size_t start = 0;
+    if (!out) {
+        max = 0;
+    }
+
+    // Single pass: each delimiter closes the current token
+    while (view.data) {
+        const cletter *hit = memchr(view.data + start, delimiter, view.length - start);
+        size_t stop = hit ? (size_t)(hit - view.data) : view.length;
+        if (count < max) {
+            out[count] = fossil_cview_make(view.data + start, stop - start);
+        }
+        count++;
+        if (!hit) {
+            break;
+        }
+        start = stop + 1;
+    }
+    return count;
+}
+
+cstring fossil_cview_to_cstr(cview view) {
+    cstring str = fossil_allocator_alloc(NULL, view.length + 1);
+    if (!str) {
+        return NULL;
+    }
+    if (view.length) {
+        memcpy(str, view.data, view.length);
+    }
+    str[view.length] = '\0';
+    return str;
+}
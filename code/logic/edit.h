@@ -0,0 +1,69 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_EDIT_H
+#define FOSSIL_STRINGS_EDIT_H
+
+/*
+ * Private edit distance shared by the fuzzy matching modules. Strings are
+ * runs of 'unit'-byte code units (1, 2 or 4) with explicit lengths, and
+ * distances count inserted, deleted and substituted units.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define _FOSSIL_EDIT_SMALL 64 // pattern length served without allocating
+
+/*
+ * A pattern prepared for Myers' bit-parallel algorithm: a match mask per
+ * text unit, 64 pattern positions to a word, plus the column state. It
+ * can be compared against many strings in turn but not by two threads at
+ * once.
+ */
+typedef struct {
+    size_t count;         // pattern units
+    size_t unit;
+    size_t blocks;
+    uint64_t last;        // bottom row bit in the last block
+    uint64_t *table;      // 'blocks' match masks for each unit below 256
+    uint32_t *wide;       // the distinct pattern units from 256 up, sorted
+    uint64_t *wide_masks; // 'blocks' match masks for each of them
+    size_t wide_count;
+    uint64_t *pv;         // +1 vertical differences
+    uint64_t *mv;         // -1 vertical differences
+    void *heap;
+    uint64_t small_table[256];
+    uint32_t small_wide[_FOSSIL_EDIT_SMALL];
+    uint64_t small_masks[_FOSSIL_EDIT_SMALL];
+    uint64_t small_pv;
+    uint64_t small_mv;
+} _fossil_edit_pattern;
+
+// Prepare 'count' units of 'pattern', backwards if 'reverse'; returns 0 if memory runs out
+int _fossil_edit_pattern_init(_fossil_edit_pattern *p, const void *pattern, size_t count, size_t unit, int reverse);
+
+// Release what _fossil_edit_pattern_init allocated
+void _fossil_edit_pattern_release(_fossil_edit_pattern *p);
+
+// Distance from the pattern to 'text' if it is at most 'max', otherwise 'max' + 1
+size_t _fossil_edit_pattern_distance(_fossil_edit_pattern *p, const void *text, size_t count, size_t max);
+
+/*
+ * Levenshtein distance between 'a' and 'b' if it is at most 'max',
+ * otherwise 'max' + 1. Returns SIZE_MAX if memory runs out. 'max' must
+ * be below SIZE_MAX - 1.
+ */
+size_t _fossil_edit_distance(const void *a, size_t a_count, const void *b, size_t b_count, size_t unit, size_t max);
+
+#endif /* FOSSIL_STRINGS_EDIT_H */
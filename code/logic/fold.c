@@ -0,0 +1,126 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fold.h"
+
+#include <string.h>
+
+#define FOLD_CHUNK 256 // bytes folded at a time while hashing
+
+static uint32_t _fold_at(const void *data, size_t index, size_t unit) {
+    if (unit == 1) {
+        return ((const uint8_t *)data)[index];
+    }
+    if (unit == 2) {
+        return ((const uint16_t *)data)[index];
+    }
+    return ((const uint32_t *)data)[index];
+}
+
+/*
+ * Index of the first unit that differs after folding, or _FOSSIL_SIMD_NONE.
+ * The vector kernel only folds ASCII, so in wide mode each difference it
+ * reports is checked again through towlower before it counts.
+ */
+static size_t _fold_mismatch(const void *a, const void *b, size_t count, size_t unit, int wide) {
+    const unsigned char *pa = a, *pb = b;
+    size_t i = 0;
+    while (i < count) {
+        size_t k = _fossil_simd_fold_mismatch(pa + i * unit, pb + i * unit, count - i, unit);
+        if (k == _FOSSIL_SIMD_NONE) {
+            return _FOSSIL_SIMD_NONE;
+        }
+        i += k;
+        if (!wide || _fossil_fold_unit(_fold_at(a, i, unit), 1) != _fossil_fold_unit(_fold_at(b, i, unit), 1)) {
+            return i;
+        }
+        i++;
+    }
+    return _FOSSIL_SIMD_NONE;
+}
+
+int _fossil_fold_compare(const void *a, const void *b, size_t unit, int wide) {
+    size_t la = _fossil_simd_length(a, unit);
+    size_t lb = _fossil_simd_length(b, unit);
+    size_t i = _fold_mismatch(a, b, (la < lb ? la : lb) + 1, unit, wide); // the shorter terminator decides
+    if (i == _FOSSIL_SIMD_NONE) {
+        return 0;
+    }
+    uint32_t x = _fossil_fold_unit(_fold_at(a, i, unit), wide);
+    uint32_t y = _fossil_fold_unit(_fold_at(b, i, unit), wide);
+    return (x > y) - (x < y);
+}
+
+int _fossil_fold_equals(const void *a, const void *b, size_t unit, int wide) {
+    size_t length = _fossil_simd_length(a, unit);
+    if (length != _fossil_simd_length(b, unit)) {
+        return 0;
+    }
+    return _fold_mismatch(a, b, length, unit, wide) == _FOSSIL_SIMD_NONE;
+}
+
+int _fossil_fold_starts_with(const void *str, const void *prefix, size_t unit, int wide) {
+    size_t length = _fossil_simd_length(prefix, unit);
+    if (length > _fossil_simd_length(str, unit)) {
+        return 0;
+    }
+    return _fold_mismatch(str, prefix, length, unit, wide) == _FOSSIL_SIMD_NONE;
+}
+
+uint64_t _fossil_fold_hash(const void *str, size_t unit, int wide) {
+    const unsigned char *p = str;
+    size_t count = _fossil_simd_length(str, unit);
+    size_t per_chunk = FOLD_CHUNK / unit;
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (count * unit * 0xFF51AFD7ED558CCDULL);
+    union {
+        unsigned char bytes[FOLD_CHUNK];
+        uint32_t units[FOLD_CHUNK / 4];
+    } buffer;
+
+    while (count > 0) {
+        size_t chunk = count < per_chunk ? count : per_chunk;
+        _fossil_simd_fold_copy(buffer.bytes, p, chunk, unit);
+        if (wide) {
+            for (size_t i = 0; i < chunk; i++) {
+                uint32_t value = _fold_at(buffer.bytes, i, unit);
+                if (value >= 0x80 && unit == 2) {
+                    ((uint16_t *)(void *)buffer.units)[i] = (uint16_t)_fossil_fold_unit(value, 1);
+                } else if (value >= 0x80) {
+                    buffer.units[i] = _fossil_fold_unit(value, 1);
+                }
+            }
+        }
+
+        // Full chunks are whole words; only the last chunk leaves a tail
+        size_t bytes = chunk * unit;
+        size_t i = 0;
+        for (; i + 8 <= bytes; i += 8) {
+            uint64_t word;
+            memcpy(&word, buffer.bytes + i, 8);
+            h = (h ^ word) * 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 29;
+        }
+        if (i < bytes) {
+            uint64_t tail = 0;
+            memcpy(&tail, buffer.bytes + i, bytes - i);
+            h = (h ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 29;
+        }
+        p += bytes;
+        count -= chunk;
+    }
+    h ^= h >> 32;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 29;
+    return h;
+}
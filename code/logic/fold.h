@@ -0,0 +1,52 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_FOLD_H
+#define FOSSIL_STRINGS_FOLD_H
+
+/*
+ * Private case-insensitive comparison shared by the string families.
+ * ASCII letters are folded inside the vector kernels. With 'wide' set,
+ * units beyond ASCII are also folded one at a time through towlower,
+ * which is what the wide family uses. Strings are zero-terminated runs
+ * of 'unit'-byte code units.
+ */
+
+#include "simd.h"
+
+#include <wctype.h>
+
+// Lower-case form of one unit
+static inline uint32_t _fossil_fold_unit(uint32_t value, int wide) {
+    if (value - 'A' < 26) {
+        return value + ('a' - 'A');
+    }
+    if (wide && value >= 0x80) {
+        return (uint32_t)towlower((wint_t)value);
+    }
+    return value;
+}
+
+// Compare like strcmp on the folded strings
+int _fossil_fold_compare(const void *a, const void *b, size_t unit, int wide);
+
+// 1 if the folded strings are equal, 0 otherwise
+int _fossil_fold_equals(const void *a, const void *b, size_t unit, int wide);
+
+// 1 if 'str' starts with 'prefix' ignoring case, 0 otherwise
+int _fossil_fold_starts_with(const void *str, const void *prefix, size_t unit, int wide);
+
+// Hash of the folded string; strings equal ignoring case hash alike
+uint64_t _fossil_fold_hash(const void *str, size_t unit, int wide);
+
+#endif /* FOSSIL_STRINGS_FOLD_H */
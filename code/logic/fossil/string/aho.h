@@ -0,0 +1,177 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_AHO_H
+#define FOSSIL_STRINGS_AHO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "bstring.h" // For the byte string type definitions
+
+/*
+ * Multi-pattern matcher type definition.
+ *
+ * An Aho-Corasick automaton finds every occurrence of every pattern in one
+ * pass over the text, whatever the number of patterns. Patterns are added
+ * first and the automaton is then compiled; a compiled automaton is read
+ * only, so any number of threads may match with it at once.
+ *
+ * Patterns and text are compared unit by unit, so a classic C string
+ * pattern also matches the same characters held in a byte string.
+ */
+typedef struct fossil_aho fossil_aho_t;
+
+/*
+ * A match reported by the automaton. 'offset' and 'length' are in units
+ * (characters for classic C strings, bletters for byte strings).
+ */
+typedef struct {
+    size_t offset; // Where the match starts in the text or stream
+    size_t length; // The length of the matched pattern
+    size_t id;     // The id given when the pattern was added
+} fossil_aho_match_t;
+
+/*
+ * Called for each match. Return nonzero to stop matching.
+ */
+typedef int (*fossil_aho_callback_t)(const fossil_aho_match_t *match, void *user);
+
+/*
+ * Streaming state carried between chunks of one text. Initialize it with
+ * fossil_aho_stream_init and treat the fields as private.
+ */
+typedef struct {
+    size_t state;
+    size_t offset;
+} fossil_aho_stream_t;
+
+/**
+ * Create an empty automaton.
+ *
+ * Returns the new automaton, or NULL on failure.
+ */
+fossil_aho_t *fossil_aho_create(void);
+
+/**
+ * Erase (free) an automaton.
+ */
+void fossil_aho_erase(fossil_aho_t *aho);
+
+/**
+ * Add a classic C string pattern.
+ *
+ * Patterns added after fossil_aho_compile take effect at the next compile.
+ *
+ * @param aho     The automaton.
+ * @param pattern The pattern; empty patterns are rejected.
+ * @param id      The id reported with matches of this pattern.
+ * @return 0 on success, -1 on failure.
+ */
+int fossil_aho_add_cstr(fossil_aho_t *aho, const_cstring pattern, size_t id);
+
+/**
+ * Add a byte string pattern.
+ *
+ * @param aho     The automaton.
+ * @param pattern The pattern; empty patterns are rejected.
+ * @param id      The id reported with matches of this pattern.
+ * @return 0 on success, -1 on failure.
+ */
+int fossil_aho_add_bstr(fossil_aho_t *aho, const_bstring pattern, size_t id);
+
+/**
+ * Compile the automaton from the patterns added so far.
+ *
+ * States are laid out breadth first with a dense transition table for the
+ * root and sorted edge lists for every other state.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+int fossil_aho_compile(fossil_aho_t *aho);
+
+/**
+ * Get the number of patterns added to an automaton.
+ */
+size_t fossil_aho_count(const fossil_aho_t *aho);
+
+/**
+ * Report every match in a classic C string.
+ *
+ * Matches are reported in order of where they end; several matches ending
+ * at the same place are reported longest first.
+ *
+ * @param aho      The compiled automaton.
+ * @param text     The text to scan.
+ * @param callback Called for each match, or NULL to only count them.
+ * @param user     Passed to the callback.
+ * @return The number of matches reported.
+ */
+size_t fossil_aho_match_cstr(const fossil_aho_t *aho, const_cstring text, fossil_aho_callback_t callback, void *user);
+
+/**
+ * Report every match in a byte string.
+ *
+ * @param aho      The compiled automaton.
+ * @param text     The text to scan.
+ * @param callback Called for each match, or NULL to only count them.
+ * @param user     Passed to the callback.
+ * @return The number of matches reported.
+ */
+size_t fossil_aho_match_bstr(const fossil_aho_t *aho, const_bstring text, fossil_aho_callback_t callback, void *user);
+
+/**
+ * Start a new stream.
+ */
+void fossil_aho_stream_init(fossil_aho_stream_t *stream);
+
+/**
+ * Scan the next chunk of a classic C string stream.
+ *
+ * Matches may span chunks, and offsets count from the start of the stream.
+ * The chunk need not be NUL-terminated. If the callback stops the scan, the
+ * rest of the chunk is skipped. A stream is only valid with the automaton
+ * and compile it was started under.
+ *
+ * @param aho      The compiled automaton.
+ * @param stream   The stream state.
+ * @param chunk    The next characters of the text.
+ * @param len      The number of characters in 'chunk'.
+ * @param callback Called for each match, or NULL to only count them.
+ * @param user     Passed to the callback.
+ * @return The number of matches reported.
+ */
+size_t fossil_aho_feed_cstr(const fossil_aho_t *aho, fossil_aho_stream_t *stream, const_cstring chunk, size_t len,
+                            fossil_aho_callback_t callback, void *user);
+
+/**
+ * Scan the next chunk of a byte string stream.
+ *
+ * @param aho      The compiled automaton.
+ * @param stream   The stream state.
+ * @param chunk    The next units of the text.
+ * @param len      The number of units in 'chunk'.
+ * @param callback Called for each match, or NULL to only count them.
+ * @param user     Passed to the callback.
+ * @return The number of matches reported.
+ */
+size_t fossil_aho_feed_bstr(const fossil_aho_t *aho, fossil_aho_stream_t *stream, const_bstring chunk, size_t len,
+                            fossil_aho_callback_t callback, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_AHO_H */
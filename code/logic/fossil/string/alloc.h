@@ -0,0 +1,104 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_ALLOC_H
+#define FOSSIL_STRINGS_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h> // For size_t
+
+/*
+ * Allocator type definition.
+ *
+ * Every string buffer the library hands back to the caller is obtained
+ * through an allocator. The functions receive 'context' as their first
+ * argument, so one set of functions can serve several pools or collect
+ * statistics per subsystem. A buffer must be released through the same
+ * allocator that produced it.
+ */
+typedef struct {
+    void *(*alloc)(void *context, size_t size);             // like malloc
+    void *(*resize)(void *context, void *ptr, size_t size); // like realloc
+    void (*release)(void *context, void *ptr);              // like free
+    void *context;
+} fossil_allocator_t;
+
+/**
+ * Get the allocator backed by malloc, realloc and free.
+ *
+ * This is the global allocator until fossil_allocator_set is called, so
+ * strings keep working with plain free by default.
+ */
+const fossil_allocator_t *fossil_allocator_system(void);
+
+/**
+ * Get the caching allocator.
+ *
+ * Requests up to 512 bytes are served from per-thread free lists grouped
+ * by size class, so short strings are recycled without taking the heap
+ * lock. Larger requests go straight to malloc. Cached blocks return to the
+ * heap when their thread exits. Buffers from this allocator must not be
+ * passed to free.
+ */
+const fossil_allocator_t *fossil_allocator_cached(void);
+
+/**
+ * Set the global allocator used by every function without an explicit one.
+ *
+ * Call this before any string is created; strings made under one global
+ * allocator must not be erased under another.
+ *
+ * @param allocator The allocator to install, or NULL for fossil_allocator_system.
+ */
+void fossil_allocator_set(const fossil_allocator_t *allocator);
+
+/**
+ * Get the global allocator.
+ */
+const fossil_allocator_t *fossil_allocator_get(void);
+
+/**
+ * Allocate memory through an allocator.
+ *
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param size      The number of bytes to allocate.
+ * @return The allocated memory, or NULL on failure.
+ */
+void *fossil_allocator_alloc(const fossil_allocator_t *allocator, size_t size);
+
+/**
+ * Resize memory obtained from an allocator.
+ *
+ * @param allocator The allocator that produced 'ptr', or NULL for the global allocator.
+ * @param ptr       The memory to resize, or NULL to allocate.
+ * @param size      The new size in bytes.
+ * @return The resized memory, or NULL on failure ('ptr' stays valid).
+ */
+void *fossil_allocator_resize(const fossil_allocator_t *allocator, void *ptr, size_t size);
+
+/**
+ * Release memory obtained from an allocator.
+ *
+ * @param allocator The allocator that produced 'ptr', or NULL for the global allocator.
+ * @param ptr       The memory to release; NULL is ignored.
+ */
+void fossil_allocator_release(const fossil_allocator_t *allocator, void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_ALLOC_H */
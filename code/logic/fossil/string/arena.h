@@ -0,0 +1,288 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_ARENA_H
+#define FOSSIL_STRINGS_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "bstring.h" // For the byte string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Arena creation flags
+#define FOSSIL_ARENA_HUGE_PAGES 0x1 // back blocks with huge pages where the platform allows it
+
+// Block size used when fossil_arena_create is given 0
+#define FOSSIL_ARENA_DEFAULT_BLOCK 65536
+
+/*
+ * Arena type definition.
+ *
+ * An arena hands out memory by bumping a pointer through large blocks, so
+ * every string produced for one request can be released at once with
+ * fossil_arena_reset or fossil_arena_erase. Strings allocated from an arena
+ * must never be passed to fossil_cstr_erase or free. An arena is not
+ * thread-safe; give each worker thread its own.
+ */
+typedef struct fossil_arena fossil_arena_t;
+
+/**
+ * Create an arena.
+ *
+ * @param block_size The size of each block, or 0 for FOSSIL_ARENA_DEFAULT_BLOCK.
+ * @param flags      A combination of FOSSIL_ARENA_* flags.
+ * @return The new arena, or NULL on failure.
+ */
+fossil_arena_t *fossil_arena_create(size_t block_size, int flags);
+
+/**
+ * Erase (free) an arena and every allocation made from it.
+ */
+void fossil_arena_erase(fossil_arena_t *arena);
+
+/**
+ * Release every allocation made from an arena in one step.
+ *
+ * The blocks are kept and reused by later allocations.
+ */
+void fossil_arena_reset(fossil_arena_t *arena);
+
+/**
+ * Get the number of bytes handed out since the arena was created or last reset.
+ */
+size_t fossil_arena_used(const fossil_arena_t *arena);
+
+/**
+ * Allocate memory from an arena.
+ *
+ * @param arena The arena to allocate from.
+ * @param size  The number of bytes to allocate.
+ * @return Memory aligned for any standard type, or NULL on failure.
+ */
+void *fossil_arena_alloc(fossil_arena_t *arena, size_t size);
+
+/**
+ * Get an allocator that allocates from an arena.
+ *
+ * Pass it to any *_with function to build that function's strings in the
+ * arena. Releasing through it does nothing; the memory comes back with
+ * fossil_arena_reset or fossil_arena_erase. The allocator refers to the
+ * arena and is only usable while the arena lives.
+ *
+ * @param arena The arena to allocate from.
+ * @return The allocator.
+ */
+fossil_allocator_t fossil_arena_allocator(fossil_arena_t *arena);
+
+/**
+ * Create a copy of a classic C string in an arena.
+ *
+ * Returns the arena-owned copy, or NULL on failure.
+ */
+cstring fossil_arena_cstr_create(fossil_arena_t *arena, const_cstring str);
+
+/**
+ * Extract a substring of a classic C string into an arena.
+ *
+ * @param arena The arena to allocate from.
+ * @param str   The null-terminated C string from which to extract the substring.
+ * @param start The starting index of the substring.
+ * @param len   The length of the substring to extract.
+ * @return The arena-owned substring, or NULL on failure or invalid parameters.
+ */
+cstring fossil_arena_cstr_substr(fossil_arena_t *arena, const_cstring str, size_t start, size_t len);
+
+/**
+ * Split a classic C string by delimiter into an arena.
+ *
+ * Returns a NULL-terminated array of arena-owned tokens, or NULL on failure.
+ * Release it with the arena, not with fossil_cstr_erase_splits.
+ */
+cstrings fossil_arena_cstr_split(fossil_arena_t *arena, const_cstring str, cletter delimiter);
+
+/**
+ * Format a string into an arena.
+ *
+ * @param arena  The arena to allocate from.
+ * @param format The format string.
+ * @param ... Additional arguments to format.
+ * @return The arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format(fossil_arena_t *arena, const_cstring format, ...);
+
+/**
+ * Format a string into an arena using a va_list.
+ *
+ * @param arena  The arena to allocate from.
+ * @param format The format string.
+ * @param args   The arguments to format.
+ * @return The arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_vformat(fossil_arena_t *arena, const_cstring format, va_list args);
+
+/**
+ * Format a phone number string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_phone(fossil_arena_t *arena, const_cstring phone);
+
+/**
+ * Format a date string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_date(fossil_arena_t *arena, const_cstring date);
+
+/**
+ * Format a time string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_time(fossil_arena_t *arena, const_cstring time);
+
+/**
+ * Format a currency string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_currency(fossil_arena_t *arena, const_cstring currency);
+
+/**
+ * Format a percentage string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_percentage(fossil_arena_t *arena, const_cstring percentage);
+
+/**
+ * Format a postal code string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_postal_code(fossil_arena_t *arena, const_cstring postal_code);
+
+/**
+ * Format a SSN (Social Security Number) string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+cstring fossil_arena_cstr_format_ssn(fossil_arena_t *arena, const_cstring ssn);
+
+/**
+ * Convert integer to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_int(fossil_arena_t *arena, int num);
+
+/**
+ * Convert long to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_long(fossil_arena_t *arena, long num);
+
+/**
+ * Convert long long to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_llong(fossil_arena_t *arena, long long num);
+
+/**
+ * Convert unsigned long to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_ulong(fossil_arena_t *arena, unsigned long num);
+
+/**
+ * Convert unsigned long long to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_ullong(fossil_arena_t *arena, unsigned long long num);
+
+/**
+ * Convert a double to classic C string in an arena.
+ *
+ * Returns the arena-owned string, or NULL on failure.
+ */
+cstring fossil_arena_cstr_from_double(fossil_arena_t *arena, double num);
+
+/**
+ * Create a copy of a byte string in an arena.
+ *
+ * Returns the arena-owned copy, or NULL on failure.
+ */
+bstring fossil_arena_bstr_create(fossil_arena_t *arena, const_bstring str);
+
+/**
+ * Extract a substring of a byte string into an arena.
+ *
+ * Returns the arena-owned substring, or NULL on failure or invalid parameters.
+ */
+bstring fossil_arena_bstr_substr(fossil_arena_t *arena, const_bstring str, size_t start, size_t len);
+
+/**
+ * Split a byte string by delimiter into an arena.
+ *
+ * Returns a NULL-terminated array of arena-owned tokens, or NULL on failure.
+ */
+bstrings fossil_arena_bstr_split(fossil_arena_t *arena, const_bstring str, bletter delimiter);
+
+/**
+ * Format a byte string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred or
+ * the format holds a unit above 0xFF.
+ */
+bstring fossil_arena_bstr_format(fossil_arena_t *arena, const_bstring format, ...);
+
+/**
+ * Create a copy of a wide string in an arena.
+ *
+ * Returns the arena-owned copy, or NULL on failure.
+ */
+wstring fossil_arena_wstr_create(fossil_arena_t *arena, const_wstring str);
+
+/**
+ * Extract a substring of a wide string into an arena.
+ *
+ * Returns the arena-owned substring, or NULL on failure or invalid parameters.
+ */
+wstring fossil_arena_wstr_substr(fossil_arena_t *arena, const_wstring str, size_t start, size_t len);
+
+/**
+ * Split a wide string by delimiter into an arena.
+ *
+ * Returns a NULL-terminated array of arena-owned tokens, or NULL on failure.
+ */
+wstrings fossil_arena_wstr_split(fossil_arena_t *arena, const_wstring str, wletter delimiter);
+
+/**
+ * Format a wide string into an arena.
+ *
+ * Returns the arena-owned formatted string, or NULL if an error occurred.
+ */
+wstring fossil_arena_wstr_format(fossil_arena_t *arena, const_wstring format, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_ARENA_H */
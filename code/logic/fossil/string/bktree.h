@@ -0,0 +1,92 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_BKTREE_H
+#define FOSSIL_STRINGS_BKTREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "fuzzy.h"   // For FOSSIL_FUZZY_ERROR
+
+/*
+ * BK-tree type definition.
+ *
+ * A BK-tree indexes classic C string keys by edit distance so that every
+ * key within a few edits of a query can be found without comparing the
+ * query to the whole dictionary. Each key hangs below another at its edit
+ * distance from it; by the triangle inequality a query only descends into
+ * the children whose distance from their parent is within the search
+ * radius of the query's own distance from that parent. Distances are the
+ * bounded bit-parallel ones from fuzzy.h, so far-away keys cost little.
+ *
+ * The tree is built once from an array of keys and never changes after,
+ * so any number of threads may query it at the same time.
+ */
+typedef struct fossil_bktree fossil_bktree_t;
+
+// One key found by a query
+typedef struct {
+    size_t id;       // the key's index in the array the tree was built from
+    size_t distance; // its edit distance from the query
+} fossil_bktree_match_t;
+
+/**
+ * Build a BK-tree over a NULL-terminated array of keys, such as the
+ * result of fossil_cstr_split. The keys are copied and key i gets id i.
+ * Duplicate keys are kept and each is reported under its own id.
+ *
+ * @param keys The keys to index.
+ * @return The new tree, or NULL on failure.
+ */
+fossil_bktree_t *fossil_bktree_create(cstrings keys);
+
+/**
+ * Erase (free) a BK-tree.
+ */
+void fossil_bktree_erase(fossil_bktree_t *tree);
+
+/**
+ * Get the number of keys in a BK-tree.
+ */
+size_t fossil_bktree_count(const fossil_bktree_t *tree);
+
+/**
+ * Get the key with a given id, or NULL if there is none.
+ */
+const_cstring fossil_bktree_key(const fossil_bktree_t *tree, size_t id);
+
+/**
+ * Find the keys within an edit distance of a query.
+ *
+ * With room for fewer matches than there are, the closest ones are kept,
+ * which also lets the search skip more of the tree.
+ *
+ * @param tree     The BK-tree.
+ * @param query    The string to look up.
+ * @param max      The largest edit distance to report.
+ * @param matches  Receives the matches ordered by distance, then id; may be NULL.
+ * @param capacity The number of matches that fit in 'matches'.
+ * @return The number of matches stored, or if 'matches' is NULL the number
+ *         of keys within 'max'; FOSSIL_FUZZY_ERROR if memory runs out.
+ */
+size_t fossil_bktree_find(const fossil_bktree_t *tree, const_cstring query, size_t max,
+                          fossil_bktree_match_t *matches, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_BKTREE_H */
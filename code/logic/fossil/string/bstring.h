@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include "bletter.h" // For the bletter type definition
+#include "alloc.h"   // For the allocator hooks
 
 // Byte string macro
 #define BSTR(str) ((bletter *)(str))
@@ -36,6 +37,15 @@ typedef const bletter** const_bstrings;
  */
 bstring fossil_bstr_create(const_bstring str);
 
+/**
+ * Create a copy of a byte string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str       The string to copy.
+ * @return The copy, to be erased with fossil_bstr_erase_with and the same allocator.
+ */
+bstring fossil_bstr_create_with(const fossil_allocator_t *allocator, const_bstring str);
+
 /**
  * Erase (free) a byte string.
  * 
@@ -43,6 +53,11 @@ bstring fossil_bstr_create(const_bstring str);
  */
 void fossil_bstr_erase(bstring str);
 
+/**
+ * Erase (free) a byte string created with a specific allocator.
+ */
+void fossil_bstr_erase_with(const fossil_allocator_t *allocator, bstring str);
+
 /**
  * Get the length of a byte string.
  * 
@@ -59,6 +74,16 @@ size_t fossil_bstr_length(const_bstring str);
  */
 bstring fossil_bstr_format(const_bstring format, ...);
 
+/**
+ * Format a byte string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param format The format string.
+ * @param ... Additional arguments to format.
+ * @return The formatted byte string, or NULL if an error occurred.
+ */
+bstring fossil_bstr_format_with(const fossil_allocator_t *allocator, const_bstring format, ...);
+
 /**
  * Format a phone number byte string.
  * 
@@ -123,6 +148,44 @@ bstring fossil_bstr_format_ssn(const_bstring ssn);
  */
 int fossil_bstr_compare(const_bstring str1, const_bstring str2);
 
+/**
+ * Compare two byte strings ignoring case.
+ * 
+ * ASCII letters compare equal in either case.
+ * Returns 0 if they are equal, a negative value if 'str1' sorts first, and a positive value otherwise.
+ */
+int fossil_bstr_icompare(const_bstring str1, const_bstring str2);
+
+/**
+ * Check whether two byte strings are equal ignoring case.
+ * 
+ * Returns 1 if they are equal, 0 otherwise.
+ */
+int fossil_bstr_iequals(const_bstring str1, const_bstring str2);
+
+/**
+ * Check whether a byte string starts with a prefix ignoring case.
+ * 
+ * Returns 1 if 'str' starts with 'prefix', 0 otherwise.
+ */
+int fossil_bstr_istarts_with(const_bstring str, const_bstring prefix);
+
+/**
+ * Find a substring in a byte string ignoring case.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in linear time.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_bstring fossil_bstr_ifind_str(const_bstring str, const_bstring needle);
+
+/**
+ * Hash a byte string ignoring case.
+ * 
+ * Strings that are equal under fossil_bstr_iequals hash alike, so this
+ * suits case-insensitive hash tables.
+ */
+uint64_t fossil_bstr_ihash(const_bstring str);
+
 /**
  * Copy a byte string.
  * 
@@ -147,6 +210,81 @@ bstring fossil_bstr_concat(bstring dest, const_bstring src);
  */
 const_bstring fossil_bstr_find(const_bstring str, bletter ch);
 
+/**
+ * Find the last occurrence of a character in a byte string.
+ * 
+ * Finds the last occurrence of 'ch' in 'str'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_bstring fossil_bstr_rfind(const_bstring str, bletter ch);
+
+/**
+ * Find the first character of a byte string that belongs to a set.
+ * 
+ * Finds the first character of 'str' that also appears in 'set'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_bstring fossil_bstr_find_any(const_bstring str, const_bstring set);
+
+/**
+ * Count the occurrences of a character in a byte string.
+ * 
+ * Returns the number of times 'ch' appears in 'str'.
+ */
+size_t fossil_bstr_count(const_bstring str, bletter ch);
+
+/**
+ * Find a substring in a byte string.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in time linear in their
+ * lengths, whatever the input. An empty needle matches at the start.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_bstring fossil_bstr_find_str(const_bstring str, const_bstring needle);
+
+/**
+ * Find the last occurrence of a substring in a byte string.
+ * 
+ * Finds the last occurrence of 'needle' in 'str' in linear time. An empty
+ * needle matches at the terminator.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_bstring fossil_bstr_rfind_str(const_bstring str, const_bstring needle);
+
+/**
+ * Check whether a byte string contains a substring.
+ * 
+ * Returns 1 if 'needle' occurs in 'str', 0 otherwise.
+ */
+int fossil_bstr_contains(const_bstring str, const_bstring needle);
+
+/**
+ * Find every occurrence of a character in a byte string.
+ * 
+ * Stores the unit offset of each 'ch' in 'str' into 'offsets', up to
+ * 'capacity' of them, and keeps counting past that; 'offsets' may be NULL
+ * when 'capacity' is 0.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_bstr_find_all(const_bstring str, bletter ch, size_t *offsets, size_t capacity);
+
+/**
+ * Find every occurrence of a substring in a byte string.
+ * 
+ * Stores the unit offset of each non-overlapping 'needle' in 'str', left
+ * to right, into 'offsets' up to 'capacity' of them.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_bstr_find_all_str(const_bstring str, const_bstring needle, size_t *offsets, size_t capacity);
+
+/**
+ * Count the occurrences of a substring in a byte string.
+ * 
+ * Returns the number of non-overlapping times 'needle' appears in 'str',
+ * or 0 for an empty needle.
+ */
+size_t fossil_bstr_count_str(const_bstring str, const_bstring needle);
+
 /**
  * Reverse a byte string.
  * 
@@ -163,6 +301,13 @@ const_bstring fossil_bstr_reverse(const_bstring str);
  */
 bstrings fossil_bstr_split(const_bstring str, bletter delimiter);
 
+/**
+ * Split a byte string by delimiter using a specific allocator.
+ * 
+ * Release the result with fossil_bstr_erase_splits_with and the same allocator.
+ */
+bstrings fossil_bstr_split_with(const fossil_allocator_t *allocator, const_bstring str, bletter delimiter);
+
 /**
  * Duplicate a byte string.
  * 
@@ -183,6 +328,17 @@ bstring fossil_bstr_strdup(const_bstring str);
  */
 bstring fossil_bstr_substr(const_bstring str, size_t start, size_t len);
 
+/**
+ * Extracts a substring from a byte string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str   The byte string from which to extract the substring.
+ * @param start The starting index of the substring.
+ * @param len   The length of the substring to extract.
+ * @return      The substring, or NULL on failure or invalid parameters.
+ */
+bstring fossil_bstr_substr_with(const fossil_allocator_t *allocator, const_bstring str, size_t start, size_t len);
+
 /**
  * Frees the memory allocated for an array of byte strings and the strings it contains.
  * 
@@ -193,6 +349,11 @@ bstring fossil_bstr_substr(const_bstring str, size_t start, size_t len);
  */
 void fossil_bstr_erase_splits(bstrings splits);
 
+/**
+ * Frees an array of byte strings produced with a specific allocator.
+ */
+void fossil_bstr_erase_splits_with(const fossil_allocator_t *allocator, bstrings splits);
+
 /**
  * Convert integer to byte string.
  * 
@@ -0,0 +1,122 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_BVIEW_H
+#define FOSSIL_STRINGS_BVIEW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "bstring.h" // For the byte string type definitions
+
+// Position returned by view searches when nothing was found
+#ifndef FOSSIL_VIEW_NPOS
+#define FOSSIL_VIEW_NPOS ((size_t)-1)
+#endif
+
+/*
+ * Byte string view type definition.
+ *
+ * A bview is a non-owning {pointer, length} slice of byte characters.
+ * It is not NUL-terminated and never allocates; the viewed data must outlive it.
+ */
+typedef struct {
+    const bletter *data;
+    size_t length;
+} bview;
+
+/**
+ * Make a view over 'length' characters starting at 'data'.
+ *
+ * Returns the view, or an empty view if 'data' is NULL.
+ */
+bview fossil_bview_make(const_bstring data, size_t length);
+
+/**
+ * Make a view over a whole byte string.
+ *
+ * The length is counted in bletter units up to the first zero unit.
+ * Returns the view, or an empty view if 'str' is NULL.
+ */
+bview fossil_bview_from(const_bstring str);
+
+/**
+ * Take a sub-view of a view.
+ *
+ * @param view  The view to slice.
+ * @param start The starting index of the sub-view.
+ * @param len   The maximum length of the sub-view.
+ * @return      The sub-view, clamped to the bounds of 'view'.
+ */
+bview fossil_bview_substr(bview view, size_t start, size_t len);
+
+/**
+ * Find a character in a view.
+ *
+ * Returns the index of the first occurrence of 'ch', or FOSSIL_VIEW_NPOS if not found.
+ */
+size_t fossil_bview_find(bview view, bletter ch);
+
+/**
+ * Compare two views.
+ *
+ * Returns 0 if they are equal, a negative value if 'view1' is less than 'view2',
+ * and a positive value if 'view1' is greater than 'view2'.
+ */
+int fossil_bview_compare(bview view1, bview view2);
+
+/**
+ * Check whether two views hold the same characters.
+ *
+ * Returns a non-zero value if they are equal, otherwise 0.
+ */
+int fossil_bview_equals(bview view1, bview view2);
+
+/**
+ * Check whether a view starts with the characters of 'prefix'.
+ *
+ * Returns a non-zero value if it does, otherwise 0.
+ */
+int fossil_bview_starts_with(bview view, bview prefix);
+
+/**
+ * Check whether a view ends with the characters of 'suffix'.
+ *
+ * Returns a non-zero value if it does, otherwise 0.
+ */
+int fossil_bview_ends_with(bview view, bview suffix);
+
+/**
+ * Split a view by delimiter without allocating.
+ *
+ * @param view      The view to split.
+ * @param delimiter The delimiter character.
+ * @param out       Caller buffer receiving up to 'max' token views (may be NULL if 'max' is 0).
+ * @param max       The capacity of 'out'.
+ * @return          The total number of tokens in 'view', which may exceed 'max'.
+ */
+size_t fossil_bview_split(bview view, bletter delimiter, bview *out, size_t max);
+
+/**
+ * Copy a view into a new byte string.
+ *
+ * Returns a newly allocated zero-terminated copy, or NULL on failure.
+ */
+bstring fossil_bview_to_bstr(bview view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_BVIEW_H */
@@ -0,0 +1,152 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_CHARSET_H
+#define FOSSIL_STRINGS_CHARSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "split.h" // For the split flags and the string type definitions
+
+/*
+ * Character set type definitions.
+ *
+ * A character set is a compiled set of characters, such as the delimiters
+ * " \t,;", that strings can be scanned against in a single pass. The
+ * classic C version is a 256-bit map laid out for nibble shuffle lookups,
+ * which test 32 characters at a time on AVX2 and 16 on NEON. The wide
+ * version keeps a bitmap for ASCII and a sorted table of ranges for the
+ * rest. The terminator is never a member.
+ *
+ * A set can be grown with add_range; once it stops changing, any number
+ * of threads may scan with it at the same time.
+ */
+typedef struct fossil_cstr_charset fossil_cstr_charset_t;
+typedef struct fossil_wstr_charset fossil_wstr_charset_t;
+
+/**
+ * Create a character set from the characters of a classic C string.
+ *
+ * @param members The characters to include; NULL or "" for an empty set.
+ * @return The new set, or NULL on failure.
+ */
+fossil_cstr_charset_t *fossil_cstr_charset_create(const_cstring members);
+
+/**
+ * Erase (free) a classic C character set.
+ */
+void fossil_cstr_charset_erase(fossil_cstr_charset_t *set);
+
+/**
+ * Add the characters from 'first' to 'last', as unsigned values, to a set.
+ *
+ * Returns 0 on success, -1 if 'first' is above 'last'.
+ */
+int fossil_cstr_charset_add_range(fossil_cstr_charset_t *set, cletter first, cletter last);
+
+/**
+ * Check whether a character is in a set.
+ */
+int fossil_cstr_charset_contains(const fossil_cstr_charset_t *set, cletter ch);
+
+/**
+ * Get the length of the initial run of 'str' made only of set members.
+ */
+size_t fossil_cstr_charset_span(const fossil_cstr_charset_t *set, const_cstring str);
+
+/**
+ * Get the length of the initial run of 'str' with no set members.
+ */
+size_t fossil_cstr_charset_cspan(const fossil_cstr_charset_t *set, const_cstring str);
+
+/**
+ * Find the first set member in 'str'.
+ *
+ * Returns a pointer to it, or NULL if there is none.
+ */
+const_cstring fossil_cstr_charset_find(const fossil_cstr_charset_t *set, const_cstring str);
+
+/**
+ * Split a classic C string at every member of a set.
+ *
+ * The result has the single-block layout of fossil_cstr_split_block and is
+ * released with fossil_cstr_erase_split_block.
+ *
+ * @param set   The delimiters.
+ * @param str   The string to split.
+ * @param flags FOSSIL_SPLIT_SKIP_EMPTY to leave out empty tokens, else 0.
+ * @return The NULL-terminated array of tokens, or NULL on failure.
+ */
+cstrings fossil_cstr_charset_split(const fossil_cstr_charset_t *set, const_cstring str, unsigned flags);
+
+/**
+ * Create a character set from the characters of a wide string.
+ *
+ * @param members The characters to include; NULL or L"" for an empty set.
+ * @return The new set, or NULL on failure.
+ */
+fossil_wstr_charset_t *fossil_wstr_charset_create(const_wstring members);
+
+/**
+ * Erase (free) a wide character set.
+ */
+void fossil_wstr_charset_erase(fossil_wstr_charset_t *set);
+
+/**
+ * Add the characters from 'first' to 'last' to a set.
+ *
+ * Returns 0 on success, -1 if 'first' is above 'last' or memory runs out.
+ */
+int fossil_wstr_charset_add_range(fossil_wstr_charset_t *set, wletter first, wletter last);
+
+/**
+ * Check whether a character is in a set.
+ */
+int fossil_wstr_charset_contains(const fossil_wstr_charset_t *set, wletter ch);
+
+/**
+ * Get the length of the initial run of 'str' made only of set members.
+ */
+size_t fossil_wstr_charset_span(const fossil_wstr_charset_t *set, const_wstring str);
+
+/**
+ * Get the length of the initial run of 'str' with no set members.
+ */
+size_t fossil_wstr_charset_cspan(const fossil_wstr_charset_t *set, const_wstring str);
+
+/**
+ * Find the first set member in 'str'.
+ *
+ * Returns a pointer to it, or NULL if there is none.
+ */
+const_wstring fossil_wstr_charset_find(const fossil_wstr_charset_t *set, const_wstring str);
+
+/**
+ * Split a wide string at every member of a set.
+ *
+ * The result is released with fossil_wstr_erase_split_block.
+ *
+ * @param set   The delimiters.
+ * @param str   The string to split.
+ * @param flags FOSSIL_SPLIT_SKIP_EMPTY to leave out empty tokens, else 0.
+ * @return The NULL-terminated array of tokens, or NULL on failure.
+ */
+wstrings fossil_wstr_charset_split(const fossil_wstr_charset_t *set, const_wstring str, unsigned flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_CHARSET_H */
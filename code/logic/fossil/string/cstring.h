@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include "cletter.h" // For classic C letter type definitions
+#include "alloc.h"   // For the allocator hooks
 
 // Classic C string type definitions
 typedef const cletter* const_cstring;
@@ -33,6 +34,15 @@ typedef const cletter** const_cstrings;
  */
 cstring fossil_cstr_create(const_cstring str);
 
+/**
+ * Create a copy of a C string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str       The string to copy.
+ * @return The copy, to be erased with fossil_cstr_erase_with and the same allocator.
+ */
+cstring fossil_cstr_create_with(const fossil_allocator_t *allocator, const_cstring str);
+
 /**
  * Erase (free) a C string.
  * 
@@ -40,6 +50,11 @@ cstring fossil_cstr_create(const_cstring str);
  */
 void fossil_cstr_erase(cstring str);
 
+/**
+ * Erase (free) a C string created with a specific allocator.
+ */
+void fossil_cstr_erase_with(const fossil_allocator_t *allocator, cstring str);
+
 /**
  * Get the length of a C string.
  * 
@@ -56,6 +71,16 @@ size_t fossil_cstr_length(const_cstring str);
  */
 cstring fossil_cstr_format(const_cstring format, ...);
 
+/**
+ * Format a string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param format The format string.
+ * @param ... Additional arguments to format.
+ * @return The formatted string, or NULL if an error occurred.
+ */
+cstring fossil_cstr_format_with(const fossil_allocator_t *allocator, const_cstring format, ...);
+
 /**
  * Format a phone number string.
  * 
@@ -120,6 +145,44 @@ cstring fossil_cstr_format_ssn(const_cstring ssn);
  */
 int fossil_cstr_compare(const_cstring str1, const_cstring str2);
 
+/**
+ * Compare two classic C strings ignoring case.
+ * 
+ * ASCII letters compare equal in either case.
+ * Returns 0 if they are equal, a negative value if 'str1' sorts first, and a positive value otherwise.
+ */
+int fossil_cstr_icompare(const_cstring str1, const_cstring str2);
+
+/**
+ * Check whether two classic C strings are equal ignoring case.
+ * 
+ * Returns 1 if they are equal, 0 otherwise.
+ */
+int fossil_cstr_iequals(const_cstring str1, const_cstring str2);
+
+/**
+ * Check whether a classic C string starts with a prefix ignoring case.
+ * 
+ * Returns 1 if 'str' starts with 'prefix', 0 otherwise.
+ */
+int fossil_cstr_istarts_with(const_cstring str, const_cstring prefix);
+
+/**
+ * Find a substring in a classic C string ignoring case.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in linear time.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_cstring fossil_cstr_ifind_str(const_cstring str, const_cstring needle);
+
+/**
+ * Hash a classic C string ignoring case.
+ * 
+ * Strings that are equal under fossil_cstr_iequals hash alike, so this
+ * suits case-insensitive hash tables.
+ */
+uint64_t fossil_cstr_ihash(const_cstring str);
+
 /**
  * Copy a classic C string.
  * 
@@ -144,6 +207,81 @@ cstring fossil_cstr_concat(cstring dest, const_cstring src);
  */
 const_cstring fossil_cstr_find(const_cstring str, cletter ch);
 
+/**
+ * Find the last occurrence of a character in a classic C string.
+ * 
+ * Finds the last occurrence of 'ch' in 'str'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_cstring fossil_cstr_rfind(const_cstring str, cletter ch);
+
+/**
+ * Find the first character of a classic C string that belongs to a set.
+ * 
+ * Finds the first character of 'str' that also appears in 'set'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_cstring fossil_cstr_find_any(const_cstring str, const_cstring set);
+
+/**
+ * Count the occurrences of a character in a classic C string.
+ * 
+ * Returns the number of times 'ch' appears in 'str'.
+ */
+size_t fossil_cstr_count(const_cstring str, cletter ch);
+
+/**
+ * Find a substring in a classic C string.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in time linear in their
+ * lengths, whatever the input. An empty needle matches at the start.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_cstring fossil_cstr_find_str(const_cstring str, const_cstring needle);
+
+/**
+ * Find the last occurrence of a substring in a classic C string.
+ * 
+ * Finds the last occurrence of 'needle' in 'str' in linear time. An empty
+ * needle matches at the terminator.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_cstring fossil_cstr_rfind_str(const_cstring str, const_cstring needle);
+
+/**
+ * Check whether a classic C string contains a substring.
+ * 
+ * Returns 1 if 'needle' occurs in 'str', 0 otherwise.
+ */
+int fossil_cstr_contains(const_cstring str, const_cstring needle);
+
+/**
+ * Find every occurrence of a character in a classic C string.
+ * 
+ * Stores the character offset of each 'ch' in 'str' into 'offsets', up to
+ * 'capacity' of them, and keeps counting past that; 'offsets' may be NULL
+ * when 'capacity' is 0.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_cstr_find_all(const_cstring str, cletter ch, size_t *offsets, size_t capacity);
+
+/**
+ * Find every occurrence of a substring in a classic C string.
+ * 
+ * Stores the character offset of each non-overlapping 'needle' in 'str', left
+ * to right, into 'offsets' up to 'capacity' of them.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_cstr_find_all_str(const_cstring str, const_cstring needle, size_t *offsets, size_t capacity);
+
+/**
+ * Count the occurrences of a substring in a classic C string.
+ * 
+ * Returns the number of non-overlapping times 'needle' appears in 'str',
+ * or 0 for an empty needle.
+ */
+size_t fossil_cstr_count_str(const_cstring str, const_cstring needle);
+
 /**
  * Reverse a classic C string.
  * 
@@ -160,6 +298,13 @@ const_cstring fossil_cstr_reverse(const_cstring str);
  */
 cstrings fossil_cstr_split(const_cstring str, cletter delimiter);
 
+/**
+ * Split a classic C string by delimiter using a specific allocator.
+ * 
+ * Release the result with fossil_cstr_erase_splits_with and the same allocator.
+ */
+cstrings fossil_cstr_split_with(const fossil_allocator_t *allocator, const_cstring str, cletter delimiter);
+
 /**
  * Duplicate a classic C string.
  * 
@@ -180,6 +325,17 @@ cstring fossil_cstr_strdup(const_cstring str);
  */
 cstring fossil_cstr_substr(const_cstring str, size_t start, size_t len);
 
+/**
+ * Extracts a substring from a null-terminated C string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str   The null-terminated C string from which to extract the substring.
+ * @param start The starting index of the substring.
+ * @param len   The length of the substring to extract.
+ * @return      The substring, or NULL on failure or invalid parameters.
+ */
+cstring fossil_cstr_substr_with(const fossil_allocator_t *allocator, const_cstring str, size_t start, size_t len);
+
 /**
  * Frees the memory allocated for an array of C strings and the strings it contains.
  * 
@@ -190,6 +346,11 @@ cstring fossil_cstr_substr(const_cstring str, size_t start, size_t len);
  */
 void fossil_cstr_erase_splits(cstrings splits);
 
+/**
+ * Frees an array of C strings produced with a specific allocator.
+ */
+void fossil_cstr_erase_splits_with(const fossil_allocator_t *allocator, cstrings splits);
+
 /**
  * Convert integer to classic C string.
  * 
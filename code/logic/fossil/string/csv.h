@@ -0,0 +1,112 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_CSV_H
+#define FOSSIL_STRINGS_CSV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cview.h" // For the classic C string view type definitions
+
+// Returned by fossil_csv_feed and fossil_csv_finish when memory runs out
+#define FOSSIL_CSV_ERROR ((size_t)-1)
+
+/*
+ * Streaming CSV tokenizer type definition.
+ *
+ * A tokenizer splits delimited text, such as CSV or TSV, into rows of
+ * fields. Text is fed in chunks of any size, and rows are reported as soon
+ * as their line ends; a row that runs across chunks is carried over until
+ * it is complete. Separators, quotes and line ends are found 64 bytes at a
+ * time with vector bit masks, and whether each byte is inside quotes comes
+ * from a carry-less multiply over the quote mask where the CPU has one.
+ *
+ * Quoting follows RFC 4180: a quoted field may hold separators and line
+ * ends, and a doubled quote inside it stands for one quote. A "\r" before a
+ * line end is dropped. An empty line is a row with one empty field.
+ *
+ * One tokenizer reads one stream at a time, from one thread.
+ */
+typedef struct fossil_csv fossil_csv_t;
+
+/*
+ * A row reported by the tokenizer. The fields are views into the fed chunk,
+ * or into the tokenizer's own buffers for fields with quotes to decode and
+ * rows that ran across chunks; either way they are only valid during the
+ * callback.
+ */
+typedef struct {
+    const cview *fields; // The fields of the row, in order
+    size_t count;        // The number of fields, at least one
+    size_t index;        // The row's number in the stream, from 0
+} fossil_csv_row_t;
+
+/*
+ * Called for each row. Return nonzero to stop the stream; nothing more is
+ * reported until fossil_csv_reset.
+ */
+typedef int (*fossil_csv_callback_t)(const fossil_csv_row_t *row, void *user);
+
+/**
+ * Create a tokenizer.
+ *
+ * @param separator The field separator, such as ',' for CSV or '\t' for TSV.
+ * @param quote     The quote character, such as '"', or 0 to read quotes as
+ *                  ordinary characters.
+ * @return The new tokenizer, or NULL if the characters clash with each other
+ *         or with the line end, or on failure.
+ */
+fossil_csv_t *fossil_csv_create(cletter separator, cletter quote);
+
+/**
+ * Erase (free) a tokenizer.
+ */
+void fossil_csv_erase(fossil_csv_t *csv);
+
+/**
+ * Drop any unfinished row and start a new stream.
+ */
+void fossil_csv_reset(fossil_csv_t *csv);
+
+/**
+ * Feed the next chunk of a stream and report every row it completes.
+ *
+ * @param csv      The tokenizer.
+ * @param chunk    The next bytes of the stream; they need not end on a row.
+ * @param length   The number of bytes in 'chunk'.
+ * @param callback Called for each row, or NULL to only count them.
+ * @param user     Passed to the callback.
+ * @return The number of rows reported, or FOSSIL_CSV_ERROR on failure.
+ */
+size_t fossil_csv_feed(fossil_csv_t *csv, const char *chunk, size_t length, fossil_csv_callback_t callback, void *user);
+
+/**
+ * End a stream: report the last row if it has no line end, then reset.
+ *
+ * A quote still open at the end of the stream takes the rest of it into
+ * its field.
+ *
+ * @param csv      The tokenizer.
+ * @param callback Called for the row, or NULL to only count it.
+ * @param user     Passed to the callback.
+ * @return The number of rows reported (0 or 1), or FOSSIL_CSV_ERROR on failure.
+ */
+size_t fossil_csv_finish(fossil_csv_t *csv, fossil_csv_callback_t callback, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_CSV_H */
@@ -18,6 +18,39 @@
 #include "cstring.h"
 #include "bstring.h"
 #include "wstring.h"
+#include "lstring.h"
+#include "sstring.h"
+#include "rstring.h"
+
+// String view types
+#include "cview.h"
+#include "bview.h"
+#include "wview.h"
+
+// Tokenizing
+#include "split.h"
+#include "charset.h"
+#include "csv.h"
+
+// Large text types
+#include "rope.h"
+
+// Shared string storage
+#include "intern.h"
+#include "arena.h"
+#include "alloc.h"
+
+// Pattern matching
+#include "aho.h"
+#include "pattern.h"
+#include "regex.h"
+#include "glob.h"
+#include "fuzzy.h"
+#include "bktree.h"
+
+// Text indexes
+#include "suffix.h"
+#include "ngram.h"
 
 // Character types
 #include "cletter.h"
@@ -0,0 +1,116 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_FUZZY_H
+#define FOSSIL_STRINGS_FUZZY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Distance returned when memory runs out
+#define FOSSIL_FUZZY_ERROR ((size_t)-1)
+
+/*
+ * Edit distance and approximate search.
+ *
+ * The distance is the Levenshtein distance: the fewest single character
+ * insertions, deletions and substitutions that turn one string into the
+ * other, counted in bytes for classic C strings and in wide characters
+ * for wide strings.
+ *
+ * It is computed with the bit-parallel algorithm of Myers as refined by
+ * Hyyrö, which advances a whole column of the edit table in a few word
+ * operations, 64 rows per word. A shared prefix and suffix are skipped
+ * first. With a bound, strings whose lengths differ by more than the
+ * bound are rejected outright and the scan stops as soon as the bound can
+ * no longer be met, so most non-matches cost a few word operations.
+ * Strings of up to 64 characters need no allocation.
+ */
+
+/**
+ * Levenshtein distance between two classic C strings.
+ *
+ * @return The distance, or FOSSIL_FUZZY_ERROR if memory runs out.
+ */
+size_t fossil_cstr_distance(const_cstring a, const_cstring b);
+
+/**
+ * Levenshtein distance between two classic C strings, giving up past a bound.
+ *
+ * @param a   The first string.
+ * @param b   The second string.
+ * @param max The largest distance of interest.
+ * @return The distance if it is at most 'max', otherwise 'max' + 1;
+ *         FOSSIL_FUZZY_ERROR if memory runs out.
+ */
+size_t fossil_cstr_distance_within(const_cstring a, const_cstring b, size_t max);
+
+/**
+ * Find an approximate occurrence of a needle in a classic C string.
+ *
+ * Reports the first place where some substring is within 'max' edits of
+ * the needle. Among the overlapping candidates there, the closest one is
+ * taken, and the longest of those if several are equally close.
+ *
+ * @param str      The string to search.
+ * @param needle   The text to look for.
+ * @param max      The most edits a match may need.
+ * @param length   Receives the length of the match; may be NULL.
+ * @param distance Receives the edit distance of the match; may be NULL.
+ * @return A pointer to the start of the match in 'str', or NULL if there
+ *         is none or memory runs out.
+ */
+const_cstring fossil_cstr_fuzzy_find(const_cstring str, const_cstring needle, size_t max, size_t *length,
+                                     size_t *distance);
+
+/**
+ * Levenshtein distance between two wide strings.
+ *
+ * @return The distance, or FOSSIL_FUZZY_ERROR if memory runs out.
+ */
+size_t fossil_wstr_distance(const_wstring a, const_wstring b);
+
+/**
+ * Levenshtein distance between two wide strings, giving up past a bound.
+ *
+ * @param a   The first string.
+ * @param b   The second string.
+ * @param max The largest distance of interest.
+ * @return The distance if it is at most 'max', otherwise 'max' + 1;
+ *         FOSSIL_FUZZY_ERROR if memory runs out.
+ */
+size_t fossil_wstr_distance_within(const_wstring a, const_wstring b, size_t max);
+
+/**
+ * Find an approximate occurrence of a needle in a wide string.
+ *
+ * @param str      The string to search.
+ * @param needle   The text to look for.
+ * @param max      The most edits a match may need.
+ * @param length   Receives the length of the match; may be NULL.
+ * @param distance Receives the edit distance of the match; may be NULL.
+ * @return A pointer to the start of the match in 'str', or NULL if there
+ *         is none or memory runs out.
+ */
+const_wstring fossil_wstr_fuzzy_find(const_wstring str, const_wstring needle, size_t max, size_t *length,
+                                     size_t *distance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_FUZZY_H */
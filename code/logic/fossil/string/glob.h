@@ -0,0 +1,175 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_GLOB_H
+#define FOSSIL_STRINGS_GLOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Glob flag: ASCII letters match either case
+#define FOSSIL_GLOB_IGNORE_CASE 0x1u
+
+// Glob flag: '*', '?' and bracket sets never match '/', as in path matching
+#define FOSSIL_GLOB_PATHNAME 0x2u
+
+/*
+ * Glob type definitions.
+ *
+ * Shell-style wildcards: '*' matches any run of characters, '?' any one
+ * character, and [a-z] or [!a-z] (also [^a-z]) any character in or out of
+ * the set. A backslash makes the next character literal. A '[' without a
+ * closing ']' is literal. The whole string must match.
+ *
+ * Matching never backtracks. The text between stars is matched left to
+ * right, each piece at its leftmost place, which takes time linear in the
+ * string for all-literal pieces and for pieces of up to 64 characters.
+ *
+ * A glob set holds many globs and reports which of them match a string.
+ * Globs are bucketed by their first character, so a string is only tried
+ * against the globs that can match how it starts, plus those that start
+ * with a wildcard. Globs and sets are read only after creation, so
+ * threads may share them.
+ */
+typedef struct fossil_cstr_glob fossil_cstr_glob_t;
+typedef struct fossil_wstr_glob fossil_wstr_glob_t;
+typedef struct fossil_cstr_globset fossil_cstr_globset_t;
+typedef struct fossil_wstr_globset fossil_wstr_globset_t;
+
+/**
+ * Compile a classic C string glob.
+ *
+ * @param pattern The wildcard pattern.
+ * @param flags   FOSSIL_GLOB_ flags, or 0.
+ * @return The new glob, or NULL on failure.
+ */
+fossil_cstr_glob_t *fossil_cstr_glob_create(const_cstring pattern, unsigned flags);
+
+/**
+ * Erase (free) a classic C string glob.
+ */
+void fossil_cstr_glob_erase(fossil_cstr_glob_t *glob);
+
+/**
+ * Check whether a classic C string matches a glob.
+ *
+ * Returns 1 if it matches, 0 otherwise.
+ */
+int fossil_cstr_glob_match(const fossil_cstr_glob_t *glob, const_cstring str);
+
+/**
+ * Compile several classic C string globs into a set.
+ *
+ * @param patterns The wildcard patterns; glob i is patterns[i].
+ * @param count    The number of patterns.
+ * @param flags    FOSSIL_GLOB_ flags applied to every pattern, or 0.
+ * @return The new set, or NULL on failure.
+ */
+fossil_cstr_globset_t *fossil_cstr_globset_create(const const_cstring *patterns, size_t count, unsigned flags);
+
+/**
+ * Erase (free) a classic C string glob set.
+ */
+void fossil_cstr_globset_erase(fossil_cstr_globset_t *set);
+
+/**
+ * Find which globs of a set match a classic C string.
+ *
+ * @param set      The glob set.
+ * @param str      The string to test.
+ * @param ids      Receives the indexes of the matching globs in ascending order; may be NULL.
+ * @param capacity The number of indexes that fit in 'ids'.
+ * @return The number of matching globs, which may exceed 'capacity'.
+ */
+size_t fossil_cstr_globset_match(const fossil_cstr_globset_t *set, const_cstring str, size_t *ids, size_t capacity);
+
+/**
+ * Test an array of classic C strings against a glob set.
+ *
+ * @param set     The glob set.
+ * @param strings The strings to test.
+ * @param count   The number of strings.
+ * @param matched Receives 1 for each string some glob matches and 0 otherwise; may be NULL.
+ * @return The number of strings some glob matches.
+ */
+size_t fossil_cstr_globset_filter(const fossil_cstr_globset_t *set, const const_cstring *strings, size_t count,
+                                  unsigned char *matched);
+
+/**
+ * Compile a wide string glob.
+ *
+ * @param pattern The wildcard pattern.
+ * @param flags   FOSSIL_GLOB_ flags, or 0.
+ * @return The new glob, or NULL on failure.
+ */
+fossil_wstr_glob_t *fossil_wstr_glob_create(const_wstring pattern, unsigned flags);
+
+/**
+ * Erase (free) a wide string glob.
+ */
+void fossil_wstr_glob_erase(fossil_wstr_glob_t *glob);
+
+/**
+ * Check whether a wide string matches a glob.
+ *
+ * Returns 1 if it matches, 0 otherwise.
+ */
+int fossil_wstr_glob_match(const fossil_wstr_glob_t *glob, const_wstring str);
+
+/**
+ * Compile several wide string globs into a set.
+ *
+ * @param patterns The wildcard patterns; glob i is patterns[i].
+ * @param count    The number of patterns.
+ * @param flags    FOSSIL_GLOB_ flags applied to every pattern, or 0.
+ * @return The new set, or NULL on failure.
+ */
+fossil_wstr_globset_t *fossil_wstr_globset_create(const const_wstring *patterns, size_t count, unsigned flags);
+
+/**
+ * Erase (free) a wide string glob set.
+ */
+void fossil_wstr_globset_erase(fossil_wstr_globset_t *set);
+
+/**
+ * Find which globs of a set match a wide string.
+ *
+ * @param set      The glob set.
+ * @param str      The string to test.
+ * @param ids      Receives the indexes of the matching globs in ascending order; may be NULL.
+ * @param capacity The number of indexes that fit in 'ids'.
+ * @return The number of matching globs, which may exceed 'capacity'.
+ */
+size_t fossil_wstr_globset_match(const fossil_wstr_globset_t *set, const_wstring str, size_t *ids, size_t capacity);
+
+/**
+ * Test an array of wide strings against a glob set.
+ *
+ * @param set     The glob set.
+ * @param strings The strings to test.
+ * @param count   The number of strings.
+ * @param matched Receives 1 for each string some glob matches and 0 otherwise; may be NULL.
+ * @return The number of strings some glob matches.
+ */
+size_t fossil_wstr_globset_filter(const fossil_wstr_globset_t *set, const const_wstring *strings, size_t count,
+                                  unsigned char *matched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_GLOB_H */
@@ -0,0 +1,98 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_INTERN_H
+#define FOSSIL_STRINGS_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "bstring.h" // For the byte string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+/*
+ * String intern pool type definition.
+ *
+ * An intern pool maps every distinct string to one canonical pointer that
+ * stays valid until the pool is erased, so interned strings can be compared
+ * with '==' and duplicates share storage. Lookups never take a lock and may
+ * run concurrently with inserts from any number of threads. Strings from
+ * different families never share a canonical pointer.
+ */
+typedef struct fossil_intern fossil_intern_t;
+
+/**
+ * Create an empty intern pool.
+ *
+ * Returns the new pool, or NULL on failure.
+ */
+fossil_intern_t *fossil_intern_create(void);
+
+/**
+ * Erase (free) an intern pool.
+ *
+ * Invalidates every canonical pointer handed out by the pool. No other
+ * thread may be using the pool at this point.
+ */
+void fossil_intern_erase(fossil_intern_t *pool);
+
+/**
+ * Get the number of distinct strings held by an intern pool.
+ */
+size_t fossil_intern_count(fossil_intern_t *pool);
+
+/**
+ * Intern the first 'len' characters of a classic C string.
+ *
+ * @param pool The intern pool.
+ * @param str  The characters to intern.
+ * @param len  The number of characters to intern.
+ * @return The canonical NUL-terminated copy, or NULL on failure.
+ */
+const_cstring fossil_intern_cstr_len(fossil_intern_t *pool, const_cstring str, size_t len);
+
+/**
+ * Intern a classic C string.
+ *
+ * Returns the canonical NUL-terminated copy, or NULL on failure.
+ */
+const_cstring fossil_intern_cstr(fossil_intern_t *pool, const_cstring str);
+
+/**
+ * Intern a byte string.
+ *
+ * Returns the canonical zero-terminated copy, or NULL on failure.
+ */
+const_bstring fossil_intern_bstr(fossil_intern_t *pool, const_bstring str);
+
+/**
+ * Intern a wide string.
+ *
+ * Returns the canonical NUL-terminated copy, or NULL on failure.
+ */
+const_wstring fossil_intern_wstr(fossil_intern_t *pool, const_wstring str);
+
+/**
+ * Look up a classic C string without inserting it.
+ *
+ * Returns the canonical copy if 'str' was interned before, otherwise NULL.
+ */
+const_cstring fossil_intern_find_cstr(fossil_intern_t *pool, const_cstring str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_INTERN_H */
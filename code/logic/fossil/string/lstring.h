@@ -0,0 +1,196 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_LSTR_H
+#define FOSSIL_STRINGS_LSTR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+/*
+ * Length-prefixed string type definitions.
+ *
+ * An lstring points at NUL-terminated character data that is preceded by a
+ * hidden header holding its length and capacity. It can be passed anywhere a
+ * const_cstring is accepted, but its length is known in O(1) and appends grow
+ * the buffer geometrically. Only release it with fossil_lstr_erase.
+ */
+typedef cletter* lstring;
+typedef const cletter* const_lstring;
+
+/**
+ * Create a length-prefixed string from a classic C string.
+ *
+ * Returns a new lstring containing a copy of 'str', or NULL on failure.
+ */
+lstring fossil_lstr_create(const_cstring str);
+
+/**
+ * Create a length-prefixed string from the first 'len' characters of 'str'.
+ *
+ * @param str The character data to copy (may contain embedded NULs).
+ * @param len The number of characters to copy.
+ * @return A new lstring, or NULL on failure.
+ */
+lstring fossil_lstr_create_len(const_cstring str, size_t len);
+
+/**
+ * Create an empty length-prefixed string with room for 'capacity' characters.
+ *
+ * Returns a new empty lstring, or NULL on failure.
+ */
+lstring fossil_lstr_with_capacity(size_t capacity);
+
+/**
+ * Erase (free) a length-prefixed string.
+ *
+ * Frees the header and character data of the given lstring.
+ */
+void fossil_lstr_erase(lstring str);
+
+/**
+ * Get the length of a length-prefixed string.
+ *
+ * Returns the stored length in O(1), or 0 if 'str' is NULL.
+ */
+size_t fossil_lstr_length(const_lstring str);
+
+/**
+ * Get the capacity of a length-prefixed string.
+ *
+ * Returns the number of characters that fit without reallocating, or 0 if 'str' is NULL.
+ */
+size_t fossil_lstr_capacity(const_lstring str);
+
+/**
+ * Ensure a length-prefixed string can hold at least 'capacity' characters.
+ *
+ * @param str      The lstring to grow.
+ * @param capacity The minimum capacity required.
+ * @return The (possibly moved) lstring, or NULL on failure. On failure the
+ *         original string is left untouched.
+ */
+lstring fossil_lstr_reserve(lstring str, size_t capacity);
+
+/**
+ * Truncate a length-prefixed string to zero length, keeping its capacity.
+ */
+void fossil_lstr_clear(lstring str);
+
+/**
+ * Recompute the stored length after the character data was modified in place.
+ *
+ * Scans for the first NUL and stores its position as the new length.
+ */
+void fossil_lstr_update_length(lstring str);
+
+/**
+ * Append the first 'len' characters of 'src' to a length-prefixed string.
+ *
+ * @param dest The lstring to append to.
+ * @param src  The character data to append.
+ * @param len  The number of characters to append.
+ * @return The (possibly moved) lstring, or NULL on failure.
+ */
+lstring fossil_lstr_concat_len(lstring dest, const_cstring src, size_t len);
+
+/**
+ * Append a classic C string to a length-prefixed string.
+ *
+ * Returns the (possibly moved) lstring, or NULL on failure.
+ */
+lstring fossil_lstr_concat(lstring dest, const_cstring src);
+
+/**
+ * Append one length-prefixed string to another without scanning 'src'.
+ *
+ * Returns the (possibly moved) lstring, or NULL on failure.
+ */
+lstring fossil_lstr_concat_lstr(lstring dest, const_lstring src);
+
+/**
+ * Compare two length-prefixed strings.
+ *
+ * Returns 0 if they are equal, a negative value if 'str1' is less than 'str2',
+ * and a positive value if 'str1' is greater than 'str2'.
+ */
+int fossil_lstr_compare(const_lstring str1, const_lstring str2);
+
+/**
+ * Find a character in a length-prefixed string.
+ *
+ * Returns a pointer to the first occurrence of 'ch' or NULL if not found.
+ */
+const_cstring fossil_lstr_find(const_lstring str, cletter ch);
+
+/**
+ * Reverse a length-prefixed string.
+ *
+ * Returns a new lstring holding the reversed characters of 'str'.
+ */
+lstring fossil_lstr_reverse(const_lstring str);
+
+/**
+ * Extracts a substring from a length-prefixed string.
+ *
+ * @param str   The lstring from which to extract the substring.
+ * @param start The starting index of the substring.
+ * @param len   The length of the substring to extract.
+ *
+ * @return      A new lstring containing the extracted substring,
+ *              or NULL if memory allocation fails or invalid parameters are provided.
+ */
+lstring fossil_lstr_substr(const_lstring str, size_t start, size_t len);
+
+/**
+ * Read a substring from the given length-prefixed string 'str'.
+ *
+ * Reads 'len' characters from 'str' starting at position '*pos'.
+ * Returns the read substring and updates '*pos' to the next position.
+ */
+lstring fossil_lstrstream_read(const_lstring str, size_t *pos, size_t len);
+
+/**
+ * Read a line from the given length-prefixed string 'str'.
+ *
+ * Reads characters from 'str' starting at position '*pos' until a newline or end of string.
+ * Returns the read line and updates '*pos' to the next position after the newline.
+ * Updates '*end_pos' to the position of the newline or end of string.
+ */
+lstring fossil_lstrstream_read_line(const_lstring str, size_t *pos, size_t *end_pos);
+
+/**
+ * Write a string to the given length-prefixed string 'dest'.
+ *
+ * Overwrites 'dest' with 'src' starting at position '*pos', growing 'dest' when
+ * the write runs past its end. Updates '*pos' to the next position after the
+ * written string. Returns the (possibly moved) lstring, or NULL on failure.
+ */
+lstring fossil_lstrstream_write(lstring dest, size_t *pos, const_cstring src);
+
+/**
+ * Append a string to the given length-prefixed string 'dest'.
+ *
+ * Appends 'src' to the end of 'dest' and sets '*pos' to the new end.
+ * Returns the (possibly moved) lstring, or NULL on failure.
+ */
+lstring fossil_lstrstream_append(lstring dest, size_t *pos, const_cstring src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_LSTR_H */
@@ -0,0 +1,100 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_NGRAM_H
+#define FOSSIL_STRINGS_NGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+// Returned by the size_t functions below when memory runs out
+#define FOSSIL_NGRAM_ERROR ((size_t)-1)
+
+/*
+ * N-gram index type definition.
+ *
+ * An n-gram index finds the documents that contain a substring among many
+ * classic C string documents without scanning them all. For every trigram
+ * (three consecutive bytes) it keeps a posting list of the documents that
+ * contain it, delta-encoded in variable-length bytes with a skip entry
+ * every few dozen postings. A search intersects the lists of the pattern's
+ * trigrams, rarest first, and confirms each remaining candidate with the
+ * library's substring search. Patterns shorter than three bytes have no
+ * trigrams and are searched for in every document.
+ *
+ * Documents can be added and removed at any time. Removed documents leave
+ * their postings behind until they make up half of the index, which is
+ * then compacted. Queries may run concurrently with each other, but adding
+ * or removing a document needs exclusive access to the index.
+ */
+typedef struct fossil_ngram fossil_ngram_t;
+
+/**
+ * Create an empty n-gram index.
+ *
+ * @return The new index, or NULL on failure.
+ */
+fossil_ngram_t *fossil_ngram_create(void);
+
+/**
+ * Erase (free) an n-gram index and its documents.
+ */
+void fossil_ngram_erase(fossil_ngram_t *index);
+
+/**
+ * Add a document to an n-gram index. The document is copied.
+ *
+ * @param index    The n-gram index.
+ * @param document The text to add.
+ * @return The document's id, higher than any id given out before, or
+ *         FOSSIL_NGRAM_ERROR on failure.
+ */
+size_t fossil_ngram_add(fossil_ngram_t *index, const_cstring document);
+
+/**
+ * Remove a document from an n-gram index.
+ *
+ * Returns 0 on success, -1 if there is no such document.
+ */
+int fossil_ngram_remove(fossil_ngram_t *index, size_t id);
+
+/**
+ * Get the number of documents in an n-gram index.
+ */
+size_t fossil_ngram_count(const fossil_ngram_t *index);
+
+/**
+ * Get the document with a given id, or NULL if there is none.
+ */
+const_cstring fossil_ngram_document(const fossil_ngram_t *index, size_t id);
+
+/**
+ * Find the documents that contain a pattern.
+ *
+ * @param index    The n-gram index.
+ * @param pattern  The text to look for; an empty pattern matches every document.
+ * @param ids      Receives the ids of the first matching documents in ascending order; may be NULL.
+ * @param capacity The number of ids that fit in 'ids'.
+ * @return The number of matching documents, which may exceed 'capacity',
+ *         or FOSSIL_NGRAM_ERROR if memory runs out.
+ */
+size_t fossil_ngram_find(const fossil_ngram_t *index, const_cstring pattern, size_t *ids, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_NGRAM_H */
@@ -0,0 +1,161 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_PATTERN_H
+#define FOSSIL_STRINGS_PATTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "bstring.h" // For the byte string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Pattern flag: letters match either case. Classic and byte patterns fold
+// ASCII letters; wide patterns also fold other characters through towlower,
+// as fossil_wstr_icompare does.
+#define FOSSIL_PATTERN_IGNORE_CASE 0x1u
+
+/*
+ * Search pattern type definitions.
+ *
+ * A pattern holds a copy of a needle together with everything a search for
+ * it needs: the Two-Way factorization, the rare units the vector prefilter
+ * looks for and the case folding mode. Build it once and search any number
+ * of haystacks with it; searches take linear time. A pattern is read only
+ * after creation, so threads may share one.
+ *
+ * find_all and count report non-overlapping matches, scanning left to right.
+ * An empty needle matches only through find, at the start of the haystack.
+ */
+typedef struct fossil_cstr_pattern fossil_cstr_pattern_t;
+typedef struct fossil_bstr_pattern fossil_bstr_pattern_t;
+typedef struct fossil_wstr_pattern fossil_wstr_pattern_t;
+
+/**
+ * Compile a classic C string needle into a pattern.
+ *
+ * @param needle The string to search for.
+ * @param flags  FOSSIL_PATTERN_IGNORE_CASE or 0.
+ * @return The new pattern, or NULL on failure.
+ */
+fossil_cstr_pattern_t *fossil_cstr_pattern_create(const_cstring needle, unsigned flags);
+
+/**
+ * Erase (free) a classic C string pattern.
+ */
+void fossil_cstr_pattern_erase(fossil_cstr_pattern_t *pattern);
+
+/**
+ * Find the first match of a pattern in a classic C string.
+ *
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_cstring fossil_cstr_pattern_find(const fossil_cstr_pattern_t *pattern, const_cstring str);
+
+/**
+ * Find every match of a pattern in a classic C string.
+ *
+ * @param pattern  The pattern.
+ * @param str      The string to search.
+ * @param offsets  Receives the character offset of each match; may be NULL.
+ * @param capacity The number of offsets that fit in 'offsets'.
+ * @return The total number of matches, which may exceed 'capacity'.
+ */
+size_t fossil_cstr_pattern_find_all(const fossil_cstr_pattern_t *pattern, const_cstring str, size_t *offsets, size_t capacity);
+
+/**
+ * Count the matches of a pattern in a classic C string.
+ */
+size_t fossil_cstr_pattern_count(const fossil_cstr_pattern_t *pattern, const_cstring str);
+
+/**
+ * Compile a byte string needle into a pattern.
+ *
+ * @param needle The string to search for.
+ * @param flags  FOSSIL_PATTERN_IGNORE_CASE or 0.
+ * @return The new pattern, or NULL on failure.
+ */
+fossil_bstr_pattern_t *fossil_bstr_pattern_create(const_bstring needle, unsigned flags);
+
+/**
+ * Erase (free) a byte string pattern.
+ */
+void fossil_bstr_pattern_erase(fossil_bstr_pattern_t *pattern);
+
+/**
+ * Find the first match of a pattern in a byte string.
+ *
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_bstring fossil_bstr_pattern_find(const fossil_bstr_pattern_t *pattern, const_bstring str);
+
+/**
+ * Find every match of a pattern in a byte string.
+ *
+ * @param pattern  The pattern.
+ * @param str      The string to search.
+ * @param offsets  Receives the unit offset of each match; may be NULL.
+ * @param capacity The number of offsets that fit in 'offsets'.
+ * @return The total number of matches, which may exceed 'capacity'.
+ */
+size_t fossil_bstr_pattern_find_all(const fossil_bstr_pattern_t *pattern, const_bstring str, size_t *offsets, size_t capacity);
+
+/**
+ * Count the matches of a pattern in a byte string.
+ */
+size_t fossil_bstr_pattern_count(const fossil_bstr_pattern_t *pattern, const_bstring str);
+
+/**
+ * Compile a wide string needle into a pattern.
+ *
+ * @param needle The string to search for.
+ * @param flags  FOSSIL_PATTERN_IGNORE_CASE or 0.
+ * @return The new pattern, or NULL on failure.
+ */
+fossil_wstr_pattern_t *fossil_wstr_pattern_create(const_wstring needle, unsigned flags);
+
+/**
+ * Erase (free) a wide string pattern.
+ */
+void fossil_wstr_pattern_erase(fossil_wstr_pattern_t *pattern);
+
+/**
+ * Find the first match of a pattern in a wide string.
+ *
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_wstring fossil_wstr_pattern_find(const fossil_wstr_pattern_t *pattern, const_wstring str);
+
+/**
+ * Find every match of a pattern in a wide string.
+ *
+ * @param pattern  The pattern.
+ * @param str      The string to search.
+ * @param offsets  Receives the character offset of each match; may be NULL.
+ * @param capacity The number of offsets that fit in 'offsets'.
+ * @return The total number of matches, which may exceed 'capacity'.
+ */
+size_t fossil_wstr_pattern_find_all(const fossil_wstr_pattern_t *pattern, const_wstring str, size_t *offsets, size_t capacity);
+
+/**
+ * Count the matches of a pattern in a wide string.
+ */
+size_t fossil_wstr_pattern_count(const fossil_wstr_pattern_t *pattern, const_wstring str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_PATTERN_H */
@@ -0,0 +1,143 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_REGEX_H
+#define FOSSIL_STRINGS_REGEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Regex flag: ASCII letters match either case
+#define FOSSIL_REGEX_IGNORE_CASE 0x1u
+
+// Offset stored for a group that took no part in the match
+#define FOSSIL_REGEX_UNSET ((size_t)-1)
+
+/*
+ * Regular expression type definitions.
+ *
+ * Supported syntax: literals, '.', bracket classes such as [a-z_] and
+ * [^0-9], the escapes \d \w \s \D \W \S \n \r \t \f \v \xHH and \x{...},
+ * '^' and '$' (start and end of the whole string), groups (...) and (?:...),
+ * alternation '|', and the quantifiers * + ? {n} {n,} {n,m}, each of which
+ * may be followed by '?' to prefer the shortest match. '.' matches anything
+ * but a newline. A classic C string regex works on bytes and a wide one on
+ * wide characters.
+ *
+ * Matching never backtracks and takes time linear in the length of the
+ * string. Each regex caches a DFA that it builds lazily as strings are
+ * searched; when the cache outgrows its budget the search finishes on the
+ * NFA instead. The cache is locked internally, so threads may share a
+ * regex. When every match starts with the same literal text, the fast
+ * substring search skips the parts of the string where no match can begin.
+ *
+ * find reports the leftmost match, preferring earlier alternatives and
+ * longer repetitions the way Perl does, together with its capture groups.
+ * As in Perl, a repetition stops after an iteration that matches nothing.
+ */
+typedef struct fossil_cstr_regex fossil_cstr_regex_t;
+typedef struct fossil_wstr_regex fossil_wstr_regex_t;
+
+// Character offsets of a match or capture group, end exclusive
+typedef struct {
+    size_t start;
+    size_t end;
+} fossil_regex_capture_t;
+
+/**
+ * Compile a regular expression over classic C strings.
+ *
+ * @param pattern The expression to compile.
+ * @param flags   FOSSIL_REGEX_IGNORE_CASE or 0.
+ * @return The new regex, or NULL if the pattern is invalid or memory runs out.
+ */
+fossil_cstr_regex_t *fossil_cstr_regex_create(const_cstring pattern, unsigned flags);
+
+/**
+ * Erase (free) a classic C string regex.
+ */
+void fossil_cstr_regex_erase(fossil_cstr_regex_t *regex);
+
+/**
+ * Number of capture slots a match fills, counting the whole match as slot 0.
+ */
+size_t fossil_cstr_regex_groups(const fossil_cstr_regex_t *regex);
+
+/**
+ * Check whether a regex matches anywhere in a classic C string.
+ *
+ * Returns 1 if it matches, 0 otherwise.
+ */
+int fossil_cstr_regex_test(const fossil_cstr_regex_t *regex, const_cstring str);
+
+/**
+ * Find the leftmost match of a regex in a classic C string.
+ *
+ * @param regex    The regex.
+ * @param str      The string to search.
+ * @param captures Receives the whole match in slot 0 and group i in slot i;
+ *                 groups that did not take part are FOSSIL_REGEX_UNSET. May be NULL.
+ * @param capacity The number of slots that fit in 'captures'.
+ * @return 1 if the regex matched, 0 if not, -1 if memory runs out.
+ */
+int fossil_cstr_regex_find(const fossil_cstr_regex_t *regex, const_cstring str,
+                           fossil_regex_capture_t *captures, size_t capacity);
+
+/**
+ * Compile a regular expression over wide strings.
+ *
+ * @param pattern The expression to compile.
+ * @param flags   FOSSIL_REGEX_IGNORE_CASE or 0.
+ * @return The new regex, or NULL if the pattern is invalid or memory runs out.
+ */
+fossil_wstr_regex_t *fossil_wstr_regex_create(const_wstring pattern, unsigned flags);
+
+/**
+ * Erase (free) a wide string regex.
+ */
+void fossil_wstr_regex_erase(fossil_wstr_regex_t *regex);
+
+/**
+ * Number of capture slots a match fills, counting the whole match as slot 0.
+ */
+size_t fossil_wstr_regex_groups(const fossil_wstr_regex_t *regex);
+
+/**
+ * Check whether a regex matches anywhere in a wide string.
+ *
+ * Returns 1 if it matches, 0 otherwise.
+ */
+int fossil_wstr_regex_test(const fossil_wstr_regex_t *regex, const_wstring str);
+
+/**
+ * Find the leftmost match of a regex in a wide string.
+ *
+ * @param regex    The regex.
+ * @param str      The string to search.
+ * @param captures Receives the whole match in slot 0 and group i in slot i;
+ *                 groups that did not take part are FOSSIL_REGEX_UNSET. May be NULL.
+ * @param capacity The number of slots that fit in 'captures'.
+ * @return 1 if the regex matched, 0 if not, -1 if memory runs out.
+ */
+int fossil_wstr_regex_find(const fossil_wstr_regex_t *regex, const_wstring str,
+                           fossil_regex_capture_t *captures, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_REGEX_H */
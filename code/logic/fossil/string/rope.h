@@ -0,0 +1,164 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_ROPE_H
+#define FOSSIL_STRINGS_ROPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+// Largest number of characters stored in a single rope chunk
+#define FOSSIL_ROPE_CHUNK 1024
+
+// Deepest tree an iterator can walk; an AVL tree this deep holds far more than SIZE_MAX chunks
+#define FOSSIL_ROPE_MAX_DEPTH 96
+
+/*
+ * Rope type definitions.
+ *
+ * A rope stores a large editable text as a height-balanced tree of chunks,
+ * so insert, delete, slice and index run in O(log n) instead of copying the
+ * tail of a flat cstring. Use fossil_rope_flatten to get a cstring back.
+ */
+typedef struct fossil_rope_node fossil_rope_node_t;
+
+typedef struct {
+    fossil_rope_node_t *root;
+    fossil_rope_node_t *spare; // cached nodes so edits never fail halfway
+    size_t spare_count;
+} fossil_rope_t;
+
+typedef struct {
+    const fossil_rope_node_t *stack[FOSSIL_ROPE_MAX_DEPTH];
+    size_t depth;
+} fossil_rope_iter_t;
+
+/**
+ * Create a rope holding a copy of a classic C string.
+ *
+ * @param str The initial contents, or NULL for an empty rope.
+ * @return A new rope, or NULL on failure.
+ */
+fossil_rope_t *fossil_rope_create(const_cstring str);
+
+/**
+ * Create a rope holding a copy of the first 'len' characters of 'str'.
+ *
+ * @param str The initial contents.
+ * @param len The number of characters to copy.
+ * @return A new rope, or NULL on failure.
+ */
+fossil_rope_t *fossil_rope_create_len(const_cstring str, size_t len);
+
+/**
+ * Erase (free) a rope and all of its chunks.
+ */
+void fossil_rope_erase(fossil_rope_t *rope);
+
+/**
+ * Get the length of a rope.
+ *
+ * Returns the number of characters in the rope in O(1).
+ */
+size_t fossil_rope_length(const fossil_rope_t *rope);
+
+/**
+ * Return the character at the specified index in a rope.
+ *
+ * Returns the character, or '\0' if the index is out of bounds or the rope is NULL.
+ */
+cletter fossil_rope_at(const fossil_rope_t *rope, size_t index);
+
+/**
+ * Insert the first 'len' characters of 'str' at position 'pos'.
+ *
+ * @param rope The rope to edit.
+ * @param pos  The insert position; positions past the end append.
+ * @param str  The characters to insert.
+ * @param len  The number of characters to insert.
+ * @return 0 on success, or -1 on failure (the rope is left unchanged).
+ */
+int fossil_rope_insert_len(fossil_rope_t *rope, size_t pos, const_cstring str, size_t len);
+
+/**
+ * Insert a classic C string at position 'pos'.
+ *
+ * Returns 0 on success, or -1 on failure (the rope is left unchanged).
+ */
+int fossil_rope_insert(fossil_rope_t *rope, size_t pos, const_cstring str);
+
+/**
+ * Append a classic C string to the end of a rope.
+ *
+ * Returns 0 on success, or -1 on failure (the rope is left unchanged).
+ */
+int fossil_rope_append(fossil_rope_t *rope, const_cstring str);
+
+/**
+ * Delete 'len' characters starting at position 'pos'.
+ *
+ * The range is clamped to the end of the rope.
+ * Returns 0 on success, or -1 on failure (the rope is left unchanged).
+ */
+int fossil_rope_delete(fossil_rope_t *rope, size_t pos, size_t len);
+
+/**
+ * Move the contents of 'src' to the end of 'dest'.
+ *
+ * 'src' is left empty but must still be erased by the caller.
+ * Returns 0 on success, or -1 on failure (both ropes are left unchanged).
+ */
+int fossil_rope_concat(fossil_rope_t *dest, fossil_rope_t *src);
+
+/**
+ * Copy a range of a rope into a new classic C string.
+ *
+ * @param rope  The rope to read.
+ * @param start The starting index of the range.
+ * @param len   The length of the range, clamped to the end of the rope.
+ * @return A newly allocated cstring, or NULL on failure or if 'start' is out of bounds.
+ */
+cstring fossil_rope_slice(const fossil_rope_t *rope, size_t start, size_t len);
+
+/**
+ * Flatten a rope into a new classic C string.
+ *
+ * Returns a newly allocated cstring holding the whole rope, or NULL on failure.
+ */
+cstring fossil_rope_flatten(const fossil_rope_t *rope);
+
+/**
+ * Start iterating over the chunks of a rope in order.
+ *
+ * The rope must not be modified while the iterator is in use.
+ */
+void fossil_rope_iter_init(fossil_rope_iter_t *iter, const fossil_rope_t *rope);
+
+/**
+ * Get the next chunk of a rope.
+ *
+ * @param iter  The iterator.
+ * @param chunk Receives a pointer to the chunk characters (not NUL-terminated).
+ * @param len   Receives the number of characters in the chunk.
+ * @return A non-zero value if a chunk was returned, or 0 at the end of the rope.
+ */
+int fossil_rope_iter_next(fossil_rope_iter_t *iter, const_cstring *chunk, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_ROPE_H */
@@ -0,0 +1,107 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_RSTR_H
+#define FOSSIL_STRINGS_RSTR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+/*
+ * Reference-counted string type definition.
+ *
+ * An rstring is an immutable NUL-terminated string with a hidden atomic
+ * reference count, so one buffer can be shared between threads instead of
+ * being duplicated. It is usable anywhere a const_cstring is accepted.
+ * Each reference is dropped with fossil_rstr_release; mutators take over the
+ * caller's reference and only copy when the buffer is shared.
+ */
+typedef const cletter* rstring;
+
+/**
+ * Create a reference-counted string from a classic C string.
+ *
+ * Returns a new rstring with a reference count of one, or NULL on failure.
+ */
+rstring fossil_rstr_create(const_cstring str);
+
+/**
+ * Create a reference-counted string from the first 'len' characters of 'str'.
+ *
+ * Returns a new rstring with a reference count of one, or NULL on failure.
+ */
+rstring fossil_rstr_create_len(const_cstring str, size_t len);
+
+/**
+ * Take an additional reference to a reference-counted string.
+ *
+ * Returns 'str' so the call can be used inline. Safe to call from any thread.
+ */
+rstring fossil_rstr_retain(rstring str);
+
+/**
+ * Drop a reference to a reference-counted string.
+ *
+ * The buffer is freed when the last reference is released. Safe to call from any thread.
+ */
+void fossil_rstr_release(rstring str);
+
+/**
+ * Get the length of a reference-counted string.
+ *
+ * Returns the stored length in O(1), or 0 if 'str' is NULL.
+ */
+size_t fossil_rstr_length(rstring str);
+
+/**
+ * Get the current reference count of a reference-counted string.
+ *
+ * The value may change concurrently and is meant for diagnostics.
+ */
+size_t fossil_rstr_refcount(rstring str);
+
+/**
+ * Compare two reference-counted strings.
+ *
+ * Shared buffers compare equal without reading their contents.
+ * Returns 0 if they are equal, a negative value if 'str1' is less than 'str2',
+ * and a positive value if 'str1' is greater than 'str2'.
+ */
+int fossil_rstr_compare(rstring str1, rstring str2);
+
+/**
+ * Append a classic C string to a reference-counted string.
+ *
+ * Takes over the caller's reference to 'str'. The buffer is grown in place
+ * when the caller holds the only reference, otherwise it is copied first.
+ * @return The resulting rstring, or NULL on failure (the caller then keeps its reference to 'str').
+ */
+rstring fossil_rstr_concat(rstring str, const_cstring src);
+
+/**
+ * Reverse a reference-counted string.
+ *
+ * Takes over the caller's reference to 'str'. The characters are reversed in
+ * place when the caller holds the only reference, otherwise it is copied first.
+ * @return The resulting rstring, or NULL on failure (the caller then keeps its reference to 'str').
+ */
+rstring fossil_rstr_reverse(rstring str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_RSTR_H */
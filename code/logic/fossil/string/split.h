@@ -0,0 +1,290 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SPLIT_H
+#define FOSSIL_STRINGS_SPLIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+#include "bstring.h" // For the byte string type definitions
+#include "wstring.h" // For the wide string type definitions
+
+// Split flag: do not yield empty tokens, so runs of delimiters act as one
+#define FOSSIL_SPLIT_SKIP_EMPTY 0x1u
+
+// Split limit: split at every delimiter
+#define FOSSIL_SPLIT_ALL ((size_t)-1)
+
+/*
+ * Split iterator type definitions.
+ *
+ * A split iterator walks the tokens of a string one at a time, finding each
+ * delimiter with the vectorized character search as it goes. It never
+ * allocates and reads the string only once; each token is reported as an
+ * offset and length in code units into the original string, which must
+ * outlive the iterator.
+ *
+ * Without FOSSIL_SPLIT_SKIP_EMPTY a string with n delimiters has n + 1
+ * tokens, as with fossil_cstr_split. After 'max_splits' splits the rest of
+ * the string is yielded as the last token, delimiters and all; with
+ * FOSSIL_SPLIT_SKIP_EMPTY the delimiters in front of it are skipped first.
+ *
+ * The fields are the iterator's state and should not be used directly.
+ */
+typedef struct {
+    size_t offset; // where the token starts, in code units
+    size_t length; // its length, in code units
+} fossil_split_token_t;
+
+typedef struct {
+    const_cstring str;
+    size_t next;
+    size_t splits_left;
+    cletter delimiter;
+    unsigned flags;
+    int done;
+} fossil_cstr_split_iter_t;
+
+typedef struct {
+    const_bstring str;
+    size_t next;
+    size_t splits_left;
+    bletter delimiter;
+    unsigned flags;
+    int done;
+} fossil_bstr_split_iter_t;
+
+typedef struct {
+    const_wstring str;
+    size_t next;
+    size_t splits_left;
+    wletter delimiter;
+    unsigned flags;
+    int done;
+} fossil_wstr_split_iter_t;
+
+/**
+ * Start iterating over the tokens of a classic C string.
+ *
+ * @param iter       The iterator to set up.
+ * @param str        The string to split; a NULL string has no tokens.
+ * @param delimiter  The delimiter character.
+ * @param max_splits The most delimiters to split at, or FOSSIL_SPLIT_ALL.
+ * @param flags      FOSSIL_SPLIT_ flags.
+ */
+void fossil_cstr_split_begin(fossil_cstr_split_iter_t *iter, const_cstring str, cletter delimiter, size_t max_splits,
+                             unsigned flags);
+
+/**
+ * Get the next token of a classic C string.
+ *
+ * Returns 1 and fills 'token', or 0 when there are no more tokens.
+ */
+int fossil_cstr_split_next(fossil_cstr_split_iter_t *iter, fossil_split_token_t *token);
+
+/**
+ * Start iterating over the tokens of a byte string.
+ */
+void fossil_bstr_split_begin(fossil_bstr_split_iter_t *iter, const_bstring str, bletter delimiter, size_t max_splits,
+                             unsigned flags);
+
+/**
+ * Get the next token of a byte string.
+ *
+ * Returns 1 and fills 'token', or 0 when there are no more tokens.
+ */
+int fossil_bstr_split_next(fossil_bstr_split_iter_t *iter, fossil_split_token_t *token);
+
+/**
+ * Start iterating over the tokens of a wide string.
+ */
+void fossil_wstr_split_begin(fossil_wstr_split_iter_t *iter, const_wstring str, wletter delimiter, size_t max_splits,
+                             unsigned flags);
+
+/**
+ * Get the next token of a wide string.
+ *
+ * Returns 1 and fills 'token', or 0 when there are no more tokens.
+ */
+int fossil_wstr_split_next(fossil_wstr_split_iter_t *iter, fossil_split_token_t *token);
+
+/*
+ * Single-block splits.
+ *
+ * These return the same NULL-terminated array as fossil_cstr_split and its
+ * siblings, but the pointers and the tokens they point at share one
+ * allocation: the pointer array, then a copy of the string with each
+ * delimiter turned into a terminator. One release frees it all, so such an
+ * array must be erased with the matching erase_split_block function rather
+ * than erase_splits.
+ */
+
+/**
+ * Split a classic C string by delimiter into a single allocation.
+ *
+ * Returns the NULL-terminated array of tokens, or NULL on failure.
+ */
+cstrings fossil_cstr_split_block(const_cstring str, cletter delimiter);
+
+/**
+ * Split a classic C string into a single allocation using a specific allocator.
+ *
+ * Release the result with fossil_cstr_erase_split_block_with and the same allocator.
+ */
+cstrings fossil_cstr_split_block_with(const fossil_allocator_t *allocator, const_cstring str, cletter delimiter);
+
+/**
+ * Free an array made by fossil_cstr_split_block.
+ */
+void fossil_cstr_erase_split_block(cstrings splits);
+
+/**
+ * Free an array made by fossil_cstr_split_block_with.
+ */
+void fossil_cstr_erase_split_block_with(const fossil_allocator_t *allocator, cstrings splits);
+
+/**
+ * Split a byte string by delimiter into a single allocation.
+ *
+ * Returns the NULL-terminated array of tokens, or NULL on failure.
+ */
+bstrings fossil_bstr_split_block(const_bstring str, bletter delimiter);
+
+/**
+ * Split a byte string into a single allocation using a specific allocator.
+ */
+bstrings fossil_bstr_split_block_with(const fossil_allocator_t *allocator, const_bstring str, bletter delimiter);
+
+/**
+ * Free an array made by fossil_bstr_split_block.
+ */
+void fossil_bstr_erase_split_block(bstrings splits);
+
+/**
+ * Free an array made by fossil_bstr_split_block_with.
+ */
+void fossil_bstr_erase_split_block_with(const fossil_allocator_t *allocator, bstrings splits);
+
+/**
+ * Split a wide string by delimiter into a single allocation.
+ *
+ * Returns the NULL-terminated array of tokens, or NULL on failure.
+ */
+wstrings fossil_wstr_split_block(const_wstring str, wletter delimiter);
+
+/**
+ * Split a wide string into a single allocation using a specific allocator.
+ */
+wstrings fossil_wstr_split_block_with(const fossil_allocator_t *allocator, const_wstring str, wletter delimiter);
+
+/**
+ * Free an array made by fossil_wstr_split_block.
+ */
+void fossil_wstr_erase_split_block(wstrings splits);
+
+/**
+ * Free an array made by fossil_wstr_split_block_with.
+ */
+void fossil_wstr_erase_split_block_with(const fossil_allocator_t *allocator, wstrings splits);
+
+/*
+ * Parallel splits.
+ *
+ * A parallel split cuts the string into ranges, finds the delimiters of
+ * each range on its own thread, and then joins the token that straddles
+ * each range boundary in one short pass over the ranges. The tokens come
+ * back as offsets and lengths into the string, as from the iterators, so
+ * nothing is copied. 'length' characters are split, so the string need not
+ * be terminated and may hold zero characters; n delimiters give n + 1
+ * tokens.
+ *
+ * The work runs on the library's own threads, or on a caller's scheduler
+ * through a thread pool hook.
+ */
+
+// One piece of parallel work; 'task' is its number, from 0
+typedef void (*fossil_parallel_task_t)(void *context, size_t task);
+
+/*
+ * A thread pool hook. 'run' must call task(context, t) once for every t
+ * below 'tasks', on any threads and in any order, and return once they have
+ * all returned. 'pool' is passed to it unchanged.
+ */
+typedef struct {
+    void (*run)(void *pool, size_t tasks, fossil_parallel_task_t task, void *context);
+    void *pool;
+} fossil_thread_pool_t;
+
+// The tokens of a parallel split, kept per range
+typedef struct fossil_split_chunks fossil_split_chunks_t;
+
+/**
+ * Split a classic C string at every delimiter on several threads.
+ *
+ * @param str       The string to split.
+ * @param length    The number of characters to split.
+ * @param delimiter The delimiter character.
+ * @param threads   The most threads to use, or 0 for one per processor;
+ *                  with a pool it only sets how finely the work is cut.
+ * @param pool      The thread pool to run on, or NULL for the library's own threads.
+ * @param count     Set to the number of tokens.
+ * @return The tokens in order, to be freed with fossil_split_erase_tokens, or NULL on failure.
+ */
+fossil_split_token_t *fossil_cstr_split_parallel(const_cstring str, size_t length, cletter delimiter, size_t threads,
+                                                 const fossil_thread_pool_t *pool, size_t *count);
+
+/**
+ * Free the tokens of fossil_cstr_split_parallel.
+ */
+void fossil_split_erase_tokens(fossil_split_token_t *tokens);
+
+/**
+ * Split a classic C string on several threads, keeping each range's tokens apart.
+ *
+ * This reads the string once where fossil_cstr_split_parallel reads it twice
+ * to lay out one array, and suits callers that hand each chunk on to its
+ * own consumer. The chunks taken in order hold every token in order.
+ *
+ * @return The chunks, to be freed with fossil_split_chunks_erase, or NULL on failure.
+ */
+fossil_split_chunks_t *fossil_cstr_split_parallel_chunks(const_cstring str, size_t length, cletter delimiter,
+                                                         size_t threads, const fossil_thread_pool_t *pool);
+
+/**
+ * Get the number of chunks in a parallel split.
+ */
+size_t fossil_split_chunks_count(const fossil_split_chunks_t *chunks);
+
+/**
+ * Get the tokens of one chunk of a parallel split; a chunk may hold none.
+ *
+ * @param chunks The chunks.
+ * @param chunk  Which chunk, from 0.
+ * @param count  Set to the number of tokens in it.
+ * @return The tokens, owned by 'chunks', or NULL if there are none.
+ */
+const fossil_split_token_t *fossil_split_chunks_get(const fossil_split_chunks_t *chunks, size_t chunk, size_t *count);
+
+/**
+ * Erase (free) the chunks of a parallel split.
+ */
+void fossil_split_chunks_erase(fossil_split_chunks_t *chunks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_SPLIT_H */
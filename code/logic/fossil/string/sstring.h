@@ -0,0 +1,254 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SSTR_H
+#define FOSSIL_STRINGS_SSTR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+// Number of characters that fit in a small string before it spills to the heap
+#define FOSSIL_SSTR_INLINE_CAPACITY 23
+
+/*
+ * Small string type definition.
+ *
+ * An sstring is a value type that keeps short strings in an inline buffer and
+ * only calls the allocator once its contents grow past
+ * FOSSIL_SSTR_INLINE_CAPACITY characters. It can live on the stack or inside
+ * another struct and may be copied with memcpy as long as only one copy is
+ * erased. Always initialize it with fossil_sstr_init before use.
+ */
+typedef struct {
+    size_t length;   // number of characters, excluding the NUL
+    size_t capacity; // characters available without reallocating
+    cletter *heap;   // spilled buffer, or NULL while the inline buffer is used
+    cletter inline_data[FOSSIL_SSTR_INLINE_CAPACITY + 1];
+} sstring;
+
+/**
+ * Initialize a small string to the empty string.
+ *
+ * @param str The small string to initialize.
+ */
+void fossil_sstr_init(sstring *str);
+
+/**
+ * Erase a small string.
+ *
+ * Frees the spilled heap buffer, if any, and resets 'str' to the empty string.
+ */
+void fossil_sstr_erase(sstring *str);
+
+/**
+ * Get the character data of a small string.
+ *
+ * Returns a NUL-terminated string valid until 'str' is next modified or erased.
+ */
+const_cstring fossil_sstr_data(const sstring *str);
+
+/**
+ * Get the length of a small string.
+ *
+ * Returns the stored length in O(1), or 0 if 'str' is NULL.
+ */
+size_t fossil_sstr_length(const sstring *str);
+
+/**
+ * Check whether a small string still uses its inline buffer.
+ *
+ * Returns a non-zero value if no heap memory is owned by 'str'.
+ */
+int fossil_sstr_is_inline(const sstring *str);
+
+/**
+ * Release ownership of the contents as a classic C string.
+ *
+ * Returns a heap-allocated copy of the contents (reusing the spilled buffer
+ * when there is one) that must be freed with fossil_cstr_erase. 'str' is left
+ * empty. Returns NULL on failure.
+ */
+cstring fossil_sstr_detach(sstring *str);
+
+/**
+ * Replace the contents of a small string with the first 'len' characters of 'src'.
+ *
+ * @param str The small string to fill.
+ * @param src The character data to copy.
+ * @param len The number of characters to copy.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_assign_len(sstring *str, const_cstring src, size_t len);
+
+/**
+ * Replace the contents of a small string with a copy of a classic C string.
+ *
+ * This is the allocation-free counterpart of fossil_cstr_create.
+ * Returns the character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_create(sstring *str, const_cstring src);
+
+/**
+ * Append a classic C string to a small string.
+ *
+ * Returns the character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_concat(sstring *str, const_cstring src);
+
+/**
+ * Format a string into a small string. The format and its arguments may
+ * point into 'str' itself.
+ *
+ * @param str    The small string to fill.
+ * @param format The format string.
+ * @param ... Additional arguments to format.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format(sstring *str, const_cstring format, ...);
+
+/**
+ * Format a string into a small string using a va_list. The format and its
+ * arguments may point into 'str' itself.
+ *
+ * @param str    The small string to fill.
+ * @param format The format string.
+ * @param args   The arguments to format.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_vformat(sstring *str, const_cstring format, va_list args);
+
+/**
+ * Format a phone number string into a small string.
+ *
+ * @param str   The small string to fill.
+ * @param phone The phone number string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_phone(sstring *str, const_cstring phone);
+
+/**
+ * Format a date string into a small string.
+ *
+ * @param str  The small string to fill.
+ * @param date The date string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_date(sstring *str, const_cstring date);
+
+/**
+ * Format a time string into a small string.
+ *
+ * @param str  The small string to fill.
+ * @param time The time string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_time(sstring *str, const_cstring time);
+
+/**
+ * Format a currency string into a small string.
+ *
+ * @param str      The small string to fill.
+ * @param currency The currency string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_currency(sstring *str, const_cstring currency);
+
+/**
+ * Format a percentage string into a small string.
+ *
+ * @param str        The small string to fill.
+ * @param percentage The percentage string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_percentage(sstring *str, const_cstring percentage);
+
+/**
+ * Format a postal code string into a small string.
+ *
+ * @param str         The small string to fill.
+ * @param postal_code The postal code string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_postal_code(sstring *str, const_cstring postal_code);
+
+/**
+ * Format a SSN (Social Security Number) string into a small string.
+ *
+ * @param str The small string to fill.
+ * @param ssn The SSN string.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_format_ssn(sstring *str, const_cstring ssn);
+
+/**
+ * Convert integer to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The integer to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_int(sstring *str, int num);
+
+/**
+ * Convert long to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The long integer to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_long(sstring *str, long num);
+
+/**
+ * Convert long long to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The long long integer to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_llong(sstring *str, long long num);
+
+/**
+ * Convert unsigned long to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The unsigned long integer to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_ulong(sstring *str, unsigned long num);
+
+/**
+ * Convert unsigned long long to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The unsigned long long integer to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_ullong(sstring *str, unsigned long long num);
+
+/**
+ * Convert a double to a small string.
+ *
+ * @param str The small string to fill.
+ * @param num The double number to convert.
+ * @return The character data of 'str', or NULL if an error occurred.
+ */
+const_cstring fossil_sstr_from_double(sstring *str, double num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_SSTR_H */
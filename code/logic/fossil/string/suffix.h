@@ -0,0 +1,122 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SUFFIX_H
+#define FOSSIL_STRINGS_SUFFIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cstring.h" // For the classic C string type definitions
+
+/*
+ * Suffix array type definition.
+ *
+ * A suffix array lists the offsets of every suffix of a text in sorted
+ * order, so all occurrences of a pattern sit in one run that two binary
+ * searches find in O(m log n) time for a pattern of m bytes, however
+ * large the text. Alongside it the index keeps the LCP array: the length
+ * of the prefix each suffix shares with the one before it.
+ *
+ * The suffix array is built with SA-IS in linear time. The LCP array is
+ * then built in parallel: the text is cut into ranges and each thread
+ * works out the shared prefixes of the suffixes starting in its range.
+ * The index takes about 9 bytes per text byte on 64-bit platforms.
+ *
+ * The index refers to the text rather than copying it, so the text must
+ * stay unchanged and alive for as long as the index is used. It never
+ * changes after creation, so any number of threads may query it at once.
+ * An index saved to a file can be loaded against the same text later
+ * without building it again.
+ */
+typedef struct fossil_suffix fossil_suffix_t;
+
+/**
+ * Build the suffix and LCP arrays of a classic C string.
+ *
+ * @param text    The text to index; it must outlive the index.
+ * @param threads The most threads to build with, or 0 for one per processor.
+ * @return The new index, or NULL on failure.
+ */
+fossil_suffix_t *fossil_suffix_create(const_cstring text, size_t threads);
+
+/**
+ * Erase (free) a suffix array index. The text is left alone.
+ */
+void fossil_suffix_erase(fossil_suffix_t *index);
+
+/**
+ * Get the length of the indexed text.
+ */
+size_t fossil_suffix_length(const fossil_suffix_t *index);
+
+/**
+ * Get the offset of the suffix at a rank in sorted order.
+ *
+ * Returns the offset, or 0 if 'rank' is out of range.
+ */
+size_t fossil_suffix_at(const fossil_suffix_t *index, size_t rank);
+
+/**
+ * Get the length of the prefix the suffix at a rank shares with the one
+ * ranked just before it.
+ *
+ * Returns the length, or 0 for rank 0 or a rank out of range.
+ */
+size_t fossil_suffix_lcp(const fossil_suffix_t *index, size_t rank);
+
+/**
+ * Count the occurrences of a pattern in the indexed text. An empty
+ * pattern occurs at every offset.
+ */
+size_t fossil_suffix_count(const fossil_suffix_t *index, const_cstring pattern);
+
+/**
+ * Find where a pattern occurs in the indexed text.
+ *
+ * @param index    The suffix array index.
+ * @param pattern  The text to look for.
+ * @param offsets  Receives occurrence offsets in ascending order; may be NULL.
+ *                 When they do not all fit, which ones are stored is unspecified.
+ * @param capacity The number of offsets that fit in 'offsets'.
+ * @return The number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_suffix_locate(const fossil_suffix_t *index, const_cstring pattern, size_t *offsets, size_t capacity);
+
+/**
+ * Save a suffix array index to a file. The text itself is not saved.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+int fossil_suffix_save(const fossil_suffix_t *index, const char *path);
+
+/**
+ * Load an index saved by fossil_suffix_save for the same text.
+ *
+ * The text's length and a sample of its bytes are checked against the
+ * file, and every stored offset is checked to lie within the text.
+ *
+ * @param path The file to read.
+ * @param text The text the index was built from; it must outlive the index.
+ * @return The loaded index, or NULL if the file cannot be read, is not a
+ *         saved index, was saved on a platform of different byte order, or
+ *         does not match the text.
+ */
+fossil_suffix_t *fossil_suffix_load(const char *path, const_cstring text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOSSIL_STRINGS_SUFFIX_H */
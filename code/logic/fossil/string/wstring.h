@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include "wletter.h" // For the bletter type definition
+#include "alloc.h"   // For the allocator hooks
 
 typedef wletter * wstring;             // cstring type
 typedef wletter ** wstrings;           // cstring array
@@ -32,6 +33,15 @@ typedef wletter ** const_wstrings;     // constent wstring array
  */
 wstring fossil_wstr_create(const_wstring str);
 
+/**
+ * Create a copy of a wide string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str       The string to copy.
+ * @return The copy, to be erased with fossil_wstr_erase_with and the same allocator.
+ */
+wstring fossil_wstr_create_with(const fossil_allocator_t *allocator, const_wstring str);
+
 /**
  * Erase (free) a C string.
  * 
@@ -39,6 +49,11 @@ wstring fossil_wstr_create(const_wstring str);
  */
 void fossil_wstr_erase(wstring str);
 
+/**
+ * Erase (free) a wide string created with a specific allocator.
+ */
+void fossil_wstr_erase_with(const fossil_allocator_t *allocator, wstring str);
+
 /**
  * Get the length of a C string.
  * 
@@ -55,6 +70,16 @@ size_t fossil_wstr_length(const_wstring str);
  */
 wstring fossil_wstr_format(const_wstring format, ...);
 
+/**
+ * Format a wide string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param format The format string.
+ * @param ... Additional arguments to format.
+ * @return The formatted wide string, or NULL if an error occurred.
+ */
+wstring fossil_wstr_format_with(const fossil_allocator_t *allocator, const_wstring format, ...);
+
 /**
  * Format a phone number wide string.
  * 
@@ -119,6 +144,45 @@ wstring fossil_wstr_format_ssn(const_wstring ssn);
  */
 int fossil_wstr_compare(const_wstring str1, const_wstring str2);
 
+/**
+ * Compare two wide strings ignoring case.
+ * 
+ * Letters compare equal in either case: ASCII
+ * is folded in vector lanes and other characters through towlower.
+ * Returns 0 if they are equal, a negative value if 'str1' sorts first, and a positive value otherwise.
+ */
+int fossil_wstr_icompare(const_wstring str1, const_wstring str2);
+
+/**
+ * Check whether two wide strings are equal ignoring case.
+ * 
+ * Returns 1 if they are equal, 0 otherwise.
+ */
+int fossil_wstr_iequals(const_wstring str1, const_wstring str2);
+
+/**
+ * Check whether a wide string starts with a prefix ignoring case.
+ * 
+ * Returns 1 if 'str' starts with 'prefix', 0 otherwise.
+ */
+int fossil_wstr_istarts_with(const_wstring str, const_wstring prefix);
+
+/**
+ * Find a substring in a wide string ignoring case.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in linear time.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_wstring fossil_wstr_ifind_str(const_wstring str, const_wstring needle);
+
+/**
+ * Hash a wide string ignoring case.
+ * 
+ * Strings that are equal under fossil_wstr_iequals hash alike, so this
+ * suits case-insensitive hash tables.
+ */
+uint64_t fossil_wstr_ihash(const_wstring str);
+
 /**
  * Copy a classic C string.
  * 
@@ -143,6 +207,81 @@ wstring fossil_wstr_concat(wstring dest, const_wstring src);
  */
 const_wstring fossil_wstr_find(const_wstring str, wletter ch);
 
+/**
+ * Find the last occurrence of a character in a wide string.
+ * 
+ * Finds the last occurrence of 'ch' in 'str'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_wstring fossil_wstr_rfind(const_wstring str, wletter ch);
+
+/**
+ * Find the first character of a wide string that belongs to a set.
+ * 
+ * Finds the first character of 'str' that also appears in 'set'.
+ * Returns a pointer to the found character or NULL if not found.
+ */
+const_wstring fossil_wstr_find_any(const_wstring str, const_wstring set);
+
+/**
+ * Count the occurrences of a character in a wide string.
+ * 
+ * Returns the number of times 'ch' appears in 'str'.
+ */
+size_t fossil_wstr_count(const_wstring str, wletter ch);
+
+/**
+ * Find a substring in a wide string.
+ * 
+ * Finds the first occurrence of 'needle' in 'str' in time linear in their
+ * lengths, whatever the input. An empty needle matches at the start.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_wstring fossil_wstr_find_str(const_wstring str, const_wstring needle);
+
+/**
+ * Find the last occurrence of a substring in a wide string.
+ * 
+ * Finds the last occurrence of 'needle' in 'str' in linear time. An empty
+ * needle matches at the terminator.
+ * Returns a pointer to the match or NULL if not found.
+ */
+const_wstring fossil_wstr_rfind_str(const_wstring str, const_wstring needle);
+
+/**
+ * Check whether a wide string contains a substring.
+ * 
+ * Returns 1 if 'needle' occurs in 'str', 0 otherwise.
+ */
+int fossil_wstr_contains(const_wstring str, const_wstring needle);
+
+/**
+ * Find every occurrence of a character in a wide string.
+ * 
+ * Stores the character offset of each 'ch' in 'str' into 'offsets', up to
+ * 'capacity' of them, and keeps counting past that; 'offsets' may be NULL
+ * when 'capacity' is 0.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_wstr_find_all(const_wstring str, wletter ch, size_t *offsets, size_t capacity);
+
+/**
+ * Find every occurrence of a substring in a wide string.
+ * 
+ * Stores the character offset of each non-overlapping 'needle' in 'str', left
+ * to right, into 'offsets' up to 'capacity' of them.
+ * Returns the total number of occurrences, which may exceed 'capacity'.
+ */
+size_t fossil_wstr_find_all_str(const_wstring str, const_wstring needle, size_t *offsets, size_t capacity);
+
+/**
+ * Count the occurrences of a substring in a wide string.
+ * 
+ * Returns the number of non-overlapping times 'needle' appears in 'str',
+ * or 0 for an empty needle.
+ */
+size_t fossil_wstr_count_str(const_wstring str, const_wstring needle);
+
 /**
  * Reverse a classic C string.
  * 
@@ -159,6 +298,13 @@ const_wstring fossil_wstr_reverse(const_wstring str);
  */
 wstrings fossil_wstr_split(const_wstring str, wletter delimiter);
 
+/**
+ * Split a wide string by delimiter using a specific allocator.
+ * 
+ * Release the result with fossil_wstr_erase_splits_with and the same allocator.
+ */
+wstrings fossil_wstr_split_with(const fossil_allocator_t *allocator, const_wstring str, wletter delimiter);
+
 /**
  * Duplicate a classic C string.
  * 
@@ -179,6 +325,17 @@ wstring fossil_wstr_strdup(const_wstring str);
  */
 wstring fossil_wstr_substr(const_wstring str, size_t start, size_t len);
 
+/**
+ * Extracts a substring from a wide string using a specific allocator.
+ * 
+ * @param allocator The allocator to use, or NULL for the global allocator.
+ * @param str   The wide string from which to extract the substring.
+ * @param start The starting index of the substring.
+ * @param len   The length of the substring to extract.
+ * @return      The substring, or NULL on failure or invalid parameters.
+ */
+wstring fossil_wstr_substr_with(const fossil_allocator_t *allocator, const_wstring str, size_t start, size_t len);
+
 /**
  * Frees the memory allocated for an array of C strings and the strings it contains.
  * 
@@ -189,6 +346,11 @@ wstring fossil_wstr_substr(const_wstring str, size_t start, size_t len);
  */
 void fossil_wstr_erase_splits(wstrings splits);
 
+/**
+ * Frees an array of wide strings produced with a specific allocator.
+ */
+void fossil_wstr_erase_splits_with(const fossil_allocator_t *allocator, wstrings splits);
+
 /**
  * Convert integer to wide string.
  * 
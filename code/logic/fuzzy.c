@@ -0,0 +1,365 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/fuzzy.h"
+#include "edit.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The edit table has a row for each pattern unit and a column for each
+ * text unit. Myers' algorithm keeps only the vertical differences between
+ * neighbouring cells of the current column, as two bit vectors (+1 and -1)
+ * split into 64-row blocks, and tracks the bottom row's score. Each text
+ * unit advances every block by one column. The top row is 0 everywhere
+ * when searching (a match may start anywhere) and grows by one per column
+ * when comparing whole strings.
+ */
+
+static uint32_t _edit_at(const void *data, size_t index, size_t unit) {
+    switch (unit) {
+        case 1: return ((const unsigned char *)data)[index];
+        case 2: return ((const uint16_t *)data)[index];
+        default: return ((const uint32_t *)data)[index];
+    }
+}
+
+static int _edit_unit_order(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static size_t _edit_wide_index(const _fossil_edit_pattern *p, uint32_t c) {
+    size_t lo = 0, hi = p->wide_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p->wide[mid] < c) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < p->wide_count && p->wide[lo] == c ? lo : SIZE_MAX;
+}
+
+int _fossil_edit_pattern_init(_fossil_edit_pattern *p, const void *pattern, size_t count, size_t unit, int reverse) {
+    p->count = count;
+    p->unit = unit;
+    p->blocks = (count + 63) / 64;
+    p->last = (uint64_t)1 << ((count + 63) % 64);
+    p->heap = NULL;
+    if (count <= _FOSSIL_EDIT_SMALL) {
+        p->table = p->small_table;
+        p->wide = p->small_wide;
+        p->wide_masks = p->small_masks;
+        p->pv = &p->small_pv;
+        p->mv = &p->small_mv;
+    } else {
+        // 256 table rows plus up to 'count' wide rows of 'blocks' masks, and the two state vectors
+        if (p->blocks > SIZE_MAX / sizeof(uint64_t) / (256 + count + 3)) {
+            return 0;
+        }
+        size_t masks = (256 + count + 2) * p->blocks;
+        p->heap = malloc(masks * sizeof(uint64_t) + count * sizeof(uint32_t));
+        if (!p->heap) {
+            return 0;
+        }
+        p->table = p->heap;
+        p->wide_masks = p->table + 256 * p->blocks;
+        p->pv = p->wide_masks + count * p->blocks;
+        p->mv = p->pv + p->blocks;
+        p->wide = (uint32_t *)(p->mv + p->blocks);
+    }
+    memset(p->table, 0, 256 * p->blocks * sizeof(uint64_t));
+
+    p->wide_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t c = _edit_at(pattern, i, unit);
+        if (c >= 256) {
+            p->wide[p->wide_count++] = c;
+        }
+    }
+    if (p->wide_count > 0) {
+        qsort(p->wide, p->wide_count, sizeof(uint32_t), _edit_unit_order);
+        size_t unique = 1;
+        for (size_t i = 1; i < p->wide_count; i++) {
+            if (p->wide[i] != p->wide[unique - 1]) {
+                p->wide[unique++] = p->wide[i];
+            }
+        }
+        p->wide_count = unique;
+        memset(p->wide_masks, 0, unique * p->blocks * sizeof(uint64_t));
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t c = _edit_at(pattern, reverse ? count - 1 - i : i, unit);
+        uint64_t *masks = c < 256 ? p->table + c * p->blocks : p->wide_masks + _edit_wide_index(p, c) * p->blocks;
+        masks[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+    for (size_t b = 0; b < p->blocks; b++) {
+        p->pv[b] = ~(uint64_t)0;
+        p->mv[b] = 0;
+    }
+    return 1;
+}
+
+void _fossil_edit_pattern_release(_fossil_edit_pattern *p) {
+    free(p->heap);
+}
+
+/*
+ * Advance every block by the column for text unit 'c'. 'top' is the
+ * difference along the top row: 0 when searching, 1 when comparing whole
+ * strings. Returns the difference along the bottom row.
+ */
+static int _edit_step(_fossil_edit_pattern *p, uint32_t c, int top) {
+    const uint64_t *eqs = NULL;
+    if (c < 256) {
+        eqs = p->table + c * p->blocks;
+    } else {
+        size_t k = _edit_wide_index(p, c);
+        eqs = k != SIZE_MAX ? p->wide_masks + k * p->blocks : NULL;
+    }
+
+    int carry = top;
+    for (size_t b = 0; b < p->blocks; b++) {
+        uint64_t eq = eqs ? eqs[b] : 0;
+        uint64_t pv = p->pv[b], mv = p->mv[b];
+        uint64_t xv = eq | mv;
+        if (carry < 0) {
+            eq |= 1;
+        }
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        uint64_t high = b + 1 == p->blocks ? p->last : (uint64_t)1 << 63;
+        int out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+        ph <<= 1;
+        mh <<= 1;
+        if (carry < 0) {
+            mh |= 1;
+        } else if (carry > 0) {
+            ph |= 1;
+        }
+        p->pv[b] = mh | ~(xv | ph);
+        p->mv[b] = ph & xv;
+        carry = out;
+    }
+    return carry;
+}
+
+size_t _fossil_edit_distance(const void *a, size_t a_count, const void *b, size_t b_count, size_t unit, size_t max) {
+    // A shared prefix and suffix never change the distance
+    size_t skip = 0;
+    while (skip < a_count && skip < b_count && _edit_at(a, skip, unit) == _edit_at(b, skip, unit)) {
+        skip++;
+    }
+    a = (const unsigned char *)a + skip * unit;
+    b = (const unsigned char *)b + skip * unit;
+    a_count -= skip;
+    b_count -= skip;
+    while (a_count > 0 && b_count > 0 && _edit_at(a, a_count - 1, unit) == _edit_at(b, b_count - 1, unit)) {
+        a_count--;
+        b_count--;
+    }
+
+    // The shorter string is the pattern, so the fewest blocks are needed
+    if (a_count > b_count) {
+        const void *t = a;
+        a = b;
+        b = t;
+        size_t n = a_count;
+        a_count = b_count;
+        b_count = n;
+    }
+    if (b_count - a_count > max) {
+        return max + 1;
+    }
+    if (a_count == 0) {
+        return b_count;
+    }
+
+    _fossil_edit_pattern p;
+    if (!_fossil_edit_pattern_init(&p, a, a_count, unit, 0)) {
+        return SIZE_MAX;
+    }
+    size_t distance = _fossil_edit_pattern_distance(&p, b, b_count, max);
+    _fossil_edit_pattern_release(&p);
+    return distance;
+}
+
+size_t _fossil_edit_pattern_distance(_fossil_edit_pattern *p, const void *text, size_t count, size_t max) {
+    size_t gap = count > p->count ? count - p->count : p->count - count;
+    if (gap > max) {
+        return max + 1;
+    }
+    if (p->count == 0) {
+        return count;
+    }
+    size_t score = p->count;
+    if (p->blocks == 1) {
+        // One word holds the whole column, so keep it in registers
+        uint64_t pv = ~(uint64_t)0, mv = 0;
+        for (size_t j = 0; j < count; j++) {
+            uint32_t c = _edit_at(text, j, p->unit);
+            uint64_t eq = 0;
+            if (c < 256) {
+                eq = p->table[c];
+            } else {
+                size_t k = _edit_wide_index(p, c);
+                eq = k != SIZE_MAX ? p->wide_masks[k] : 0;
+            }
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            score += (ph & p->last) != 0;
+            score -= (mh & p->last) != 0;
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            if (score > max && score - max > count - j - 1) {
+                return max + 1;
+            }
+        }
+        return score;
+    }
+
+    for (size_t b = 0; b < p->blocks; b++) {
+        p->pv[b] = ~(uint64_t)0;
+        p->mv[b] = 0;
+    }
+    for (size_t j = 0; j < count; j++) {
+        score += (size_t)(ptrdiff_t)_edit_step(p, _edit_at(text, j, p->unit), 1);
+        // Each remaining column lowers the score by at most one
+        if (score > max && score - max > count - j - 1) {
+            return max + 1;
+        }
+    }
+    return score;
+}
+
+/*
+ * Start of the first approximate match of 'needle' in 'str', storing its
+ * length and distance, or _FOSSIL_SIMD_NONE. SIZE_MAX - 1 if memory runs out.
+ */
+static size_t _edit_find(const void *str, size_t count, const void *needle, size_t needle_count, size_t unit,
+                         size_t max, size_t *length, size_t *distance) {
+    if (needle_count <= max) {
+        *length = 0;
+        *distance = needle_count;
+        return 0;
+    }
+
+    // Forward: the score of each column is the best match ending there
+    _fossil_edit_pattern p;
+    if (!_fossil_edit_pattern_init(&p, needle, needle_count, unit, 0)) {
+        return SIZE_MAX - 1;
+    }
+    size_t score = needle_count, best = SIZE_MAX, end = 0;
+    for (size_t j = 0; j < count && best != 0; j++) {
+        score += (size_t)(ptrdiff_t)_edit_step(&p, _edit_at(str, j, unit), 0);
+        if (score <= max) {
+            if (score <= best) {
+                best = score;
+                end = j + 1;
+            }
+        } else if (best != SIZE_MAX) {
+            break; // the first run of close ends is over
+        }
+    }
+    _fossil_edit_pattern_release(&p);
+    if (best == SIZE_MAX) {
+        return _FOSSIL_SIMD_NONE;
+    }
+
+    // Backward from the end, comparing the reversed needle with ever longer suffixes
+    if (!_fossil_edit_pattern_init(&p, needle, needle_count, unit, 1)) {
+        return SIZE_MAX - 1;
+    }
+    size_t reach = needle_count + best, start = end;
+    size_t stop = end > reach ? end - reach : 0;
+    score = needle_count;
+    for (size_t s = end; s-- > stop;) {
+        score += (size_t)(ptrdiff_t)_edit_step(&p, _edit_at(str, s, unit), 1);
+        if (score == best) {
+            start = s;
+        }
+    }
+    _fossil_edit_pattern_release(&p);
+    *length = end - start;
+    *distance = best;
+    return start;
+}
+
+// ---- public API ----
+
+static size_t _edit_within(const void *a, const void *b, size_t unit, size_t max) {
+    if (!a || !b) {
+        return FOSSIL_FUZZY_ERROR;
+    }
+    if (max > SIZE_MAX - 2) {
+        max = SIZE_MAX - 2;
+    }
+    return _fossil_edit_distance(a, _fossil_simd_length(a, unit), b, _fossil_simd_length(b, unit), unit, max);
+}
+
+static const void *_edit_fuzzy_find(const void *str, const void *needle, size_t unit, size_t max, size_t *length,
+                                    size_t *distance) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t found_length, found_distance;
+    size_t at = _edit_find(str, _fossil_simd_length(str, unit), needle, _fossil_simd_length(needle, unit), unit, max,
+                           &found_length, &found_distance);
+    if (at == _FOSSIL_SIMD_NONE || at == SIZE_MAX - 1) {
+        return NULL;
+    }
+    if (length) {
+        *length = found_length;
+    }
+    if (distance) {
+        *distance = found_distance;
+    }
+    return (const unsigned char *)str + at * unit;
+}
+
+size_t fossil_cstr_distance(const_cstring a, const_cstring b) {
+    return _edit_within(a, b, sizeof(cletter), SIZE_MAX);
+}
+
+size_t fossil_cstr_distance_within(const_cstring a, const_cstring b, size_t max) {
+    return _edit_within(a, b, sizeof(cletter), max);
+}
+
+const_cstring fossil_cstr_fuzzy_find(const_cstring str, const_cstring needle, size_t max, size_t *length,
+                                     size_t *distance) {
+    return _edit_fuzzy_find(str, needle, sizeof(cletter), max, length, distance);
+}
+
+size_t fossil_wstr_distance(const_wstring a, const_wstring b) {
+    return _edit_within(a, b, sizeof(wletter), SIZE_MAX);
+}
+
+size_t fossil_wstr_distance_within(const_wstring a, const_wstring b, size_t max) {
+    return _edit_within(a, b, sizeof(wletter), max);
+}
+
+const_wstring fossil_wstr_fuzzy_find(const_wstring str, const_wstring needle, size_t max, size_t *length,
+                                     size_t *distance) {
+    return _edit_fuzzy_find(str, needle, sizeof(wletter), max, length, distance);
+}
@@ -0,0 +1,693 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/glob.h"
+#include "search.h"
+#include "fold.h"
+#include "grow.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A glob is compiled into parts (the text between '/' in pathname mode,
+ * otherwise the whole pattern), each part into pieces (the runs between
+ * stars) and each piece into atoms that match one character. Because a
+ * star can absorb anything, placing every piece at its leftmost possible
+ * position never loses a match, so no choice is ever revisited: the first
+ * and last pieces are pinned to the ends of the part and the ones between
+ * are searched for in order.
+ */
+
+#define GLOB_SHIFT_AND 64 // longest wildcard piece searched bit-parallel
+#define GLOB_BUCKETS 256  // glob set buckets, keyed by the low byte of the first character
+
+enum { GLOB_LITERAL, GLOB_ANY, GLOB_SET };
+
+typedef struct {
+    uint32_t lo;
+    uint32_t hi;
+} _glob_range;
+
+typedef struct {
+    uint32_t kind;
+    uint32_t value;  // LITERAL: the character, folded when ignoring case; SET: first range
+    uint32_t count;  // SET: number of ranges
+    uint32_t negate; // SET: matches the characters outside the ranges
+} _glob_atom;
+
+typedef struct {
+    size_t first; // atoms
+    size_t count;
+    void *units;  // an all-literal piece, found through 'plan'
+    _fossil_search_plan plan;
+    uint64_t *masks; // Shift-And masks for characters below 256
+} _glob_piece;
+
+typedef struct {
+    size_t first; // pieces
+    size_t count;
+    size_t fixed; // characters the pieces take
+    int star;
+    int lead;     // starts with a star
+    int trail;    // ends with a star
+} _glob_part;
+
+typedef struct {
+    size_t unit;
+    int fold;
+    int pathname;
+    int exact;         // no star anywhere, so the length is fixed
+    size_t min_length;
+    _glob_atom *atoms;
+    size_t atom_count;
+    size_t atom_capacity;
+    _glob_range *ranges;
+    size_t range_count;
+    size_t range_capacity;
+    _glob_piece *pieces;
+    size_t piece_count;
+    size_t piece_capacity;
+    _glob_part *parts;
+    size_t part_count;
+    size_t part_capacity;
+} _glob;
+
+/*
+ * The ids of the globs whose first character falls in each bucket, then
+ * the globs that may start with anything in the last bucket. Each run is
+ * ascending.
+ */
+typedef struct {
+    _glob *globs;
+    size_t count;
+    uint32_t offsets[GLOB_BUCKETS + 2];
+    uint32_t *ids;
+} _globset;
+
+struct fossil_cstr_glob {
+    _glob glob;
+};
+
+struct fossil_wstr_glob {
+    _glob glob;
+};
+
+struct fossil_cstr_globset {
+    _globset set;
+};
+
+struct fossil_wstr_globset {
+    _globset set;
+};
+
+static uint32_t _glob_at(const void *data, size_t index, size_t unit) {
+    switch (unit) {
+        case 1: return ((const unsigned char *)data)[index];
+        case 2: return ((const uint16_t *)data)[index];
+        default: return ((const uint32_t *)data)[index];
+    }
+}
+
+static int _glob_range_order(const void *a, const void *b) {
+    const _glob_range *x = a, *y = b;
+    return (x->lo > y->lo) - (x->lo < y->lo);
+}
+
+static int _glob_atom_matches(const _glob *glob, const _glob_atom *atom, uint32_t c) {
+    if (atom->kind == GLOB_LITERAL) {
+        return (glob->fold ? _fossil_fold_unit(c, 0) : c) == atom->value;
+    }
+    if (atom->kind == GLOB_ANY) {
+        return 1;
+    }
+    const _glob_range *ranges = glob->ranges + atom->value;
+    size_t lo = 0, hi = atom->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ranges[mid].hi < c) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    int in = lo < atom->count && ranges[lo].lo <= c;
+    return in != (int)atom->negate;
+}
+
+// ---- compiling ----
+
+static int _glob_add_range(_glob *glob, uint32_t lo, uint32_t hi) {
+    _glob_range *ranges = _fossil_grow(glob->ranges, &glob->range_capacity, glob->range_count, sizeof(*ranges), 8);
+    if (!ranges) {
+        return 0;
+    }
+    glob->ranges = ranges;
+    glob->ranges[glob->range_count].lo = lo;
+    glob->ranges[glob->range_count].hi = hi;
+    glob->range_count++;
+    return 1;
+}
+
+static int _glob_add_atom(_glob *glob, uint32_t kind, uint32_t value, uint32_t count, uint32_t negate) {
+    _glob_atom *atoms = _fossil_grow(glob->atoms, &glob->atom_capacity, glob->atom_count, sizeof(*atoms), 8);
+    if (!atoms) {
+        return 0;
+    }
+    glob->atoms = atoms;
+    _glob_atom *atom = &glob->atoms[glob->atom_count++];
+    atom->kind = kind;
+    atom->value = kind == GLOB_LITERAL && glob->fold ? _fossil_fold_unit(value, 0) : value;
+    atom->count = count;
+    atom->negate = negate;
+    return 1;
+}
+
+/*
+ * Parse the bracket set opening at 'at' into a SET atom. Returns the index
+ * just past it, 0 if the set is never closed (the '[' is then literal),
+ * or SIZE_MAX if memory runs out.
+ */
+static size_t _glob_parse_set(_glob *glob, const void *pattern, size_t count, size_t at) {
+    size_t unit = glob->unit;
+    size_t first = glob->range_count;
+    size_t i = at + 1;
+    int negate = i < count && (_glob_at(pattern, i, unit) == '!' || _glob_at(pattern, i, unit) == '^');
+    i += negate;
+
+    for (int leading = 1;; leading = 0) {
+        if (i >= count) {
+            glob->range_count = first;
+            return 0;
+        }
+        uint32_t lo = _glob_at(pattern, i, unit);
+        if (lo == ']' && !leading) {
+            i++;
+            break;
+        }
+        if (lo == '\\' && i + 1 < count) {
+            lo = _glob_at(pattern, ++i, unit);
+        }
+        i++;
+        uint32_t hi = lo;
+        if (i + 1 < count && _glob_at(pattern, i, unit) == '-' && _glob_at(pattern, i + 1, unit) != ']') {
+            hi = _glob_at(pattern, ++i, unit);
+            if (hi == '\\' && i + 1 < count) {
+                hi = _glob_at(pattern, ++i, unit);
+            }
+            i++;
+        }
+        if (lo > hi) {
+            continue; // a reversed range matches nothing
+        }
+        if (!_glob_add_range(glob, lo, hi)) {
+            return SIZE_MAX;
+        }
+        if (glob->fold && lo <= 'z' && hi >= 'a' &&
+            !_glob_add_range(glob, (lo > 'a' ? lo : 'a') - 32, (hi < 'z' ? hi : 'z') - 32)) {
+            return SIZE_MAX;
+        }
+        if (glob->fold && lo <= 'Z' && hi >= 'A' &&
+            !_glob_add_range(glob, (lo > 'A' ? lo : 'A') + 32, (hi < 'Z' ? hi : 'Z') + 32)) {
+            return SIZE_MAX;
+        }
+    }
+
+    // Sort and merge so a character is found by bisection
+    _glob_range *ranges = glob->ranges + first;
+    size_t n = glob->range_count - first, merged = 0;
+    if (n > 1) {
+        qsort(ranges, n, sizeof(*ranges), _glob_range_order);
+    }
+    for (size_t k = 0; k < n; k++) {
+        if (merged > 0 && (ranges[merged - 1].hi == UINT32_MAX || ranges[k].lo <= ranges[merged - 1].hi + 1)) {
+            if (ranges[k].hi > ranges[merged - 1].hi) {
+                ranges[merged - 1].hi = ranges[k].hi;
+            }
+        } else {
+            ranges[merged++] = ranges[k];
+        }
+    }
+    glob->range_count = first + merged;
+    return _glob_add_atom(glob, GLOB_SET, (uint32_t)first, (uint32_t)merged, (uint32_t)negate) ? i : SIZE_MAX;
+}
+
+// Close the piece of atoms from 'first' onwards, if it has any
+static int _glob_close_piece(_glob *glob, size_t first) {
+    size_t count = glob->atom_count - first;
+    if (count == 0) {
+        return 1;
+    }
+    _glob_piece *pieces = _fossil_grow(glob->pieces, &glob->piece_capacity, glob->piece_count, sizeof(*pieces), 8);
+    if (!pieces) {
+        return 0;
+    }
+    glob->pieces = pieces;
+    _glob_piece *piece = &glob->pieces[glob->piece_count++];
+    memset(piece, 0, sizeof(*piece));
+    piece->first = first;
+    piece->count = count;
+    glob->parts[glob->part_count - 1].count++;
+    glob->parts[glob->part_count - 1].fixed += count;
+    return 1;
+}
+
+static int _glob_open_part(_glob *glob) {
+    _glob_part *parts = _fossil_grow(glob->parts, &glob->part_capacity, glob->part_count, sizeof(*parts), 8);
+    if (!parts) {
+        return 0;
+    }
+    glob->parts = parts;
+    _glob_part *part = &glob->parts[glob->part_count++];
+    memset(part, 0, sizeof(*part));
+    part->first = glob->piece_count;
+    return 1;
+}
+
+// Give each piece its search: the substring search when all literal, else Shift-And masks
+static int _glob_prepare_piece(_glob *glob, _glob_piece *piece) {
+    const _glob_atom *atoms = glob->atoms + piece->first;
+    size_t literal = 0;
+    while (literal < piece->count && atoms[literal].kind == GLOB_LITERAL) {
+        literal++;
+    }
+    if (literal == piece->count) {
+        piece->units = malloc(piece->count * glob->unit);
+        if (!piece->units) {
+            return 0;
+        }
+        for (size_t i = 0; i < piece->count; i++) {
+            switch (glob->unit) {
+                case 1: ((unsigned char *)piece->units)[i] = (unsigned char)atoms[i].value; break;
+                case 2: ((uint16_t *)piece->units)[i] = (uint16_t)atoms[i].value; break;
+                default: ((uint32_t *)piece->units)[i] = atoms[i].value; break;
+            }
+        }
+        _fossil_search_plan_init(&piece->plan, piece->units, piece->count, glob->unit,
+                                 glob->fold ? _FOSSIL_FOLD_ASCII : _FOSSIL_FOLD_NONE);
+        return 1;
+    }
+    if (piece->count > GLOB_SHIFT_AND) {
+        return 1; // compared position by position
+    }
+    piece->masks = calloc(256, sizeof(uint64_t));
+    if (!piece->masks) {
+        return 0;
+    }
+    for (uint32_t c = 0; c < 256; c++) {
+        for (size_t j = 0; j < piece->count; j++) {
+            if (_glob_atom_matches(glob, &atoms[j], c)) {
+                piece->masks[c] |= (uint64_t)1 << j;
+            }
+        }
+    }
+    return 1;
+}
+
+static void _glob_release(_glob *glob) {
+    for (size_t i = 0; i < glob->piece_count; i++) {
+        free(glob->pieces[i].units);
+        free(glob->pieces[i].masks);
+    }
+    free(glob->atoms);
+    free(glob->ranges);
+    free(glob->pieces);
+    free(glob->parts);
+}
+
+// Compile 'pattern' into 'glob'; returns 0 if memory runs out
+static int _glob_build(_glob *glob, const void *pattern, size_t unit, unsigned flags) {
+    memset(glob, 0, sizeof(*glob));
+    glob->unit = unit;
+    glob->fold = (flags & FOSSIL_GLOB_IGNORE_CASE) != 0;
+    glob->pathname = (flags & FOSSIL_GLOB_PATHNAME) != 0;
+    glob->exact = 1;
+    if (!_glob_open_part(glob)) {
+        return 0;
+    }
+
+    size_t count = _fossil_simd_length(pattern, unit);
+    size_t piece = 0; // first atom of the open piece
+    for (size_t i = 0; i < count;) {
+        uint32_t c = _glob_at(pattern, i, unit);
+        _glob_part *part = &glob->parts[glob->part_count - 1];
+        int ok = 1;
+        if (c == '*') {
+            ok = _glob_close_piece(glob, piece);
+            part = &glob->parts[glob->part_count - 1];
+            part->lead |= part->count == 0 && !part->star;
+            part->star = part->trail = 1;
+            glob->exact = 0;
+            piece = glob->atom_count;
+            i++;
+        } else if (glob->pathname && (c == '/' || (c == '\\' && i + 1 < count && _glob_at(pattern, i + 1, unit) == '/'))) {
+            ok = _glob_close_piece(glob, piece) && _glob_open_part(glob);
+            piece = glob->atom_count;
+            i += c == '/' ? 1 : 2;
+        } else {
+            part->trail = 0;
+            if (c == '?') {
+                ok = _glob_add_atom(glob, GLOB_ANY, 0, 0, 0);
+                i++;
+            } else if (c == '[') {
+                size_t next = _glob_parse_set(glob, pattern, count, i);
+                ok = next != SIZE_MAX && (next != 0 || _glob_add_atom(glob, GLOB_LITERAL, c, 0, 0));
+                i = next ? next : i + 1;
+            } else {
+                if (c == '\\' && i + 1 < count) {
+                    c = _glob_at(pattern, ++i, unit);
+                }
+                ok = _glob_add_atom(glob, GLOB_LITERAL, c, 0, 0);
+                i++;
+            }
+        }
+        if (!ok) {
+            _glob_release(glob);
+            return 0;
+        }
+    }
+    if (!_glob_close_piece(glob, piece)) {
+        _glob_release(glob);
+        return 0;
+    }
+
+    for (size_t i = 0; i < glob->piece_count; i++) {
+        if (!_glob_prepare_piece(glob, &glob->pieces[i])) {
+            _glob_release(glob);
+            return 0;
+        }
+    }
+    glob->min_length = glob->part_count - 1; // the separators
+    for (size_t i = 0; i < glob->part_count; i++) {
+        glob->min_length += glob->parts[i].fixed;
+    }
+    return 1;
+}
+
+// ---- matching ----
+
+static int _glob_piece_at(const _glob *glob, const _glob_piece *piece, const void *str, size_t at) {
+    const _glob_atom *atoms = glob->atoms + piece->first;
+    for (size_t j = 0; j < piece->count; j++) {
+        if (!_glob_atom_matches(glob, &atoms[j], _glob_at(str, at + j, glob->unit))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Leftmost place in [from, to) where the whole piece fits and matches, or _FOSSIL_SIMD_NONE
+static size_t _glob_piece_find(const _glob *glob, const _glob_piece *piece, const void *str, size_t from, size_t to) {
+    if (to - from < piece->count) {
+        return _FOSSIL_SIMD_NONE;
+    }
+    if (piece->units) {
+        return _fossil_search_plan_find(&piece->plan, str, to, from);
+    }
+    if (piece->masks) {
+        const _glob_atom *atoms = glob->atoms + piece->first;
+        uint64_t state = 0, found = (uint64_t)1 << (piece->count - 1);
+        for (size_t i = from; i < to; i++) {
+            uint32_t c = _glob_at(str, i, glob->unit);
+            uint64_t mask = 0;
+            if (c < 256) {
+                mask = piece->masks[c];
+            } else {
+                for (size_t j = 0; j < piece->count; j++) {
+                    mask |= (uint64_t)_glob_atom_matches(glob, &atoms[j], c) << j;
+                }
+            }
+            state = ((state << 1) | 1) & mask;
+            if (state & found) {
+                return i + 1 - piece->count;
+            }
+        }
+        return _FOSSIL_SIMD_NONE;
+    }
+    for (size_t i = from; i + piece->count <= to; i++) {
+        if (_glob_piece_at(glob, piece, str, i)) {
+            return i;
+        }
+    }
+    return _FOSSIL_SIMD_NONE;
+}
+
+static int _glob_part_match(const _glob *glob, const _glob_part *part, const void *str, size_t from, size_t to) {
+    const _glob_piece *pieces = glob->pieces + part->first;
+    size_t count = part->count;
+    if (!part->star) {
+        return to - from == part->fixed && (count == 0 || _glob_piece_at(glob, &pieces[0], str, from));
+    }
+    if (to - from < part->fixed) {
+        return 0;
+    }
+
+    size_t i = 0;
+    if (!part->lead) {
+        if (!_glob_piece_at(glob, &pieces[0], str, from)) {
+            return 0;
+        }
+        from += pieces[0].count;
+        i = 1;
+    }
+    if (!part->trail && count > i) {
+        const _glob_piece *last = &pieces[--count];
+        if (!_glob_piece_at(glob, last, str, to - last->count)) {
+            return 0;
+        }
+        to -= last->count;
+    }
+    for (; i < count; i++) {
+        size_t at = _glob_piece_find(glob, &pieces[i], str, from, to);
+        if (at == _FOSSIL_SIMD_NONE) {
+            return 0;
+        }
+        from = at + pieces[i].count;
+    }
+    return 1;
+}
+
+static int _glob_match(const _glob *glob, const void *str, size_t count) {
+    if (count < glob->min_length || (glob->exact && count != glob->min_length)) {
+        return 0;
+    }
+    if (!glob->pathname) {
+        return _glob_part_match(glob, &glob->parts[0], str, 0, count);
+    }
+
+    // Each part matches exactly one '/'-separated component
+    const unsigned char *bytes = str;
+    size_t from = 0;
+    for (size_t i = 0; i < glob->part_count; i++) {
+        size_t slash = _fossil_simd_find(bytes + from * glob->unit, count - from, '/', glob->unit);
+        int last = i + 1 == glob->part_count;
+        if (last != (slash == _FOSSIL_SIMD_NONE)) {
+            return 0;
+        }
+        size_t to = last ? count : from + slash;
+        if (!_glob_part_match(glob, &glob->parts[i], str, from, to)) {
+            return 0;
+        }
+        from = to + 1;
+    }
+    return 1;
+}
+
+// ---- sets ----
+
+// The bucket a glob is filed under, or GLOB_BUCKETS if it may start with anything
+static size_t _glob_bucket(const _glob *glob) {
+    const _glob_part *part = &glob->parts[0];
+    if (part->lead || part->count == 0) {
+        return GLOB_BUCKETS;
+    }
+    const _glob_atom *atom = &glob->atoms[glob->pieces[part->first].first];
+    return atom->kind == GLOB_LITERAL ? atom->value & (GLOB_BUCKETS - 1) : GLOB_BUCKETS;
+}
+
+static void _globset_erase(_globset *set) {
+    if (!set) {
+        return;
+    }
+    for (size_t i = 0; i < set->count; i++) {
+        _glob_release(&set->globs[i]);
+    }
+    free(set->globs);
+    free(set->ids);
+    free(set);
+}
+
+static void *_globset_create(size_t size, const void *const *patterns, size_t count, size_t unit, unsigned flags) {
+    if ((!patterns && count > 0) || count >= UINT32_MAX) {
+        return NULL;
+    }
+    _globset *set = calloc(1, size);
+    if (!set) {
+        return NULL;
+    }
+    set->globs = calloc(count ? count : 1, sizeof(*set->globs));
+    set->ids = malloc((count ? count : 1) * sizeof(*set->ids));
+    if (!set->globs || !set->ids) {
+        _globset_erase(set);
+        return NULL;
+    }
+    for (; set->count < count; set->count++) {
+        if (!patterns[set->count] || !_glob_build(&set->globs[set->count], patterns[set->count], unit, flags)) {
+            _globset_erase(set);
+            return NULL;
+        }
+    }
+
+    // Counting sort into buckets keeps each bucket's ids ascending
+    for (size_t i = 0; i < count; i++) {
+        set->offsets[_glob_bucket(&set->globs[i]) + 1]++;
+    }
+    for (size_t b = 0; b <= GLOB_BUCKETS; b++) {
+        set->offsets[b + 1] += set->offsets[b];
+    }
+    uint32_t fill[GLOB_BUCKETS + 1];
+    memcpy(fill, set->offsets, sizeof(fill));
+    for (size_t i = 0; i < count; i++) {
+        set->ids[fill[_glob_bucket(&set->globs[i])]++] = (uint32_t)i;
+    }
+    return set;
+}
+
+/*
+ * Try the globs that can match 'str' in ascending order, storing the ids
+ * of matches while 'capacity' allows. Stops after 'limit' matches and
+ * returns how many there were.
+ */
+static size_t _globset_scan(const _globset *set, const void *str, size_t unit, size_t *ids, size_t capacity,
+                            size_t limit) {
+    if (set->count == 0) {
+        return 0;
+    }
+    size_t count = _fossil_simd_length(str, unit);
+    uint32_t first = _glob_at(str, 0, unit); // the terminator for an empty string
+    size_t bucket = (set->globs[0].fold ? _fossil_fold_unit(first, 0) : first) & (GLOB_BUCKETS - 1);
+
+    // Merge the bucket with the globs that may start with anything
+    const uint32_t *a = set->ids + set->offsets[bucket], *a_end = set->ids + set->offsets[bucket + 1];
+    const uint32_t *b = set->ids + set->offsets[GLOB_BUCKETS], *b_end = set->ids + set->offsets[GLOB_BUCKETS + 1];
+    size_t found = 0;
+    while ((a < a_end || b < b_end) && found < limit) {
+        uint32_t id = (b == b_end || (a < a_end && *a < *b)) ? *a++ : *b++;
+        if (_glob_match(&set->globs[id], str, count)) {
+            if (found < capacity) {
+                ids[found] = id;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+static size_t _globset_filter(const _globset *set, const void *const *strings, size_t count, size_t unit,
+                              unsigned char *matched) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        int hit = strings[i] && _globset_scan(set, strings[i], unit, NULL, 0, 1) > 0;
+        if (matched) {
+            matched[i] = (unsigned char)hit;
+        }
+        total += (size_t)hit;
+    }
+    return total;
+}
+
+// ---- public API ----
+
+static void *_glob_create(size_t size, const void *pattern, size_t unit, unsigned flags) {
+    if (!pattern) {
+        return NULL;
+    }
+    _glob *glob = malloc(size);
+    if (glob && !_glob_build(glob, pattern, unit, flags)) {
+        free(glob);
+        glob = NULL;
+    }
+    return glob;
+}
+
+static void _glob_erase(_glob *glob) {
+    if (glob) {
+        _glob_release(glob);
+        free(glob);
+    }
+}
+
+fossil_cstr_glob_t *fossil_cstr_glob_create(const_cstring pattern, unsigned flags) {
+    return _glob_create(sizeof(fossil_cstr_glob_t), pattern, sizeof(cletter), flags);
+}
+
+void fossil_cstr_glob_erase(fossil_cstr_glob_t *glob) {
+    _glob_erase(glob ? &glob->glob : NULL);
+}
+
+int fossil_cstr_glob_match(const fossil_cstr_glob_t *glob, const_cstring str) {
+    return glob && str ? _glob_match(&glob->glob, str, _fossil_simd_length(str, sizeof(cletter))) : 0;
+}
+
+fossil_cstr_globset_t *fossil_cstr_globset_create(const const_cstring *patterns, size_t count, unsigned flags) {
+    return _globset_create(sizeof(fossil_cstr_globset_t), (const void *const *)patterns, count, sizeof(cletter), flags);
+}
+
+void fossil_cstr_globset_erase(fossil_cstr_globset_t *set) {
+    _globset_erase(set ? &set->set : NULL);
+}
+
+size_t fossil_cstr_globset_match(const fossil_cstr_globset_t *set, const_cstring str, size_t *ids, size_t capacity) {
+    return set && str ? _globset_scan(&set->set, str, sizeof(cletter), ids, ids ? capacity : 0, SIZE_MAX) : 0;
+}
+
+size_t fossil_cstr_globset_filter(const fossil_cstr_globset_t *set, const const_cstring *strings, size_t count,
+                                  unsigned char *matched) {
+    if (!set || (!strings && count > 0)) {
+        return 0;
+    }
+    return _globset_filter(&set->set, (const void *const *)strings, count, sizeof(cletter), matched);
+}
+
+fossil_wstr_glob_t *fossil_wstr_glob_create(const_wstring pattern, unsigned flags) {
+    return _glob_create(sizeof(fossil_wstr_glob_t), pattern, sizeof(wletter), flags);
+}
+
+void fossil_wstr_glob_erase(fossil_wstr_glob_t *glob) {
+    _glob_erase(glob ? &glob->glob : NULL);
+}
+
+int fossil_wstr_glob_match(const fossil_wstr_glob_t *glob, const_wstring str) {
+    return glob && str ? _glob_match(&glob->glob, str, _fossil_simd_length(str, sizeof(wletter))) : 0;
+}
+
+fossil_wstr_globset_t *fossil_wstr_globset_create(const const_wstring *patterns, size_t count, unsigned flags) {
+    return _globset_create(sizeof(fossil_wstr_globset_t), (const void *const *)patterns, count, sizeof(wletter), flags);
+}
+
+void fossil_wstr_globset_erase(fossil_wstr_globset_t *set) {
+    _globset_erase(set ? &set->set : NULL);
+}
+
+size_t fossil_wstr_globset_match(const fossil_wstr_globset_t *set, const_wstring str, size_t *ids, size_t capacity) {
+    return set && str ? _globset_scan(&set->set, str, sizeof(wletter), ids, ids ? capacity : 0, SIZE_MAX) : 0;
+}
+
+size_t fossil_wstr_globset_filter(const fossil_wstr_globset_t *set, const const_wstring *strings, size_t count,
+                                  unsigned char *matched) {
+    if (!set || (!strings && count > 0)) {
+        return 0;
+    }
+    return _globset_filter(&set->set, (const void *const *)strings, count, sizeof(wletter), matched);
+}
@@ -0,0 +1,43 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_GROW_H
+#define FOSSIL_STRINGS_GROW_H
+
+/*
+ * Private array growth shared by the pattern compilers. Arrays double from
+ * 'initial' elements and never exceed UINT32_MAX of them, so indices into
+ * them fit the 32-bit fields the compiled programs use.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Make room for one more element; returns the possibly moved array, or NULL
+static inline void *_fossil_grow(void *array, size_t *capacity, size_t count, size_t size, size_t initial) {
+    if (count < *capacity) {
+        return array;
+    }
+    size_t grown = *capacity ? *capacity * 2 : initial;
+    if (grown > UINT32_MAX || grown > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *moved = realloc(array, grown * size);
+    if (moved) {
+        *capacity = grown;
+    }
+    return moved;
+}
+
+#endif /* FOSSIL_STRINGS_GROW_H */
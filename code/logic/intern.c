@@ -0,0 +1,301 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/intern.h"
+#include "sync.h"
+
+/*
+ * The pool is split into shards, each an open-addressing table of entry
+ * pointers. Writers serialize on the shard mutex; readers only perform
+ * acquire loads. Entries are immutable once published and tables are never
+ * freed before the pool, so a reader holding an old table stays safe.
+ */
+
+#define INTERN_SHARD_BITS 6
+#define INTERN_SHARDS (1u << INTERN_SHARD_BITS)
+#define INTERN_MIN_SLOTS 64
+#define INTERN_BLOCK_SIZE 65536
+
+enum { INTERN_CSTR, INTERN_BSTR, INTERN_WSTR };
+
+typedef struct {
+    uint64_t hash;
+    size_t size; // bytes of character data, excluding the terminator
+    size_t kind;
+} _intern_entry;
+
+typedef struct _intern_table {
+    struct _intern_table *retired; // older tables, freed with the pool
+    size_t mask;
+    _fossil_atomic_ptr slots[];
+} _intern_table;
+
+typedef struct _intern_block {
+    struct _intern_block *next;
+    size_t used;
+    size_t size;
+    _intern_entry first[]; // keeps the storage aligned for entries
+} _intern_block;
+
+typedef struct {
+    _fossil_atomic_ptr table;
+    _fossil_mutex lock;
+    size_t count;
+    _intern_block *blocks;
+} _intern_shard;
+
+struct fossil_intern {
+    _intern_shard shards[INTERN_SHARDS];
+};
+
+// Word-at-a-time multiply/xorshift hash
+static uint64_t _intern_hash(const void *data, size_t size, size_t kind) {
+    const unsigned char *p = data;
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (size * 0xFF51AFD7ED558CCDULL) ^ kind;
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        h = (h ^ word) * 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 29;
+        p += 8;
+        size -= 8;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, size);
+    h = (h ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 32;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 29;
+    return h;
+}
+
+static const unsigned char *_intern_data(const _intern_entry *entry) {
+    return (const unsigned char *)(entry + 1);
+}
+
+static _intern_table *_intern_table_new(size_t slots) {
+    _intern_table *table = malloc(sizeof(_intern_table) + slots * sizeof(_fossil_atomic_ptr));
+    if (!table) {
+        return NULL;
+    }
+    table->retired = NULL;
+    table->mask = slots - 1;
+    for (size_t i = 0; i < slots; i++) {
+        _fossil_atomic_ptr_store(&table->slots[i], NULL);
+    }
+    return table;
+}
+
+// Lock-free probe; safe to call concurrently with inserts
+static const _intern_entry *_intern_probe(_intern_shard *shard, const void *data, size_t size,
+                                          size_t kind, uint64_t hash) {
+    _intern_table *table = _fossil_atomic_ptr_load(&shard->table);
+    if (!table) {
+        return NULL;
+    }
+    for (size_t i = (size_t)hash & table->mask;; i = (i + 1) & table->mask) {
+        const _intern_entry *entry = _fossil_atomic_ptr_load(&table->slots[i]);
+        if (!entry) {
+            return NULL;
+        }
+        if (entry->hash == hash && entry->size == size && entry->kind == kind &&
+            memcmp(_intern_data(entry), data, size) == 0) {
+            return entry;
+        }
+    }
+}
+
+// Copy a new entry into the shard's block storage; caller holds the shard lock
+static _intern_entry *_intern_store(_intern_shard *shard, const void *data, size_t size,
+                                    size_t kind, uint64_t hash, size_t unit) {
+    size_t need = sizeof(_intern_entry) + size + unit;
+    need = (need + sizeof(_intern_entry) - 1) / sizeof(_intern_entry) * sizeof(_intern_entry);
+
+    _intern_block *block = shard->blocks;
+    if (!block || block->size - block->used < need) {
+        size_t bytes = need > INTERN_BLOCK_SIZE ? need : INTERN_BLOCK_SIZE;
+        block = malloc(sizeof(_intern_block) + bytes);
+        if (!block) {
+            return NULL;
+        }
+        block->used = 0;
+        block->size = bytes;
+        // Keep filling the current block when an oversized string gets its own
+        if (shard->blocks && bytes > INTERN_BLOCK_SIZE) {
+            block->next = shard->blocks->next;
+            shard->blocks->next = block;
+        } else {
+            block->next = shard->blocks;
+            shard->blocks = block;
+        }
+    }
+
+    _intern_entry *entry = (_intern_entry *)(void *)((unsigned char *)block->first + block->used);
+    block->used += need;
+    entry->hash = hash;
+    entry->size = size;
+    entry->kind = kind;
+    unsigned char *copy = (unsigned char *)(entry + 1);
+    memcpy(copy, data, size);
+    memset(copy + size, 0, unit); // Terminator in the family's unit size
+    return entry;
+}
+
+// Publish 'entry' into a table, growing first if needed; caller holds the shard lock
+static int _intern_publish(_intern_shard *shard, _intern_entry *entry) {
+    _intern_table *table = _fossil_atomic_ptr_load(&shard->table);
+    if (!table || (shard->count + 1) * 2 > table->mask + 1) {
+        size_t slots = table ? (table->mask + 1) * 2 : INTERN_MIN_SLOTS;
+        _intern_table *grown = _intern_table_new(slots);
+        if (!grown) {
+            return -1;
+        }
+        if (table) {
+            for (size_t i = 0; i <= table->mask; i++) {
+                _intern_entry *old = _fossil_atomic_ptr_load(&table->slots[i]);
+                if (old) {
+                    size_t j = (size_t)old->hash & grown->mask;
+                    while (_fossil_atomic_ptr_load(&grown->slots[j])) {
+                        j = (j + 1) & grown->mask;
+                    }
+                    _fossil_atomic_ptr_store(&grown->slots[j], old);
+                }
+            }
+            grown->retired = table;
+        }
+        _fossil_atomic_ptr_store(&shard->table, grown);
+        table = grown;
+    }
+
+    size_t i = (size_t)entry->hash & table->mask;
+    while (_fossil_atomic_ptr_load(&table->slots[i])) {
+        i = (i + 1) & table->mask;
+    }
+    _fossil_atomic_ptr_store(&table->slots[i], entry);
+    shard->count++;
+    return 0;
+}
+
+static const void *_intern(fossil_intern_t *pool, const void *data, size_t size, size_t kind, size_t unit) {
+    if (!pool || !data) {
+        return NULL;
+    }
+    uint64_t hash = _intern_hash(data, size, kind);
+    _intern_shard *shard = &pool->shards[hash >> (64 - INTERN_SHARD_BITS)];
+
+    // Fast path: most keys are already present
+    const _intern_entry *found = _intern_probe(shard, data, size, kind, hash);
+    if (found) {
+        return _intern_data(found);
+    }
+
+    _fossil_mutex_lock(&shard->lock);
+    found = _intern_probe(shard, data, size, kind, hash); // Another thread may have won
+    if (!found) {
+        _intern_entry *entry = _intern_store(shard, data, size, kind, hash, unit);
+        if (entry && _intern_publish(shard, entry) == 0) {
+            found = entry;
+        }
+    }
+    _fossil_mutex_unlock(&shard->lock);
+    return found ? _intern_data(found) : NULL;
+}
+
+fossil_intern_t *fossil_intern_create(void) {
+    fossil_intern_t *pool = malloc(sizeof(fossil_intern_t));
+    if (!pool) {
+        return NULL;
+    }
+    for (size_t i = 0; i < INTERN_SHARDS; i++) {
+        _fossil_atomic_ptr_store(&pool->shards[i].table, NULL);
+        _fossil_mutex_init(&pool->shards[i].lock);
+        pool->shards[i].count = 0;
+        pool->shards[i].blocks = NULL;
+    }
+    return pool;
+}
+
+void fossil_intern_erase(fossil_intern_t *pool) {
+    if (!pool) {
+        return;
+    }
+    for (size_t i = 0; i < INTERN_SHARDS; i++) {
+        _intern_shard *shard = &pool->shards[i];
+        _intern_table *table = _fossil_atomic_ptr_load(&shard->table);
+        while (table) {
+            _intern_table *older = table->retired;
+            free(table);
+            table = older;
+        }
+        while (shard->blocks) {
+            _intern_block *next = shard->blocks->next;
+            free(shard->blocks);
+            shard->blocks = next;
+        }
+        _fossil_mutex_destroy(&shard->lock);
+    }
+    free(pool);
+}
+
+size_t fossil_intern_count(fossil_intern_t *pool) {
+    if (!pool) {
+        return 0;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < INTERN_SHARDS; i++) {
+        _fossil_mutex_lock(&pool->shards[i].lock);
+        total += pool->shards[i].count;
+        _fossil_mutex_unlock(&pool->shards[i].lock);
+    }
+    return total;
+}
+
+const_cstring fossil_intern_cstr_len(fossil_intern_t *pool, const_cstring str, size_t len) {
+    return _intern(pool, str, len, INTERN_CSTR, sizeof(cletter));
+}
+
+const_cstring fossil_intern_cstr(fossil_intern_t *pool, const_cstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return fossil_intern_cstr_len(pool, str, strlen(str));
+}
+
+const_bstring fossil_intern_bstr(fossil_intern_t *pool, const_bstring str) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = 0;
+    while (str[len] != 0) {
+        len++;
+    }
+    return _intern(pool, str, len * sizeof(bletter), INTERN_BSTR, sizeof(bletter));
+}
+
+const_wstring fossil_intern_wstr(fossil_intern_t *pool, const_wstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return _intern(pool, str, wcslen(str) * sizeof(wletter), INTERN_WSTR, sizeof(wletter));
+}
+
+const_cstring fossil_intern_find_cstr(fossil_intern_t *pool, const_cstring str) {
+    if (!pool || !str) {
+        return NULL;
+    }
+    size_t len = strlen(str);
+    uint64_t hash = _intern_hash(str, len, INTERN_CSTR);
+    const _intern_entry *found = _intern_probe(&pool->shards[hash >> (64 - INTERN_SHARD_BITS)],
+                                               str, len, INTERN_CSTR, hash);
+    return found ? (const_cstring)_intern_data(found) : NULL;
+}
@@ -0,0 +1,290 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/lstring.h"
+
+// Hidden header stored right before the character data of every lstring
+typedef struct {
+    size_t length;
+    size_t capacity;
+} _lstr_header;
+
+#define LSTR_MIN_CAPACITY 16
+
+static _lstr_header *_lstr_head(const_lstring str) {
+    return (_lstr_header *)(void *)((char *)(uintptr_t)str - sizeof(_lstr_header));
+}
+
+// Allocate a header plus 'capacity' characters and the terminating NUL
+static lstring _lstr_alloc(size_t capacity) {
+    if (capacity > SIZE_MAX - sizeof(_lstr_header) - 1) {
+        return NULL; // Size overflow
+    }
+    _lstr_header *head = fossil_allocator_alloc(NULL, sizeof(_lstr_header) + capacity + 1);
+    if (!head) {
+        return NULL;
+    }
+    head->length = 0;
+    head->capacity = capacity;
+    lstring str = (lstring)(head + 1);
+    str[0] = '\0';
+    return str;
+}
+
+lstring fossil_lstr_create_len(const_cstring str, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    lstring out = _lstr_alloc(len);
+    if (!out) {
+        return NULL;
+    }
+    memcpy(out, str, len);
+    out[len] = '\0';
+    _lstr_head(out)->length = len;
+    return out;
+}
+
+lstring fossil_lstr_create(const_cstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return fossil_lstr_create_len(str, strlen(str));
+}
+
+lstring fossil_lstr_with_capacity(size_t capacity) {
+    return _lstr_alloc(capacity);
+}
+
+void fossil_lstr_erase(lstring str) {
+    if (str) {
+        fossil_allocator_release(NULL, _lstr_head(str));
+    }
+}
+
+size_t fossil_lstr_length(const_lstring str) {
+    return str ? _lstr_head(str)->length : 0;
+}
+
+size_t fossil_lstr_capacity(const_lstring str) {
+    return str ? _lstr_head(str)->capacity : 0;
+}
+
+lstring fossil_lstr_reserve(lstring str, size_t capacity) {
+    if (!str) {
+        return NULL;
+    }
+    _lstr_header *head = _lstr_head(str);
+    if (capacity <= head->capacity) {
+        return str;
+    }
+
+    // Grow geometrically so repeated appends stay amortized O(1)
+    size_t grown = head->capacity < LSTR_MIN_CAPACITY ? LSTR_MIN_CAPACITY : head->capacity;
+    while (grown < capacity && grown <= (SIZE_MAX - sizeof(_lstr_header) - 1) / 2) {
+        grown *= 2;
+    }
+    if (grown < capacity) {
+        grown = capacity;
+    }
+    if (grown > SIZE_MAX - sizeof(_lstr_header) - 1) {
+        return NULL; // Size overflow
+    }
+
+    _lstr_header *moved = fossil_allocator_resize(NULL, head, sizeof(_lstr_header) + grown + 1);
+    if (!moved) {
+        return NULL;
+    }
+    moved->capacity = grown;
+    return (lstring)(moved + 1);
+}
+
+void fossil_lstr_clear(lstring str) {
+    if (str) {
+        _lstr_head(str)->length = 0;
+        str[0] = '\0';
+    }
+}
+
+void fossil_lstr_update_length(lstring str) {
+    if (str) {
+        _lstr_header *head = _lstr_head(str);
+        const cletter *nul = memchr(str, '\0', head->capacity + 1);
+        head->length = nul ? (size_t)(nul - str) : head->capacity;
+        str[head->length] = '\0';
+    }
+}
+
+lstring fossil_lstr_concat_len(lstring dest, const_cstring src, size_t len) {
+    if (!dest || !src) {
+        return NULL;
+    }
+    size_t dest_len = _lstr_head(dest)->length;
+    if (len > SIZE_MAX - dest_len) {
+        return NULL; // Size overflow
+    }
+    // 'src' may alias 'dest', so remember its offset across the reallocation
+    int aliased = src >= dest && src <= dest + dest_len;
+    size_t offset = aliased ? (size_t)(src - dest) : 0;
+
+    lstring grown = fossil_lstr_reserve(dest, dest_len + len);
+    if (!grown) {
+        return NULL;
+    }
+    memmove(grown + dest_len, aliased ? grown + offset : src, len);
+    grown[dest_len + len] = '\0';
+    _lstr_head(grown)->length = dest_len + len;
+    return grown;
+}
+
+lstring fossil_lstr_concat(lstring dest, const_cstring src) {
+    if (!dest || !src) {
+        return NULL;
+    }
+    return fossil_lstr_concat_len(dest, src, strlen(src));
+}
+
+lstring fossil_lstr_concat_lstr(lstring dest, const_lstring src) {
+    if (!dest || !src) {
+        return NULL;
+    }
+    return fossil_lstr_concat_len(dest, src, _lstr_head(src)->length);
+}
+
+int fossil_lstr_compare(const_lstring str1, const_lstring str2) {
+    if (!str1 || !str2) {
+        return -1;
+    }
+    size_t len1 = _lstr_head(str1)->length;
+    size_t len2 = _lstr_head(str2)->length;
+    int cmp = memcmp(str1, str2, len1 < len2 ? len1 : len2);
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (len1 > len2) - (len1 < len2);
+}
+
+const_cstring fossil_lstr_find(const_lstring str, cletter ch) {
+    if (!str) {
+        return NULL;
+    }
+    return memchr(str, ch, _lstr_head(str)->length);
+}
+
+lstring fossil_lstr_reverse(const_lstring str) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _lstr_head(str)->length;
+    lstring rev = _lstr_alloc(len);
+    if (!rev) {
+        return NULL;
+    }
+    for (size_t i = 0; i < len; i++) {
+        rev[i] = str[len - i - 1];
+    }
+    rev[len] = '\0';
+    _lstr_head(rev)->length = len;
+    return rev;
+}
+
+lstring fossil_lstr_substr(const_lstring str, size_t start, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    size_t str_len = _lstr_head(str)->length;
+    if (start >= str_len) {
+        return NULL;
+    }
+    if (len > str_len - start) {
+        len = str_len - start;
+    }
+    return fossil_lstr_create_len(str + start, len);
+}
+
+// Read a substring of length 'len' from the string starting at position 'pos'
+lstring fossil_lstrstream_read(const_lstring str, size_t *pos, size_t len) {
+    if (!str || !pos || *pos >= _lstr_head(str)->length || len == 0) {
+        return NULL; // Invalid input or end of string reached, or zero length
+    }
+    lstring buffer = fossil_lstr_substr(str, *pos, len);
+    if (!buffer) {
+        return NULL; // Memory allocation failure
+    }
+    *pos += _lstr_head(buffer)->length; // Move position by the length of the read substring
+    return buffer;
+}
+
+// Read a line from the string starting at position 'pos' and update 'end_pos'
+lstring fossil_lstrstream_read_line(const_lstring str, size_t *pos, size_t *end_pos) {
+    if (!str || !pos || !end_pos || *pos >= _lstr_head(str)->length) {
+        return NULL; // Invalid input or end of string reached
+    }
+    size_t len = _lstr_head(str)->length;
+    size_t start = *pos;
+    const cletter *newline = memchr(str + start, '\n', len - start);
+    size_t stop = newline ? (size_t)(newline - str) : len;
+
+    lstring buffer = fossil_lstr_create_len(str + start, stop - start);
+    if (!buffer) {
+        return NULL; // Memory allocation failure
+    }
+    *pos = newline ? stop + 1 : stop;
+    *end_pos = *pos;
+    return buffer;
+}
+
+// Write the source string to the destination starting at position 'pos'
+lstring fossil_lstrstream_write(lstring dest, size_t *pos, const_cstring src) {
+    if (!dest || !pos || !src) {
+        return NULL; // Invalid input
+    }
+    size_t dest_len = _lstr_head(dest)->length;
+    size_t src_len = strlen(src);
+    if (*pos > dest_len || src_len > SIZE_MAX - *pos) {
+        return NULL; // Writing would leave a gap or overflow
+    }
+    size_t end = *pos + src_len;
+    if (end > dest_len) {
+        int aliased = src >= dest && src <= dest + dest_len;
+        size_t offset = aliased ? (size_t)(src - dest) : 0;
+        lstring grown = fossil_lstr_reserve(dest, end);
+        if (!grown) {
+            return NULL;
+        }
+        if (aliased) {
+            src = grown + offset;
+        }
+        dest = grown;
+    }
+    memmove(dest + *pos, src, src_len);
+    if (end > dest_len) {
+        dest[end] = '\0';
+        _lstr_head(dest)->length = end;
+    }
+    *pos = end; // Move position by the length of the written substring
+    return dest;
+}
+
+// Append the source string to the destination and move 'pos' to the new end
+lstring fossil_lstrstream_append(lstring dest, size_t *pos, const_cstring src) {
+    if (!dest || !pos || !src) {
+        return NULL; // Invalid input
+    }
+    lstring grown = fossil_lstr_concat(dest, src);
+    if (!grown) {
+        return NULL;
+    }
+    *pos = _lstr_head(grown)->length;
+    return grown;
+}
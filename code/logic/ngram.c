@@ -0,0 +1,478 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/ngram.h"
+#include "search.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A posting list stores each document id as its difference from the one
+ * before, seven bits to a byte with the top bit set on all but the last.
+ * Ids only grow, so adding a document appends to the lists it touches.
+ * Every NGRAM_BLOCK postings a skip entry records the id before the block
+ * and where it starts, so an intersection can step over whole blocks.
+ */
+
+#define NGRAM_BLOCK 64
+#define NGRAM_VARINT_MAX 10       // bytes in the longest encoded size_t
+#define NGRAM_EMPTY ((size_t)-1)  // no list, or a list's end
+#define NGRAM_STACK 64            // pattern trigrams kept on the C stack
+
+typedef struct {
+    size_t base;   // the id before the block, 0 for the first
+    size_t offset; // where the block's bytes start
+} _ngram_skip;
+
+typedef struct {
+    uint32_t gram;
+    size_t count;  // postings, including removed documents'
+    size_t last;   // the last id appended
+    unsigned char *bytes;
+    size_t size;
+    size_t room;
+    _ngram_skip *skips;
+    size_t skip_room;
+} _ngram_list;
+
+struct fossil_ngram {
+    char **documents;  // by id, NULL once removed
+    size_t *lengths;
+    size_t next;       // the id the next document gets
+    size_t room;
+    size_t live;
+    _ngram_list *lists;
+    size_t list_count;
+    size_t list_room;
+    size_t *slots;     // list index by trigram hash, NGRAM_EMPTY when free
+    size_t mask;
+    size_t postings;   // total over all lists
+    size_t dead;       // postings of removed documents
+};
+
+// ---- trigrams ----
+
+static int _ngram_gram_order(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Store the distinct trigrams of 'text' in 'grams' (room for length - 2) and return how many
+static size_t _ngram_grams(const unsigned char *text, size_t length, uint32_t *grams) {
+    if (length < 3) {
+        return 0;
+    }
+    for (size_t i = 0; i + 2 < length; i++) {
+        grams[i] = (uint32_t)text[i] << 16 | (uint32_t)text[i + 1] << 8 | text[i + 2];
+    }
+    qsort(grams, length - 2, sizeof(uint32_t), _ngram_gram_order);
+    size_t unique = 1;
+    for (size_t i = 1; i < length - 2; i++) {
+        if (grams[i] != grams[unique - 1]) {
+            grams[unique++] = grams[i];
+        }
+    }
+    return unique;
+}
+
+static size_t _ngram_slot(uint32_t gram, size_t mask) {
+    return (size_t)((gram * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+static size_t _ngram_lookup(const fossil_ngram_t *index, uint32_t gram) {
+    for (size_t i = _ngram_slot(gram, index->mask);; i = (i + 1) & index->mask) {
+        size_t list = index->slots[i];
+        if (list == NGRAM_EMPTY || index->lists[list].gram == gram) {
+            return list;
+        }
+    }
+}
+
+// The list for 'gram', created empty if there is none; NGRAM_EMPTY if memory runs out
+static size_t _ngram_list_for(fossil_ngram_t *index, uint32_t gram) {
+    size_t found = _ngram_lookup(index, gram);
+    if (found != NGRAM_EMPTY) {
+        return found;
+    }
+    if (index->list_count == index->list_room) {
+        size_t room = index->list_room * 2;
+        _ngram_list *lists = realloc(index->lists, room * sizeof(_ngram_list));
+        if (!lists) {
+            return NGRAM_EMPTY;
+        }
+        index->lists = lists;
+        index->list_room = room;
+    }
+    if ((index->list_count + 1) * 2 > index->mask + 1) {
+        size_t mask = index->mask * 2 + 1;
+        size_t *slots = malloc((mask + 1) * sizeof(size_t));
+        if (!slots) {
+            return NGRAM_EMPTY;
+        }
+        memset(slots, 0xFF, (mask + 1) * sizeof(size_t));
+        for (size_t l = 0; l < index->list_count; l++) {
+            size_t i = _ngram_slot(index->lists[l].gram, mask);
+            while (slots[i] != NGRAM_EMPTY) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = l;
+        }
+        free(index->slots);
+        index->slots = slots;
+        index->mask = mask;
+    }
+    _ngram_list *list = &index->lists[index->list_count];
+    memset(list, 0, sizeof(*list));
+    list->gram = gram;
+    size_t i = _ngram_slot(gram, index->mask);
+    while (index->slots[i] != NGRAM_EMPTY) {
+        i = (i + 1) & index->mask;
+    }
+    index->slots[i] = index->list_count;
+    return index->list_count++;
+}
+
+// ---- posting lists ----
+
+static size_t _ngram_put(unsigned char *bytes, size_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        bytes[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[n++] = (unsigned char)value;
+    return n;
+}
+
+static size_t _ngram_get(const unsigned char *bytes, size_t *at) {
+    size_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        unsigned char byte = bytes[(*at)++];
+        value |= (size_t)(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return value;
+        }
+    }
+}
+
+// Make room to append one posting; returns 0 if memory runs out
+static int _ngram_reserve(_ngram_list *list) {
+    if (list->room - list->size < NGRAM_VARINT_MAX) {
+        size_t room = list->room ? list->room * 2 : 16;
+        unsigned char *bytes = realloc(list->bytes, room);
+        if (!bytes) {
+            return 0;
+        }
+        list->bytes = bytes;
+        list->room = room;
+    }
+    size_t skips = list->count / NGRAM_BLOCK + 1;
+    if (skips > list->skip_room) {
+        size_t room = list->skip_room ? list->skip_room * 2 : 1;
+        _ngram_skip *grown = realloc(list->skips, room * sizeof(_ngram_skip));
+        if (!grown) {
+            return 0;
+        }
+        list->skips = grown;
+        list->skip_room = room;
+    }
+    return 1;
+}
+
+// Append an id above every id in the list, into room already reserved
+static void _ngram_append(_ngram_list *list, size_t id) {
+    size_t prev = list->count ? list->last : 0;
+    if (list->count % NGRAM_BLOCK == 0) {
+        list->skips[list->count / NGRAM_BLOCK].base = prev;
+        list->skips[list->count / NGRAM_BLOCK].offset = list->size;
+    }
+    list->size += _ngram_put(list->bytes + list->size, id - prev);
+    list->last = id;
+    list->count++;
+}
+
+/*
+ * Drop the postings of removed documents from every list. Each list is
+ * rewritten in place: the gap between two kept ids never takes more bytes
+ * than the gaps it replaces, so writing never overtakes reading.
+ */
+static void _ngram_compact(fossil_ngram_t *index) {
+    for (size_t l = 0; l < index->list_count; l++) {
+        _ngram_list *list = &index->lists[l];
+        size_t count = list->count, at = 0, id = 0;
+        list->count = list->size = list->last = 0;
+        for (size_t k = 0; k < count; k++) {
+            id += _ngram_get(list->bytes, &at);
+            if (index->documents[id]) {
+                _ngram_append(list, id);
+            }
+        }
+    }
+    index->postings = 0;
+    for (size_t l = 0; l < index->list_count; l++) {
+        index->postings += index->lists[l].count;
+    }
+    index->dead = 0;
+}
+
+// A position in a posting list during an intersection
+typedef struct {
+    const _ngram_list *list;
+    size_t k;   // the posting under the cursor
+    size_t at;  // where the one after it starts
+    size_t id;  // its id, NGRAM_EMPTY past the end
+} _ngram_cursor;
+
+static void _ngram_cursor_init(_ngram_cursor *cursor, const _ngram_list *list) {
+    cursor->list = list;
+    cursor->k = 0;
+    cursor->at = 0;
+    cursor->id = list->count ? _ngram_get(list->bytes, &cursor->at) : NGRAM_EMPTY;
+}
+
+// Move to the first posting at or after 'target' and report whether it is 'target'
+static int _ngram_cursor_seek(_ngram_cursor *cursor, size_t target) {
+    const _ngram_list *list = cursor->list;
+    if (cursor->id != NGRAM_EMPTY && cursor->id < target) {
+        // Skip to the last block starting after an id below 'target'
+        size_t blocks = (list->count + NGRAM_BLOCK - 1) / NGRAM_BLOCK;
+        size_t lo = cursor->k / NGRAM_BLOCK + 1, hi = blocks;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (list->skips[mid].base < target) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo - 1 > cursor->k / NGRAM_BLOCK) {
+            cursor->k = (lo - 1) * NGRAM_BLOCK;
+            cursor->at = list->skips[lo - 1].offset;
+            cursor->id = list->skips[lo - 1].base + _ngram_get(list->bytes, &cursor->at);
+        }
+        while (cursor->id < target) {
+            if (++cursor->k == list->count) {
+                cursor->id = NGRAM_EMPTY;
+                break;
+            }
+            cursor->id += _ngram_get(list->bytes, &cursor->at);
+        }
+    }
+    return cursor->id == target;
+}
+
+// ---- building ----
+
+fossil_ngram_t *fossil_ngram_create(void) {
+    fossil_ngram_t *index = calloc(1, sizeof(fossil_ngram_t));
+    if (!index) {
+        return NULL;
+    }
+    index->room = 16;
+    index->list_room = 16;
+    index->mask = 63;
+    index->documents = malloc(index->room * sizeof(char *));
+    index->lengths = malloc(index->room * sizeof(size_t));
+    index->lists = malloc(index->list_room * sizeof(_ngram_list));
+    index->slots = malloc((index->mask + 1) * sizeof(size_t));
+    if (!index->documents || !index->lengths || !index->lists || !index->slots) {
+        fossil_ngram_erase(index);
+        return NULL;
+    }
+    memset(index->slots, 0xFF, (index->mask + 1) * sizeof(size_t));
+    return index;
+}
+
+void fossil_ngram_erase(fossil_ngram_t *index) {
+    if (!index) {
+        return;
+    }
+    for (size_t id = 0; index->documents && id < index->next; id++) {
+        free(index->documents[id]);
+    }
+    for (size_t l = 0; l < index->list_count; l++) {
+        free(index->lists[l].bytes);
+        free(index->lists[l].skips);
+    }
+    free(index->documents);
+    free(index->lengths);
+    free(index->lists);
+    free(index->slots);
+    free(index);
+}
+
+size_t fossil_ngram_add(fossil_ngram_t *index, const_cstring document) {
+    if (!index || !document) {
+        return FOSSIL_NGRAM_ERROR;
+    }
+    size_t length = _fossil_simd_length(document, 1);
+    char *copy = malloc(length + 1);
+    uint32_t *grams = malloc((length > 2 ? length - 2 : 1) * sizeof(uint32_t));
+    int ok = copy && grams;
+    if (ok && index->next == index->room) {
+        size_t room = index->room * 2;
+        char **documents = realloc(index->documents, room * sizeof(char *));
+        if (documents) {
+            index->documents = documents;
+        }
+        size_t *lengths = realloc(index->lengths, room * sizeof(size_t));
+        if (lengths) {
+            index->lengths = lengths;
+        }
+        ok = documents && lengths;
+        if (ok) {
+            index->room = room;
+        }
+    }
+
+    // Reserve everything first so the postings go in all together or not at all
+    size_t count = ok ? _ngram_grams((const unsigned char *)document, length, grams) : 0;
+    for (size_t g = 0; ok && g < count; g++) {
+        size_t list = _ngram_list_for(index, grams[g]);
+        ok = list != NGRAM_EMPTY && _ngram_reserve(&index->lists[list]);
+        grams[g] = (uint32_t)list; // list indexes stay valid as the lists grow
+    }
+    if (!ok) {
+        free(copy);
+        free(grams);
+        return FOSSIL_NGRAM_ERROR;
+    }
+
+    size_t id = index->next++;
+    for (size_t g = 0; g < count; g++) {
+        _ngram_append(&index->lists[grams[g]], id);
+    }
+    memcpy(copy, document, length + 1);
+    index->documents[id] = copy;
+    index->lengths[id] = length;
+    index->postings += count;
+    index->live++;
+    free(grams);
+    return id;
+}
+
+int fossil_ngram_remove(fossil_ngram_t *index, size_t id) {
+    if (!index || id >= index->next || !index->documents[id]) {
+        return -1;
+    }
+    size_t length = index->lengths[id];
+    uint32_t *grams = malloc((length > 2 ? length - 2 : 1) * sizeof(uint32_t));
+    int counted = grams != NULL;
+    if (counted) {
+        index->dead += _ngram_grams((const unsigned char *)index->documents[id], length, grams);
+        free(grams);
+    }
+    free(index->documents[id]);
+    index->documents[id] = NULL;
+    index->live--;
+    if (index->dead * 2 > index->postings || !counted) {
+        _ngram_compact(index); // needs no memory, so it also settles a count that could not be worked out
+    }
+    return 0;
+}
+
+// ---- querying ----
+
+size_t fossil_ngram_count(const fossil_ngram_t *index) {
+    return index ? index->live : 0;
+}
+
+const_cstring fossil_ngram_document(const fossil_ngram_t *index, size_t id) {
+    return index && id < index->next ? index->documents[id] : NULL;
+}
+
+static int _ngram_rarest_first(const void *a, const void *b) {
+    const _ngram_list *x = *(const _ngram_list *const *)a, *y = *(const _ngram_list *const *)b;
+    return (x->count > y->count) - (x->count < y->count);
+}
+
+// Keep the candidates that contain the pattern, storing ids while 'capacity' allows
+static size_t _ngram_verify(const fossil_ngram_t *index, const _fossil_search_plan *plan, const size_t *candidates,
+                            size_t count, size_t *ids, size_t capacity) {
+    size_t found = 0;
+    for (size_t c = 0; c < count; c++) {
+        size_t id = candidates ? candidates[c] : c;
+        if (index->documents[id] &&
+            _fossil_search_plan_find(plan, index->documents[id], index->lengths[id], 0) != _FOSSIL_SIMD_NONE) {
+            if (ids && found < capacity) {
+                ids[found] = id;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+size_t fossil_ngram_find(const fossil_ngram_t *index, const_cstring pattern, size_t *ids, size_t capacity) {
+    if (!index || !pattern) {
+        return 0;
+    }
+    size_t length = _fossil_simd_length(pattern, 1);
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, pattern, length, 1, _FOSSIL_FOLD_NONE);
+    if (length < 3) {
+        return _ngram_verify(index, &plan, NULL, index->next, ids, capacity);
+    }
+
+    uint32_t local_grams[NGRAM_STACK];
+    const _ngram_list *local_lists[NGRAM_STACK];
+    uint32_t *grams = length - 2 <= NGRAM_STACK ? local_grams : malloc((length - 2) * sizeof(uint32_t));
+    const _ngram_list **lists = length - 2 <= NGRAM_STACK ? local_lists : malloc((length - 2) * sizeof(*lists));
+    size_t *candidates = NULL, found = FOSSIL_NGRAM_ERROR;
+    if (grams && lists) {
+        size_t count = _ngram_grams((const unsigned char *)pattern, length, grams), missing = 0;
+        for (size_t g = 0; g < count; g++) {
+            size_t list = _ngram_lookup(index, grams[g]);
+            missing |= list == NGRAM_EMPTY;
+            lists[g] = list == NGRAM_EMPTY ? NULL : &index->lists[list];
+        }
+        if (missing) {
+            found = 0; // a trigram no document has
+        } else {
+            qsort(lists, count, sizeof(*lists), _ngram_rarest_first);
+            candidates = malloc((lists[0]->count ? lists[0]->count : 1) * sizeof(size_t));
+        }
+        if (candidates) {
+            size_t kept = 0, at = 0, id = 0;
+            for (size_t k = 0; k < lists[0]->count; k++) {
+                id += _ngram_get(lists[0]->bytes, &at);
+                if (index->documents[id]) {
+                    candidates[kept++] = id;
+                }
+            }
+            for (size_t g = 1; g < count && kept > 0; g++) {
+                _ngram_cursor cursor;
+                _ngram_cursor_init(&cursor, lists[g]);
+                size_t still = 0;
+                for (size_t c = 0; c < kept; c++) {
+                    if (_ngram_cursor_seek(&cursor, candidates[c])) {
+                        candidates[still++] = candidates[c];
+                    }
+                }
+                kept = still;
+            }
+            found = _ngram_verify(index, &plan, candidates, kept, ids, capacity);
+        }
+    }
+    if (grams != local_grams) {
+        free(grams);
+    }
+    if (lists != local_lists) {
+        free(lists);
+    }
+    free(candidates);
+    return found;
+}
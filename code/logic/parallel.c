@@ -0,0 +1,63 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "parallel.h"
+#include "sync.h"
+
+#define PARALLEL_MAX_THREADS 256
+
+typedef struct {
+    _fossil_atomic_size next; // tasks claimed so far
+    size_t tasks;
+    _fossil_parallel_fn fn;
+    void *context;
+} _parallel_job;
+
+static void _parallel_work(void *arg) {
+    _parallel_job *job = arg;
+    for (;;) {
+        size_t task = _fossil_atomic_inc(&job->next) - 1;
+        if (task >= job->tasks) {
+            return;
+        }
+        job->fn(job->context, task);
+    }
+}
+
+void _fossil_parallel_run(size_t tasks, size_t threads, _fossil_parallel_fn fn, void *context) {
+    if (threads == 0) {
+        threads = _fossil_cpu_count();
+    }
+    if (threads > tasks) {
+        threads = tasks;
+    }
+    if (threads > PARALLEL_MAX_THREADS) {
+        threads = PARALLEL_MAX_THREADS;
+    }
+
+    _parallel_job job;
+    _fossil_atomic_init(&job.next, 0);
+    job.tasks = tasks;
+    job.fn = fn;
+    job.context = context;
+
+    _fossil_thread workers[PARALLEL_MAX_THREADS];
+    size_t started = 0;
+    while (started + 1 < threads && _fossil_thread_start(&workers[started], _parallel_work, &job) == 0) {
+        started++;
+    }
+    _parallel_work(&job);
+    for (size_t i = 0; i < started; i++) {
+        _fossil_thread_join(workers[i]);
+    }
+}
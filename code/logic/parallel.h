@@ -0,0 +1,34 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_PARALLEL_H
+#define FOSSIL_STRINGS_PARALLEL_H
+
+/*
+ * Private data-parallel loop shared by the bulk builders. Work is cut into
+ * independent tasks that worker threads claim in order, and the calling
+ * thread works alongside them.
+ */
+
+#include <stddef.h>
+
+typedef void (*_fossil_parallel_fn)(void *context, size_t task);
+
+/*
+ * Run fn(context, task) for every task below 'tasks' on up to 'threads'
+ * threads, 0 meaning one per processor, and return once all have run.
+ * If threads cannot be started the calling thread runs the rest itself.
+ */
+void _fossil_parallel_run(size_t tasks, size_t threads, _fossil_parallel_fn fn, void *context);
+
+#endif /* FOSSIL_STRINGS_PARALLEL_H */
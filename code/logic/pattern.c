@@ -0,0 +1,134 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/pattern.h"
+#include "search.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The three pattern types share one layout: the search plan followed, in
+ * the same allocation, by the needle it refers to.
+ */
+struct fossil_cstr_pattern {
+    _fossil_search_plan plan;
+};
+
+struct fossil_bstr_pattern {
+    _fossil_search_plan plan;
+};
+
+struct fossil_wstr_pattern {
+    _fossil_search_plan plan;
+};
+
+// 'fold' is the folding mode FOSSIL_PATTERN_IGNORE_CASE selects for the family
+static void *_pattern_create(size_t header, const void *needle, size_t unit, unsigned flags, int fold) {
+    if (!needle) {
+        return NULL;
+    }
+    size_t count = _fossil_simd_length(needle, unit);
+    if (count > (SIZE_MAX - header) / unit - 1) {
+        return NULL;
+    }
+    unsigned char *pattern = malloc(header + (count + 1) * unit);
+    if (!pattern) {
+        return NULL;
+    }
+    void *copy = pattern + header;
+    memcpy(copy, needle, (count + 1) * unit);
+    _fossil_search_plan_init((_fossil_search_plan *)(void *)pattern, copy, count, unit,
+                             (flags & FOSSIL_PATTERN_IGNORE_CASE) ? fold : _FOSSIL_FOLD_NONE);
+    return pattern;
+}
+
+static size_t _pattern_find(const _fossil_search_plan *plan, const void *str) {
+    return _fossil_search_plan_find(plan, str, _fossil_simd_length(str, plan->unit), 0);
+}
+
+static size_t _pattern_find_all(const _fossil_search_plan *plan, const void *str, size_t *offsets, size_t capacity) {
+    return _fossil_search_plan_find_all(plan, str, _fossil_simd_length(str, plan->unit), offsets, offsets ? capacity : 0);
+}
+
+fossil_cstr_pattern_t *fossil_cstr_pattern_create(const_cstring needle, unsigned flags) {
+    return _pattern_create(sizeof(fossil_cstr_pattern_t), needle, sizeof(cletter), flags, _FOSSIL_FOLD_ASCII);
+}
+
+void fossil_cstr_pattern_erase(fossil_cstr_pattern_t *pattern) {
+    free(pattern);
+}
+
+const_cstring fossil_cstr_pattern_find(const fossil_cstr_pattern_t *pattern, const_cstring str) {
+    if (!pattern || !str) {
+        return NULL;
+    }
+    size_t i = _pattern_find(&pattern->plan, str);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_cstr_pattern_find_all(const fossil_cstr_pattern_t *pattern, const_cstring str, size_t *offsets, size_t capacity) {
+    return pattern && str ? _pattern_find_all(&pattern->plan, str, offsets, capacity) : 0;
+}
+
+size_t fossil_cstr_pattern_count(const fossil_cstr_pattern_t *pattern, const_cstring str) {
+    return fossil_cstr_pattern_find_all(pattern, str, NULL, 0);
+}
+
+fossil_bstr_pattern_t *fossil_bstr_pattern_create(const_bstring needle, unsigned flags) {
+    return _pattern_create(sizeof(fossil_bstr_pattern_t), needle, sizeof(bletter), flags, _FOSSIL_FOLD_ASCII);
+}
+
+void fossil_bstr_pattern_erase(fossil_bstr_pattern_t *pattern) {
+    free(pattern);
+}
+
+const_bstring fossil_bstr_pattern_find(const fossil_bstr_pattern_t *pattern, const_bstring str) {
+    if (!pattern || !str) {
+        return NULL;
+    }
+    size_t i = _pattern_find(&pattern->plan, str);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_bstr_pattern_find_all(const fossil_bstr_pattern_t *pattern, const_bstring str, size_t *offsets, size_t capacity) {
+    return pattern && str ? _pattern_find_all(&pattern->plan, str, offsets, capacity) : 0;
+}
+
+size_t fossil_bstr_pattern_count(const fossil_bstr_pattern_t *pattern, const_bstring str) {
+    return fossil_bstr_pattern_find_all(pattern, str, NULL, 0);
+}
+
+fossil_wstr_pattern_t *fossil_wstr_pattern_create(const_wstring needle, unsigned flags) {
+    return _pattern_create(sizeof(fossil_wstr_pattern_t), needle, sizeof(wletter), flags, _FOSSIL_FOLD_WIDE);
+}
+
+void fossil_wstr_pattern_erase(fossil_wstr_pattern_t *pattern) {
+    free(pattern);
+}
+
+const_wstring fossil_wstr_pattern_find(const fossil_wstr_pattern_t *pattern, const_wstring str) {
+    if (!pattern || !str) {
+        return NULL;
+    }
+    size_t i = _pattern_find(&pattern->plan, str);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_wstr_pattern_find_all(const fossil_wstr_pattern_t *pattern, const_wstring str, size_t *offsets, size_t capacity) {
+    return pattern && str ? _pattern_find_all(&pattern->plan, str, offsets, capacity) : 0;
+}
+
+size_t fossil_wstr_pattern_count(const fossil_wstr_pattern_t *pattern, const_wstring str) {
+    return fossil_wstr_pattern_find_all(pattern, str, NULL, 0);
+}
@@ -0,0 +1,1511 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/regex.h"
+#include "search.h"
+#include "grow.h"
+#include "sync.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A pattern is parsed into a tree, then compiled into a Thompson NFA: a
+ * program whose instructions either consume one character from a set of
+ * ranges or move between instructions without consuming anything.
+ *
+ * Matching runs the NFA as a set of instruction indexes advanced one
+ * character at a time, which is linear in the string however the pattern
+ * is written. Each distinct set reached is cached as a DFA state together
+ * with its transitions, so most characters cost a single table lookup.
+ * Characters are first mapped to classes that no instruction tells apart,
+ * which keeps the transition rows short. find learns from the DFA where
+ * the earliest match ends and only then runs the slower Pike VM, which
+ * tracks capture offsets per thread, over the part that can matter.
+ */
+
+#define REGEX_NONE UINT32_MAX
+#define REGEX_UNKNOWN (UINT32_MAX - 1) // transition not built yet
+#define REGEX_SPECIAL 0x80000000u      // transition flag: the target state needs a closer look
+#define REGEX_MAX_INSTS 65536          // compiled program size limit
+#define REGEX_MAX_DEPTH 256            // nesting limit for groups and quantifiers
+#define REGEX_MAX_REPEAT 1000          // largest count in {n,m}
+#define REGEX_INFINITE SIZE_MAX
+#define REGEX_DFA_BUDGET (1u << 20)    // bytes of cached DFA per regex
+
+enum { NODE_CAT, NODE_ALT, NODE_CLASS, NODE_BOL, NODE_EOL, NODE_GROUP, NODE_REPEAT };
+enum { OP_CLASS, OP_SPLIT, OP_JMP, OP_SAVE, OP_BOL, OP_EOL, OP_ENTER, OP_PROGRESS, OP_MATCH };
+
+typedef struct {
+    uint32_t lo;
+    uint32_t hi;
+} _regex_range;
+
+typedef struct {
+    uint8_t kind;
+    uint8_t greedy;
+    uint32_t literal; // the character of a plain literal, REGEX_NONE otherwise
+    uint32_t child;   // first child, REGEX_NONE for none
+    uint32_t last;    // last child
+    uint32_t next;    // next sibling
+    size_t a;         // CLASS: first range; REPEAT: minimum; GROUP: index
+    size_t b;         // CLASS: range count; REPEAT: maximum
+} _regex_node;
+
+/*
+ * CLASS: x = first range, y = range count. SPLIT: try x, then y.
+ * JMP: go to x. SAVE: record the position in capture slot x.
+ * ENTER: begin an iteration of a loop whose body can match nothing.
+ * PROGRESS: end that iteration, going to y if it consumed nothing.
+ */
+typedef struct {
+    uint32_t op;
+    uint32_t x;
+    uint32_t y;
+} _regex_inst;
+
+typedef struct {
+    const void *src;
+    size_t count;
+    size_t pos;
+    size_t unit;
+    uint32_t max; // largest character value for the unit size
+    int fold;
+    unsigned depth;
+    int error;
+
+    _regex_node *nodes;
+    size_t node_count;
+    size_t node_capacity;
+    _regex_range *ranges;
+    size_t range_count;
+    size_t range_capacity;
+    _regex_range *scratch; // ranges of the class being parsed
+    size_t scratch_count;
+    size_t scratch_capacity;
+    _regex_inst *prog;
+    size_t prog_count;
+    size_t prog_capacity;
+    size_t groups;
+    uint32_t loops;    // ENTER...PROGRESS loops open while compiling
+    uint32_t nesting;  // the most of them ever open at once
+} _regex_builder;
+
+typedef struct {
+    uint32_t *dense;
+    uint32_t *sparse;
+    uint32_t count;
+} _regex_set;
+
+typedef struct {
+    uint32_t first; // kernel instructions in the shared pcs array
+    uint32_t count;
+    uint8_t begin;  // the state a search from the start of the string begins in
+    uint8_t match;  // a match ends at this point
+    uint8_t match_end; // a match ends here if the string ends here
+} _regex_state;
+
+/*
+ * A state's kernel is the sorted list of instructions that decide what it
+ * does next: the character consumers, MATCH, and '$' assertions that may
+ * still pass at the end of the string.
+ */
+typedef struct {
+    _regex_state *states;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *pcs;
+    size_t pcs_count;
+    size_t pcs_capacity;
+    uint32_t *next;   // 'classes' transitions per state, maybe flagged REGEX_SPECIAL
+    uint32_t *table;  // open-addressing index of the states
+    size_t table_mask;
+    uint32_t start[2]; // indexed by whether the search begins at the start of the string
+    int full;          // the budget is spent; new states go through the NFA
+
+    _regex_set set;
+    uint32_t *stack;
+    uint32_t *kernel;
+    uint32_t *spare;
+    uint32_t kernel_count;
+} _regex_dfa;
+
+typedef struct {
+    _regex_inst *prog;
+    uint32_t count;
+    _regex_range *ranges;
+    size_t groups;
+    uint32_t nesting; // how deeply loops that can iterate emptily nest
+    size_t unit;
+    int anchored;
+
+    int has_prefix; // every match starts with the literal text in 'prefix'
+    _fossil_search_plan prefix;
+    void *prefix_units;
+
+    uint32_t *bounds; // sorted points where some range starts or stops
+    uint32_t bound_count;
+    uint32_t classes;
+    uint32_t byte_class[256];
+
+    _fossil_mutex lock;
+    _regex_dfa dfa;
+} _regex;
+
+struct fossil_cstr_regex {
+    _regex re;
+};
+
+struct fossil_wstr_regex {
+    _regex re;
+};
+
+static uint32_t _regex_at(const void *data, size_t index, size_t unit) {
+    switch (unit) {
+        case 1: return ((const unsigned char *)data)[index];
+        case 2: return ((const uint16_t *)data)[index];
+        default: return ((const uint32_t *)data)[index];
+    }
+}
+
+static int _regex_range_order(const void *a, const void *b) {
+    const _regex_range *x = a, *y = b;
+    return (x->lo > y->lo) - (x->lo < y->lo);
+}
+
+// Orders instruction indexes and class bounds alike
+static int _regex_pc_order(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ---- parsing ----
+
+static int _regex_more(const _regex_builder *b) {
+    return b->pos < b->count;
+}
+
+static uint32_t _regex_peek(const _regex_builder *b) {
+    return _regex_at(b->src, b->pos, b->unit);
+}
+
+static uint32_t _regex_node_new(_regex_builder *b, int kind) {
+    _regex_node *nodes = _fossil_grow(b->nodes, &b->node_capacity, b->node_count, sizeof(*nodes), 16);
+    if (!nodes) {
+        b->error = 1;
+        return REGEX_NONE;
+    }
+    b->nodes = nodes;
+    _regex_node *node = &nodes[b->node_count];
+    memset(node, 0, sizeof(*node));
+    node->kind = (uint8_t)kind;
+    node->literal = node->child = node->last = node->next = REGEX_NONE;
+    return (uint32_t)b->node_count++;
+}
+
+static void _regex_append(_regex_builder *b, uint32_t parent, uint32_t child) {
+    if (b->error) {
+        return;
+    }
+    _regex_node *node = &b->nodes[parent];
+    if (node->child == REGEX_NONE) {
+        node->child = child;
+    } else {
+        b->nodes[node->last].next = child;
+    }
+    node->last = child;
+}
+
+static void _regex_class_add(_regex_builder *b, uint32_t lo, uint32_t hi) {
+    _regex_range *scratch = _fossil_grow(b->scratch, &b->scratch_capacity, b->scratch_count, sizeof(*scratch), 16);
+    if (!scratch) {
+        b->error = 1;
+        return;
+    }
+    b->scratch = scratch;
+    scratch[b->scratch_count].lo = lo;
+    scratch[b->scratch_count].hi = hi;
+    b->scratch_count++;
+}
+
+// Add \d, \w or \s, or with 'negate' everything they leave out
+static void _regex_class_add_named(_regex_builder *b, uint32_t name, int negate) {
+    static const _regex_range digit[] = { { '0', '9' } };
+    static const _regex_range word[] = { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+    static const _regex_range space[] = { { '\t', '\r' }, { ' ', ' ' } };
+    const _regex_range *set = name == 'd' ? digit : name == 'w' ? word : space;
+    size_t count = name == 'd' ? 1 : name == 'w' ? 4 : 2;
+
+    if (!negate) {
+        for (size_t i = 0; i < count; i++) {
+            _regex_class_add(b, set[i].lo, set[i].hi);
+        }
+        return;
+    }
+    uint32_t from = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (set[i].lo > from) {
+            _regex_class_add(b, from, set[i].lo - 1);
+        }
+        from = set[i].hi + 1;
+    }
+    _regex_class_add(b, from, b->max);
+}
+
+// Turn the scratch ranges into a CLASS node
+static uint32_t _regex_class_finish(_regex_builder *b, int negate, uint32_t literal) {
+    if (b->error) {
+        return REGEX_NONE;
+    }
+    if (b->fold) {
+        size_t count = b->scratch_count;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t lo = b->scratch[i].lo, hi = b->scratch[i].hi;
+            if (lo <= 'z' && hi >= 'a') {
+                _regex_class_add(b, (lo > 'a' ? lo : 'a') - 32, (hi < 'z' ? hi : 'z') - 32);
+            }
+            if (lo <= 'Z' && hi >= 'A') {
+                _regex_class_add(b, (lo > 'A' ? lo : 'A') + 32, (hi < 'Z' ? hi : 'Z') + 32);
+            }
+        }
+    }
+
+    // Sort and merge, then complement if asked
+    size_t merged = 0;
+    if (b->scratch_count > 1) {
+        qsort(b->scratch, b->scratch_count, sizeof(*b->scratch), _regex_range_order);
+    }
+    for (size_t i = 0; i < b->scratch_count; i++) {
+        _regex_range r = b->scratch[i];
+        if (merged > 0 && (b->scratch[merged - 1].hi == UINT32_MAX || r.lo <= b->scratch[merged - 1].hi + 1)) {
+            if (r.hi > b->scratch[merged - 1].hi) {
+                b->scratch[merged - 1].hi = r.hi;
+            }
+        } else {
+            b->scratch[merged++] = r;
+        }
+    }
+    b->scratch_count = merged;
+
+    size_t first = b->range_count;
+    if (negate) {
+        uint64_t from = 0;
+        for (size_t i = 0; i < merged; i++) {
+            _regex_range r = b->scratch[i];
+            if (r.lo > from) {
+                _regex_range *ranges = _fossil_grow(b->ranges, &b->range_capacity, b->range_count, sizeof(*ranges), 16);
+                if (!ranges) {
+                    b->error = 1;
+                    return REGEX_NONE;
+                }
+                b->ranges = ranges;
+                ranges[b->range_count].lo = (uint32_t)from;
+                ranges[b->range_count].hi = r.lo - 1;
+                b->range_count++;
+            }
+            from = (uint64_t)r.hi + 1;
+        }
+        if (from <= b->max) {
+            _regex_range *ranges = _fossil_grow(b->ranges, &b->range_capacity, b->range_count, sizeof(*ranges), 16);
+            if (!ranges) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+            b->ranges = ranges;
+            ranges[b->range_count].lo = (uint32_t)from;
+            ranges[b->range_count].hi = b->max;
+            b->range_count++;
+        }
+    } else {
+        for (size_t i = 0; i < merged; i++) {
+            _regex_range *ranges = _fossil_grow(b->ranges, &b->range_capacity, b->range_count, sizeof(*ranges), 16);
+            if (!ranges) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+            b->ranges = ranges;
+            ranges[b->range_count++] = b->scratch[i];
+        }
+    }
+    b->scratch_count = 0;
+
+    uint32_t node = _regex_node_new(b, NODE_CLASS);
+    if (node != REGEX_NONE) {
+        b->nodes[node].a = first;
+        b->nodes[node].b = b->range_count - first;
+        b->nodes[node].literal = literal;
+    }
+    return node;
+}
+
+static uint32_t _regex_literal(_regex_builder *b, uint32_t value) {
+    _regex_class_add(b, value, value);
+    return _regex_class_finish(b, 0, value);
+}
+
+static int _regex_hex(uint32_t c) {
+    if (c - '0' < 10) {
+        return (int)(c - '0');
+    }
+    c |= 0x20;
+    return c - 'a' < 6 ? (int)(c - 'a' + 10) : -1;
+}
+
+/*
+ * Parse the escape after a backslash. Returns 1 with the character in
+ * 'value', or 2 with a class name (d, w, s or their capitals) in 'value'.
+ */
+static int _regex_escape(_regex_builder *b, uint32_t *value) {
+    if (!_regex_more(b)) {
+        b->error = 1;
+        return 0;
+    }
+    uint32_t c = _regex_peek(b);
+    b->pos++;
+    switch (c) {
+        case 'd': case 'w': case 's': case 'D': case 'W': case 'S':
+            *value = c;
+            return 2;
+        case 'n': *value = '\n'; return 1;
+        case 'r': *value = '\r'; return 1;
+        case 't': *value = '\t'; return 1;
+        case 'f': *value = '\f'; return 1;
+        case 'v': *value = '\v'; return 1;
+        case 'x': {
+            uint64_t result = 0;
+            int braced = _regex_more(b) && _regex_peek(b) == '{';
+            size_t digits = 0;
+            b->pos += braced;
+            while (_regex_more(b) && (braced || digits < 2) && _regex_hex(_regex_peek(b)) >= 0) {
+                result = result * 16 + (uint64_t)_regex_hex(_regex_peek(b));
+                if (result > b->max) {
+                    b->error = 1;
+                    return 0;
+                }
+                b->pos++;
+                digits++;
+            }
+            if (digits == 0 || (!braced && digits != 2) || (braced && !(_regex_more(b) && _regex_peek(b) == '}'))) {
+                b->error = 1;
+                return 0;
+            }
+            b->pos += braced;
+            *value = (uint32_t)result;
+            return 1;
+        }
+        default:
+            // Other letters and digits are reserved; punctuation stands for itself
+            if (c - '0' < 10 || (c | 0x20) - 'a' < 26) {
+                b->error = 1;
+                return 0;
+            }
+            *value = c;
+            return 1;
+    }
+}
+
+static uint32_t _regex_parse_class(_regex_builder *b) {
+    int negate = _regex_more(b) && _regex_peek(b) == '^';
+    b->pos += negate;
+    int first = 1;
+    for (;;) {
+        if (b->error || !_regex_more(b)) {
+            b->error = 1;
+            return REGEX_NONE;
+        }
+        uint32_t c = _regex_peek(b);
+        if (c == ']' && !first) {
+            b->pos++;
+            break;
+        }
+        first = 0;
+        b->pos++;
+
+        uint32_t lo = c;
+        if (c == '\\') {
+            int kind = _regex_escape(b, &lo);
+            if (kind == 2) {
+                _regex_class_add_named(b, lo | 0x20, lo < 'a');
+                continue;
+            }
+            if (kind == 0) {
+                return REGEX_NONE;
+            }
+        }
+        uint32_t hi = lo;
+        if (b->pos + 1 < b->count && _regex_peek(b) == '-' && _regex_at(b->src, b->pos + 1, b->unit) != ']') {
+            b->pos++;
+            hi = _regex_peek(b);
+            b->pos++;
+            if (hi == '\\' && _regex_escape(b, &hi) != 1) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+            if (hi < lo) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+        }
+        _regex_class_add(b, lo, hi);
+    }
+    return _regex_class_finish(b, negate, REGEX_NONE);
+}
+
+static uint32_t _regex_parse_alt(_regex_builder *b);
+
+static uint32_t _regex_parse_atom(_regex_builder *b) {
+    uint32_t c = _regex_peek(b);
+    b->pos++;
+    switch (c) {
+        case '(': {
+            if (++b->depth > REGEX_MAX_DEPTH) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+            int capture = 1;
+            if (b->pos + 1 < b->count && _regex_peek(b) == '?' && _regex_at(b->src, b->pos + 1, b->unit) == ':') {
+                capture = 0;
+                b->pos += 2;
+            }
+            size_t index = capture ? ++b->groups : 0;
+            uint32_t inner = _regex_parse_alt(b);
+            if (b->error || !_regex_more(b) || _regex_peek(b) != ')') {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+            b->pos++;
+            b->depth--;
+            if (!capture) {
+                return inner;
+            }
+            uint32_t group = _regex_node_new(b, NODE_GROUP);
+            if (group != REGEX_NONE) {
+                b->nodes[group].a = index;
+                _regex_append(b, group, inner);
+            }
+            return group;
+        }
+        case '*': case '+': case '?':
+            b->error = 1; // nothing to repeat
+            return REGEX_NONE;
+        case '.':
+            _regex_class_add(b, '\n', '\n');
+            return _regex_class_finish(b, 1, REGEX_NONE);
+        case '^':
+            return _regex_node_new(b, NODE_BOL);
+        case '$':
+            return _regex_node_new(b, NODE_EOL);
+        case '[':
+            return _regex_parse_class(b);
+        case '\\': {
+            uint32_t value;
+            int kind = _regex_escape(b, &value);
+            if (kind == 2) {
+                _regex_class_add_named(b, value | 0x20, value < 'a');
+                return _regex_class_finish(b, 0, REGEX_NONE);
+            }
+            return kind ? _regex_literal(b, value) : REGEX_NONE;
+        }
+        default:
+            return _regex_literal(b, c);
+    }
+}
+
+static size_t _regex_number(_regex_builder *b) {
+    size_t value = 0;
+    if (!_regex_more(b) || _regex_peek(b) - '0' >= 10) {
+        b->error = 1;
+        return 0;
+    }
+    while (_regex_more(b) && _regex_peek(b) - '0' < 10) {
+        value = value * 10 + (_regex_peek(b) - '0');
+        if (value > REGEX_MAX_REPEAT) {
+            b->error = 1;
+            return 0;
+        }
+        b->pos++;
+    }
+    return value;
+}
+
+static uint32_t _regex_parse_repeat(_regex_builder *b) {
+    uint32_t atom = _regex_parse_atom(b);
+    while (!b->error && _regex_more(b)) {
+        uint32_t c = _regex_peek(b);
+        size_t min, max;
+        if (c == '*') {
+            min = 0;
+            max = REGEX_INFINITE;
+        } else if (c == '+') {
+            min = 1;
+            max = REGEX_INFINITE;
+        } else if (c == '?') {
+            min = 0;
+            max = 1;
+        } else if (c == '{' && b->pos + 1 < b->count && _regex_at(b->src, b->pos + 1, b->unit) - '0' < 10) {
+            b->pos++;
+            min = max = _regex_number(b);
+            if (_regex_more(b) && _regex_peek(b) == ',') {
+                b->pos++;
+                max = _regex_more(b) && _regex_peek(b) == '}' ? REGEX_INFINITE : _regex_number(b);
+            }
+            if (b->error || !_regex_more(b) || _regex_peek(b) != '}' || max < min) {
+                b->error = 1;
+                return REGEX_NONE;
+            }
+        } else {
+            break;
+        }
+        b->pos++;
+
+        uint32_t repeat = _regex_node_new(b, NODE_REPEAT);
+        if (repeat == REGEX_NONE) {
+            return REGEX_NONE;
+        }
+        b->nodes[repeat].a = min;
+        b->nodes[repeat].b = max;
+        b->nodes[repeat].greedy = 1;
+        if (_regex_more(b) && _regex_peek(b) == '?') {
+            b->nodes[repeat].greedy = 0;
+            b->pos++;
+        }
+        _regex_append(b, repeat, atom);
+        atom = repeat;
+    }
+    return atom;
+}
+
+static uint32_t _regex_parse_cat(_regex_builder *b) {
+    uint32_t cat = _regex_node_new(b, NODE_CAT);
+    while (!b->error && _regex_more(b) && _regex_peek(b) != '|' && _regex_peek(b) != ')') {
+        _regex_append(b, cat, _regex_parse_repeat(b));
+    }
+    return cat;
+}
+
+static uint32_t _regex_parse_alt(_regex_builder *b) {
+    uint32_t first = _regex_parse_cat(b);
+    if (b->error || !_regex_more(b) || _regex_peek(b) != '|') {
+        return first;
+    }
+    uint32_t alt = _regex_node_new(b, NODE_ALT);
+    _regex_append(b, alt, first);
+    while (!b->error && _regex_more(b) && _regex_peek(b) == '|') {
+        b->pos++;
+        _regex_append(b, alt, _regex_parse_cat(b));
+    }
+    return alt;
+}
+
+// ---- compiling ----
+
+static uint32_t _regex_emit(_regex_builder *b, uint32_t op, uint32_t x, uint32_t y) {
+    if (b->error || b->prog_count >= REGEX_MAX_INSTS) {
+        b->error = 1;
+        return 0;
+    }
+    _regex_inst *prog = _fossil_grow(b->prog, &b->prog_capacity, b->prog_count, sizeof(*prog), 16);
+    if (!prog) {
+        b->error = 1;
+        return 0;
+    }
+    b->prog = prog;
+    prog[b->prog_count].op = op;
+    prog[b->prog_count].x = x;
+    prog[b->prog_count].y = y;
+    return (uint32_t)b->prog_count++;
+}
+
+static uint32_t _regex_here(const _regex_builder *b) {
+    return (uint32_t)b->prog_count;
+}
+
+// Whether the node can match without consuming a character
+static int _regex_nullable(const _regex_builder *b, uint32_t index) {
+    const _regex_node *node = &b->nodes[index];
+    switch (node->kind) {
+        case NODE_CLASS:
+            return 0;
+        case NODE_CAT:
+            for (uint32_t child = node->child; child != REGEX_NONE; child = b->nodes[child].next) {
+                if (!_regex_nullable(b, child)) {
+                    return 0;
+                }
+            }
+            return 1;
+        case NODE_ALT:
+            for (uint32_t child = node->child; child != REGEX_NONE; child = b->nodes[child].next) {
+                if (_regex_nullable(b, child)) {
+                    return 1;
+                }
+            }
+            return 0;
+        case NODE_GROUP:
+            return _regex_nullable(b, node->child);
+        case NODE_REPEAT:
+            return node->a == 0 || _regex_nullable(b, node->child);
+        default:
+            return 1;
+    }
+}
+
+static void _regex_compile(_regex_builder *b, uint32_t index, unsigned depth) {
+    if (b->error || depth > REGEX_MAX_DEPTH * 4) {
+        b->error = 1;
+        return;
+    }
+    const _regex_node node = b->nodes[index];
+    switch (node.kind) {
+        case NODE_CLASS:
+            _regex_emit(b, OP_CLASS, (uint32_t)node.a, (uint32_t)node.b);
+            break;
+        case NODE_BOL:
+            _regex_emit(b, OP_BOL, 0, 0);
+            break;
+        case NODE_EOL:
+            _regex_emit(b, OP_EOL, 0, 0);
+            break;
+        case NODE_CAT:
+            for (uint32_t child = node.child; child != REGEX_NONE && !b->error; child = b->nodes[child].next) {
+                _regex_compile(b, child, depth + 1);
+            }
+            break;
+        case NODE_GROUP:
+            _regex_emit(b, OP_SAVE, (uint32_t)node.a * 2, 0);
+            _regex_compile(b, node.child, depth + 1);
+            _regex_emit(b, OP_SAVE, (uint32_t)node.a * 2 + 1, 0);
+            break;
+        case NODE_ALT: {
+            // Each alternative but the last is tried through a SPLIT and jumps to the end
+            uint32_t jumps = REGEX_NONE; // chained through the unpatched JMP targets
+            for (uint32_t child = node.child; child != REGEX_NONE && !b->error; child = b->nodes[child].next) {
+                if (b->nodes[child].next == REGEX_NONE) {
+                    _regex_compile(b, child, depth + 1);
+                    break;
+                }
+                uint32_t split = _regex_emit(b, OP_SPLIT, _regex_here(b) + 1, 0);
+                _regex_compile(b, child, depth + 1);
+                uint32_t jump = _regex_emit(b, OP_JMP, jumps, 0);
+                jumps = jump;
+                if (!b->error) {
+                    b->prog[split].y = _regex_here(b);
+                }
+            }
+            while (!b->error && jumps != REGEX_NONE) {
+                uint32_t previous = b->prog[jumps].x;
+                b->prog[jumps].x = _regex_here(b);
+                jumps = previous;
+            }
+            break;
+        }
+        case NODE_REPEAT: {
+            for (size_t i = 0; i < node.a && !b->error; i++) {
+                _regex_compile(b, node.child, depth + 1);
+            }
+            if (node.b == REGEX_INFINITE) {
+                // As in Perl, an iteration that consumes nothing ends the loop
+                int nullable = _regex_nullable(b, node.child);
+                uint32_t loop = _regex_emit(b, OP_SPLIT, 0, 0);
+                uint32_t progress = 0;
+                if (nullable) {
+                    _regex_emit(b, OP_ENTER, 0, 0);
+                    if (++b->loops > b->nesting) {
+                        b->nesting = b->loops;
+                    }
+                }
+                _regex_compile(b, node.child, depth + 1);
+                if (nullable) {
+                    b->loops--;
+                    progress = _regex_emit(b, OP_PROGRESS, 0, 0);
+                }
+                _regex_emit(b, OP_JMP, loop, 0);
+                if (!b->error) {
+                    b->prog[loop].x = node.greedy ? loop + 1 : _regex_here(b);
+                    b->prog[loop].y = node.greedy ? _regex_here(b) : loop + 1;
+                    if (nullable) {
+                        b->prog[progress].y = _regex_here(b);
+                    }
+                }
+                break;
+            }
+            // x{n,m}: m - n optional copies, each skipping to the end when it fails
+            uint32_t splits = REGEX_NONE; // chained through the unpatched SPLIT targets
+            for (size_t i = node.a; i < node.b && !b->error; i++) {
+                splits = _regex_emit(b, OP_SPLIT, 0, splits);
+                _regex_compile(b, node.child, depth + 1);
+            }
+            uint32_t end = _regex_here(b);
+            while (!b->error && splits != REGEX_NONE) {
+                uint32_t previous = b->prog[splits].y;
+                b->prog[splits].x = node.greedy ? splits + 1 : end;
+                b->prog[splits].y = node.greedy ? end : splits + 1;
+                splits = previous;
+            }
+            break;
+        }
+    }
+}
+
+// ---- matching ----
+
+static int _regex_has(const _regex *re, const _regex_inst *inst, uint32_t c) {
+    const _regex_range *ranges = re->ranges + inst->x;
+    size_t lo = 0, hi = inst->y;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ranges[mid].hi < c) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < inst->y && ranges[lo].lo <= c;
+}
+
+static uint32_t _regex_class_of(const _regex *re, uint32_t c) {
+    if (c < 256) {
+        return re->byte_class[c];
+    }
+    uint32_t lo = 0, hi = re->bound_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (re->bounds[mid] <= c) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void _regex_set_clear(_regex_set *set) {
+    set->count = 0;
+}
+
+// Insert 'pc'; returns 0 if it was already there
+static int _regex_set_insert(_regex_set *set, uint32_t pc) {
+    uint32_t slot = set->sparse[pc];
+    if (slot < set->count && set->dense[slot] == pc) {
+        return 0;
+    }
+    set->sparse[pc] = set->count;
+    set->dense[set->count++] = pc;
+    return 1;
+}
+
+// Add 'pc' and everything reachable from it without consuming a character
+static void _regex_closure(const _regex *re, _regex_set *set, uint32_t *stack, uint32_t pc, int at_begin, int at_end) {
+    size_t top = 0;
+    stack[top++] = pc;
+    while (top > 0) {
+        pc = stack[--top];
+        if (!_regex_set_insert(set, pc)) {
+            continue;
+        }
+        const _regex_inst *inst = &re->prog[pc];
+        switch (inst->op) {
+            case OP_JMP: stack[top++] = inst->x; break;
+            case OP_SPLIT: stack[top++] = inst->y; stack[top++] = inst->x; break;
+            case OP_SAVE: stack[top++] = pc + 1; break;
+            case OP_ENTER: stack[top++] = pc + 1; break;
+            case OP_PROGRESS: stack[top++] = inst->y; stack[top++] = pc + 1; break;
+            case OP_BOL: if (at_begin) { stack[top++] = pc + 1; } break;
+            case OP_EOL: if (at_end) { stack[top++] = pc + 1; } break;
+            default: break;
+        }
+    }
+}
+
+// Copy the kernel of the closure in 'set' into 'out'; returns its size
+static uint32_t _regex_kernel(const _regex *re, const _regex_set *set, uint32_t *out, int sort) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < set->count; i++) {
+        uint32_t op = re->prog[set->dense[i]].op;
+        if (op == OP_CLASS || op == OP_MATCH || op == OP_EOL) {
+            out[count++] = set->dense[i];
+        }
+    }
+    if (sort && count > 1) {
+        qsort(out, count, sizeof(*out), _regex_pc_order);
+    }
+    return count;
+}
+
+static int _regex_kernel_matches(const _regex *re, const uint32_t *kernel, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (re->prog[kernel[i]].op == OP_MATCH) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Whether a match ends here given that the string ends here
+static int _regex_kernel_matches_end(_regex *re, const uint32_t *kernel, uint32_t count, int at_begin) {
+    _regex_dfa *dfa = &re->dfa;
+    _regex_set_clear(&dfa->set);
+    for (uint32_t i = 0; i < count; i++) {
+        _regex_closure(re, &dfa->set, dfa->stack, kernel[i], at_begin, 1);
+    }
+    for (uint32_t i = 0; i < dfa->set.count; i++) {
+        if (re->prog[dfa->set.dense[i]].op == OP_MATCH) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Advance 'kernel' over one character into the DFA's set
+static void _regex_step(_regex *re, const uint32_t *kernel, uint32_t count, uint32_t c) {
+    _regex_dfa *dfa = &re->dfa;
+    _regex_set_clear(&dfa->set);
+    for (uint32_t i = 0; i < count; i++) {
+        const _regex_inst *inst = &re->prog[kernel[i]];
+        if (inst->op == OP_CLASS && _regex_has(re, inst, c)) {
+            _regex_closure(re, &dfa->set, dfa->stack, kernel[i] + 1, 0, 0);
+        }
+    }
+    if (!re->anchored) {
+        _regex_closure(re, &dfa->set, dfa->stack, 0, 0, 0); // a match may also start after this character
+    }
+}
+
+static uint64_t _regex_kernel_hash(const uint32_t *kernel, uint32_t count, int begin) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (uint64_t)begin;
+    for (uint32_t i = 0; i < count; i++) {
+        h = (h ^ kernel[i]) * 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+static size_t _regex_dfa_bytes(const _regex *re, size_t states, size_t pcs, size_t slots) {
+    return states * (sizeof(_regex_state) + re->classes * sizeof(uint32_t)) + pcs * sizeof(uint32_t) +
+           slots * sizeof(uint32_t);
+}
+
+// Double the state index; returns 0 if memory runs out
+static int _regex_dfa_rehash(_regex *re, size_t slots) {
+    _regex_dfa *dfa = &re->dfa;
+    uint32_t *table = malloc(slots * sizeof(*table));
+    if (!table) {
+        return 0;
+    }
+    for (size_t i = 0; i < slots; i++) {
+        table[i] = REGEX_NONE;
+    }
+    for (uint32_t s = 0; s < dfa->count; s++) {
+        const _regex_state *state = &dfa->states[s];
+        size_t i = (size_t)_regex_kernel_hash(dfa->pcs + state->first, state->count, state->begin) & (slots - 1);
+        while (table[i] != REGEX_NONE) {
+            i = (i + 1) & (slots - 1);
+        }
+        table[i] = s;
+    }
+    free(dfa->table);
+    dfa->table = table;
+    dfa->table_mask = slots - 1;
+    return 1;
+}
+
+/*
+ * Find or add the state for the kernel in dfa->kernel. Returns REGEX_NONE
+ * when the state is new and the cache has no room for it.
+ */
+static uint32_t _regex_dfa_state(_regex *re, int begin) {
+    _regex_dfa *dfa = &re->dfa;
+    const uint32_t *kernel = dfa->kernel;
+    uint32_t count = dfa->kernel_count;
+    uint64_t hash = _regex_kernel_hash(kernel, count, begin);
+
+    if (dfa->table) {
+        for (size_t i = (size_t)hash & dfa->table_mask; dfa->table[i] != REGEX_NONE; i = (i + 1) & dfa->table_mask) {
+            const _regex_state *state = &dfa->states[dfa->table[i]];
+            if (state->begin == begin && state->count == count &&
+                memcmp(dfa->pcs + state->first, kernel, count * sizeof(*kernel)) == 0) {
+                return dfa->table[i];
+            }
+        }
+    }
+    if (dfa->full) {
+        return REGEX_NONE;
+    }
+
+    size_t slots = dfa->table ? dfa->table_mask + 1 : 64;
+    if ((size_t)dfa->count * 2 + 2 > slots) {
+        slots *= 2;
+    }
+    if (_regex_dfa_bytes(re, (size_t)dfa->count + 1, dfa->pcs_count + count, slots) > REGEX_DFA_BUDGET) {
+        dfa->full = 1;
+        return REGEX_NONE;
+    }
+    if ((!dfa->table || slots != dfa->table_mask + 1) && !_regex_dfa_rehash(re, slots)) {
+        return REGEX_NONE;
+    }
+    if (dfa->count == dfa->capacity) {
+        uint32_t grown = dfa->capacity ? dfa->capacity * 2 : 16;
+        _regex_state *states = realloc(dfa->states, grown * sizeof(*states));
+        if (!states) {
+            return REGEX_NONE;
+        }
+        dfa->states = states;
+        uint32_t *next = realloc(dfa->next, (size_t)grown * re->classes * sizeof(*next));
+        if (!next) {
+            return REGEX_NONE;
+        }
+        dfa->next = next;
+        dfa->capacity = grown;
+    }
+    while (dfa->pcs_count + count > dfa->pcs_capacity) {
+        size_t grown = dfa->pcs_capacity ? dfa->pcs_capacity * 2 : 64;
+        uint32_t *pcs = realloc(dfa->pcs, grown * sizeof(*pcs));
+        if (!pcs) {
+            return REGEX_NONE;
+        }
+        dfa->pcs = pcs;
+        dfa->pcs_capacity = grown;
+    }
+
+    uint32_t index = dfa->count++;
+    _regex_state *state = &dfa->states[index];
+    state->first = (uint32_t)dfa->pcs_count;
+    state->count = count;
+    state->begin = (uint8_t)begin;
+    state->match = (uint8_t)_regex_kernel_matches(re, kernel, count);
+    memcpy(dfa->pcs + dfa->pcs_count, kernel, count * sizeof(*kernel));
+    dfa->pcs_count += count;
+    for (uint32_t k = 0; k < re->classes; k++) {
+        dfa->next[(size_t)index * re->classes + k] = REGEX_UNKNOWN;
+    }
+
+    size_t i = (size_t)hash & dfa->table_mask;
+    while (dfa->table[i] != REGEX_NONE) {
+        i = (i + 1) & dfa->table_mask;
+    }
+    dfa->table[i] = index;
+
+    // Computed last: it reuses the set that produced the kernel
+    state->match_end = (uint8_t)(state->match || _regex_kernel_matches_end(re, kernel, count, begin));
+    return index;
+}
+
+static uint32_t _regex_dfa_start(_regex *re, int begin) {
+    _regex_dfa *dfa = &re->dfa;
+    if (dfa->start[begin] != REGEX_NONE) {
+        return dfa->start[begin];
+    }
+    _regex_set_clear(&dfa->set);
+    _regex_closure(re, &dfa->set, dfa->stack, 0, begin, 0);
+    dfa->kernel_count = _regex_kernel(re, &dfa->set, dfa->kernel, 1);
+    dfa->start[begin] = _regex_dfa_state(re, begin);
+    return dfa->start[begin];
+}
+
+// Build the transition from state 's' on character class 'k'; returns it flagged
+static uint32_t _regex_dfa_next(_regex *re, uint32_t s, uint32_t k) {
+    _regex_dfa *dfa = &re->dfa;
+    uint32_t c = k ? re->bounds[k - 1] : 0; // every character of a class behaves alike
+    _regex_step(re, dfa->pcs + dfa->states[s].first, dfa->states[s].count, c);
+    dfa->kernel_count = _regex_kernel(re, &dfa->set, dfa->kernel, 1);
+    uint32_t t = _regex_dfa_state(re, 0);
+    if (t == REGEX_NONE) {
+        return t;
+    }
+    const _regex_state *state = &dfa->states[t];
+    if (state->match || state->count == 0 || (t == dfa->start[0] && re->has_prefix)) {
+        t |= REGEX_SPECIAL;
+    }
+    dfa->next[(size_t)s * re->classes + k] = t;
+    return t;
+}
+
+/*
+ * Finish a scan on the NFA once the DFA cache cannot grow. The set of
+ * instructions in dfa->kernel describes position 'i'.
+ */
+static size_t _regex_nfa_scan(_regex *re, const void *str, size_t count, size_t i, int begin) {
+    _regex_dfa *dfa = &re->dfa;
+    uint32_t *kernel = dfa->kernel, *spare = dfa->spare;
+    uint32_t n = dfa->kernel_count;
+    for (;;) {
+        if (_regex_kernel_matches(re, kernel, n)) {
+            return i;
+        }
+        if (i == count) {
+            return _regex_kernel_matches_end(re, kernel, n, begin) ? count : _FOSSIL_SIMD_NONE;
+        }
+        if (n == 0 && re->anchored) {
+            return _FOSSIL_SIMD_NONE;
+        }
+        _regex_step(re, kernel, n, _regex_at(str, i, re->unit));
+        n = _regex_kernel(re, &dfa->set, spare, 0);
+        uint32_t *swap = kernel;
+        kernel = spare;
+        spare = swap;
+        begin = 0;
+        i++;
+    }
+}
+
+/*
+ * Where the earliest-ending match ends, or _FOSSIL_SIMD_NONE. 'from'
+ * receives the first position a match can start at.
+ */
+static size_t _regex_scan(_regex *re, const void *str, size_t count, size_t *from) {
+    size_t i = 0;
+    if (re->has_prefix) {
+        i = _fossil_search_plan_find(&re->prefix, str, count, 0);
+        if (i == _FOSSIL_SIMD_NONE) {
+            return i;
+        }
+    }
+    *from = i;
+
+    size_t end = _FOSSIL_SIMD_NONE;
+    _regex_dfa *dfa = &re->dfa;
+    const unsigned char *bytes = str;
+    _fossil_mutex_lock(&re->lock);
+    if (re->has_prefix) {
+        _regex_dfa_start(re, 0); // built first so transitions into it are flagged
+    }
+    uint32_t s = _regex_dfa_start(re, i == 0);
+    if (s == REGEX_NONE) {
+        end = _regex_nfa_scan(re, str, count, i, i == 0);
+        _fossil_mutex_unlock(&re->lock);
+        return end;
+    }
+    for (;;) {
+        const _regex_state *state = &dfa->states[s];
+        if (state->match) {
+            end = i;
+            break;
+        }
+        if (i == count) {
+            end = state->match_end ? count : _FOSSIL_SIMD_NONE;
+            break;
+        }
+        if (state->count == 0) {
+            break; // an anchored search with nothing left alive
+        }
+        if (s == dfa->start[0] && re->has_prefix) {
+            // Nothing in flight, so skip to where the literal prefix next occurs
+            size_t next = _fossil_search_plan_find(&re->prefix, str, count, i);
+            if (next == _FOSSIL_SIMD_NONE) {
+                break;
+            }
+            i = next;
+        }
+
+        // Follow cached transitions for as long as they lead to ordinary states
+        uint32_t k, t;
+        do {
+            k = re->unit == 1 ? re->byte_class[bytes[i]] : _regex_class_of(re, _regex_at(str, i, re->unit));
+            t = dfa->next[(size_t)s * re->classes + k];
+            if (t & REGEX_SPECIAL) {
+                break;
+            }
+            s = t;
+        } while (++i < count);
+        if (i == count) {
+            continue;
+        }
+        if (t == REGEX_UNKNOWN) {
+            t = _regex_dfa_next(re, s, k);
+            if (t == REGEX_NONE) {
+                end = _regex_nfa_scan(re, str, count, i + 1, 0);
+                break;
+            }
+        }
+        s = t & ~REGEX_SPECIAL;
+        i++;
+    }
+    _fossil_mutex_unlock(&re->lock);
+    return end;
+}
+
+/*
+ * Pike VM. Threads are kept in priority order, each with its own capture
+ * slots, so the first thread to reach MATCH is the leftmost-first match.
+ *
+ * When loops can iterate emptily, a thread's last slot counts its open
+ * iterations that have consumed nothing yet. An inner iteration begins no
+ * earlier than the one around it, so the count tells which of them would
+ * stop at PROGRESS, and threads at one instruction are told apart by it:
+ * the set holds pc + count * program size.
+ */
+typedef struct {
+    _regex_set set;
+    size_t *slots; // 'nslots' per thread, in the order of set.dense
+} _regex_list;
+
+typedef struct {
+    uint32_t pc;    // instruction to explore, or REGEX_NONE to restore a slot
+    uint32_t slot;
+    size_t value;
+} _regex_job;
+
+static void _regex_add_thread(const _regex *re, _regex_list *list, _regex_job *stack, uint32_t pc,
+                              size_t *cur, size_t nslots, size_t pos, size_t count) {
+    size_t top = 0, empty = nslots - 1;
+    stack[top].pc = pc;
+    top++;
+    while (top > 0) {
+        _regex_job job = stack[--top];
+        if (job.pc == REGEX_NONE) {
+            cur[job.slot] = job.value;
+            continue;
+        }
+        if (!_regex_set_insert(&list->set, re->nesting ? job.pc + (uint32_t)cur[empty] * re->count : job.pc)) {
+            continue;
+        }
+        const _regex_inst *inst = &re->prog[job.pc];
+        switch (inst->op) {
+            case OP_JMP:
+                stack[top++].pc = inst->x;
+                break;
+            case OP_SPLIT:
+                stack[top++].pc = inst->y;
+                stack[top++].pc = inst->x;
+                break;
+            case OP_SAVE:
+                stack[top].pc = REGEX_NONE;
+                stack[top].slot = inst->x;
+                stack[top].value = cur[inst->x];
+                top++;
+                cur[inst->x] = pos;
+                stack[top++].pc = job.pc + 1;
+                break;
+            case OP_ENTER:
+            case OP_PROGRESS:
+                stack[top].pc = REGEX_NONE;
+                stack[top].slot = (uint32_t)empty;
+                stack[top].value = cur[empty];
+                top++;
+                if (inst->op == OP_ENTER) {
+                    cur[empty]++;
+                    stack[top++].pc = job.pc + 1;
+                } else if (cur[empty] > 0) {
+                    cur[empty]--;
+                    stack[top++].pc = inst->y;
+                } else {
+                    stack[top++].pc = job.pc + 1;
+                }
+                break;
+            case OP_BOL:
+                if (pos == 0) {
+                    stack[top++].pc = job.pc + 1;
+                }
+                break;
+            case OP_EOL:
+                if (pos == count) {
+                    stack[top++].pc = job.pc + 1;
+                }
+                break;
+            default:
+                memcpy(list->slots + (size_t)(list->set.count - 1) * nslots, cur, nslots * sizeof(*cur));
+                break;
+        }
+    }
+}
+
+/*
+ * Leftmost-first match with captures. New threads start no later than
+ * 'last', where the DFA saw the earliest match end. Returns 1 on a match,
+ * 0 on none and -1 if memory runs out.
+ */
+static int _regex_pike(const _regex *re, const void *str, size_t count, size_t from, size_t last, size_t *result) {
+    size_t n = (size_t)re->count * (re->nesting + 1); // distinct threads
+    size_t nslots = re->groups * 2 + (re->nesting > 0);
+    size_t *slots = malloc((2 * n + 1) * nslots * sizeof(size_t));
+    uint32_t *sets = calloc(4 * n, sizeof(uint32_t));
+    _regex_job *stack = malloc((2 * n + 1) * sizeof(_regex_job));
+    if (!slots || !sets || !stack) {
+        free(slots);
+        free(sets);
+        free(stack);
+        return -1;
+    }
+    _regex_list lists[2] = {
+        { { sets, sets + n, 0 }, slots },
+        { { sets + 2 * n, sets + 3 * n, 0 }, slots + n * nslots }
+    };
+    _regex_list *clist = &lists[0], *nlist = &lists[1];
+    size_t *cur = slots + 2 * n * nslots;
+    int matched = 0;
+
+    for (size_t i = from;; i++) {
+        if (!matched && i <= last && (i == from || !re->anchored)) {
+            for (size_t k = 0; k < re->groups * 2; k++) {
+                cur[k] = FOSSIL_REGEX_UNSET;
+            }
+            if (re->nesting) {
+                cur[nslots - 1] = 0;
+            }
+            _regex_add_thread(re, clist, stack, 0, cur, nslots, i, count);
+        }
+        if (clist->set.count == 0 && (matched || re->anchored || i >= last)) {
+            break;
+        }
+
+        uint32_t c = i < count ? _regex_at(str, i, re->unit) : 0;
+        _regex_set_clear(&nlist->set);
+        for (uint32_t t = 0; t < clist->set.count; t++) {
+            const size_t *thread = clist->slots + (size_t)t * nslots;
+            uint32_t pc = clist->set.dense[t] % re->count;
+            const _regex_inst *inst = &re->prog[pc];
+            if (inst->op == OP_MATCH) {
+                memcpy(result, thread, re->groups * 2 * sizeof(*result));
+                matched = 1;
+                break; // threads after this one have lower priority
+            }
+            if (inst->op == OP_CLASS && i < count && _regex_has(re, inst, c)) {
+                memcpy(cur, thread, nslots * sizeof(*cur));
+                if (re->nesting) {
+                    cur[nslots - 1] = 0; // every open iteration has now consumed something
+                }
+                _regex_add_thread(re, nlist, stack, pc + 1, cur, nslots, i + 1, count);
+            }
+        }
+        _regex_list *swap = clist;
+        clist = nlist;
+        nlist = swap;
+        if (i >= count) {
+            break;
+        }
+    }
+
+    free(slots);
+    free(sets);
+    free(stack);
+    return matched;
+}
+
+static int _regex_find(const _regex *regex, const void *str, fossil_regex_capture_t *captures, size_t capacity) {
+    _regex *re = (_regex *)regex; // only the internally locked DFA cache changes
+    size_t count = _fossil_simd_length(str, re->unit);
+    size_t from = 0;
+    size_t end = _regex_scan(re, str, count, &from);
+    if (end == _FOSSIL_SIMD_NONE) {
+        return 0;
+    }
+    if (!captures || capacity == 0) {
+        return 1;
+    }
+
+    size_t *slots = malloc(re->groups * 2 * sizeof(*slots));
+    if (!slots) {
+        return -1;
+    }
+    int found = _regex_pike(re, str, count, from, end, slots);
+    for (size_t g = 0; g < capacity; g++) {
+        int set = found == 1 && g < re->groups && slots[2 * g] != FOSSIL_REGEX_UNSET && slots[2 * g + 1] != FOSSIL_REGEX_UNSET;
+        captures[g].start = set ? slots[2 * g] : FOSSIL_REGEX_UNSET;
+        captures[g].end = set ? slots[2 * g + 1] : FOSSIL_REGEX_UNSET;
+    }
+    free(slots);
+    return found;
+}
+
+// ---- construction ----
+
+// Split the character space into classes that no instruction tells apart
+static int _regex_alphabet(_regex *re, size_t range_count) {
+    re->bounds = malloc((range_count * 2 + 1) * sizeof(*re->bounds));
+    if (!re->bounds) {
+        return 0;
+    }
+    uint32_t count = 0;
+    for (size_t i = 0; i < range_count; i++) {
+        if (re->ranges[i].lo > 0) {
+            re->bounds[count++] = re->ranges[i].lo;
+        }
+        if (re->ranges[i].hi < UINT32_MAX) {
+            re->bounds[count++] = re->ranges[i].hi + 1;
+        }
+    }
+    if (count > 1) {
+        qsort(re->bounds, count, sizeof(*re->bounds), _regex_pc_order);
+    }
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (unique == 0 || re->bounds[unique - 1] != re->bounds[i]) {
+            re->bounds[unique++] = re->bounds[i];
+        }
+    }
+    re->bound_count = unique;
+    re->classes = unique + 1;
+
+    uint32_t k = 0;
+    for (uint32_t c = 0; c < 256; c++) {
+        while (k < unique && re->bounds[k] <= c) {
+            k++;
+        }
+        re->byte_class[c] = k;
+    }
+    return 1;
+}
+
+// Literal characters every match begins with, as a search plan
+static int _regex_prefix(_regex *re, const _regex_builder *b, uint32_t root) {
+    const _regex_node *node = &b->nodes[root];
+    if (node->kind != NODE_CAT || re->anchored) {
+        return 1;
+    }
+    size_t length = 0;
+    for (uint32_t child = node->child; child != REGEX_NONE && b->nodes[child].literal != REGEX_NONE;
+         child = b->nodes[child].next) {
+        length++;
+    }
+    if (length == 0) {
+        return 1;
+    }
+    re->prefix_units = malloc(length * re->unit);
+    if (!re->prefix_units) {
+        return 0;
+    }
+    uint32_t child = node->child;
+    for (size_t i = 0; i < length; i++, child = b->nodes[child].next) {
+        uint32_t value = b->nodes[child].literal;
+        switch (re->unit) {
+            case 1: ((unsigned char *)re->prefix_units)[i] = (unsigned char)value; break;
+            case 2: ((uint16_t *)re->prefix_units)[i] = (uint16_t)value; break;
+            default: ((uint32_t *)re->prefix_units)[i] = value; break;
+        }
+    }
+    _fossil_search_plan_init(&re->prefix, re->prefix_units, length, re->unit,
+                             b->fold ? _FOSSIL_FOLD_ASCII : _FOSSIL_FOLD_NONE);
+    re->has_prefix = 1;
+    return 1;
+}
+
+static void _regex_erase(_regex *re) {
+    if (!re) {
+        return;
+    }
+    _fossil_mutex_destroy(&re->lock);
+    free(re->prog);
+    free(re->ranges);
+    free(re->prefix_units);
+    free(re->bounds);
+    free(re->dfa.states);
+    free(re->dfa.pcs);
+    free(re->dfa.next);
+    free(re->dfa.table);
+    free(re->dfa.set.dense);
+    free(re->dfa.set.sparse);
+    free(re->dfa.stack);
+    free(re->dfa.kernel);
+    free(re->dfa.spare);
+    free(re);
+}
+
+static void *_regex_create(size_t size, const void *pattern, size_t unit, unsigned flags) {
+    if (!pattern) {
+        return NULL;
+    }
+    _regex_builder b;
+    memset(&b, 0, sizeof(b));
+    b.src = pattern;
+    b.count = _fossil_simd_length(pattern, unit);
+    b.unit = unit;
+    b.max = unit == 1 ? 0xFF : unit == 2 ? 0xFFFF : UINT32_MAX;
+    b.fold = (flags & FOSSIL_REGEX_IGNORE_CASE) != 0;
+
+    uint32_t root = _regex_parse_alt(&b);
+    if (!b.error && b.pos != b.count) {
+        b.error = 1; // an unmatched ')'
+    }
+    _regex_emit(&b, OP_SAVE, 0, 0);
+    if (!b.error) {
+        _regex_compile(&b, root, 0);
+    }
+    _regex_emit(&b, OP_SAVE, 1, 0);
+    _regex_emit(&b, OP_MATCH, 0, 0);
+
+    _regex *re = b.error ? NULL : calloc(1, size);
+    if (re) {
+        const _regex_node *top = &b.nodes[root];
+        re->prog = b.prog;
+        re->count = (uint32_t)b.prog_count;
+        re->ranges = b.ranges;
+        re->groups = b.groups + 1;
+        re->nesting = b.nesting;
+        re->unit = unit;
+        re->anchored = top->kind == NODE_CAT && top->child != REGEX_NONE && b.nodes[top->child].kind == NODE_BOL;
+        _fossil_mutex_init(&re->lock);
+        b.prog = NULL;
+        b.ranges = NULL;
+
+        _regex_dfa *dfa = &re->dfa;
+        size_t n = re->count;
+        dfa->start[0] = dfa->start[1] = REGEX_NONE;
+        dfa->set.dense = malloc(n * sizeof(uint32_t));
+        dfa->set.sparse = calloc(n, sizeof(uint32_t));
+        dfa->stack = malloc((2 * n + 1) * sizeof(uint32_t));
+        dfa->kernel = malloc(n * sizeof(uint32_t));
+        dfa->spare = malloc(n * sizeof(uint32_t));
+        if (!dfa->set.dense || !dfa->set.sparse || !dfa->stack || !dfa->kernel || !dfa->spare ||
+            !_regex_alphabet(re, b.range_count) || !_regex_prefix(re, &b, root)) {
+            _regex_erase(re);
+            re = NULL;
+        }
+    }
+    free(b.nodes);
+    free(b.ranges);
+    free(b.scratch);
+    free(b.prog);
+    return re;
+}
+
+fossil_cstr_regex_t *fossil_cstr_regex_create(const_cstring pattern, unsigned flags) {
+    return _regex_create(sizeof(fossil_cstr_regex_t), pattern, sizeof(cletter), flags);
+}
+
+void fossil_cstr_regex_erase(fossil_cstr_regex_t *regex) {
+    _regex_erase(regex ? &regex->re : NULL);
+}
+
+size_t fossil_cstr_regex_groups(const fossil_cstr_regex_t *regex) {
+    return regex ? regex->re.groups : 0;
+}
+
+int fossil_cstr_regex_test(const fossil_cstr_regex_t *regex, const_cstring str) {
+    return regex && str ? _regex_find(&regex->re, str, NULL, 0) : 0;
+}
+
+int fossil_cstr_regex_find(const fossil_cstr_regex_t *regex, const_cstring str,
+                           fossil_regex_capture_t *captures, size_t capacity) {
+    return regex && str ? _regex_find(&regex->re, str, captures, capacity) : 0;
+}
+
+fossil_wstr_regex_t *fossil_wstr_regex_create(const_wstring pattern, unsigned flags) {
+    return _regex_create(sizeof(fossil_wstr_regex_t), pattern, sizeof(wletter), flags);
+}
+
+void fossil_wstr_regex_erase(fossil_wstr_regex_t *regex) {
+    _regex_erase(regex ? &regex->re : NULL);
+}
+
+size_t fossil_wstr_regex_groups(const fossil_wstr_regex_t *regex) {
+    return regex ? regex->re.groups : 0;
+}
+
+int fossil_wstr_regex_test(const fossil_wstr_regex_t *regex, const_wstring str) {
+    return regex && str ? _regex_find(&regex->re, str, NULL, 0) : 0;
+}
+
+int fossil_wstr_regex_find(const fossil_wstr_regex_t *regex, const_wstring str,
+                           fossil_regex_capture_t *captures, size_t capacity) {
+    return regex && str ? _regex_find(&regex->re, str, captures, capacity) : 0;
+}
@@ -0,0 +1,490 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/rope.h"
+
+// Leaves hold a chunk of text; internal nodes only hold their two children
+struct fossil_rope_node {
+    size_t length; // characters below this node
+    int height;    // 0 for leaves
+    fossil_rope_node_t *left;
+    fossil_rope_node_t *right;
+    cletter *data; // chunk characters, leaves only
+};
+
+// Nodes a single insert, delete or concat may take from the cache
+#define ROPE_SPARE_RESERVE 4
+#define ROPE_SPARE_LIMIT 64
+
+static int _rope_is_leaf(const fossil_rope_node_t *node) {
+    return node->left == NULL;
+}
+
+static int _rope_height(const fossil_rope_node_t *node) {
+    return node ? node->height : -1;
+}
+
+static void _rope_update(fossil_rope_node_t *node) {
+    int lh = node->left->height;
+    int rh = node->right->height;
+    node->height = 1 + (lh > rh ? lh : rh);
+    node->length = node->left->length + node->right->length;
+}
+
+// Take a node from the cache; callers reserve enough beforehand
+static fossil_rope_node_t *_rope_take(fossil_rope_t *rope) {
+    fossil_rope_node_t *node = rope->spare;
+    rope->spare = node->left;
+    rope->spare_count--;
+    return node;
+}
+
+static void _rope_give(fossil_rope_t *rope, fossil_rope_node_t *node) {
+    if (rope->spare_count >= ROPE_SPARE_LIMIT) {
+        free(node);
+        return;
+    }
+    node->left = rope->spare;
+    rope->spare = node;
+    rope->spare_count++;
+}
+
+static int _rope_reserve(fossil_rope_t *rope) {
+    while (rope->spare_count < ROPE_SPARE_RESERVE) {
+        fossil_rope_node_t *node = malloc(sizeof(fossil_rope_node_t));
+        if (!node) {
+            return -1;
+        }
+        node->left = rope->spare;
+        rope->spare = node;
+        rope->spare_count++;
+    }
+    return 0;
+}
+
+static void _rope_free_tree(fossil_rope_t *rope, fossil_rope_node_t *node) {
+    while (node) {
+        fossil_rope_node_t *right = node->right;
+        if (_rope_is_leaf(node)) {
+            free(node->data);
+        } else {
+            _rope_free_tree(rope, node->left);
+        }
+        if (rope) {
+            _rope_give(rope, node);
+        } else {
+            free(node);
+        }
+        node = right;
+    }
+}
+
+static fossil_rope_node_t *_rope_rotate_right(fossil_rope_node_t *node) {
+    fossil_rope_node_t *pivot = node->left;
+    node->left = pivot->right;
+    _rope_update(node);
+    pivot->right = node;
+    _rope_update(pivot);
+    return pivot;
+}
+
+static fossil_rope_node_t *_rope_rotate_left(fossil_rope_node_t *node) {
+    fossil_rope_node_t *pivot = node->right;
+    node->right = pivot->left;
+    _rope_update(node);
+    pivot->left = node;
+    _rope_update(pivot);
+    return pivot;
+}
+
+static fossil_rope_node_t *_rope_balance(fossil_rope_node_t *node) {
+    int diff = node->left->height - node->right->height;
+    if (diff > 1) {
+        if (_rope_height(node->left->left) < _rope_height(node->left->right)) {
+            node->left = _rope_rotate_left(node->left);
+        }
+        return _rope_rotate_right(node);
+    }
+    if (diff < -1) {
+        if (_rope_height(node->right->right) < _rope_height(node->right->left)) {
+            node->right = _rope_rotate_right(node->right);
+        }
+        return _rope_rotate_left(node);
+    }
+    return node;
+}
+
+// Concatenate two balanced trees; uses at most one cached node
+static fossil_rope_node_t *_rope_join(fossil_rope_t *rope, fossil_rope_node_t *a, fossil_rope_node_t *b) {
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+
+    // Merge neighbouring small chunks so repeated small inserts stay compact
+    if (_rope_is_leaf(a) && _rope_is_leaf(b) && a->length + b->length <= FOSSIL_ROPE_CHUNK) {
+        cletter *data = realloc(a->data, a->length + b->length);
+        if (data) {
+            memcpy(data + a->length, b->data, b->length);
+            a->data = data;
+            a->length += b->length;
+            free(b->data);
+            _rope_give(rope, b);
+            return a;
+        }
+    }
+
+    if (a->height > b->height + 1) {
+        a->right = _rope_join(rope, a->right, b);
+        _rope_update(a);
+        return _rope_balance(a);
+    }
+    if (b->height > a->height + 1) {
+        b->left = _rope_join(rope, a, b->left);
+        _rope_update(b);
+        return _rope_balance(b);
+    }
+
+    fossil_rope_node_t *node = _rope_take(rope);
+    node->left = a;
+    node->right = b;
+    node->data = NULL;
+    _rope_update(node);
+    return node;
+}
+
+// Number of characters the right half of a leaf needs when splitting at 'index'
+static size_t _rope_split_need(const fossil_rope_node_t *node, size_t index) {
+    while (node && !_rope_is_leaf(node)) {
+        if (index < node->left->length) {
+            node = node->left;
+        } else {
+            index -= node->left->length;
+            node = node->right;
+        }
+    }
+    if (!node || index == 0 || index >= node->length) {
+        return 0;
+    }
+    return node->length - index;
+}
+
+// Split a tree at 'index'; 'buffer' holds the preallocated right half of a split leaf
+static void _rope_split(fossil_rope_t *rope, fossil_rope_node_t *node, size_t index, cletter *buffer,
+                        fossil_rope_node_t **left, fossil_rope_node_t **right) {
+    if (!node || index == 0) {
+        *left = NULL;
+        *right = node;
+        return;
+    }
+    if (index >= node->length) {
+        *left = node;
+        *right = NULL;
+        return;
+    }
+    if (_rope_is_leaf(node)) {
+        fossil_rope_node_t *tail = _rope_take(rope);
+        tail->length = node->length - index;
+        tail->height = 0;
+        tail->left = tail->right = NULL;
+        tail->data = buffer;
+        memcpy(buffer, node->data + index, tail->length);
+        node->length = index;
+        *left = node;
+        *right = tail;
+        return;
+    }
+
+    fossil_rope_node_t *l = node->left;
+    fossil_rope_node_t *r = node->right;
+    _rope_give(rope, node);
+
+    fossil_rope_node_t *a, *b;
+    if (index < l->length) {
+        _rope_split(rope, l, index, buffer, &a, &b);
+        *left = a;
+        *right = _rope_join(rope, b, r);
+    } else {
+        _rope_split(rope, r, index - l->length, buffer, &a, &b);
+        *left = _rope_join(rope, l, a);
+        *right = b;
+    }
+}
+
+// Split the root at 'index', allocating everything up front so nothing fails midway
+static int _rope_split_root(fossil_rope_t *rope, size_t index,
+                            fossil_rope_node_t **left, fossil_rope_node_t **right) {
+    size_t need = _rope_split_need(rope->root, index);
+    cletter *buffer = NULL;
+    if (need > 0) {
+        buffer = malloc(need);
+        if (!buffer) {
+            return -1;
+        }
+    }
+    if (_rope_reserve(rope) != 0) {
+        free(buffer);
+        return -1;
+    }
+    _rope_split(rope, rope->root, index, buffer, left, right);
+    rope->root = NULL;
+    return 0;
+}
+
+// Build a balanced tree of full chunks from flat text
+static fossil_rope_node_t *_rope_build(const_cstring str, size_t len) {
+    if (len == 0) {
+        return NULL;
+    }
+    fossil_rope_node_t *node = malloc(sizeof(fossil_rope_node_t));
+    if (!node) {
+        return NULL;
+    }
+    if (len <= FOSSIL_ROPE_CHUNK) {
+        node->data = malloc(len);
+        if (!node->data) {
+            free(node);
+            return NULL;
+        }
+        memcpy(node->data, str, len);
+        node->length = len;
+        node->height = 0;
+        node->left = node->right = NULL;
+        return node;
+    }
+
+    // Halve by chunk count so sibling heights never differ by more than one
+    size_t chunks = (len + FOSSIL_ROPE_CHUNK - 1) / FOSSIL_ROPE_CHUNK;
+    size_t split = (chunks / 2) * FOSSIL_ROPE_CHUNK;
+    node->data = NULL;
+    node->left = _rope_build(str, split);
+    node->right = node->left ? _rope_build(str + split, len - split) : NULL;
+    if (!node->left || !node->right) {
+        _rope_free_tree(NULL, node->left);
+        free(node);
+        return NULL;
+    }
+    _rope_update(node);
+    return node;
+}
+
+fossil_rope_t *fossil_rope_create_len(const_cstring str, size_t len) {
+    if (!str && len > 0) {
+        return NULL;
+    }
+    fossil_rope_t *rope = malloc(sizeof(fossil_rope_t));
+    if (!rope) {
+        return NULL;
+    }
+    rope->spare = NULL;
+    rope->spare_count = 0;
+    rope->root = _rope_build(str, len);
+    if (len > 0 && !rope->root) {
+        free(rope);
+        return NULL;
+    }
+    return rope;
+}
+
+fossil_rope_t *fossil_rope_create(const_cstring str) {
+    return fossil_rope_create_len(str, str ? strlen(str) : 0);
+}
+
+void fossil_rope_erase(fossil_rope_t *rope) {
+    if (!rope) {
+        return;
+    }
+    _rope_free_tree(NULL, rope->root);
+    while (rope->spare) {
+        fossil_rope_node_t *next = rope->spare->left;
+        free(rope->spare);
+        rope->spare = next;
+    }
+    free(rope);
+}
+
+size_t fossil_rope_length(const fossil_rope_t *rope) {
+    return (rope && rope->root) ? rope->root->length : 0;
+}
+
+cletter fossil_rope_at(const fossil_rope_t *rope, size_t index) {
+    if (!rope || index >= fossil_rope_length(rope)) {
+        return '\0'; // Out-of-bounds access or null pointer
+    }
+    const fossil_rope_node_t *node = rope->root;
+    while (!_rope_is_leaf(node)) {
+        if (index < node->left->length) {
+            node = node->left;
+        } else {
+            index -= node->left->length;
+            node = node->right;
+        }
+    }
+    return node->data[index];
+}
+
+int fossil_rope_insert_len(fossil_rope_t *rope, size_t pos, const_cstring str, size_t len) {
+    if (!rope || (!str && len > 0)) {
+        return -1;
+    }
+    if (len == 0) {
+        return 0;
+    }
+    if (pos > fossil_rope_length(rope)) {
+        pos = fossil_rope_length(rope);
+    }
+
+    fossil_rope_node_t *middle = _rope_build(str, len);
+    if (!middle) {
+        return -1;
+    }
+    fossil_rope_node_t *left, *right;
+    if (_rope_split_root(rope, pos, &left, &right) != 0) {
+        _rope_free_tree(NULL, middle);
+        return -1;
+    }
+    rope->root = _rope_join(rope, _rope_join(rope, left, middle), right);
+    return 0;
+}
+
+int fossil_rope_insert(fossil_rope_t *rope, size_t pos, const_cstring str) {
+    if (!str) {
+        return -1;
+    }
+    return fossil_rope_insert_len(rope, pos, str, strlen(str));
+}
+
+int fossil_rope_append(fossil_rope_t *rope, const_cstring str) {
+    return fossil_rope_insert(rope, fossil_rope_length(rope), str);
+}
+
+int fossil_rope_delete(fossil_rope_t *rope, size_t pos, size_t len) {
+    if (!rope) {
+        return -1;
+    }
+    size_t total = fossil_rope_length(rope);
+    if (pos >= total || len == 0) {
+        return 0;
+    }
+    if (len > total - pos) {
+        len = total - pos;
+    }
+
+    fossil_rope_node_t *left, *rest, *middle, *right;
+    if (_rope_split_root(rope, pos, &left, &rest) != 0) {
+        return -1;
+    }
+    rope->root = rest;
+    if (_rope_split_root(rope, len, &middle, &right) != 0) {
+        rope->root = _rope_join(rope, left, rest); // Undo the first split
+        return -1;
+    }
+    _rope_free_tree(rope, middle);
+    rope->root = _rope_join(rope, left, right);
+    return 0;
+}
+
+int fossil_rope_concat(fossil_rope_t *dest, fossil_rope_t *src) {
+    if (!dest || !src || dest == src) {
+        return -1;
+    }
+    if (_rope_reserve(dest) != 0) {
+        return -1;
+    }
+    dest->root = _rope_join(dest, dest->root, src->root);
+    src->root = NULL;
+    return 0;
+}
+
+// Copy 'len' characters starting at 'start' below 'node' into 'out'
+static void _rope_copy(const fossil_rope_node_t *node, size_t start, size_t len, cletter *out) {
+    while (len > 0) {
+        if (_rope_is_leaf(node)) {
+            memcpy(out, node->data + start, len);
+            return;
+        }
+        size_t left_len = node->left->length;
+        if (start >= left_len) {
+            start -= left_len;
+            node = node->right;
+            continue;
+        }
+        size_t take = left_len - start < len ? left_len - start : len;
+        _rope_copy(node->left, start, take, out);
+        out += take;
+        len -= take;
+        start = 0;
+        node = node->right;
+    }
+}
+
+cstring fossil_rope_slice(const fossil_rope_t *rope, size_t start, size_t len) {
+    size_t total = fossil_rope_length(rope);
+    if (!rope || start > total || (start == total && total > 0)) {
+        return NULL;
+    }
+    if (len > total - start) {
+        len = total - start;
+    }
+    cstring out = fossil_allocator_alloc(NULL, len + 1);
+    if (!out) {
+        return NULL;
+    }
+    if (len > 0) {
+        _rope_copy(rope->root, start, len, out);
+    }
+    out[len] = '\0';
+    return out;
+}
+
+cstring fossil_rope_flatten(const fossil_rope_t *rope) {
+    return fossil_rope_slice(rope, 0, fossil_rope_length(rope));
+}
+
+static void _rope_iter_push_left(fossil_rope_iter_t *iter, const fossil_rope_node_t *node) {
+    while (node && iter->depth < FOSSIL_ROPE_MAX_DEPTH) {
+        iter->stack[iter->depth++] = node;
+        node = node->left;
+    }
+}
+
+void fossil_rope_iter_init(fossil_rope_iter_t *iter, const fossil_rope_t *rope) {
+    if (!iter) {
+        return;
+    }
+    iter->depth = 0;
+    if (rope) {
+        _rope_iter_push_left(iter, rope->root);
+    }
+}
+
+int fossil_rope_iter_next(fossil_rope_iter_t *iter, const_cstring *chunk, size_t *len) {
+    if (!iter || iter->depth == 0) {
+        return 0;
+    }
+    // The top of the stack is always the next leaf in order
+    const fossil_rope_node_t *leaf = iter->stack[--iter->depth];
+    if (chunk) {
+        *chunk = leaf->data;
+    }
+    if (len) {
+        *len = leaf->length;
+    }
+    if (iter->depth > 0) {
+        const fossil_rope_node_t *parent = iter->stack[--iter->depth];
+        _rope_iter_push_left(iter, parent->right);
+    }
+    return 1;
+}
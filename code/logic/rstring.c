@@ -0,0 +1,177 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/rstring.h"
+#include "sync.h"
+
+// Hidden header stored right before the character data of every rstring
+typedef struct {
+    _fossil_atomic_size refs;
+    size_t length;
+    size_t capacity;
+} _rstr_header;
+
+static _rstr_header *_rstr_head(rstring str) {
+    return (_rstr_header *)(void *)((char *)(uintptr_t)str - sizeof(_rstr_header));
+}
+
+static cstring _rstr_alloc(size_t capacity) {
+    if (capacity > SIZE_MAX - sizeof(_rstr_header) - 1) {
+        return NULL; // Size overflow
+    }
+    _rstr_header *head = fossil_allocator_alloc(NULL, sizeof(_rstr_header) + capacity + 1);
+    if (!head) {
+        return NULL;
+    }
+    _fossil_atomic_init(&head->refs, 1);
+    head->length = 0;
+    head->capacity = capacity;
+    return (cstring)(head + 1);
+}
+
+rstring fossil_rstr_create_len(const_cstring str, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+    cstring out = _rstr_alloc(len);
+    if (!out) {
+        return NULL;
+    }
+    memcpy(out, str, len);
+    out[len] = '\0';
+    _rstr_head(out)->length = len;
+    return out;
+}
+
+rstring fossil_rstr_create(const_cstring str) {
+    if (!str) {
+        return NULL;
+    }
+    return fossil_rstr_create_len(str, strlen(str));
+}
+
+rstring fossil_rstr_retain(rstring str) {
+    if (str) {
+        _fossil_atomic_inc(&_rstr_head(str)->refs);
+    }
+    return str;
+}
+
+void fossil_rstr_release(rstring str) {
+    if (str && _fossil_atomic_dec(&_rstr_head(str)->refs) == 0) {
+        fossil_allocator_release(NULL, _rstr_head(str));
+    }
+}
+
+size_t fossil_rstr_length(rstring str) {
+    return str ? _rstr_head(str)->length : 0;
+}
+
+size_t fossil_rstr_refcount(rstring str) {
+    return str ? _fossil_atomic_load(&_rstr_head(str)->refs) : 0;
+}
+
+int fossil_rstr_compare(rstring str1, rstring str2) {
+    if (!str1 || !str2) {
+        return -1;
+    }
+    if (str1 == str2) {
+        return 0; // Same shared buffer
+    }
+    size_t len1 = _rstr_head(str1)->length;
+    size_t len2 = _rstr_head(str2)->length;
+    int cmp = memcmp(str1, str2, len1 < len2 ? len1 : len2);
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (len1 > len2) - (len1 < len2);
+}
+
+// Only the holder of the last reference may write to the buffer
+static int _rstr_is_unique(rstring str) {
+    return _fossil_atomic_load(&_rstr_head(str)->refs) == 1;
+}
+
+rstring fossil_rstr_concat(rstring str, const_cstring src) {
+    if (!str || !src) {
+        return NULL;
+    }
+    size_t len = _rstr_head(str)->length;
+    size_t add = strlen(src);
+    if (add > SIZE_MAX - sizeof(_rstr_header) - 1 - len) {
+        return NULL; // Size overflow
+    }
+
+    // 'src' pointing into 'str' would move with the buffer, so copy in that case
+    int aliased = src >= str && src <= str + len;
+    if (_rstr_is_unique(str) && !aliased) {
+        _rstr_header *head = _rstr_head(str);
+        if (len + add > head->capacity) {
+            // Grow geometrically so repeated appends stay amortized O(1)
+            size_t grown = head->capacity * 2 > len + add ? head->capacity * 2 : len + add;
+            if (grown > SIZE_MAX - sizeof(_rstr_header) - 1) {
+                grown = len + add;
+            }
+            _rstr_header *moved = fossil_allocator_resize(NULL, head, sizeof(_rstr_header) + grown + 1);
+            if (!moved) {
+                return NULL;
+            }
+            moved->capacity = grown;
+            head = moved;
+        }
+        cstring data = (cstring)(head + 1);
+        memcpy(data + len, src, add + 1);
+        head->length = len + add;
+        return data;
+    }
+
+    // Shared: copy, then drop the caller's reference to the original
+    cstring copy = _rstr_alloc(len + add);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy, str, len);
+    memcpy(copy + len, src, add + 1);
+    _rstr_head(copy)->length = len + add;
+    fossil_rstr_release(str);
+    return copy;
+}
+
+rstring fossil_rstr_reverse(rstring str) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _rstr_head(str)->length;
+    cstring out;
+    if (_rstr_is_unique(str)) {
+        out = (cstring)(uintptr_t)str;
+        for (size_t i = 0; i < len / 2; i++) {
+            cletter tmp = out[i];
+            out[i] = out[len - i - 1];
+            out[len - i - 1] = tmp;
+        }
+        return out;
+    }
+
+    out = _rstr_alloc(len);
+    if (!out) {
+        return NULL;
+    }
+    for (size_t i = 0; i < len; i++) {
+        out[i] = str[len - i - 1];
+    }
+    out[len] = '\0';
+    _rstr_head(out)->length = len;
+    fossil_rstr_release(str);
+    return out;
+}
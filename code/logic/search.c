@@ -0,0 +1,354 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "search.h"
+#include "fold.h"
+
+#include <string.h>
+
+/*
+ * A sequence of units read forwards or backwards, optionally case folded. Running Two-Way over the reversed haystack
+ * and needle finds the last occurrence, so rfind shares the forward code.
+ */
+typedef struct {
+    const unsigned char *data;
+    size_t count;
+    size_t unit;
+    int reverse;
+    int fold; // a _FOSSIL_FOLD_ mode
+} _search_seq;
+
+static inline uint32_t _search_at(const _search_seq *seq, size_t index) {
+    uint32_t value;
+    if (seq->reverse) {
+        index = seq->count - 1 - index;
+    }
+    switch (seq->unit) {
+        case 1: value = seq->data[index]; break;
+        case 2: value = ((const uint16_t *)(const void *)seq->data)[index]; break;
+        default: value = ((const uint32_t *)(const void *)seq->data)[index]; break;
+    }
+    if (seq->fold) {
+        value = _fossil_fold_unit(value, seq->fold == _FOSSIL_FOLD_WIDE);
+    }
+    return value;
+}
+
+/*
+ * Critical factorization of the needle: the larger of its maximal suffixes
+ * under the two unit orderings. Returns where the right half starts and
+ * stores that half's period in 'period'.
+ */
+static size_t _search_critical(const _search_seq *needle, size_t *period) {
+    size_t count = needle->count;
+    size_t suffix = SIZE_MAX, suffix_rev = SIZE_MAX;
+    size_t j = 0, k = 1, p = 1;
+
+    while (j + k < count) {
+        uint32_t a = _search_at(needle, j + k);
+        uint32_t b = _search_at(needle, suffix + k);
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - suffix;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            suffix = j++;
+            k = p = 1;
+        }
+    }
+    *period = p;
+
+    j = 0;
+    k = p = 1;
+    while (j + k < count) {
+        uint32_t a = _search_at(needle, j + k);
+        uint32_t b = _search_at(needle, suffix_rev + k);
+        if (b < a) {
+            j += k;
+            k = 1;
+            p = j - suffix_rev;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            suffix_rev = j++;
+            k = p = 1;
+        }
+    }
+
+    // SIZE_MAX stands for "before the first unit", so compare one past
+    if (suffix_rev + 1 < suffix + 1) {
+        return suffix + 1;
+    }
+    *period = p;
+    return suffix_rev + 1;
+}
+
+// Fill in the Two-Way fields of 'plan' for the needle read through 'needle'
+static void _search_factor(_fossil_search_plan *plan, const _search_seq *needle) {
+    size_t count = needle->count;
+    plan->split = _search_critical(needle, &plan->period);
+    plan->periodic = plan->period < count;
+    for (size_t i = 0; plan->periodic && i < plan->split; i++) {
+        plan->periodic = _search_at(needle, i) == _search_at(needle, i + plan->period);
+    }
+    if (!plan->periodic) {
+        plan->period = (plan->split > count - plan->split ? plan->split : count - plan->split) + 1;
+    }
+}
+
+// Two-Way search starting at 'start'; at most 2 * count unit comparisons
+static size_t _search_two_way(const _fossil_search_plan *plan, const _search_seq *haystack,
+                              const _search_seq *needle, size_t start) {
+    size_t count = needle->count;
+    size_t split = plan->split;
+    size_t period = plan->period;
+    size_t last = haystack->count - count;
+    size_t i, j = start;
+
+    if (plan->periodic) {
+        // The left half repeats, so a match on it can be remembered across shifts
+        size_t memory = 0;
+        while (j <= last) {
+            i = split > memory ? split : memory;
+            while (i < count && _search_at(needle, i) == _search_at(haystack, i + j)) {
+                i++;
+            }
+            if (i < count) {
+                j += i - split + 1;
+                memory = 0;
+                continue;
+            }
+            i = split;
+            while (i > memory && _search_at(needle, i - 1) == _search_at(haystack, i - 1 + j)) {
+                i--;
+            }
+            if (i <= memory) {
+                return j;
+            }
+            j += period;
+            memory = count - period;
+        }
+    } else {
+        while (j <= last) {
+            i = split;
+            while (i < count && _search_at(needle, i) == _search_at(haystack, i + j)) {
+                i++;
+            }
+            if (i < count) {
+                j += i - split + 1;
+                continue;
+            }
+            i = split;
+            while (i > 0 && _search_at(needle, i - 1) == _search_at(haystack, i - 1 + j)) {
+                i--;
+            }
+            if (i == 0) {
+                return j;
+            }
+            j += period;
+        }
+    }
+    return _FOSSIL_SIMD_NONE;
+}
+
+static uint32_t _search_unit_at(const void *data, size_t index, size_t unit) {
+    _search_seq seq = { data, index + 1, unit, 0, 0 };
+    return _search_at(&seq, index);
+}
+
+/*
+ * Rough commonness of a unit in text, higher meaning more common. The
+ * prefilter probes the needle's least common units so that candidates
+ * are few; this only has to order units sensibly, not be exact.
+ */
+static unsigned _search_rank(uint32_t value) {
+    static const char letters[] = "etaoinshrdlcumwfgypbvkjxqz";
+    if (value == ' ') {
+        return 255;
+    }
+    if (value - 'a' < 26) {
+        return 250 - (unsigned)(strchr(letters, (int)value) - letters) * 4;
+    }
+    if (value - 'A' < 26 || value - '0' < 10) {
+        return 140;
+    }
+    if (value == '.' || value == ',' || value == '/' || value == '-' || value == '_' ||
+        value == '=' || value == ':' || value == '\n' || value == '\t') {
+        return 130;
+    }
+    return value < 128 ? 60 : 20;
+}
+
+void _fossil_search_plan_init(_fossil_search_plan *plan, const void *needle, size_t count, size_t unit, int fold) {
+    plan->needle = needle;
+    plan->count = count;
+    plan->unit = unit;
+    plan->fold = fold;
+    plan->probe[0] = plan->probe[1] = 0;
+    plan->split = 0;
+    plan->period = 1;
+    plan->periodic = 0;
+    if (count == 0) {
+        return;
+    }
+
+    _search_seq seq = { needle, count, unit, 0, fold };
+    _search_factor(plan, &seq);
+
+    // The rarest unit, then the rarest unit with a different value
+    size_t rare = 0, other = count - 1;
+    for (size_t i = 1; i < count; i++) {
+        if (_search_rank(_search_at(&seq, i)) < _search_rank(_search_at(&seq, rare))) {
+            rare = i;
+        }
+    }
+    uint32_t rare_value = _search_at(&seq, rare);
+    int found = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = _search_at(&seq, i);
+        if (value != rare_value &&
+            (!found || _search_rank(value) < _search_rank(_search_at(&seq, other)))) {
+            other = i;
+            found = 1;
+        }
+    }
+    if (!found) {
+        other = rare == 0 ? count - 1 : 0;
+    }
+    plan->probe[0] = rare < other ? rare : other;
+    plan->probe[1] = rare < other ? other : rare;
+}
+
+size_t _fossil_search_plan_find(const _fossil_search_plan *plan, const void *haystack, size_t count, size_t start) {
+    size_t needle_count = plan->count;
+    size_t unit = plan->unit;
+    if (start > count || needle_count > count - start) {
+        return _FOSSIL_SIMD_NONE;
+    }
+    if (needle_count == 0) {
+        return start;
+    }
+
+    /*
+     * towlower can map a unit from outside ASCII onto an ASCII letter, so
+     * the ASCII-folding prefilter would miss matches in wide fold mode.
+     */
+    size_t pos = start;
+    if (plan->fold != _FOSSIL_FOLD_WIDE) {
+        const unsigned char *bytes = haystack;
+        _search_seq pat = { plan->needle, needle_count, unit, 0, plan->fold };
+        uint32_t first = _search_at(&pat, plan->probe[0]);
+        if (needle_count == 1 && !plan->fold) {
+            size_t hit = _fossil_simd_find(bytes + pos * unit, count - pos, first, unit);
+            return hit == _FOSSIL_SIMD_NONE ? hit : pos + hit;
+        }
+
+        /*
+         * Jump between places where both probe units match and verify each
+         * one. Text that keeps producing false candidates (long runs of one
+         * character, say) is handed to Two-Way once the failed checks
+         * outweigh the ground covered, which keeps the total linear.
+         */
+        uint32_t second = _search_at(&pat, plan->probe[1]);
+        size_t offset = plan->probe[0];
+        size_t gap = plan->probe[1] - plan->probe[0];
+        size_t failures = 0;
+        while (pos + needle_count <= count) {
+            size_t window = count - pos - needle_count + 1 + gap; // probe positions that fit
+            size_t hit = _fossil_simd_find_pair(bytes + (pos + offset) * unit, window, first, second, gap, unit, plan->fold);
+            if (hit == _FOSSIL_SIMD_NONE) {
+                return _FOSSIL_SIMD_NONE;
+            }
+            pos += hit;
+            const void *candidate = bytes + pos * unit;
+            if (plan->fold ? _fossil_simd_fold_mismatch(candidate, plan->needle, needle_count, unit) == _FOSSIL_SIMD_NONE
+                           : memcmp(candidate, plan->needle, needle_count * unit) == 0) {
+                return pos;
+            }
+            pos++;
+            if (++failures > 8 + (pos - start) / needle_count) {
+                break;
+            }
+        }
+        if (pos + needle_count > count) {
+            return _FOSSIL_SIMD_NONE;
+        }
+    }
+
+    _search_seq hay = { haystack, count, unit, 0, plan->fold };
+    _search_seq pat = { plan->needle, needle_count, unit, 0, plan->fold };
+    return _search_two_way(plan, &hay, &pat, pos);
+}
+
+size_t _fossil_search_plan_find_all(const _fossil_search_plan *plan, const void *haystack, size_t count,
+                                    size_t *offsets, size_t capacity) {
+    if (plan->count == 0) {
+        return 0;
+    }
+    if (plan->count == 1 && !plan->fold) {
+        return _fossil_simd_find_all(haystack, count, _search_unit_at(plan->needle, 0, plan->unit), plan->unit, offsets, capacity);
+    }
+    size_t found = 0;
+    size_t at = _fossil_search_plan_find(plan, haystack, count, 0);
+    while (at != _FOSSIL_SIMD_NONE) {
+        if (found < capacity) {
+            offsets[found] = at;
+        }
+        found++;
+        at = _fossil_search_plan_find(plan, haystack, count, at + plan->count);
+    }
+    return found;
+}
+
+size_t _fossil_search_find(const void *haystack, size_t count, const void *needle, size_t needle_count, size_t unit) {
+    if (needle_count > count) {
+        return _FOSSIL_SIMD_NONE;
+    }
+    if (needle_count == 1) {
+        return _fossil_simd_find(haystack, count, _search_unit_at(needle, 0, unit), unit);
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, needle_count, unit, _FOSSIL_FOLD_NONE);
+    return _fossil_search_plan_find(&plan, haystack, count, 0);
+}
+
+size_t _fossil_search_rfind(const void *haystack, size_t count, const void *needle, size_t needle_count, size_t unit) {
+    if (needle_count > count) {
+        return _FOSSIL_SIMD_NONE;
+    }
+    if (needle_count == 0) {
+        return count;
+    }
+    if (needle_count == 1) {
+        return _fossil_simd_rfind(haystack, count, _search_unit_at(needle, 0, unit), unit);
+    }
+
+    _search_seq hay = { haystack, count, unit, 1, 0 };
+    _search_seq pat = { needle, needle_count, unit, 1, 0 };
+    _fossil_search_plan plan;
+    _search_factor(&plan, &pat);
+    size_t hit = _search_two_way(&plan, &hay, &pat, 0);
+    return hit == _FOSSIL_SIMD_NONE ? hit : count - needle_count - hit;
+}
@@ -0,0 +1,63 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SEARCH_H
+#define FOSSIL_STRINGS_SEARCH_H
+
+/*
+ * Private substring search shared by the string families. Both directions
+ * use the Two-Way algorithm, so a search never costs more than a constant
+ * times the haystack plus needle length. 'unit' is the code unit size in
+ * bytes (1, 2 or 4) and every length or index is in units.
+ */
+
+#include "simd.h"
+
+// Case folding modes for a plan
+#define _FOSSIL_FOLD_NONE 0
+#define _FOSSIL_FOLD_ASCII 1 // ASCII letters match either case
+#define _FOSSIL_FOLD_WIDE 2  // also fold beyond ASCII through towlower
+
+/*
+ * Everything a search needs to know about its needle, computed once so a
+ * needle that is searched for repeatedly pays for its setup only once.
+ * The plan refers to the needle rather than copying it.
+ */
+typedef struct {
+    const void *needle;
+    size_t count;
+    size_t unit;
+    int fold;        // a _FOSSIL_FOLD_ mode
+    size_t split;    // Two-Way critical factorization
+    size_t period;
+    int periodic;
+    size_t probe[2]; // positions of the two rarest units, tried first
+} _fossil_search_plan;
+
+// Prepare a plan for 'needle' under a _FOSSIL_FOLD_ mode
+void _fossil_search_plan_init(_fossil_search_plan *plan, const void *needle, size_t count, size_t unit, int fold);
+
+// Index of the first match at or after 'start', or _FOSSIL_SIMD_NONE
+size_t _fossil_search_plan_find(const _fossil_search_plan *plan, const void *haystack, size_t count, size_t start);
+
+// Store non-overlapping match indexes while 'capacity' allows and return how many there are
+size_t _fossil_search_plan_find_all(const _fossil_search_plan *plan, const void *haystack, size_t count,
+                                    size_t *offsets, size_t capacity);
+
+// Index of the first occurrence of 'needle' in 'haystack', or _FOSSIL_SIMD_NONE
+size_t _fossil_search_find(const void *haystack, size_t count, const void *needle, size_t needle_count, size_t unit);
+
+// Index of the last occurrence of 'needle' in 'haystack', or _FOSSIL_SIMD_NONE
+size_t _fossil_search_rfind(const void *haystack, size_t count, const void *needle, size_t needle_count, size_t unit);
+
+#endif /* FOSSIL_STRINGS_SEARCH_H */
@@ -0,0 +1,1321 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "simd.h"
+#include "sync.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Kernels compare a whole vector of units against a splatted character and
+ * turn the result into a bit mask with one bit per byte, so a unit of size
+ * 'unit' owns 'unit' consecutive bits. Bounded kernels use unaligned loads
+ * and finish the tail in C. Kernels on zero-terminated strings use aligned
+ * loads only: an aligned vector never crosses a page boundary, so reading
+ * past the terminator is safe even though sanitizers cannot see that.
+ * Define FOSSIL_STRINGS_NO_SIMD to build the portable kernels only.
+ */
+
+#if !defined(FOSSIL_STRINGS_NO_SIMD) && (defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC)))
+#define SIMD_X86 1
+#include <immintrin.h>
+#elif !defined(FOSSIL_STRINGS_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_AVX2 __attribute__((target("avx2,popcnt,pclmul")))
+#define SIMD_UNCHECKED __attribute__((no_sanitize_address))
+#else
+#define SIMD_AVX2
+#define SIMD_UNCHECKED
+#endif
+
+#define SIMD_NONE _FOSSIL_SIMD_NONE
+#define SIMD_MAX_SET 16 // larger find_any sets use the portable kernel
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Portable kernels
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static uint32_t _scalar_at(const void *data, size_t index, size_t unit) {
+    if (unit == 1) {
+        return ((const uint8_t *)data)[index];
+    }
+    if (unit == 2) {
+        return ((const uint16_t *)data)[index];
+    }
+    return ((const uint32_t *)data)[index];
+}
+
+static size_t _scalar_find(const void *data, size_t count, uint32_t ch, size_t unit) {
+    for (size_t i = 0; i < count; i++) {
+        if (_scalar_at(data, i, unit) == ch) {
+            return i;
+        }
+    }
+    return SIMD_NONE;
+}
+
+static size_t _scalar_rfind(const void *data, size_t count, uint32_t ch, size_t unit) {
+    for (size_t i = count; i-- > 0;) {
+        if (_scalar_at(data, i, unit) == ch) {
+            return i;
+        }
+    }
+    return SIMD_NONE;
+}
+
+static size_t _scalar_count(const void *data, size_t count, uint32_t ch, size_t unit) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += _scalar_at(data, i, unit) == ch;
+    }
+    return total;
+}
+
+static size_t _scalar_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (_scalar_at(data, i, unit) == ch) {
+            if (total < capacity) {
+                offsets[total] = i;
+            }
+            total++;
+        }
+    }
+    return total;
+}
+
+static size_t _scalar_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit) {
+    if (unit == 1) {
+        // Byte sets become a lookup table
+        unsigned char table[256] = { 0 };
+        for (size_t j = 0; j < set_count; j++) {
+            table[((const uint8_t *)set)[j]] = 1;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (table[((const uint8_t *)data)[i]]) {
+                return i;
+            }
+        }
+        return SIMD_NONE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = _scalar_at(data, i, unit);
+        for (size_t j = 0; j < set_count; j++) {
+            if (_scalar_at(set, j, unit) == value) {
+                return i;
+            }
+        }
+    }
+    return SIMD_NONE;
+}
+
+// ASCII upper case to lower case; everything else is left alone
+static uint32_t _scalar_fold(uint32_t value) {
+    return value - 'A' < 26 ? value + ('a' - 'A') : value;
+}
+
+static size_t _scalar_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold) {
+    for (size_t i = 0; i + gap < count; i++) {
+        uint32_t a = _scalar_at(data, i, unit);
+        uint32_t b = _scalar_at(data, i + gap, unit);
+        if (fold) {
+            a = _scalar_fold(a);
+            b = _scalar_fold(b);
+        }
+        if (a == first && b == last) {
+            return i;
+        }
+    }
+    return SIMD_NONE;
+}
+
+static size_t _scalar_fold_mismatch(const void *a, const void *b, size_t count, size_t unit) {
+    for (size_t i = 0; i < count; i++) {
+        if (_scalar_fold(_scalar_at(a, i, unit)) != _scalar_fold(_scalar_at(b, i, unit))) {
+            return i;
+        }
+    }
+    return SIMD_NONE;
+}
+
+static void _scalar_fold_copy(void *dst, const void *src, size_t count, size_t unit) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = _scalar_fold(_scalar_at(src, i, unit));
+        if (unit == 1) {
+            ((uint8_t *)dst)[i] = (uint8_t)value;
+        } else if (unit == 2) {
+            ((uint16_t *)dst)[i] = (uint16_t)value;
+        } else {
+            ((uint32_t *)dst)[i] = value;
+        }
+    }
+}
+
+static size_t _scalar_chr(const void *data, uint32_t ch, size_t unit) {
+    for (size_t i = 0;; i++) {
+        uint32_t value = _scalar_at(data, i, unit);
+        if (value == ch || value == 0) {
+            return i;
+        }
+    }
+}
+
+static int _scalar_class_has(const _fossil_simd_class *cls, uint8_t byte) {
+    const uint8_t *rows = byte < 0x80 ? cls->low : cls->high;
+    return (rows[byte & 15] >> ((byte >> 4) & 7)) & 1;
+}
+
+static size_t _scalar_class_find(const void *data, size_t count, const _fossil_simd_class *cls) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < count; i++) {
+        if (_scalar_class_has(cls, p[i])) {
+            return i;
+        }
+    }
+    return SIMD_NONE;
+}
+
+#if !defined(SIMD_NEON) // NEON always has a vector class lookup
+static size_t _scalar_class_chr(const void *data, const _fossil_simd_class *cls) {
+    const uint8_t *p = data;
+    for (size_t i = 0;; i++) {
+        if (_scalar_class_has(cls, p[i])) {
+            return i;
+        }
+    }
+}
+#endif
+
+#if !defined(SIMD_X86) && !defined(SIMD_NEON)
+static size_t _scalar_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote, int *quoted,
+                                  size_t *offsets) {
+    const uint8_t *p = data;
+    size_t total = 0;
+    int inside = *quoted;
+    for (size_t i = 0; i < count; i++) {
+        if (quote && p[i] == quote) {
+            inside = !inside;
+        } else if (!inside && (p[i] == sep || p[i] == end)) {
+            offsets[total++] = i;
+        }
+    }
+    *quoted = inside;
+    return total;
+}
+#endif
+
+#if defined(SIMD_X86)
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * SSE2 kernels (baseline on x86-64)
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Bit scanning; callers guarantee a non-zero argument
+static unsigned _simd_lsb32(uint32_t v) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward(&i, v);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctz(v);
+#endif
+}
+
+static unsigned _simd_msb32(uint32_t v) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanReverse(&i, v);
+    return (unsigned)i;
+#else
+    return 31u - (unsigned)__builtin_clz(v);
+#endif
+}
+
+static unsigned _simd_popcount32(uint32_t v) {
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    return (((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+// Keeps one mask bit per matching unit
+static uint32_t _simd_unit_bits32(size_t unit) {
+    return unit == 1 ? 0xFFFFFFFFu : unit == 2 ? 0x55555555u : 0x11111111u;
+}
+
+static inline __m128i _sse2_splat(uint32_t ch, size_t unit) {
+    if (unit == 1) {
+        return _mm_set1_epi8((char)ch);
+    }
+    if (unit == 2) {
+        return _mm_set1_epi16((short)ch);
+    }
+    return _mm_set1_epi32((int)ch);
+}
+
+static inline __m128i _sse2_eq(__m128i a, __m128i b, size_t unit) {
+    if (unit == 1) {
+        return _mm_cmpeq_epi8(a, b);
+    }
+    if (unit == 2) {
+        return _mm_cmpeq_epi16(a, b);
+    }
+    return _mm_cmpeq_epi32(a, b);
+}
+
+/*
+ * ASCII case folding in a register: shifting 'A'..'Z' to the bottom of the
+ * signed range lets one signed compare pick them out, and OR-ing 0x20 into
+ * those lanes lowers them.
+ */
+static inline __m128i _sse2_fold(__m128i v, size_t unit) {
+    __m128i upper, bit;
+    if (unit == 1) {
+        upper = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(0x80 - 'A')), _mm_set1_epi8(-0x80 + 26));
+        bit = _mm_set1_epi8(0x20);
+    } else if (unit == 2) {
+        upper = _mm_cmplt_epi16(_mm_add_epi16(v, _mm_set1_epi16(0x8000 - 'A')), _mm_set1_epi16(-0x8000 + 26));
+        bit = _mm_set1_epi16(0x20);
+    } else {
+        upper = _mm_cmplt_epi32(_mm_add_epi32(v, _mm_set1_epi32(0x7FFFFFFF - 'A' + 1)), _mm_set1_epi32(INT32_MIN + 26));
+        bit = _mm_set1_epi32(0x20);
+    }
+    return _mm_or_si128(v, _mm_and_si128(upper, bit));
+}
+
+static inline uint32_t _sse2_mask(const unsigned char *p, __m128i needle, size_t unit) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(const void *)p);
+    return (uint32_t)_mm_movemask_epi8(_sse2_eq(block, needle, unit));
+}
+
+static size_t _sse2_find(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    __m128i needle = _sse2_splat(ch, unit);
+    for (; i + 16 <= bytes; i += 16) {
+        uint32_t mask = _sse2_mask(p + i, needle, unit);
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _scalar_find(p + i, (bytes - i) / unit, ch, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+static size_t _sse2_rfind(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t end = count * unit;
+    __m128i needle = _sse2_splat(ch, unit);
+    for (; end >= 16; end -= 16) {
+        uint32_t mask = _sse2_mask(p + end - 16, needle, unit);
+        if (mask) {
+            return (end - 16 + _simd_msb32(mask)) / unit;
+        }
+    }
+    return _scalar_rfind(p, end / unit, ch, unit);
+}
+
+static size_t _sse2_count(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    __m128i needle = _sse2_splat(ch, unit);
+    for (; i + 16 <= bytes; i += 16) {
+        total += _simd_popcount32(_sse2_mask(p + i, needle, unit));
+    }
+    return total / unit + _scalar_count(p + i, (bytes - i) / unit, ch, unit);
+}
+
+// Offsets come straight from the match bits; once the buffer is full only counting remains
+static size_t _sse2_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    uint32_t keep = _simd_unit_bits32(unit);
+    __m128i needle = _sse2_splat(ch, unit);
+    for (; i + 16 <= bytes && total < capacity; i += 16) {
+        uint32_t mask = _sse2_mask(p + i, needle, unit) & keep;
+        for (; mask; mask &= mask - 1) {
+            if (total < capacity) {
+                offsets[total] = (i + _simd_lsb32(mask)) / unit;
+            }
+            total++;
+        }
+    }
+    if (total >= capacity) {
+        return total + _sse2_count(p + i, (bytes - i) / unit, ch, unit);
+    }
+    size_t tail = _scalar_find_all(p + i, (bytes - i) / unit, ch, unit, offsets + total, capacity - total);
+    for (size_t k = total; k < total + tail && k < capacity; k++) {
+        offsets[k] += i / unit;
+    }
+    return total + tail;
+}
+
+static size_t _sse2_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit) {
+    if (set_count == 0 || set_count > SIMD_MAX_SET) {
+        return _scalar_find_any(data, count, set, set_count, unit);
+    }
+    __m128i needles[SIMD_MAX_SET];
+    for (size_t j = 0; j < set_count; j++) {
+        needles[j] = _sse2_splat(_scalar_at(set, j, unit), unit);
+    }
+
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+        __m128i hits = _sse2_eq(block, needles[0], unit);
+        for (size_t j = 1; j < set_count; j++) {
+            hits = _mm_or_si128(hits, _sse2_eq(block, needles[j], unit));
+        }
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _scalar_find_any(p + i, (bytes - i) / unit, set, set_count, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+// Candidates for a needle: its first unit here and its last unit 'gap' units later
+static size_t _sse2_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold) {
+    if (gap >= count) {
+        return SIMD_NONE;
+    }
+    const unsigned char *p = data;
+    size_t span = (count - gap) * unit;
+    size_t offset = gap * unit;
+    size_t i = 0;
+    __m128i head = _sse2_splat(first, unit);
+    __m128i tail = _sse2_splat(last, unit);
+    for (; i + 16 <= span; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(p + i + offset));
+        if (fold) {
+            a = _sse2_fold(a, unit);
+            b = _sse2_fold(b, unit);
+        }
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_sse2_eq(a, head, unit), _sse2_eq(b, tail, unit)));
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t rest = _scalar_find_pair(p + i, count - i / unit, first, last, gap, unit, fold);
+    return rest == SIMD_NONE ? SIMD_NONE : i / unit + rest;
+}
+
+// Byte lanes suffice: the first differing byte lies in the first differing unit
+static size_t _sse2_fold_mismatch(const void *a, const void *b, size_t count, size_t unit) {
+    const unsigned char *pa = a, *pb = b;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i x = _sse2_fold(_mm_loadu_si128((const __m128i *)(const void *)(pa + i)), unit);
+        __m128i y = _sse2_fold(_mm_loadu_si128((const __m128i *)(const void *)(pb + i)), unit);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xFFFFu;
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _scalar_fold_mismatch(pa + i, pb + i, (bytes - i) / unit, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+static void _sse2_fold_copy(void *dst, const void *src, size_t count, size_t unit) {
+    unsigned char *out = dst;
+    const unsigned char *in = src;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(in + i));
+        _mm_storeu_si128((__m128i *)(void *)(out + i), _sse2_fold(v, unit));
+    }
+    _scalar_fold_copy(out + i, in + i, (bytes - i) / unit, unit);
+}
+
+SIMD_UNCHECKED static size_t _sse2_chr(const void *data, uint32_t ch, size_t unit) {
+    if ((uintptr_t)data % unit) {
+        return _scalar_chr(data, ch, unit); // Lanes would straddle units
+    }
+    const unsigned char *p = data;
+    const unsigned char *block = (const unsigned char *)((uintptr_t)p & ~(uintptr_t)15);
+    size_t skip = (size_t)(p - block);
+    __m128i needle = _sse2_splat(ch, unit);
+    __m128i zero = _mm_setzero_si128();
+
+    __m128i v = _mm_load_si128((const __m128i *)(const void *)block);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_sse2_eq(v, needle, unit), _sse2_eq(v, zero, unit)));
+    mask >>= skip;
+    if (mask) {
+        return _simd_lsb32(mask) / unit;
+    }
+    for (;;) {
+        block += 16;
+        v = _mm_load_si128((const __m128i *)(const void *)block);
+        mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_sse2_eq(v, needle, unit), _sse2_eq(v, zero, unit)));
+        if (mask) {
+            return ((size_t)(block - p) + _simd_lsb32(mask)) / unit;
+        }
+    }
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * AVX2 kernels (selected at run time)
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+SIMD_AVX2 static inline __m256i _avx2_splat(uint32_t ch, size_t unit) {
+    if (unit == 1) {
+        return _mm256_set1_epi8((char)ch);
+    }
+    if (unit == 2) {
+        return _mm256_set1_epi16((short)ch);
+    }
+    return _mm256_set1_epi32((int)ch);
+}
+
+SIMD_AVX2 static inline __m256i _avx2_eq(__m256i a, __m256i b, size_t unit) {
+    if (unit == 1) {
+        return _mm256_cmpeq_epi8(a, b);
+    }
+    if (unit == 2) {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+    return _mm256_cmpeq_epi32(a, b);
+}
+
+SIMD_AVX2 static inline __m256i _avx2_fold(__m256i v, size_t unit) {
+    __m256i upper, bit;
+    if (unit == 1) {
+        upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-0x80 + 26), _mm256_add_epi8(v, _mm256_set1_epi8(0x80 - 'A')));
+        bit = _mm256_set1_epi8(0x20);
+    } else if (unit == 2) {
+        upper = _mm256_cmpgt_epi16(_mm256_set1_epi16(-0x8000 + 26), _mm256_add_epi16(v, _mm256_set1_epi16(0x8000 - 'A')));
+        bit = _mm256_set1_epi16(0x20);
+    } else {
+        upper = _mm256_cmpgt_epi32(_mm256_set1_epi32(INT32_MIN + 26), _mm256_add_epi32(v, _mm256_set1_epi32(0x7FFFFFFF - 'A' + 1)));
+        bit = _mm256_set1_epi32(0x20);
+    }
+    return _mm256_or_si256(v, _mm256_and_si256(upper, bit));
+}
+
+SIMD_AVX2 static inline uint32_t _avx2_mask(const unsigned char *p, __m256i needle, size_t unit) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)(const void *)p);
+    return (uint32_t)_mm256_movemask_epi8(_avx2_eq(block, needle, unit));
+}
+
+SIMD_AVX2 static size_t _avx2_find(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    __m256i needle = _avx2_splat(ch, unit);
+    for (; i + 32 <= bytes; i += 32) {
+        uint32_t mask = _avx2_mask(p + i, needle, unit);
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _sse2_find(p + i, (bytes - i) / unit, ch, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+SIMD_AVX2 static size_t _avx2_rfind(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t end = count * unit;
+    __m256i needle = _avx2_splat(ch, unit);
+    for (; end >= 32; end -= 32) {
+        uint32_t mask = _avx2_mask(p + end - 32, needle, unit);
+        if (mask) {
+            return (end - 32 + _simd_msb32(mask)) / unit;
+        }
+    }
+    return _sse2_rfind(p, end / unit, ch, unit);
+}
+
+SIMD_AVX2 static size_t _avx2_count(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    __m256i needle = _avx2_splat(ch, unit);
+    for (; i + 32 <= bytes; i += 32) {
+        total += (size_t)_mm_popcnt_u32(_avx2_mask(p + i, needle, unit));
+    }
+    return total / unit + _sse2_count(p + i, (bytes - i) / unit, ch, unit);
+}
+
+SIMD_AVX2 static size_t _avx2_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    uint32_t keep = _simd_unit_bits32(unit);
+    __m256i needle = _avx2_splat(ch, unit);
+    for (; i + 32 <= bytes && total < capacity; i += 32) {
+        uint32_t mask = _avx2_mask(p + i, needle, unit) & keep;
+        for (; mask; mask &= mask - 1) {
+            if (total < capacity) {
+                offsets[total] = (i + _simd_lsb32(mask)) / unit;
+            }
+            total++;
+        }
+    }
+    if (total >= capacity) {
+        return total + _avx2_count(p + i, (bytes - i) / unit, ch, unit);
+    }
+    size_t tail = _sse2_find_all(p + i, (bytes - i) / unit, ch, unit, offsets + total, capacity - total);
+    for (size_t k = total; k < total + tail && k < capacity; k++) {
+        offsets[k] += i / unit;
+    }
+    return total + tail;
+}
+
+SIMD_AVX2 static size_t _avx2_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit) {
+    if (set_count == 0 || set_count > SIMD_MAX_SET) {
+        return _scalar_find_any(data, count, set, set_count, unit);
+    }
+    __m256i needles[SIMD_MAX_SET];
+    for (size_t j = 0; j < set_count; j++) {
+        needles[j] = _avx2_splat(_scalar_at(set, j, unit), unit);
+    }
+
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        __m256i hits = _avx2_eq(block, needles[0], unit);
+        for (size_t j = 1; j < set_count; j++) {
+            hits = _mm256_or_si256(hits, _avx2_eq(block, needles[j], unit));
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _sse2_find_any(p + i, (bytes - i) / unit, set, set_count, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+SIMD_AVX2 static size_t _avx2_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold) {
+    if (gap >= count) {
+        return SIMD_NONE;
+    }
+    const unsigned char *p = data;
+    size_t span = (count - gap) * unit;
+    size_t offset = gap * unit;
+    size_t i = 0;
+    __m256i head = _avx2_splat(first, unit);
+    __m256i tail = _avx2_splat(last, unit);
+    for (; i + 32 <= span; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(p + i + offset));
+        if (fold) {
+            a = _avx2_fold(a, unit);
+            b = _avx2_fold(b, unit);
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_avx2_eq(a, head, unit), _avx2_eq(b, tail, unit)));
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t rest = _sse2_find_pair(p + i, count - i / unit, first, last, gap, unit, fold);
+    return rest == SIMD_NONE ? SIMD_NONE : i / unit + rest;
+}
+
+SIMD_AVX2 static size_t _avx2_fold_mismatch(const void *a, const void *b, size_t count, size_t unit) {
+    const unsigned char *pa = a, *pb = b;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i x = _avx2_fold(_mm256_loadu_si256((const __m256i *)(const void *)(pa + i)), unit);
+        __m256i y = _avx2_fold(_mm256_loadu_si256((const __m256i *)(const void *)(pb + i)), unit);
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (mask) {
+            return (i + _simd_lsb32(mask)) / unit;
+        }
+    }
+    size_t tail = _sse2_fold_mismatch(pa + i, pb + i, (bytes - i) / unit, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+SIMD_AVX2 static void _avx2_fold_copy(void *dst, const void *src, size_t count, size_t unit) {
+    unsigned char *out = dst;
+    const unsigned char *in = src;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(in + i));
+        _mm256_storeu_si256((__m256i *)(void *)(out + i), _avx2_fold(v, unit));
+    }
+    _sse2_fold_copy(out + i, in + i, (bytes - i) / unit, unit);
+}
+
+SIMD_AVX2 SIMD_UNCHECKED static size_t _avx2_chr(const void *data, uint32_t ch, size_t unit) {
+    if ((uintptr_t)data % unit) {
+        return _scalar_chr(data, ch, unit); // Lanes would straddle units
+    }
+    const unsigned char *p = data;
+    const unsigned char *block = (const unsigned char *)((uintptr_t)p & ~(uintptr_t)31);
+    size_t skip = (size_t)(p - block);
+    __m256i needle = _avx2_splat(ch, unit);
+    __m256i zero = _mm256_setzero_si256();
+
+    __m256i v = _mm256_load_si256((const __m256i *)(const void *)block);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_avx2_eq(v, needle, unit), _avx2_eq(v, zero, unit)));
+    mask >>= skip;
+    if (mask) {
+        return _simd_lsb32(mask) / unit;
+    }
+    for (;;) {
+        block += 32;
+        v = _mm256_load_si256((const __m256i *)(const void *)block);
+        mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_avx2_eq(v, needle, unit), _avx2_eq(v, zero, unit)));
+        if (mask) {
+            return ((size_t)(block - p) + _simd_lsb32(mask)) / unit;
+        }
+    }
+}
+
+/*
+ * Class membership by nibble shuffles: the low nibble picks a column of
+ * the class from each half of the table, bit 7 routing the byte to the
+ * right half (a shuffle index with bit 7 set yields 0), and the high
+ * nibble picks the bit within it. SSE2 has no byte shuffle, so machines
+ * without AVX2 use the portable class kernels.
+ */
+SIMD_AVX2 static inline __m256i _avx2_class_hits(__m256i v, __m256i low, __m256i high) {
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i index = _mm256_and_si256(v, _mm256_set1_epi8((char)0x8F));
+    __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(low, index),
+                                   _mm256_shuffle_epi8(high, _mm256_xor_si256(index, _mm256_set1_epi8((char)0x80))));
+    __m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)));
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit);
+}
+
+SIMD_AVX2 static size_t _avx2_class_find(const void *data, size_t count, const _fossil_simd_class *cls) {
+    __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)cls->low));
+    __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)cls->high));
+    const unsigned char *p = data;
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_avx2_class_hits(v, low, high));
+        if (mask) {
+            return i + _simd_lsb32(mask);
+        }
+    }
+    size_t tail = _scalar_class_find(p + i, count - i, cls);
+    return tail == SIMD_NONE ? SIMD_NONE : i + tail;
+}
+
+SIMD_AVX2 SIMD_UNCHECKED static size_t _avx2_class_chr(const void *data, const _fossil_simd_class *cls) {
+    __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)cls->low));
+    __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)cls->high));
+    const unsigned char *p = data;
+    const unsigned char *block = (const unsigned char *)((uintptr_t)p & ~(uintptr_t)31);
+    size_t skip = (size_t)(p - block);
+
+    __m256i v = _mm256_load_si256((const __m256i *)(const void *)block);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_avx2_class_hits(v, low, high));
+    mask >>= skip;
+    if (mask) {
+        return _simd_lsb32(mask);
+    }
+    for (;;) {
+        block += 32;
+        v = _mm256_load_si256((const __m256i *)(const void *)block);
+        mask = (uint32_t)_mm256_movemask_epi8(_avx2_class_hits(v, low, high));
+        if (mask) {
+            return (size_t)(block - p) + _simd_lsb32(mask);
+        }
+    }
+}
+
+// Bit i of the result is set when byte i of the 64-byte block equals the needle
+static inline uint64_t _sse2_block_mask(const unsigned char *block, __m128i needle) {
+    uint64_t mask = 0;
+    for (int k = 0; k < 4; k++) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(block + 16 * k));
+        mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) << (16 * k);
+    }
+    return mask;
+}
+
+// Bit i of the result is the XOR of bits 0 to i of 'x'
+static inline uint64_t _sse2_prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static inline size_t _simd_quoted_emit(uint64_t mask, size_t base, size_t *offsets, size_t total) {
+    for (uint32_t low = (uint32_t)mask; low; low &= low - 1) {
+        offsets[total++] = base + _simd_lsb32(low);
+    }
+    for (uint32_t high = (uint32_t)(mask >> 32); high; high &= high - 1) {
+        offsets[total++] = base + 32 + _simd_lsb32(high);
+    }
+    return total;
+}
+
+/*
+ * The quoted scans work on 64-byte blocks: one bit mask each for the quotes
+ * and for the separators and row ends, then a prefix XOR over the quote mask
+ * gives the bytes inside quotes (the opening quote and what follows it, up
+ * to the closing quote). A doubled quote toggles twice, so it needs no
+ * special case. The last partial block is copied into a zeroed buffer;
+ * zero is never a separator, row end or quote.
+ */
+static size_t _sse2_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote, int *quoted,
+                                size_t *offsets) {
+    const unsigned char *p = data;
+    __m128i seps = _mm_set1_epi8((char)sep), ends = _mm_set1_epi8((char)end), quotes = _mm_set1_epi8((char)quote);
+    uint64_t carry = *quoted ? ~(uint64_t)0 : 0;
+    unsigned char tail[64];
+    size_t total = 0;
+    for (size_t i = 0; i < count; i += 64) {
+        const unsigned char *block = p + i;
+        if (count - i < 64) {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, count - i);
+            block = tail;
+        }
+        uint64_t inside = carry;
+        if (quote) {
+            inside ^= _sse2_prefix_xor(_sse2_block_mask(block, quotes));
+            carry = (inside >> 63) ? ~(uint64_t)0 : 0;
+        }
+        uint64_t structural = _sse2_block_mask(block, seps) | _sse2_block_mask(block, ends);
+        total = _simd_quoted_emit(structural & ~inside, i, offsets, total);
+    }
+    *quoted = carry != 0;
+    return total;
+}
+
+// The AVX2 tier also requires PCLMULQDQ: a carry-less multiply by all ones is the prefix XOR
+SIMD_AVX2 static inline uint64_t _avx2_block_mask(const unsigned char *block, __m256i needle) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)block);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(block + 32));
+    uint32_t low = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, needle));
+    uint32_t high = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, needle));
+    return (uint64_t)high << 32 | low;
+}
+
+SIMD_AVX2 static inline uint64_t _avx2_prefix_xor(uint64_t x) {
+    __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), _mm_set1_epi8((char)0xFF), 0);
+    return (uint64_t)_mm_cvtsi128_si64(product);
+}
+
+SIMD_AVX2 static size_t _avx2_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote,
+                                          int *quoted, size_t *offsets) {
+    const unsigned char *p = data;
+    __m256i seps = _mm256_set1_epi8((char)sep), ends = _mm256_set1_epi8((char)end);
+    __m256i quotes = _mm256_set1_epi8((char)quote);
+    uint64_t carry = *quoted ? ~(uint64_t)0 : 0;
+    unsigned char tail[64];
+    size_t total = 0;
+    for (size_t i = 0; i < count; i += 64) {
+        const unsigned char *block = p + i;
+        if (count - i < 64) {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, count - i);
+            block = tail;
+        }
+        uint64_t inside = carry;
+        if (quote) {
+            inside ^= _avx2_prefix_xor(_avx2_block_mask(block, quotes));
+            carry = (inside >> 63) ? ~(uint64_t)0 : 0;
+        }
+        uint64_t structural = _avx2_block_mask(block, seps) | _avx2_block_mask(block, ends);
+        total = _simd_quoted_emit(structural & ~inside, i, offsets, total);
+    }
+    *quoted = carry != 0;
+    return total;
+}
+
+static int _simd_has_avx2(void) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return 0;
+    }
+    __cpuid(info, 1);
+    int osxsave = (info[2] >> 27) & 1;
+    int popcnt = (info[2] >> 23) & 1;
+    int pclmul = (info[2] >> 1) & 1;
+    if (!osxsave || !popcnt || !pclmul || (_xgetbv(0) & 6) != 6) {
+        return 0; // The OS must save the YMM registers
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("pclmul");
+#endif
+}
+
+#elif defined(SIMD_NEON)
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * NEON kernels (baseline on AArch64)
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+static unsigned _simd_lsb64(uint64_t v) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward64(&i, v);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctzll(v);
+#endif
+}
+
+static unsigned _simd_msb64(uint64_t v) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanReverse64(&i, v);
+    return (unsigned)i;
+#else
+    return 63u - (unsigned)__builtin_clzll(v);
+#endif
+}
+
+static inline uint8x16_t _neon_eq(uint8x16_t a, uint32_t ch, size_t unit) {
+    if (unit == 1) {
+        return vceqq_u8(a, vdupq_n_u8((uint8_t)ch));
+    }
+    if (unit == 2) {
+        return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vdupq_n_u16((uint16_t)ch)));
+    }
+    return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vdupq_n_u32(ch)));
+}
+
+// Unsigned lanes make the 'A'..'Z' range check a single compare
+static inline uint8x16_t _neon_fold(uint8x16_t v, size_t unit) {
+    if (unit == 1) {
+        uint8x16_t upper = vcltq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8(26));
+        return vorrq_u8(v, vandq_u8(upper, vdupq_n_u8(0x20)));
+    }
+    if (unit == 2) {
+        uint16x8_t w = vreinterpretq_u16_u8(v);
+        uint16x8_t upper = vcltq_u16(vsubq_u16(w, vdupq_n_u16('A')), vdupq_n_u16(26));
+        return vreinterpretq_u8_u16(vorrq_u16(w, vandq_u16(upper, vdupq_n_u16(0x20))));
+    }
+    uint32x4_t w = vreinterpretq_u32_u8(v);
+    uint32x4_t upper = vcltq_u32(vsubq_u32(w, vdupq_n_u32('A')), vdupq_n_u32(26));
+    return vreinterpretq_u8_u32(vorrq_u32(w, vandq_u32(upper, vdupq_n_u32(0x20))));
+}
+
+// NEON has no movemask; narrowing by 4 leaves one nibble per byte instead
+static inline uint64_t _neon_mask(uint8x16_t eq) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+}
+
+static size_t _neon_find(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        uint64_t mask = _neon_mask(_neon_eq(vld1q_u8(p + i), ch, unit));
+        if (mask) {
+            return (i + _simd_lsb64(mask) / 4) / unit;
+        }
+    }
+    size_t tail = _scalar_find(p + i, (bytes - i) / unit, ch, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+static size_t _neon_rfind(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t end = count * unit;
+    for (; end >= 16; end -= 16) {
+        uint64_t mask = _neon_mask(_neon_eq(vld1q_u8(p + end - 16), ch, unit));
+        if (mask) {
+            return (end - 16 + _simd_msb64(mask) / 4) / unit;
+        }
+    }
+    return _scalar_rfind(p, end / unit, ch, unit);
+}
+
+static size_t _neon_count(const void *data, size_t count, uint32_t ch, size_t unit) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        total += vaddvq_u8(vshrq_n_u8(_neon_eq(vld1q_u8(p + i), ch, unit), 7));
+    }
+    return total / unit + _scalar_count(p + i, (bytes - i) / unit, ch, unit);
+}
+
+static size_t _neon_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity) {
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    size_t total = 0;
+    // One nibble per byte; keep a single bit per matching unit
+    uint64_t keep = unit == 1 ? 0x1111111111111111ull : unit == 2 ? 0x0101010101010101ull : 0x0001000100010001ull;
+    for (; i + 16 <= bytes && total < capacity; i += 16) {
+        uint64_t mask = _neon_mask(_neon_eq(vld1q_u8(p + i), ch, unit)) & keep;
+        for (; mask; mask &= mask - 1) {
+            if (total < capacity) {
+                offsets[total] = (i + _simd_lsb64(mask) / 4) / unit;
+            }
+            total++;
+        }
+    }
+    if (total >= capacity) {
+        return total + _neon_count(p + i, (bytes - i) / unit, ch, unit);
+    }
+    size_t tail = _scalar_find_all(p + i, (bytes - i) / unit, ch, unit, offsets + total, capacity - total);
+    for (size_t k = total; k < total + tail && k < capacity; k++) {
+        offsets[k] += i / unit;
+    }
+    return total + tail;
+}
+
+static size_t _neon_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit) {
+    if (set_count == 0 || set_count > SIMD_MAX_SET) {
+        return _scalar_find_any(data, count, set, set_count, unit);
+    }
+    const unsigned char *p = data;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t block = vld1q_u8(p + i);
+        uint8x16_t hits = _neon_eq(block, _scalar_at(set, 0, unit), unit);
+        for (size_t j = 1; j < set_count; j++) {
+            hits = vorrq_u8(hits, _neon_eq(block, _scalar_at(set, j, unit), unit));
+        }
+        uint64_t mask = _neon_mask(hits);
+        if (mask) {
+            return (i + _simd_lsb64(mask) / 4) / unit;
+        }
+    }
+    size_t tail = _scalar_find_any(p + i, (bytes - i) / unit, set, set_count, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+static size_t _neon_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold) {
+    if (gap >= count) {
+        return SIMD_NONE;
+    }
+    const unsigned char *p = data;
+    size_t span = (count - gap) * unit;
+    size_t offset = gap * unit;
+    size_t i = 0;
+    for (; i + 16 <= span; i += 16) {
+        uint8x16_t a = vld1q_u8(p + i);
+        uint8x16_t b = vld1q_u8(p + i + offset);
+        if (fold) {
+            a = _neon_fold(a, unit);
+            b = _neon_fold(b, unit);
+        }
+        uint8x16_t hits = vandq_u8(_neon_eq(a, first, unit), _neon_eq(b, last, unit));
+        uint64_t mask = _neon_mask(hits);
+        if (mask) {
+            return (i + _simd_lsb64(mask) / 4) / unit;
+        }
+    }
+    size_t rest = _scalar_find_pair(p + i, count - i / unit, first, last, gap, unit, fold);
+    return rest == SIMD_NONE ? SIMD_NONE : i / unit + rest;
+}
+
+static size_t _neon_fold_mismatch(const void *a, const void *b, size_t count, size_t unit) {
+    const unsigned char *pa = a, *pb = b;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t same = vceqq_u8(_neon_fold(vld1q_u8(pa + i), unit), _neon_fold(vld1q_u8(pb + i), unit));
+        uint64_t mask = ~_neon_mask(same);
+        if (mask) {
+            return (i + _simd_lsb64(mask) / 4) / unit;
+        }
+    }
+    size_t tail = _scalar_fold_mismatch(pa + i, pb + i, (bytes - i) / unit, unit);
+    return tail == SIMD_NONE ? SIMD_NONE : i / unit + tail;
+}
+
+static void _neon_fold_copy(void *dst, const void *src, size_t count, size_t unit) {
+    unsigned char *out = dst;
+    const unsigned char *in = src;
+    size_t bytes = count * unit;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        vst1q_u8(out + i, _neon_fold(vld1q_u8(in + i), unit));
+    }
+    _scalar_fold_copy(out + i, in + i, (bytes - i) / unit, unit);
+}
+
+SIMD_UNCHECKED static size_t _neon_chr(const void *data, uint32_t ch, size_t unit) {
+    if ((uintptr_t)data % unit) {
+        return _scalar_chr(data, ch, unit); // Lanes would straddle units
+    }
+    const unsigned char *p = data;
+    const unsigned char *block = (const unsigned char *)((uintptr_t)p & ~(uintptr_t)15);
+    size_t skip = (size_t)(p - block);
+
+    uint8x16_t v = vld1q_u8(block);
+    uint64_t mask = _neon_mask(vorrq_u8(_neon_eq(v, ch, unit), _neon_eq(v, 0, unit)));
+    mask >>= skip * 4;
+    if (mask) {
+        return (_simd_lsb64(mask) / 4) / unit;
+    }
+    for (;;) {
+        block += 16;
+        v = vld1q_u8(block);
+        mask = _neon_mask(vorrq_u8(_neon_eq(v, ch, unit), _neon_eq(v, 0, unit)));
+        if (mask) {
+            return ((size_t)(block - p) + _simd_lsb64(mask) / 4) / unit;
+        }
+    }
+}
+
+// The nibble shuffle class lookup of the AVX2 kernels, with TBL for the shuffle
+static inline uint8x16_t _neon_class_hits(uint8x16_t v, uint8x16_t low, uint8x16_t high) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t index = vandq_u8(v, vdupq_n_u8(0x8F));
+    uint8x16_t rows = vorrq_u8(vqtbl1q_u8(low, index), vqtbl1q_u8(high, veorq_u8(index, vdupq_n_u8(0x80))));
+    return vtstq_u8(rows, vqtbl1q_u8(vld1q_u8(bits), vshrq_n_u8(v, 4)));
+}
+
+static size_t _neon_class_find(const void *data, size_t count, const _fossil_simd_class *cls) {
+    uint8x16_t low = vld1q_u8(cls->low), high = vld1q_u8(cls->high);
+    const unsigned char *p = data;
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint64_t mask = _neon_mask(_neon_class_hits(vld1q_u8(p + i), low, high));
+        if (mask) {
+            return i + _simd_lsb64(mask) / 4;
+        }
+    }
+    size_t tail = _scalar_class_find(p + i, count - i, cls);
+    return tail == SIMD_NONE ? SIMD_NONE : i + tail;
+}
+
+SIMD_UNCHECKED static size_t _neon_class_chr(const void *data, const _fossil_simd_class *cls) {
+    uint8x16_t low = vld1q_u8(cls->low), high = vld1q_u8(cls->high);
+    const unsigned char *p = data;
+    const unsigned char *block = (const unsigned char *)((uintptr_t)p & ~(uintptr_t)15);
+    size_t skip = (size_t)(p - block);
+
+    uint64_t mask = _neon_mask(_neon_class_hits(vld1q_u8(block), low, high));
+    mask >>= skip * 4;
+    if (mask) {
+        return _simd_lsb64(mask) / 4;
+    }
+    for (;;) {
+        block += 16;
+        mask = _neon_mask(_neon_class_hits(vld1q_u8(block), low, high));
+        if (mask) {
+            return (size_t)(block - p) + _simd_lsb64(mask) / 4;
+        }
+    }
+}
+
+// One bit per byte of a 64-byte block, packed with pairwise adds
+static inline uint64_t _neon_block_mask(const unsigned char *block, uint8x16_t needle) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t weights = vld1q_u8(bits);
+    uint8x16_t a = vandq_u8(vceqq_u8(vld1q_u8(block), needle), weights);
+    uint8x16_t b = vandq_u8(vceqq_u8(vld1q_u8(block + 16), needle), weights);
+    uint8x16_t c = vandq_u8(vceqq_u8(vld1q_u8(block + 32), needle), weights);
+    uint8x16_t d = vandq_u8(vceqq_u8(vld1q_u8(block + 48), needle), weights);
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(a, b), vpaddq_u8(c, d));
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+// A carry-less multiply by all ones with PMULL where the crypto extension has it
+static inline uint64_t _neon_prefix_xor(uint64_t x) {
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+    return (uint64_t)vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)x, (poly64_t)~(uint64_t)0)), 0);
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+// The 64-byte block scan of the x86 kernels
+static size_t _neon_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote, int *quoted,
+                                size_t *offsets) {
+    const unsigned char *p = data;
+    uint8x16_t seps = vdupq_n_u8(sep), ends = vdupq_n_u8(end), quotes = vdupq_n_u8(quote);
+    uint64_t carry = *quoted ? ~(uint64_t)0 : 0;
+    unsigned char tail[64];
+    size_t total = 0;
+    for (size_t i = 0; i < count; i += 64) {
+        const unsigned char *block = p + i;
+        if (count - i < 64) {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, count - i);
+            block = tail;
+        }
+        uint64_t inside = carry;
+        if (quote) {
+            inside ^= _neon_prefix_xor(_neon_block_mask(block, quotes));
+            carry = (inside >> 63) ? ~(uint64_t)0 : 0;
+        }
+        for (uint64_t mask = (_neon_block_mask(block, seps) | _neon_block_mask(block, ends)) & ~inside; mask;
+             mask &= mask - 1) {
+            offsets[total++] = i + _simd_lsb64(mask);
+        }
+    }
+    *quoted = carry != 0;
+    return total;
+}
+
+#endif
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Dispatch
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+typedef struct {
+    size_t (*find)(const void *, size_t, uint32_t, size_t);
+    size_t (*rfind)(const void *, size_t, uint32_t, size_t);
+    size_t (*count)(const void *, size_t, uint32_t, size_t);
+    size_t (*find_all)(const void *, size_t, uint32_t, size_t, size_t *, size_t);
+    size_t (*find_any)(const void *, size_t, const void *, size_t, size_t);
+    size_t (*find_pair)(const void *, size_t, uint32_t, uint32_t, size_t, size_t, int);
+    size_t (*fold_mismatch)(const void *, const void *, size_t, size_t);
+    void (*fold_copy)(void *, const void *, size_t, size_t);
+    size_t (*chr)(const void *, uint32_t, size_t);
+    size_t (*class_find)(const void *, size_t, const _fossil_simd_class *);
+    size_t (*class_chr)(const void *, const _fossil_simd_class *);
+    size_t (*quoted_scan)(const void *, size_t, uint8_t, uint8_t, uint8_t, int *, size_t *);
+} _simd_kernels;
+
+#if defined(SIMD_X86)
+static const _simd_kernels _simd_sse2 = {
+    _sse2_find, _sse2_rfind, _sse2_count, _sse2_find_all, _sse2_find_any, _sse2_find_pair, _sse2_fold_mismatch, _sse2_fold_copy, _sse2_chr,
+    _scalar_class_find, _scalar_class_chr, _sse2_quoted_scan
+};
+static const _simd_kernels _simd_avx2 = {
+    _avx2_find, _avx2_rfind, _avx2_count, _avx2_find_all, _avx2_find_any, _avx2_find_pair, _avx2_fold_mismatch, _avx2_fold_copy, _avx2_chr,
+    _avx2_class_find, _avx2_class_chr, _avx2_quoted_scan
+};
+#elif defined(SIMD_NEON)
+static const _simd_kernels _simd_neon = {
+    _neon_find, _neon_rfind, _neon_count, _neon_find_all, _neon_find_any, _neon_find_pair, _neon_fold_mismatch, _neon_fold_copy, _neon_chr,
+    _neon_class_find, _neon_class_chr, _neon_quoted_scan
+};
+#else
+static const _simd_kernels _simd_scalar = {
+    _scalar_find, _scalar_rfind, _scalar_count, _scalar_find_all, _scalar_find_any, _scalar_find_pair, _scalar_fold_mismatch, _scalar_fold_copy, _scalar_chr,
+    _scalar_class_find, _scalar_class_chr, _scalar_quoted_scan
+};
+#endif
+
+static _fossil_atomic_ptr _simd_active = NULL;
+
+// Every thread that races here picks the same table, so the store is benign
+static const _simd_kernels *_simd_kernels_get(void) {
+    const _simd_kernels *kernels = _fossil_atomic_ptr_load(&_simd_active);
+    if (!kernels) {
+#if defined(SIMD_X86)
+        kernels = _simd_has_avx2() ? &_simd_avx2 : &_simd_sse2;
+#elif defined(SIMD_NEON)
+        kernels = &_simd_neon;
+#else
+        kernels = &_simd_scalar;
+#endif
+        _fossil_atomic_ptr_store(&_simd_active, (void *)kernels);
+    }
+    return kernels;
+}
+
+size_t _fossil_simd_find(const void *data, size_t count, uint32_t ch, size_t unit) {
+    return _simd_kernels_get()->find(data, count, ch, unit);
+}
+
+size_t _fossil_simd_rfind(const void *data, size_t count, uint32_t ch, size_t unit) {
+    return _simd_kernels_get()->rfind(data, count, ch, unit);
+}
+
+size_t _fossil_simd_count(const void *data, size_t count, uint32_t ch, size_t unit) {
+    return _simd_kernels_get()->count(data, count, ch, unit);
+}
+
+size_t _fossil_simd_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity) {
+    return _simd_kernels_get()->find_all(data, count, ch, unit, offsets, capacity);
+}
+
+size_t _fossil_simd_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit) {
+    return _simd_kernels_get()->find_any(data, count, set, set_count, unit);
+}
+
+size_t _fossil_simd_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold) {
+    return _simd_kernels_get()->find_pair(data, count, first, last, gap, unit, fold);
+}
+
+size_t _fossil_simd_fold_mismatch(const void *a, const void *b, size_t count, size_t unit) {
+    return _simd_kernels_get()->fold_mismatch(a, b, count, unit);
+}
+
+void _fossil_simd_fold_copy(void *dst, const void *src, size_t count, size_t unit) {
+    _simd_kernels_get()->fold_copy(dst, src, count, unit);
+}
+
+size_t _fossil_simd_chr(const void *data, uint32_t ch, size_t unit) {
+    return _simd_kernels_get()->chr(data, ch, unit);
+}
+
+size_t _fossil_simd_length(const void *data, size_t unit) {
+    return _simd_kernels_get()->chr(data, 0, unit);
+}
+
+size_t _fossil_simd_class_find(const void *data, size_t count, const _fossil_simd_class *cls) {
+    return _simd_kernels_get()->class_find(data, count, cls);
+}
+
+size_t _fossil_simd_class_chr(const void *data, const _fossil_simd_class *cls) {
+    return _simd_kernels_get()->class_chr(data, cls);
+}
+
+size_t _fossil_simd_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote, int *quoted,
+                                size_t *offsets) {
+    return _simd_kernels_get()->quoted_scan(data, count, sep, end, quote, quoted, offsets);
+}
+
+void _fossil_simd_class_add(_fossil_simd_class *cls, uint8_t byte) {
+    uint8_t *rows = byte < 0x80 ? cls->low : cls->high;
+    rows[byte & 15] |= (uint8_t)(1u << ((byte >> 4) & 7));
+}
+
+int _fossil_simd_class_has(const _fossil_simd_class *cls, uint8_t byte) {
+    return _scalar_class_has(cls, byte);
+}
@@ -0,0 +1,94 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SIMD_H
+#define FOSSIL_STRINGS_SIMD_H
+
+/*
+ * Private character scanning kernels shared by the string families.
+ * 'unit' is the code unit size in bytes (1, 2 or 4) and every count or
+ * index is in units. The best implementation for the running CPU (AVX2,
+ * SSE2, NEON or portable C) is picked on first use.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Returned by the kernels when nothing matches
+#define _FOSSIL_SIMD_NONE ((size_t)-1)
+
+// Index of the first 'ch' among 'count' units, or _FOSSIL_SIMD_NONE
+size_t _fossil_simd_find(const void *data, size_t count, uint32_t ch, size_t unit);
+
+// Index of the last 'ch' among 'count' units, or _FOSSIL_SIMD_NONE
+size_t _fossil_simd_rfind(const void *data, size_t count, uint32_t ch, size_t unit);
+
+// Number of units equal to 'ch'
+size_t _fossil_simd_count(const void *data, size_t count, uint32_t ch, size_t unit);
+
+// Store the index of each 'ch' while 'capacity' allows and return how many there are
+size_t _fossil_simd_find_all(const void *data, size_t count, uint32_t ch, size_t unit, size_t *offsets, size_t capacity);
+
+// Index of the first unit that appears in 'set', or _FOSSIL_SIMD_NONE
+size_t _fossil_simd_find_any(const void *data, size_t count, const void *set, size_t set_count, size_t unit);
+
+// Index of the first i where unit i is 'first' and unit i + gap is 'last', or _FOSSIL_SIMD_NONE;
+// with 'fold' the units are compared after ASCII case folding, so 'first' and 'last' must be lower case
+size_t _fossil_simd_find_pair(const void *data, size_t count, uint32_t first, uint32_t last, size_t gap, size_t unit, int fold);
+
+// Index of the first unit where 'a' and 'b' differ ignoring ASCII case, or _FOSSIL_SIMD_NONE
+size_t _fossil_simd_fold_mismatch(const void *a, const void *b, size_t count, size_t unit);
+
+// Copy 'count' units with ASCII upper case letters lowered
+void _fossil_simd_fold_copy(void *dst, const void *src, size_t count, size_t unit);
+
+// Index of the first 'ch' or zero terminator in a zero-terminated string
+size_t _fossil_simd_chr(const void *data, uint32_t ch, size_t unit);
+
+// Number of units before the zero terminator
+size_t _fossil_simd_length(const void *data, size_t unit);
+
+/*
+ * A set of byte values for the class kernels, laid out for nibble shuffle
+ * lookups: bit h of low[l] is set when byte h << 4 | l is in the class for
+ * h below 8, and bit h - 8 of high[l] when h is 8 or more. Start from an
+ * all-zero class.
+ */
+typedef struct {
+    uint8_t low[16];
+    uint8_t high[16];
+} _fossil_simd_class;
+
+// Add a byte value to a class
+void _fossil_simd_class_add(_fossil_simd_class *cls, uint8_t byte);
+
+// Whether a byte value is in a class
+int _fossil_simd_class_has(const _fossil_simd_class *cls, uint8_t byte);
+
+// Index of the first of 'count' bytes that is in the class, or _FOSSIL_SIMD_NONE
+size_t _fossil_simd_class_find(const void *data, size_t count, const _fossil_simd_class *cls);
+
+// Index of the first byte in the class in a zero-terminated string; the class must hold 0
+size_t _fossil_simd_class_chr(const void *data, const _fossil_simd_class *cls);
+
+/*
+ * Store the offsets of the 'sep' and 'end' bytes among 'count' bytes that lie
+ * outside quotes, in order, and return how many there are; 'offsets' needs
+ * room for 'count' entries. A 'quote' byte opens or closes a quoted run and
+ * a doubled one does both; 0 turns quoting off. '*quoted' carries whether
+ * the scan starts inside quotes in, and whether it ends inside them out.
+ */
+size_t _fossil_simd_quoted_scan(const void *data, size_t count, uint8_t sep, uint8_t end, uint8_t quote, int *quoted,
+                                size_t *offsets);
+
+#endif /* FOSSIL_STRINGS_SIMD_H */
@@ -0,0 +1,470 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/split.h"
+#include "parallel.h"
+#include "simd.h"
+#include "sync.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SPLIT_MIN_RANGE ((size_t)1 << 16) // smaller ranges cost more to hand out than to scan
+#define SPLIT_RANGES_PER_THREAD 4         // spare ranges even out threads that fall behind
+
+static uint32_t _split_unit_at(const void *str, size_t i, size_t unit) {
+    switch (unit) {
+        case 1: return ((const unsigned char *)str)[i];
+        case 2: return ((const uint16_t *)str)[i];
+        default: return ((const uint32_t *)str)[i];
+    }
+}
+
+// The iterator step shared by the string families; 'unit' is the code unit size in bytes
+static int _split_next(const void *str, size_t unit, uint32_t delimiter, size_t *next, size_t *splits_left,
+                       unsigned flags, int *done, fossil_split_token_t *token) {
+    if (*done || !token) {
+        return 0;
+    }
+    size_t at = *next;
+    if (flags & FOSSIL_SPLIT_SKIP_EMPTY) {
+        while (delimiter != 0 && _split_unit_at(str, at, unit) == delimiter) {
+            at++;
+        }
+        if (_split_unit_at(str, at, unit) == 0) {
+            *done = 1;
+            return 0;
+        }
+    }
+
+    const char *rest = (const char *)str + at * unit;
+    size_t end = at + (*splits_left == 0 ? _fossil_simd_length(rest, unit) : _fossil_simd_chr(rest, delimiter, unit));
+    token->offset = at;
+    token->length = end - at;
+    if (_split_unit_at(str, end, unit) == 0) {
+        *done = 1;
+    } else {
+        *next = end + 1;
+        if (*splits_left != FOSSIL_SPLIT_ALL) {
+            (*splits_left)--;
+        }
+    }
+    return 1;
+}
+
+// ---- classic C strings ----
+
+void fossil_cstr_split_begin(fossil_cstr_split_iter_t *iter, const_cstring str, cletter delimiter, size_t max_splits,
+                             unsigned flags) {
+    if (!iter) {
+        return;
+    }
+    iter->str = str;
+    iter->next = 0;
+    iter->splits_left = max_splits;
+    iter->delimiter = delimiter;
+    iter->flags = flags;
+    iter->done = str == NULL;
+}
+
+int fossil_cstr_split_next(fossil_cstr_split_iter_t *iter, fossil_split_token_t *token) {
+    if (!iter) {
+        return 0;
+    }
+    return _split_next(iter->str, 1, (unsigned char)iter->delimiter, &iter->next, &iter->splits_left, iter->flags,
+                       &iter->done, token);
+}
+
+// ---- byte strings ----
+
+void fossil_bstr_split_begin(fossil_bstr_split_iter_t *iter, const_bstring str, bletter delimiter, size_t max_splits,
+                             unsigned flags) {
+    if (!iter) {
+        return;
+    }
+    iter->str = str;
+    iter->next = 0;
+    iter->splits_left = max_splits;
+    iter->delimiter = delimiter;
+    iter->flags = flags;
+    iter->done = str == NULL;
+}
+
+int fossil_bstr_split_next(fossil_bstr_split_iter_t *iter, fossil_split_token_t *token) {
+    if (!iter) {
+        return 0;
+    }
+    return _split_next(iter->str, sizeof(bletter), iter->delimiter, &iter->next, &iter->splits_left, iter->flags,
+                       &iter->done, token);
+}
+
+// ---- wide strings ----
+
+void fossil_wstr_split_begin(fossil_wstr_split_iter_t *iter, const_wstring str, wletter delimiter, size_t max_splits,
+                             unsigned flags) {
+    if (!iter) {
+        return;
+    }
+    iter->str = str;
+    iter->next = 0;
+    iter->splits_left = max_splits;
+    iter->delimiter = delimiter;
+    iter->flags = flags;
+    iter->done = str == NULL;
+}
+
+int fossil_wstr_split_next(fossil_wstr_split_iter_t *iter, fossil_split_token_t *token) {
+    if (!iter) {
+        return 0;
+    }
+    return _split_next(iter->str, sizeof(wletter), (uint32_t)iter->delimiter, &iter->next, &iter->splits_left,
+                       iter->flags, &iter->done, token);
+}
+
+// ---- single-block splits ----
+
+/*
+ * Allocate room for the pointers and a copy of the string, and copy it in.
+ * Returns the block, with the token count in 'tokens' and the copy in 'data'.
+ */
+static void *_split_block(const fossil_allocator_t *allocator, const void *str, size_t unit, uint32_t delimiter,
+                          size_t *tokens, char **data) {
+    size_t length = _fossil_simd_length(str, unit);
+    *tokens = _fossil_simd_count(str, length, delimiter, unit) + 1;
+    size_t head = (*tokens + 1) * sizeof(void *);
+    char *block = fossil_allocator_alloc(allocator, head + (length + 1) * unit);
+    if (!block) {
+        return NULL;
+    }
+    *data = block + head;
+    memcpy(*data, str, (length + 1) * unit);
+    return block;
+}
+
+cstrings fossil_cstr_split_block(const_cstring str, cletter delimiter) {
+    return fossil_cstr_split_block_with(NULL, str, delimiter);
+}
+
+cstrings fossil_cstr_split_block_with(const fossil_allocator_t *allocator, const_cstring str, cletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t tokens;
+    char *data;
+    cstrings splits = _split_block(allocator, str, 1, (unsigned char)delimiter, &tokens, &data);
+    if (!splits) {
+        return NULL;
+    }
+    for (size_t t = 0; t < tokens; t++) {
+        splits[t] = data;
+        data += _fossil_simd_chr(data, (unsigned char)delimiter, 1);
+        *data++ = '\0';
+    }
+    splits[tokens] = NULL;
+    return splits;
+}
+
+void fossil_cstr_erase_split_block(cstrings splits) {
+    fossil_cstr_erase_split_block_with(NULL, splits);
+}
+
+void fossil_cstr_erase_split_block_with(const fossil_allocator_t *allocator, cstrings splits) {
+    fossil_allocator_release(allocator, splits);
+}
+
+bstrings fossil_bstr_split_block(const_bstring str, bletter delimiter) {
+    return fossil_bstr_split_block_with(NULL, str, delimiter);
+}
+
+bstrings fossil_bstr_split_block_with(const fossil_allocator_t *allocator, const_bstring str, bletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t tokens;
+    char *data;
+    bstrings splits = _split_block(allocator, str, sizeof(bletter), delimiter, &tokens, &data);
+    if (!splits) {
+        return NULL;
+    }
+    bstring token = (bstring)data;
+    for (size_t t = 0; t < tokens; t++) {
+        splits[t] = token;
+        token += _fossil_simd_chr(token, delimiter, sizeof(bletter));
+        *token++ = 0;
+    }
+    splits[tokens] = NULL;
+    return splits;
+}
+
+void fossil_bstr_erase_split_block(bstrings splits) {
+    fossil_bstr_erase_split_block_with(NULL, splits);
+}
+
+void fossil_bstr_erase_split_block_with(const fossil_allocator_t *allocator, bstrings splits) {
+    fossil_allocator_release(allocator, splits);
+}
+
+wstrings fossil_wstr_split_block(const_wstring str, wletter delimiter) {
+    return fossil_wstr_split_block_with(NULL, str, delimiter);
+}
+
+wstrings fossil_wstr_split_block_with(const fossil_allocator_t *allocator, const_wstring str, wletter delimiter) {
+    if (!str) {
+        return NULL;
+    }
+    size_t tokens;
+    char *data;
+    wstrings splits = _split_block(allocator, str, sizeof(wletter), (uint32_t)delimiter, &tokens, &data);
+    if (!splits) {
+        return NULL;
+    }
+    wstring token = (wstring)data;
+    for (size_t t = 0; t < tokens; t++) {
+        splits[t] = token;
+        token += _fossil_simd_chr(token, (uint32_t)delimiter, sizeof(wletter));
+        *token++ = L'\0';
+    }
+    splits[tokens] = NULL;
+    return splits;
+}
+
+void fossil_wstr_erase_split_block(wstrings splits) {
+    fossil_wstr_erase_split_block_with(NULL, splits);
+}
+
+void fossil_wstr_erase_split_block_with(const fossil_allocator_t *allocator, wstrings splits) {
+    fossil_allocator_release(allocator, splits);
+}
+
+// ---- parallel splits ----
+
+typedef struct {
+    fossil_split_token_t *tokens;
+    size_t count;
+    size_t room;
+    int failed;
+} _split_chunk;
+
+struct fossil_split_chunks {
+    size_t count;
+    _split_chunk chunk[];
+};
+
+typedef struct {
+    const char *str;
+    size_t length;
+    unsigned char delimiter;
+    size_t ranges;
+    size_t *bases; // delimiters per range, then where each range's tokens start
+    size_t total;
+    fossil_split_token_t *tokens;
+    fossil_split_chunks_t *chunks;
+} _split_job;
+
+static size_t _split_ranges(size_t length, size_t threads) {
+    size_t most = length / SPLIT_MIN_RANGE + 1;
+    if (threads == 0) {
+        threads = _fossil_cpu_count();
+    }
+    if (threads > most) {
+        threads = most;
+    }
+    size_t ranges = threads * SPLIT_RANGES_PER_THREAD;
+    return ranges < most ? ranges : most;
+}
+
+static void _split_range(const _split_job *job, size_t range, size_t *begin, size_t *end) {
+    size_t size = job->length / job->ranges, extra = job->length % job->ranges;
+    *begin = range * size + (range < extra ? range : extra);
+    *end = *begin + size + (range < extra);
+}
+
+static void _split_run(const fossil_thread_pool_t *pool, size_t tasks, size_t threads, fossil_parallel_task_t task,
+                       void *context) {
+    if (pool && pool->run) {
+        pool->run(pool->pool, tasks, task, context);
+    } else {
+        _fossil_parallel_run(tasks, threads, task, context);
+    }
+}
+
+/*
+ * A range only knows where its first token ends: the token started after
+ * the last delimiter of some earlier range. Walking the ranges in order
+ * with 'tail' just past the latest delimiter fixes each first token up.
+ */
+static void _split_stitch(fossil_split_token_t *tokens, size_t count, size_t *tail) {
+    if (count == 0) {
+        return;
+    }
+    size_t end = tokens[0].offset + tokens[0].length;
+    tokens[0].offset = *tail;
+    tokens[0].length = end - *tail;
+    *tail = tokens[count - 1].offset + tokens[count - 1].length + 1;
+}
+
+static void _split_count_range(void *context, size_t range) {
+    _split_job *job = context;
+    size_t begin, end;
+    _split_range(job, range, &begin, &end);
+    job->bases[range] = _fossil_simd_count(job->str + begin, end - begin, job->delimiter, 1);
+}
+
+static void _split_fill_range(void *context, size_t range) {
+    _split_job *job = context;
+    size_t begin, end;
+    _split_range(job, range, &begin, &end);
+    size_t base = job->bases[range];
+    size_t count = (range + 1 < job->ranges ? job->bases[range + 1] : job->total) - base;
+    if (count == 0) {
+        return;
+    }
+    // The delimiter offsets fill the first half of the range's own slots, and
+    // are widened into tokens from the back so none is overwritten unread.
+    size_t *ends = (size_t *)(void *)(job->tokens + base);
+    _fossil_simd_find_all(job->str + begin, end - begin, job->delimiter, 1, ends, count);
+    for (size_t k = count; k-- > 0;) {
+        size_t stop = begin + ends[k];
+        size_t start = k > 0 ? begin + ends[k - 1] + 1 : begin;
+        job->tokens[base + k].offset = start;
+        job->tokens[base + k].length = stop - start;
+    }
+}
+
+fossil_split_token_t *fossil_cstr_split_parallel(const_cstring str, size_t length, cletter delimiter, size_t threads,
+                                                 const fossil_thread_pool_t *pool, size_t *count) {
+    if (!str || !count) {
+        return NULL;
+    }
+    _split_job job = {str, length, (unsigned char)delimiter, _split_ranges(length, threads), NULL, 0, NULL, NULL};
+    job.bases = malloc(job.ranges * sizeof(size_t));
+    if (!job.bases) {
+        return NULL;
+    }
+    _split_run(pool, job.ranges, threads, _split_count_range, &job);
+    for (size_t r = 0; r < job.ranges; r++) {
+        size_t delimiters = job.bases[r];
+        job.bases[r] = job.total;
+        job.total += delimiters;
+    }
+    job.tokens = malloc((job.total + 1) * sizeof(fossil_split_token_t));
+    if (!job.tokens) {
+        free(job.bases);
+        return NULL;
+    }
+    _split_run(pool, job.ranges, threads, _split_fill_range, &job);
+
+    size_t tail = 0;
+    for (size_t r = 0; r < job.ranges; r++) {
+        size_t next = r + 1 < job.ranges ? job.bases[r + 1] : job.total;
+        _split_stitch(job.tokens + job.bases[r], next - job.bases[r], &tail);
+    }
+    job.tokens[job.total].offset = tail; // the token after the last delimiter
+    job.tokens[job.total].length = length - tail;
+    free(job.bases);
+    *count = job.total + 1;
+    return job.tokens;
+}
+
+void fossil_split_erase_tokens(fossil_split_token_t *tokens) {
+    free(tokens);
+}
+
+static int _split_push(_split_chunk *chunk, size_t start, size_t stop) {
+    if (chunk->count == chunk->room) {
+        size_t room = chunk->room ? chunk->room * 2 : 64;
+        fossil_split_token_t *tokens = realloc(chunk->tokens, room * sizeof(fossil_split_token_t));
+        if (!tokens) {
+            chunk->failed = 1;
+            return 0;
+        }
+        chunk->tokens = tokens;
+        chunk->room = room;
+    }
+    chunk->tokens[chunk->count].offset = start;
+    chunk->tokens[chunk->count].length = stop - start;
+    chunk->count++;
+    return 1;
+}
+
+static void _split_chunk_range(void *context, size_t range) {
+    _split_job *job = context;
+    _split_chunk *chunk = &job->chunks->chunk[range];
+    size_t begin, end;
+    _split_range(job, range, &begin, &end);
+    size_t start = begin;
+    for (size_t at = begin;;) {
+        size_t hit = _fossil_simd_find(job->str + at, end - at, job->delimiter, 1);
+        if (hit == _FOSSIL_SIMD_NONE) {
+            break;
+        }
+        if (!_split_push(chunk, start, at + hit)) {
+            return;
+        }
+        start = at = at + hit + 1;
+    }
+    if (range + 1 == job->ranges) {
+        _split_push(chunk, start, job->length);
+    }
+}
+
+fossil_split_chunks_t *fossil_cstr_split_parallel_chunks(const_cstring str, size_t length, cletter delimiter,
+                                                         size_t threads, const fossil_thread_pool_t *pool) {
+    if (!str) {
+        return NULL;
+    }
+    _split_job job = {str, length, (unsigned char)delimiter, _split_ranges(length, threads), NULL, 0, NULL, NULL};
+    job.chunks = calloc(1, sizeof(fossil_split_chunks_t) + job.ranges * sizeof(_split_chunk));
+    if (!job.chunks) {
+        return NULL;
+    }
+    job.chunks->count = job.ranges;
+    _split_run(pool, job.ranges, threads, _split_chunk_range, &job);
+
+    size_t tail = 0;
+    for (size_t r = 0; r < job.ranges; r++) {
+        if (job.chunks->chunk[r].failed) {
+            fossil_split_chunks_erase(job.chunks);
+            return NULL;
+        }
+        _split_stitch(job.chunks->chunk[r].tokens, job.chunks->chunk[r].count, &tail);
+    }
+    return job.chunks;
+}
+
+size_t fossil_split_chunks_count(const fossil_split_chunks_t *chunks) {
+    return chunks ? chunks->count : 0;
+}
+
+const fossil_split_token_t *fossil_split_chunks_get(const fossil_split_chunks_t *chunks, size_t chunk, size_t *count) {
+    if (!chunks || chunk >= chunks->count) {
+        if (count) {
+            *count = 0;
+        }
+        return NULL;
+    }
+    if (count) {
+        *count = chunks->chunk[chunk].count;
+    }
+    return chunks->chunk[chunk].count ? chunks->chunk[chunk].tokens : NULL;
+}
+
+void fossil_split_chunks_erase(fossil_split_chunks_t *chunks) {
+    if (!chunks) {
+        return;
+    }
+    for (size_t r = 0; r < chunks->count; r++) {
+        free(chunks->chunk[r].tokens);
+    }
+    free(chunks);
+}
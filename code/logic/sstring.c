@@ -0,0 +1,304 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/sstring.h"
+
+#define SSTR_FORMAT_SCRATCH 256 // formatted results shorter than this are built on the stack
+
+static cletter *_sstr_buffer(sstring *str) {
+    return str->heap ? str->heap : str->inline_data;
+}
+
+// Make room for 'capacity' characters, optionally keeping the current contents
+static int _sstr_reserve(sstring *str, size_t capacity, int keep) {
+    if (capacity <= str->capacity) {
+        return 0;
+    }
+    if (capacity == SIZE_MAX) {
+        return -1; // Size overflow
+    }
+    // Double when that cannot overflow, leaving room for the terminator
+    size_t grown = capacity;
+    if (str->capacity <= SIZE_MAX / 2 - 1 && str->capacity * 2 > capacity) {
+        grown = str->capacity * 2;
+    }
+    cletter *heap = fossil_allocator_alloc(NULL, grown + 1);
+    if (!heap) {
+        return -1;
+    }
+    if (keep) {
+        memcpy(heap, _sstr_buffer(str), str->length + 1);
+    }
+    fossil_allocator_release(NULL, str->heap);
+    str->heap = heap;
+    str->capacity = grown;
+    return 0;
+}
+
+void fossil_sstr_init(sstring *str) {
+    if (str) {
+        str->length = 0;
+        str->capacity = FOSSIL_SSTR_INLINE_CAPACITY;
+        str->heap = NULL;
+        str->inline_data[0] = '\0';
+    }
+}
+
+void fossil_sstr_erase(sstring *str) {
+    if (str) {
+        fossil_allocator_release(NULL, str->heap);
+        fossil_sstr_init(str);
+    }
+}
+
+const_cstring fossil_sstr_data(const sstring *str) {
+    if (!str) {
+        return NULL;
+    }
+    return str->heap ? str->heap : str->inline_data;
+}
+
+size_t fossil_sstr_length(const sstring *str) {
+    return str ? str->length : 0;
+}
+
+int fossil_sstr_is_inline(const sstring *str) {
+    return str && !str->heap;
+}
+
+cstring fossil_sstr_detach(sstring *str) {
+    if (!str) {
+        return NULL;
+    }
+    cstring out = str->heap;
+    if (!out) {
+        out = fossil_allocator_alloc(NULL, str->length + 1);
+        if (!out) {
+            return NULL;
+        }
+        memcpy(out, str->inline_data, str->length + 1);
+    }
+    str->heap = NULL; // Ownership moved to the caller
+    fossil_sstr_init(str);
+    return out;
+}
+
+const_cstring fossil_sstr_assign_len(sstring *str, const_cstring src, size_t len) {
+    if (!str || !src) {
+        return NULL;
+    }
+    if (_sstr_reserve(str, len, 0) != 0) {
+        return NULL;
+    }
+    cletter *buffer = _sstr_buffer(str);
+    memmove(buffer, src, len);
+    buffer[len] = '\0';
+    str->length = len;
+    return buffer;
+}
+
+const_cstring fossil_sstr_create(sstring *str, const_cstring src) {
+    if (!str || !src) {
+        return NULL;
+    }
+    return fossil_sstr_assign_len(str, src, strlen(src));
+}
+
+const_cstring fossil_sstr_concat(sstring *str, const_cstring src) {
+    if (!str || !src) {
+        return NULL;
+    }
+    size_t len = strlen(src);
+    if (len > SIZE_MAX - 1 - str->length) {
+        return NULL; // Size overflow
+    }
+    // 'src' may point into the current buffer, so keep its offset across growth
+    const cletter *old = _sstr_buffer(str);
+    int aliased = src >= old && src <= old + str->length;
+    size_t offset = aliased ? (size_t)(src - old) : 0;
+    if (_sstr_reserve(str, str->length + len, 1) != 0) {
+        return NULL;
+    }
+    cletter *buffer = _sstr_buffer(str);
+    memmove(buffer + str->length, aliased ? buffer + offset : src, len);
+    str->length += len;
+    buffer[str->length] = '\0';
+    return buffer;
+}
+
+const_cstring fossil_sstr_vformat(sstring *str, const_cstring format, va_list args) {
+    if (!str || !format) {
+        return NULL; // Input validation
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    // The format and its arguments may point into 'str' itself, so the result
+    // is written elsewhere first and the old buffer outlives the formatting
+    cletter scratch[SSTR_FORMAT_SCRATCH];
+    int size = vsnprintf(scratch, sizeof(scratch), format, args);
+    if (size < 0) {
+        va_end(args_copy);
+        fossil_sstr_erase(str);
+        return NULL; // Error handling
+    }
+    cletter *formatted = scratch;
+    if ((size_t)size >= sizeof(scratch)) {
+        formatted = fossil_allocator_alloc(NULL, (size_t)size + 1);
+        if (!formatted) {
+            va_end(args_copy);
+            fossil_sstr_erase(str);
+            return NULL;
+        }
+        vsnprintf(formatted, (size_t)size + 1, format, args_copy);
+    }
+    va_end(args_copy);
+
+    if (formatted != scratch && (size_t)size > str->capacity) {
+        fossil_allocator_release(NULL, str->heap); // adopt the formatted buffer
+        str->heap = formatted;
+        str->capacity = (size_t)size;
+    } else {
+        if (_sstr_reserve(str, (size_t)size, 0) != 0) {
+            fossil_sstr_erase(str);
+            return NULL;
+        }
+        memcpy(_sstr_buffer(str), formatted, (size_t)size + 1);
+        if (formatted != scratch) {
+            fossil_allocator_release(NULL, formatted);
+        }
+    }
+    str->length = (size_t)size;
+    return _sstr_buffer(str);
+}
+
+const_cstring fossil_sstr_format(sstring *str, const_cstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    const_cstring result = fossil_sstr_vformat(str, format, args);
+    va_end(args);
+    return result;
+}
+
+const_cstring fossil_sstr_format_phone(sstring *str, const_cstring phone) {
+    if (!phone || strlen(phone) != 10) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "(%c%c%c) %c%c%c-%c%c%c%c",
+                            phone[0], phone[1], phone[2],
+                            phone[3], phone[4], phone[5],
+                            phone[6], phone[7], phone[8], phone[9]);
+}
+
+const_cstring fossil_sstr_format_date(sstring *str, const_cstring date) {
+    if (!date || strlen(date) != 8) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "%c%c/%c%c/%c%c%c%c",
+                            date[0], date[1],
+                            date[2], date[3],
+                            date[4], date[5], date[6], date[7]);
+}
+
+const_cstring fossil_sstr_format_time(sstring *str, const_cstring time) {
+    if (!time || strlen(time) != 6) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "%c%c:%c%c:%c%c",
+                            time[0], time[1],
+                            time[2], time[3],
+                            time[4], time[5]);
+}
+
+const_cstring fossil_sstr_format_currency(sstring *str, const_cstring currency) {
+    if (!currency) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "$%s", currency);
+}
+
+const_cstring fossil_sstr_format_percentage(sstring *str, const_cstring percentage) {
+    if (!percentage) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "%s%%", percentage);
+}
+
+const_cstring fossil_sstr_format_postal_code(sstring *str, const_cstring postal_code) {
+    if (!postal_code || strlen(postal_code) != 5) {
+        return NULL;
+    }
+
+    return fossil_sstr_assign_len(str, postal_code, 5);
+}
+
+const_cstring fossil_sstr_format_ssn(sstring *str, const_cstring ssn) {
+    if (!ssn || strlen(ssn) != 9) {
+        return NULL;
+    }
+
+    return fossil_sstr_format(str, "%c%c%c-%c%c-%c%c%c%c",
+                            ssn[0], ssn[1], ssn[2],
+                            ssn[3], ssn[4],
+                            ssn[5], ssn[6], ssn[7], ssn[8]);
+}
+
+// Write the decimal digits of 'num' into the inline buffer without printf
+static const_cstring _sstr_from_unsigned(sstring *str, unsigned long long num, int negative) {
+    cletter digits[24];
+    size_t pos = sizeof(digits);
+    do {
+        digits[--pos] = (cletter)('0' + (num % 10));
+        num /= 10;
+    } while (num > 0);
+    if (negative) {
+        digits[--pos] = '-';
+    }
+    return fossil_sstr_assign_len(str, digits + pos, sizeof(digits) - pos);
+}
+
+static const_cstring _sstr_from_signed(sstring *str, long long num) {
+    // Negate in unsigned arithmetic so LLONG_MIN does not overflow
+    unsigned long long magnitude = num < 0 ? 0ULL - (unsigned long long)num : (unsigned long long)num;
+    return _sstr_from_unsigned(str, magnitude, num < 0);
+}
+
+const_cstring fossil_sstr_from_int(sstring *str, int num) {
+    return _sstr_from_signed(str, num);
+}
+
+const_cstring fossil_sstr_from_long(sstring *str, long num) {
+    return _sstr_from_signed(str, num);
+}
+
+const_cstring fossil_sstr_from_llong(sstring *str, long long num) {
+    return _sstr_from_signed(str, num);
+}
+
+const_cstring fossil_sstr_from_ulong(sstring *str, unsigned long num) {
+    return _sstr_from_unsigned(str, num, 0);
+}
+
+const_cstring fossil_sstr_from_ullong(sstring *str, unsigned long long num) {
+    return _sstr_from_unsigned(str, num, 0);
+}
+
+const_cstring fossil_sstr_from_double(sstring *str, double num) {
+    return fossil_sstr_format(str, "%lf", num);
+}
@@ -0,0 +1,595 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/suffix.h"
+#include "parallel.h"
+#include "simd.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * LCP values are stored in one byte each. The rare ones of 255 or more
+ * are kept at full width in a sorted side table, found by bisection.
+ */
+
+#define SUFFIX_EMPTY ((size_t)-1)
+#define SUFFIX_SATURATED 255
+#define SUFFIX_CHUNK ((size_t)1 << 18) // text positions per parallel task
+#define SUFFIX_SAMPLES 4096            // text windows hashed into the file fingerprint
+#define SUFFIX_MAGIC "FSSUFFIX"
+#define SUFFIX_VERSION 1u
+#define SUFFIX_ORDER 0x0102030405060708ull
+
+struct fossil_suffix {
+    const unsigned char *text;
+    size_t length;
+    size_t *sa;
+    unsigned char *lcp;
+    size_t *long_rank; // ranks whose LCP is saturated, ascending
+    size_t *long_lcp;  // their full LCPs
+    size_t long_count;
+};
+
+// ---- SA-IS ----
+
+/*
+ * The input of each level is bytes at the top and names (size_t) below.
+ * A suffix is S-type if it is smaller than the one after it, else L-type;
+ * an LMS position is an S-type one right after an L-type one. The text is
+ * taken to end with a virtual sentinel smaller than every character.
+ */
+
+static size_t _sais_at(const void *s, int names, size_t i) {
+    return names ? ((const size_t *)s)[i] : ((const unsigned char *)s)[i];
+}
+
+static int _sais_is_s(const unsigned char *stype, size_t i) {
+    return (stype[i >> 3] >> (i & 7)) & 1;
+}
+
+static int _sais_is_lms(const unsigned char *stype, size_t i) {
+    return i > 0 && _sais_is_s(stype, i) && !_sais_is_s(stype, i - 1);
+}
+
+/*
+ * Induce the order of all suffixes from the LMS suffixes already placed at
+ * the start of the S-type part of their buckets. 'sum_l' holds each
+ * bucket's start and 'sum_s' the start of its S-type part.
+ */
+static void _sais_induce(const void *s, int names, size_t n, size_t k, const unsigned char *stype,
+                         const size_t *sum_l, size_t *buf, size_t *sa) {
+    memcpy(buf, sum_l, k * sizeof(size_t));
+    sa[buf[_sais_at(s, names, n - 1)]++] = n - 1; // the last suffix is L-type against the sentinel
+    for (size_t i = 0; i < n; i++) {
+        size_t v = sa[i];
+        if (v != SUFFIX_EMPTY && v > 0 && !_sais_is_s(stype, v - 1)) {
+            sa[buf[_sais_at(s, names, v - 1)]++] = v - 1;
+        }
+    }
+    memcpy(buf, sum_l, k * sizeof(size_t));
+    for (size_t i = n; i-- > 0;) {
+        size_t v = sa[i];
+        if (v != SUFFIX_EMPTY && v > 0 && _sais_is_s(stype, v - 1)) {
+            sa[--buf[_sais_at(s, names, v - 1) + 1]] = v - 1;
+        }
+    }
+}
+
+// Sort the suffixes of 's' (characters up to 'upper') into 'sa'; returns 0 if memory runs out
+static int _sais(const void *s, int names, size_t n, size_t upper, size_t *sa) {
+    if (n <= 2) {
+        if (n == 2) {
+            int first = _sais_at(s, names, 0) < _sais_at(s, names, 1);
+            sa[0] = first ? 0 : 1;
+            sa[1] = first ? 1 : 0;
+        } else if (n == 1) {
+            sa[0] = 0;
+        }
+        return 1;
+    }
+
+    size_t k = upper + 2;
+    unsigned char *stype = calloc(n / 8 + 1, 1);
+    size_t *sum_l = calloc(3 * k, sizeof(size_t));
+    if (!stype || !sum_l) {
+        free(stype);
+        free(sum_l);
+        return 0;
+    }
+    size_t *sum_s = sum_l + k, *buf = sum_s + k;
+
+    for (size_t i = n - 1; i-- > 0;) {
+        size_t c = _sais_at(s, names, i), d = _sais_at(s, names, i + 1);
+        if (c < d || (c == d && _sais_is_s(stype, i + 1))) {
+            stype[i >> 3] |= (unsigned char)(1u << (i & 7));
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (_sais_is_s(stype, i)) {
+            sum_l[_sais_at(s, names, i) + 1]++;
+        } else {
+            sum_s[_sais_at(s, names, i)]++;
+        }
+    }
+    for (size_t c = 0; c <= upper; c++) {
+        sum_s[c] += sum_l[c];
+        sum_l[c + 1] += sum_s[c];
+    }
+
+    // Sort the LMS substrings by inducing from the LMS positions in text order
+    for (size_t i = 0; i < n; i++) {
+        sa[i] = SUFFIX_EMPTY;
+    }
+    memcpy(buf, sum_s, k * sizeof(size_t));
+    for (size_t i = 1; i < n; i++) {
+        if (_sais_is_lms(stype, i)) {
+            sa[buf[_sais_at(s, names, i)]++] = i;
+        }
+    }
+    _sais_induce(s, names, n, k, stype, sum_l, buf, sa);
+
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (_sais_is_lms(stype, sa[i])) {
+            sa[m++] = sa[i];
+        }
+    }
+    if (m > 0) {
+        // Name the sorted LMS substrings; LMS positions are at least two apart, so p / 2 is a free slot
+        for (size_t i = m; i < n; i++) {
+            sa[i] = SUFFIX_EMPTY;
+        }
+        size_t name = 0, prev = SUFFIX_EMPTY, prev_end = 0;
+        for (size_t i = 0; i < m; i++) {
+            size_t p = sa[i], end = p + 1;
+            while (end < n && !_sais_is_lms(stype, end)) {
+                end++;
+            }
+            int same = prev != SUFFIX_EMPTY && end - p == prev_end - prev && end < n && prev_end < n;
+            for (size_t j = 0; same && j <= end - p; j++) {
+                same = _sais_at(s, names, p + j) == _sais_at(s, names, prev + j);
+            }
+            if (!same && prev != SUFFIX_EMPTY) {
+                name++;
+            }
+            sa[m + p / 2] = name;
+            prev = p;
+            prev_end = end;
+        }
+
+        // Gather the names in text order at the end of 'sa' and sort them
+        size_t *reduced = sa + n;
+        for (size_t i = n; i-- > m;) {
+            if (sa[i] != SUFFIX_EMPTY) {
+                *--reduced = sa[i];
+            }
+        }
+        if (name + 1 < m) {
+            if (!_sais(reduced, 1, m, name, sa)) {
+                free(stype);
+                free(sum_l);
+                return 0;
+            }
+        } else {
+            for (size_t i = 0; i < m; i++) {
+                sa[reduced[i]] = i; // every name is distinct, so it is the rank
+            }
+        }
+
+        // Map the sorted ranks back to positions
+        size_t j = 0;
+        for (size_t i = 1; i < n; i++) {
+            if (_sais_is_lms(stype, i)) {
+                reduced[j++] = i;
+            }
+        }
+        for (size_t i = 0; i < m; i++) {
+            sa[i] = reduced[sa[i]];
+        }
+        for (size_t i = m; i < n; i++) {
+            sa[i] = SUFFIX_EMPTY;
+        }
+
+        // Move the sorted LMS suffixes to the start of their buckets' S-type parts, last first
+        memset(buf, 0, k * sizeof(size_t));
+        for (size_t i = 0; i < m; i++) {
+            buf[_sais_at(s, names, sa[i])]++;
+        }
+        for (size_t c = 0; c < k; c++) {
+            buf[c] += sum_s[c];
+        }
+        for (size_t i = m; i-- > 0;) {
+            size_t p = sa[i];
+            sa[i] = SUFFIX_EMPTY;
+            sa[--buf[_sais_at(s, names, p)]] = p;
+        }
+        _sais_induce(s, names, n, k, stype, sum_l, buf, sa);
+    }
+    free(stype);
+    free(sum_l);
+    return 1;
+}
+
+// ---- LCP ----
+
+typedef struct {
+    fossil_suffix_t *index;
+    size_t *phi;     // the suffix ranked before each offset's, then its LCP
+    size_t *counts;  // saturated LCPs per task, then where each task's run starts
+    size_t tasks;
+} _suffix_build;
+
+static void _suffix_range(const _suffix_build *build, size_t task, size_t *begin, size_t *end) {
+    *begin = task * SUFFIX_CHUNK;
+    *end = *begin + SUFFIX_CHUNK < build->index->length ? *begin + SUFFIX_CHUNK : build->index->length;
+}
+
+static void _suffix_phi(void *context, size_t task) {
+    _suffix_build *build = context;
+    const size_t *sa = build->index->sa;
+    size_t begin, end;
+    _suffix_range(build, task, &begin, &end);
+    for (size_t i = begin; i < end; i++) {
+        build->phi[sa[i]] = i > 0 ? sa[i - 1] : SUFFIX_EMPTY;
+    }
+}
+
+// Kasai's bound: the LCP at offset i + 1 is at least the one at i minus one, within a range
+static void _suffix_plcp(void *context, size_t task) {
+    _suffix_build *build = context;
+    const unsigned char *text = build->index->text;
+    size_t n = build->index->length, begin, end, l = 0;
+    _suffix_range(build, task, &begin, &end);
+    for (size_t i = begin; i < end; i++) {
+        size_t j = build->phi[i];
+        if (j == SUFFIX_EMPTY) {
+            build->phi[i] = 0;
+            l = 0;
+            continue;
+        }
+        while (i + l < n && j + l < n && text[i + l] == text[j + l]) {
+            l++;
+        }
+        build->phi[i] = l;
+        l = l > 0 ? l - 1 : 0;
+    }
+}
+
+static void _suffix_lcp(void *context, size_t task) {
+    _suffix_build *build = context;
+    fossil_suffix_t *index = build->index;
+    size_t begin, end, saturated = 0;
+    _suffix_range(build, task, &begin, &end);
+    for (size_t i = begin; i < end; i++) {
+        size_t l = i > 0 ? build->phi[index->sa[i]] : 0;
+        index->lcp[i] = (unsigned char)(l < SUFFIX_SATURATED ? l : SUFFIX_SATURATED);
+        saturated += l >= SUFFIX_SATURATED;
+    }
+    build->counts[task] = saturated;
+}
+
+static void _suffix_long(void *context, size_t task) {
+    _suffix_build *build = context;
+    fossil_suffix_t *index = build->index;
+    size_t begin, end, at = build->counts[task];
+    _suffix_range(build, task, &begin, &end);
+    for (size_t i = begin; i < end; i++) {
+        if (index->lcp[i] == SUFFIX_SATURATED) {
+            index->long_rank[at] = i;
+            index->long_lcp[at++] = build->phi[index->sa[i]];
+        }
+    }
+}
+
+// Fill the LCP arrays from the finished suffix array; returns 0 if memory runs out
+static int _suffix_build_lcp(fossil_suffix_t *index, size_t threads) {
+    _suffix_build build;
+    build.index = index;
+    build.tasks = (index->length + SUFFIX_CHUNK - 1) / SUFFIX_CHUNK;
+    build.phi = malloc(index->length * sizeof(size_t));
+    build.counts = malloc(build.tasks * sizeof(size_t));
+    if (!build.phi || !build.counts) {
+        free(build.phi);
+        free(build.counts);
+        return 0;
+    }
+    _fossil_parallel_run(build.tasks, threads, _suffix_phi, &build);
+    _fossil_parallel_run(build.tasks, threads, _suffix_plcp, &build);
+    _fossil_parallel_run(build.tasks, threads, _suffix_lcp, &build);
+
+    for (size_t t = 0; t < build.tasks; t++) {
+        size_t count = build.counts[t];
+        build.counts[t] = index->long_count;
+        index->long_count += count;
+    }
+    int ok = 1;
+    if (index->long_count > 0) {
+        index->long_rank = malloc(index->long_count * sizeof(size_t));
+        index->long_lcp = malloc(index->long_count * sizeof(size_t));
+        ok = index->long_rank && index->long_lcp;
+        if (ok) {
+            _fossil_parallel_run(build.tasks, threads, _suffix_long, &build);
+        }
+    }
+    free(build.phi);
+    free(build.counts);
+    return ok;
+}
+
+// ---- building ----
+
+static fossil_suffix_t *_suffix_alloc(const_cstring text, size_t length) {
+    fossil_suffix_t *index = calloc(1, sizeof(fossil_suffix_t));
+    if (!index) {
+        return NULL;
+    }
+    index->text = (const unsigned char *)text;
+    index->length = length;
+    index->sa = malloc((length ? length : 1) * sizeof(size_t));
+    index->lcp = malloc(length ? length : 1);
+    if (!index->sa || !index->lcp) {
+        fossil_suffix_erase(index);
+        return NULL;
+    }
+    return index;
+}
+
+fossil_suffix_t *fossil_suffix_create(const_cstring text, size_t threads) {
+    if (!text) {
+        return NULL;
+    }
+    size_t length = _fossil_simd_length(text, 1);
+    if (length > SIZE_MAX / sizeof(size_t)) {
+        return NULL;
+    }
+    fossil_suffix_t *index = _suffix_alloc(text, length);
+    if (!index) {
+        return NULL;
+    }
+    if (!_sais(text, 0, length, UINT8_MAX, index->sa) || (length > 0 && !_suffix_build_lcp(index, threads))) {
+        fossil_suffix_erase(index);
+        return NULL;
+    }
+    return index;
+}
+
+void fossil_suffix_erase(fossil_suffix_t *index) {
+    if (!index) {
+        return;
+    }
+    free(index->sa);
+    free(index->lcp);
+    free(index->long_rank);
+    free(index->long_lcp);
+    free(index);
+}
+
+// ---- querying ----
+
+size_t fossil_suffix_length(const fossil_suffix_t *index) {
+    return index ? index->length : 0;
+}
+
+size_t fossil_suffix_at(const fossil_suffix_t *index, size_t rank) {
+    return index && rank < index->length ? index->sa[rank] : 0;
+}
+
+size_t fossil_suffix_lcp(const fossil_suffix_t *index, size_t rank) {
+    if (!index || rank >= index->length) {
+        return 0;
+    }
+    if (index->lcp[rank] < SUFFIX_SATURATED) {
+        return index->lcp[rank];
+    }
+    size_t lo = 0, hi = index->long_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->long_rank[mid] < rank) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return index->long_lcp[lo];
+}
+
+/*
+ * First rank whose suffix, cut to the pattern's length, is not below the
+ * pattern ('upper' 0) or is above it ('upper' 1). The prefix already known
+ * to match both ends of the range is not compared again.
+ */
+static size_t _suffix_bound(const fossil_suffix_t *index, const unsigned char *pattern, size_t count, int upper) {
+    size_t lo = 0, hi = index->length, lo_match = 0, hi_match = 0;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const unsigned char *suffix = index->text + index->sa[mid];
+        size_t left = index->length - index->sa[mid];
+        size_t k = lo_match < hi_match ? lo_match : hi_match;
+        while (k < count && k < left && suffix[k] == pattern[k]) {
+            k++;
+        }
+        int below;
+        if (k == count) {
+            below = upper;
+        } else {
+            below = k == left || suffix[k] < pattern[k];
+        }
+        if (below) {
+            lo = mid + 1;
+            lo_match = k;
+        } else {
+            hi = mid;
+            hi_match = k;
+        }
+    }
+    return lo;
+}
+
+static int _suffix_offset_order(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+size_t fossil_suffix_count(const fossil_suffix_t *index, const_cstring pattern) {
+    return fossil_suffix_locate(index, pattern, NULL, 0);
+}
+
+size_t fossil_suffix_locate(const fossil_suffix_t *index, const_cstring pattern, size_t *offsets, size_t capacity) {
+    if (!index || !pattern) {
+        return 0;
+    }
+    size_t count = _fossil_simd_length(pattern, 1);
+    size_t first = _suffix_bound(index, (const unsigned char *)pattern, count, 0);
+    size_t last = _suffix_bound(index, (const unsigned char *)pattern, count, 1);
+    if (offsets) {
+        size_t stored = last - first < capacity ? last - first : capacity;
+        memcpy(offsets, index->sa + first, stored * sizeof(size_t));
+        qsort(offsets, stored, sizeof(size_t), _suffix_offset_order);
+    }
+    return last - first;
+}
+
+// ---- files ----
+
+typedef struct {
+    char magic[8];
+    uint64_t order;   // SUFFIX_ORDER as written, to catch byte order changes
+    uint64_t version;
+    uint64_t length;
+    uint64_t fingerprint;
+    uint64_t long_count;
+} _suffix_header;
+
+// FNV-1a over the length and evenly spaced 16-byte windows of the text
+static uint64_t _suffix_fingerprint(const unsigned char *text, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull ^ (uint64_t)length;
+    size_t step = length / SUFFIX_SAMPLES + 1;
+    for (size_t at = 0; at < length; at += step) {
+        for (size_t i = at; i < at + 16 && i < length; i++) {
+            hash = (hash ^ text[i]) * 0x100000001b3ull;
+        }
+    }
+    return hash;
+}
+
+static int _suffix_write_words(FILE *file, const size_t *words, size_t count) {
+    uint64_t buffer[1024];
+    while (count > 0) {
+        size_t n = count < 1024 ? count : 1024;
+        for (size_t i = 0; i < n; i++) {
+            buffer[i] = words[i];
+        }
+        if (fwrite(buffer, sizeof(uint64_t), n, file) != n) {
+            return 0;
+        }
+        words += n;
+        count -= n;
+    }
+    return 1;
+}
+
+// Read 'count' words, each of which must be below 'limit'
+static int _suffix_read_words(FILE *file, size_t *words, size_t count, uint64_t limit) {
+    uint64_t buffer[1024];
+    while (count > 0) {
+        size_t n = count < 1024 ? count : 1024;
+        if (fread(buffer, sizeof(uint64_t), n, file) != n) {
+            return 0;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (buffer[i] >= limit) {
+                return 0;
+            }
+            words[i] = (size_t)buffer[i];
+        }
+        words += n;
+        count -= n;
+    }
+    return 1;
+}
+
+int fossil_suffix_save(const fossil_suffix_t *index, const char *path) {
+    if (!index || !path) {
+        return -1;
+    }
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return -1;
+    }
+    _suffix_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SUFFIX_MAGIC, sizeof(header.magic));
+    header.order = SUFFIX_ORDER;
+    header.version = SUFFIX_VERSION;
+    header.length = index->length;
+    header.fingerprint = _suffix_fingerprint(index->text, index->length);
+    header.long_count = index->long_count;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             _suffix_write_words(file, index->sa, index->length) &&
+             fwrite(index->lcp, 1, index->length, file) == index->length &&
+             _suffix_write_words(file, index->long_rank, index->long_count) &&
+             _suffix_write_words(file, index->long_lcp, index->long_count);
+    ok = fclose(file) == 0 && ok;
+    return ok ? 0 : -1;
+}
+
+fossil_suffix_t *fossil_suffix_load(const char *path, const_cstring text) {
+    if (!path || !text) {
+        return NULL;
+    }
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    size_t length = _fossil_simd_length(text, 1);
+    _suffix_header header;
+    fossil_suffix_t *index = NULL;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, SUFFIX_MAGIC, 8) != 0 ||
+        header.order != SUFFIX_ORDER || header.version != SUFFIX_VERSION || header.length != length ||
+        header.long_count > length ||
+        header.fingerprint != _suffix_fingerprint((const unsigned char *)text, length)) {
+        fclose(file);
+        return NULL;
+    }
+
+    index = _suffix_alloc(text, length);
+    int ok = index != NULL;
+    if (ok && header.long_count > 0) {
+        index->long_count = (size_t)header.long_count;
+        index->long_rank = malloc(index->long_count * sizeof(size_t));
+        index->long_lcp = malloc(index->long_count * sizeof(size_t));
+        ok = index->long_rank && index->long_lcp;
+    }
+    ok = ok && _suffix_read_words(file, index->sa, length, length) &&
+         fread(index->lcp, 1, length, file) == length &&
+         _suffix_read_words(file, index->long_rank, index->long_count, length) &&
+         _suffix_read_words(file, index->long_lcp, index->long_count, length);
+    fclose(file);
+
+    // Each saturated LCP byte needs its entry in the side table, in rank order
+    size_t saturated = 0;
+    for (size_t i = 0; ok && i < length; i++) {
+        if (index->lcp[i] == SUFFIX_SATURATED) {
+            ok = saturated < index->long_count && index->long_rank[saturated++] == i;
+        }
+    }
+    if (!ok || saturated != (index ? index->long_count : 0)) {
+        fossil_suffix_erase(index);
+        return NULL;
+    }
+    return index;
+}
@@ -0,0 +1,300 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_STRINGS_SYNC_H
+#define FOSSIL_STRINGS_SYNC_H
+
+/*
+ * Private synchronization helpers shared by the string library sources.
+ * MSVC does not ship C11 atomics, so it uses the Interlocked intrinsics.
+ * MinGW has both, so atomics key off the compiler and locks off the platform.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+typedef volatile intptr_t _fossil_atomic_size;
+
+static __inline void _fossil_atomic_init(_fossil_atomic_size *value, size_t init) {
+    *value = (intptr_t)init;
+}
+
+static __inline size_t _fossil_atomic_load(_fossil_atomic_size *value) {
+    return (size_t)*value; // volatile reads have acquire semantics on MSVC
+}
+
+#ifdef _WIN64
+static __inline size_t _fossil_atomic_inc(_fossil_atomic_size *value) {
+    return (size_t)_InterlockedIncrement64((volatile __int64 *)value);
+}
+
+static __inline size_t _fossil_atomic_dec(_fossil_atomic_size *value) {
+    return (size_t)_InterlockedDecrement64((volatile __int64 *)value);
+}
+#else
+static __inline size_t _fossil_atomic_inc(_fossil_atomic_size *value) {
+    return (size_t)_InterlockedIncrement((volatile long *)value);
+}
+
+static __inline size_t _fossil_atomic_dec(_fossil_atomic_size *value) {
+    return (size_t)_InterlockedDecrement((volatile long *)value);
+}
+#endif
+
+typedef void *volatile _fossil_atomic_ptr;
+
+static __inline void *_fossil_atomic_ptr_load(_fossil_atomic_ptr *value) {
+    return *value; // volatile reads have acquire semantics on MSVC
+}
+
+static __inline void _fossil_atomic_ptr_store(_fossil_atomic_ptr *value, void *ptr) {
+    _InterlockedExchangePointer((void *volatile *)value, ptr);
+}
+
+#else
+#include <stdatomic.h>
+
+typedef _Atomic size_t _fossil_atomic_size;
+
+static inline void _fossil_atomic_init(_fossil_atomic_size *value, size_t init) {
+    atomic_init(value, init);
+}
+
+static inline size_t _fossil_atomic_load(_fossil_atomic_size *value) {
+    return atomic_load_explicit(value, memory_order_acquire);
+}
+
+// Increments only need to be atomic; no other memory is published by them
+static inline size_t _fossil_atomic_inc(_fossil_atomic_size *value) {
+    return atomic_fetch_add_explicit(value, 1, memory_order_relaxed) + 1;
+}
+
+// Decrements release prior writes and acquire them before the last owner frees
+static inline size_t _fossil_atomic_dec(_fossil_atomic_size *value) {
+    return atomic_fetch_sub_explicit(value, 1, memory_order_acq_rel) - 1;
+}
+
+typedef _Atomic(void *) _fossil_atomic_ptr;
+
+// Pointer loads acquire whatever the publishing store released
+static inline void *_fossil_atomic_ptr_load(_fossil_atomic_ptr *value) {
+    return atomic_load_explicit(value, memory_order_acquire);
+}
+
+static inline void _fossil_atomic_ptr_store(_fossil_atomic_ptr *value, void *ptr) {
+    atomic_store_explicit(value, ptr, memory_order_release);
+}
+#endif
+
+/*
+ * Mutexes: SRW locks on Windows, POSIX threads everywhere else.
+ */
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+typedef SRWLOCK _fossil_mutex;
+
+static __inline void _fossil_mutex_init(_fossil_mutex *mutex) {
+    InitializeSRWLock(mutex);
+}
+
+static __inline void _fossil_mutex_destroy(_fossil_mutex *mutex) {
+    (void)mutex; // SRW locks own no resources
+}
+
+static __inline void _fossil_mutex_lock(_fossil_mutex *mutex) {
+    AcquireSRWLockExclusive(mutex);
+}
+
+static __inline void _fossil_mutex_unlock(_fossil_mutex *mutex) {
+    ReleaseSRWLockExclusive(mutex);
+}
+
+/*
+ * One-time initialization and thread-exit callbacks. Fiber-local storage
+ * is used for the key because, unlike TLS, it runs a callback on exit.
+ */
+typedef INIT_ONCE _fossil_once_flag;
+#define _FOSSIL_ONCE_INIT INIT_ONCE_STATIC_INIT
+
+typedef struct {
+    void (*fn)(void);
+} _fossil_once_call;
+
+static __inline BOOL CALLBACK _fossil_once_thunk(PINIT_ONCE once, PVOID param, PVOID *context) {
+    (void)once;
+    (void)context;
+    ((_fossil_once_call *)param)->fn();
+    return TRUE;
+}
+
+static __inline void _fossil_once(_fossil_once_flag *flag, void (*fn)(void)) {
+    _fossil_once_call call = { fn };
+    InitOnceExecuteOnce(flag, _fossil_once_thunk, &call, NULL);
+}
+
+typedef DWORD _fossil_tls_key;
+#define _FOSSIL_TLS_CALLBACK NTAPI
+
+static __inline int _fossil_tls_create(_fossil_tls_key *key, void (NTAPI *destructor)(void *)) {
+    *key = FlsAlloc(destructor);
+    return *key == FLS_OUT_OF_INDEXES ? -1 : 0;
+}
+
+static __inline void _fossil_tls_set(_fossil_tls_key key, void *value) {
+    FlsSetValue(key, value);
+}
+
+/*
+ * Worker threads, started and joined by one owner.
+ */
+typedef HANDLE _fossil_thread;
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} _fossil_thread_call;
+
+static __inline DWORD WINAPI _fossil_thread_thunk(LPVOID param) {
+    _fossil_thread_call call = *(_fossil_thread_call *)param;
+    free(param);
+    call.fn(call.arg);
+    return 0;
+}
+
+// Returns 0 on success, -1 if the thread could not be started
+static __inline int _fossil_thread_start(_fossil_thread *thread, void (*fn)(void *), void *arg) {
+    _fossil_thread_call *call = malloc(sizeof(*call));
+    if (!call) {
+        return -1;
+    }
+    call->fn = fn;
+    call->arg = arg;
+    *thread = CreateThread(NULL, 0, _fossil_thread_thunk, call, 0, NULL);
+    if (!*thread) {
+        free(call);
+        return -1;
+    }
+    return 0;
+}
+
+static __inline void _fossil_thread_join(_fossil_thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+// Number of processors available to run threads
+static __inline size_t _fossil_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (size_t)info.dwNumberOfProcessors : 1;
+}
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t _fossil_mutex;
+
+static inline void _fossil_mutex_init(_fossil_mutex *mutex) {
+    pthread_mutex_init(mutex, NULL);
+}
+
+static inline void _fossil_mutex_destroy(_fossil_mutex *mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+static inline void _fossil_mutex_lock(_fossil_mutex *mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+static inline void _fossil_mutex_unlock(_fossil_mutex *mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+typedef pthread_once_t _fossil_once_flag;
+#define _FOSSIL_ONCE_INIT PTHREAD_ONCE_INIT
+
+static inline void _fossil_once(_fossil_once_flag *flag, void (*fn)(void)) {
+    pthread_once(flag, fn);
+}
+
+typedef pthread_key_t _fossil_tls_key;
+#define _FOSSIL_TLS_CALLBACK
+
+// The destructor runs on thread exit for every thread that set a non-NULL value
+static inline int _fossil_tls_create(_fossil_tls_key *key, void (*destructor)(void *)) {
+    return pthread_key_create(key, destructor) == 0 ? 0 : -1;
+}
+
+static inline void _fossil_tls_set(_fossil_tls_key key, void *value) {
+    pthread_setspecific(key, value);
+}
+
+/*
+ * Worker threads, started and joined by one owner.
+ */
+typedef pthread_t _fossil_thread;
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} _fossil_thread_call;
+
+static inline void *_fossil_thread_thunk(void *param) {
+    _fossil_thread_call call = *(_fossil_thread_call *)param;
+    free(param);
+    call.fn(call.arg);
+    return NULL;
+}
+
+// Returns 0 on success, -1 if the thread could not be started
+static inline int _fossil_thread_start(_fossil_thread *thread, void (*fn)(void *), void *arg) {
+    _fossil_thread_call *call = malloc(sizeof(*call));
+    if (!call) {
+        return -1;
+    }
+    call->fn = fn;
+    call->arg = arg;
+    if (pthread_create(thread, NULL, _fossil_thread_thunk, call) != 0) {
+        free(call);
+        return -1;
+    }
+    return 0;
+}
+
+static inline void _fossil_thread_join(_fossil_thread thread) {
+    pthread_join(thread, NULL);
+}
+
+// Number of processors available to run threads
+static inline size_t _fossil_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+}
+#endif
+
+// Storage class for per-thread variables
+#if defined(_MSC_VER) && !defined(__clang__)
+#define _FOSSIL_THREAD_LOCAL __declspec(thread)
+#else
+#define _FOSSIL_THREAD_LOCAL _Thread_local
+#endif
+
+#endif /* FOSSIL_STRINGS_SYNC_H */
@@ -12,6 +12,11 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/string/wstring.h"
+#include "simd.h"
+#include "search.h"
+#include "fold.h"
+
+#include <errno.h>
 
 // Helper function to calculate the number of digits in an integer
 int _wstr_num_digits(long long num) {
@@ -30,12 +35,16 @@ int _wstr_num_digits(long long num) {
 
 // String library functions
 wstring fossil_wstr_create(const_wstring str) {
+    return fossil_wstr_create_with(NULL, str);
+}
+
+wstring fossil_wstr_create_with(const fossil_allocator_t *allocator, const_wstring str) {
     if (str == NULL) {
         return NULL;
     }
 
     size_t len = wcslen(str);
-    wstring new_str = (wstring)malloc((len + 1) * sizeof(wletter));
+    wstring new_str = (wstring)fossil_allocator_alloc(allocator, (len + 1) * sizeof(wletter));
     
     if (new_str == NULL) {
         // Handle memory allocation failure
@@ -47,8 +56,12 @@ wstring fossil_wstr_create(const_wstring str) {
 }
 
 void fossil_wstr_erase(wstring str) {
+    fossil_wstr_erase_with(NULL, str);
+}
+
+void fossil_wstr_erase_with(const fossil_allocator_t *allocator, wstring str) {
     if (str != NULL) {
-        free(str);
+        fossil_allocator_release(allocator, str);
     }
 }
 
@@ -60,31 +73,51 @@ size_t fossil_wstr_length(const_wstring str) {
     return wcslen(str);
 }
 
-wstring fossil_wstr_format(const_wstring format, ...) {
+static wstring _wstr_vformat(const fossil_allocator_t *allocator, const_wstring format, va_list args) {
     if (!format) {
         return NULL; // Input validation
     }
 
-    va_list args, args_copy;
-    va_start(args, format);
-    va_copy(args_copy, args);
-
-    // Calculate required size
-    int size = vswprintf(NULL, 0, (const wchar_t *)format, args);
-    va_end(args);
-
-    if (size < 0) {
-        return NULL; // Error handling
+    // vswprintf cannot report the size it needs, so grow the buffer until it fits.
+    // An argument that does not convert fails the same way at any size.
+    wstring buffer = NULL;
+    for (size_t cap = 64; cap <= (size_t)INT_MAX / sizeof(wchar_t); cap *= 2) {
+        wstring grown = fossil_allocator_resize(allocator, buffer, cap * sizeof(wchar_t));
+        if (!grown) {
+            break; // Memory management
+        }
+        buffer = grown;
+
+        va_list args_copy;
+        va_copy(args_copy, args);
+        errno = 0;
+        int size = vswprintf((wchar_t *)buffer, cap, (const wchar_t *)format, args_copy);
+        va_end(args_copy);
+        if (size >= 0) {
+            return buffer;
+        }
+        if (errno == EILSEQ) {
+            break;
+        }
     }
 
-    wstring buffer = malloc((size_t)size * sizeof(wchar_t) + sizeof(wchar_t));
-    if (!buffer) {
-        return NULL; // Memory management
-    }
+    fossil_allocator_release(allocator, buffer);
+    return NULL; // Error handling
+}
 
-    vswprintf((wchar_t *)buffer, (size_t)size + 1, (const wchar_t *)format, args_copy);
-    va_end(args_copy);
+wstring fossil_wstr_format(const_wstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    wstring buffer = _wstr_vformat(NULL, format, args);
+    va_end(args);
+    return buffer;
+}
 
+wstring fossil_wstr_format_with(const fossil_allocator_t *allocator, const_wstring format, ...) {
+    va_list args;
+    va_start(args, format);
+    wstring buffer = _wstr_vformat(allocator, format, args);
+    va_end(args);
     return buffer;
 }
 
@@ -167,6 +200,35 @@ int fossil_wstr_compare(const_wstring str1, const_wstring str2) {
     return wcscmp(str1, str2);
 }
 
+int fossil_wstr_icompare(const_wstring str1, const_wstring str2) {
+    if (str1 == NULL || str2 == NULL) {
+        return (str1 == NULL && str2 == NULL) ? 0 : (str1 == NULL) ? -1 : 1;
+    }
+    return _fossil_fold_compare(str1, str2, sizeof(wletter), 1);
+}
+
+int fossil_wstr_iequals(const_wstring str1, const_wstring str2) {
+    return str1 && str2 && _fossil_fold_equals(str1, str2, sizeof(wletter), 1);
+}
+
+int fossil_wstr_istarts_with(const_wstring str, const_wstring prefix) {
+    return str && prefix && _fossil_fold_starts_with(str, prefix, sizeof(wletter), 1);
+}
+
+const_wstring fossil_wstr_ifind_str(const_wstring str, const_wstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(wletter)), sizeof(wletter), _FOSSIL_FOLD_WIDE);
+    size_t i = _fossil_search_plan_find(&plan, str, _fossil_simd_length(str, sizeof(wletter)), 0);
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+uint64_t fossil_wstr_ihash(const_wstring str) {
+    return str ? _fossil_fold_hash(str, sizeof(wletter), 1) : 0;
+}
+
 wstring fossil_wstr_copy(wstring dest, const_wstring src) {
     if (src == NULL) {
         return dest;
@@ -174,7 +236,7 @@ wstring fossil_wstr_copy(wstring dest, const_wstring src) {
 
     size_t len = wcslen(src);
     if (dest == NULL) {
-        dest = (wstring)malloc((len + 1) * sizeof(wletter));
+        dest = (wstring)fossil_allocator_alloc(NULL, (len + 1) * sizeof(wletter));
         if (dest == NULL) {
             return NULL; // Memory allocation failed
         }
@@ -191,7 +253,7 @@ wstring fossil_wstr_concat(wstring dest, const_wstring src) {
 
     size_t dest_len = (dest != NULL) ? wcslen(dest) : 0;
     size_t src_len = wcslen(src);
-    wstring new_str = (wstring)realloc(dest, (dest_len + src_len + 1) * sizeof(wletter));
+    wstring new_str = (wstring)fossil_allocator_resize(NULL, dest, (dest_len + src_len + 1) * sizeof(wletter));
     
     if (new_str == NULL) {
         return NULL; // Memory allocation failed
@@ -202,11 +264,78 @@ wstring fossil_wstr_concat(wstring dest, const_wstring src) {
 }
 
 const_wstring fossil_wstr_find(const_wstring str, wletter ch) {
-    if (str == NULL) {
+    if (!str) {
         return NULL;
     }
+    size_t i = _fossil_simd_chr(str, (uint32_t)ch, sizeof(wletter));
+    return str[i] == ch ? str + i : NULL;
+}
+
+const_wstring fossil_wstr_rfind(const_wstring str, wletter ch) {
+    if (!str) {
+        return NULL;
+    }
+    size_t len = _fossil_simd_length(str, sizeof(wletter));
+    if (ch == 0) {
+        return str + len; // The terminator, as with strrchr
+    }
+    size_t i = _fossil_simd_rfind(str, len, (uint32_t)ch, sizeof(wletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_wstring fossil_wstr_find_any(const_wstring str, const_wstring set) {
+    if (!str || !set) {
+        return NULL;
+    }
+    size_t i = _fossil_simd_find_any(str, _fossil_simd_length(str, sizeof(wletter)), set, _fossil_simd_length(set, sizeof(wletter)), sizeof(wletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+size_t fossil_wstr_count(const_wstring str, wletter ch) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_count(str, _fossil_simd_length(str, sizeof(wletter)), (uint32_t)ch, sizeof(wletter));
+}
 
-    return wcschr(str, ch);
+const_wstring fossil_wstr_find_str(const_wstring str, const_wstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_find(str, _fossil_simd_length(str, sizeof(wletter)), needle, _fossil_simd_length(needle, sizeof(wletter)), sizeof(wletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+const_wstring fossil_wstr_rfind_str(const_wstring str, const_wstring needle) {
+    if (!str || !needle) {
+        return NULL;
+    }
+    size_t i = _fossil_search_rfind(str, _fossil_simd_length(str, sizeof(wletter)), needle, _fossil_simd_length(needle, sizeof(wletter)), sizeof(wletter));
+    return i == _FOSSIL_SIMD_NONE ? NULL : str + i;
+}
+
+int fossil_wstr_contains(const_wstring str, const_wstring needle) {
+    return fossil_wstr_find_str(str, needle) != NULL;
+}
+
+size_t fossil_wstr_find_all(const_wstring str, wletter ch, size_t *offsets, size_t capacity) {
+    if (!str || ch == 0) {
+        return 0;
+    }
+    return _fossil_simd_find_all(str, _fossil_simd_length(str, sizeof(wletter)), (uint32_t)ch, sizeof(wletter), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_wstr_find_all_str(const_wstring str, const_wstring needle, size_t *offsets, size_t capacity) {
+    if (!str || !needle) {
+        return 0;
+    }
+    _fossil_search_plan plan;
+    _fossil_search_plan_init(&plan, needle, _fossil_simd_length(needle, sizeof(wletter)), sizeof(wletter), _FOSSIL_FOLD_NONE);
+    return _fossil_search_plan_find_all(&plan, str, _fossil_simd_length(str, sizeof(wletter)), offsets, offsets ? capacity : 0);
+}
+
+size_t fossil_wstr_count_str(const_wstring str, const_wstring needle) {
+    return fossil_wstr_find_all_str(str, needle, NULL, 0);
 }
 
 const_wstring fossil_wstr_reverse(const_wstring str) {
@@ -215,7 +344,7 @@ const_wstring fossil_wstr_reverse(const_wstring str) {
     }
 
     size_t len = wcslen(str);
-    wstring rev_str = (wstring)malloc((len + 1) * sizeof(wletter));
+    wstring rev_str = (wstring)fossil_allocator_alloc(NULL, (len + 1) * sizeof(wletter));
     
     if (rev_str == NULL) {
         return NULL; // Memory allocation failed
@@ -230,12 +359,17 @@ const_wstring fossil_wstr_reverse(const_wstring str) {
 }
 
 wstrings fossil_wstr_split(const_wstring str, wletter delimiter) {
+    return fossil_wstr_split_with(NULL, str, delimiter);
+}
+
+wstrings fossil_wstr_split_with(const fossil_allocator_t *allocator, const_wstring str, wletter delimiter) {
     if (str == NULL) {
         return NULL;
     }
 
     size_t len = wcslen(str);
-    wstrings splits = (wstrings)malloc((len + 1) * sizeof(wstring));
+    size_t tokens = _fossil_simd_count(str, len, (uint32_t)delimiter, sizeof(wletter)) + 1;
+    wstrings splits = (wstrings)fossil_allocator_alloc(allocator, (tokens + 1) * sizeof(wstring));
     
     if (splits == NULL) {
         return NULL; // Memory allocation failed
@@ -246,10 +380,10 @@ wstrings fossil_wstr_split(const_wstring str, wletter delimiter) {
     for (size_t i = 0; i <= len; i++) {
         if (str[i] == delimiter || str[i] == L'\0') {
             size_t sub_len = &str[i] - start;
-            splits[count] = (wstring)malloc((sub_len + 1) * sizeof(wletter));
+            splits[count] = (wstring)fossil_allocator_alloc(allocator, (sub_len + 1) * sizeof(wletter));
             
             if (splits[count] == NULL) {
-                fossil_wstr_erase_splits(splits);
+                fossil_wstr_erase_splits_with(allocator, splits);
                 return NULL; // Memory allocation failed
             }
 
@@ -269,6 +403,10 @@ wstring fossil_wstr_strdup(const_wstring str) {
 }
 
 wstring fossil_wstr_substr(const_wstring str, size_t start, size_t len) {
+    return fossil_wstr_substr_with(NULL, str, start, len);
+}
+
+wstring fossil_wstr_substr_with(const fossil_allocator_t *allocator, const_wstring str, size_t start, size_t len) {
     if (str == NULL) {
         return NULL;
     }
@@ -282,7 +420,7 @@ wstring fossil_wstr_substr(const_wstring str, size_t start, size_t len) {
         len = str_len - start;
     }
 
-    wstring substr = (wstring)malloc((len + 1) * sizeof(wletter));
+    wstring substr = (wstring)fossil_allocator_alloc(allocator, (len + 1) * sizeof(wletter));
     if (substr == NULL) {
         return NULL; // Memory allocation failed
     }
@@ -294,14 +432,18 @@ wstring fossil_wstr_substr(const_wstring str, size_t start, size_t len) {
 }
 
 void fossil_wstr_erase_splits(wstrings splits) {
+    fossil_wstr_erase_splits_with(NULL, splits);
+}
+
+void fossil_wstr_erase_splits_with(const fossil_allocator_t *allocator, wstrings splits) {
     if (splits == NULL) {
         return;
     }
 
     for (size_t i = 0; splits[i] != NULL; i++) {
-        free(splits[i]);
+        fossil_allocator_release(allocator, splits[i]);
     }
-    free(splits);
+    fossil_allocator_release(allocator, splits);
 }
 
 // Read a substring of length 'len' from the string starting at position 'pos'
@@ -391,7 +533,7 @@ size_t fossil_wstrstream_tell(const_wstring str, size_t pos) {
 // Convert integer to wide string
 wstring fossil_wstr_from_int(int num) {
     int digits = _wstr_num_digits(num);
-    wstring str = (wstring)malloc((digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
+    wstring str = (wstring)fossil_allocator_alloc(NULL, (digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -402,7 +544,7 @@ wstring fossil_wstr_from_int(int num) {
 // Convert long to wide string
 wstring fossil_wstr_from_long(long num) {
     int digits = _wstr_num_digits(num);
-    wstring str = (wstring)malloc((digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
+    wstring str = (wstring)fossil_allocator_alloc(NULL, (digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -413,7 +555,7 @@ wstring fossil_wstr_from_long(long num) {
 // Convert long long to wide string
 wstring fossil_wstr_from_llong(long long num) {
     int digits = _wstr_num_digits(num);
-    wstring str = (wstring)malloc((digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
+    wstring str = (wstring)fossil_allocator_alloc(NULL, (digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -424,7 +566,7 @@ wstring fossil_wstr_from_llong(long long num) {
 // Convert unsigned long to wide string
 wstring fossil_wstr_from_ulong(unsigned long num) {
     int digits = _wstr_num_digits(num);
-    wstring str = (wstring)malloc((digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
+    wstring str = (wstring)fossil_allocator_alloc(NULL, (digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -435,7 +577,7 @@ wstring fossil_wstr_from_ulong(unsigned long num) {
 // Convert unsigned long long to wide string
 wstring fossil_wstr_from_ullong(unsigned long long num) {
     int digits = _wstr_num_digits(num);
-    wstring str = (wstring)malloc((digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
+    wstring str = (wstring)fossil_allocator_alloc(NULL, (digits + 1) * sizeof(wchar_t)); // Allocate memory dynamically
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -448,7 +590,7 @@ wstring fossil_wstr_from_double(double num) {
     int max_length = 50; // Arbitrarily chosen
 
     // Allocate memory for the string
-    wstring str = malloc(max_length * sizeof(wchar_t));
+    wstring str = fossil_allocator_alloc(NULL, max_length * sizeof(wchar_t));
     if (!str) {
         return NULL; // Return NULL if memory allocation fails
     }
@@ -456,7 +598,7 @@ wstring fossil_wstr_from_double(double num) {
     // Convert the double to string
     int written = swprintf(str, max_length, L"%lf", (long unsigned int)num);
     if (written < 0 || written >= max_length) {
-        free(str); // Free the allocated memory
+        fossil_allocator_release(NULL, str); // Free the allocated memory
         return NULL; // Return NULL if swprintf failed or buffer overflow
     }
 
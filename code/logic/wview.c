@@ -0,0 +1,101 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/string/wview.h"
+
+wview fossil_wview_make(const_wstring data, size_t length) {
+    wview view = { data, data ? length : 0 };
+    return view;
+}
+
+wview fossil_wview_from(const_wstring str) {
+    return fossil_wview_make(str, str ? wcslen(str) : 0);
+}
+
+wview fossil_wview_substr(wview view, size_t start, size_t len) {
+    if (start > view.length) {
+        start = view.length;
+    }
+    if (len > view.length - start) {
+        len = view.length - start;
+    }
+    return fossil_wview_make(view.data ? view.data + start : NULL, len);
+}
+
+size_t fossil_wview_find(wview view, wletter ch) {
+    if (!view.data) {
+        return FOSSIL_VIEW_NPOS;
+    }
+    const wletter *hit = wmemchr(view.data, ch, view.length);
+    return hit ? (size_t)(hit - view.data) : FOSSIL_VIEW_NPOS;
+}
+
+int fossil_wview_compare(wview view1, wview view2) {
+    size_t len = view1.length < view2.length ? view1.length : view2.length;
+    int cmp = len ? wmemcmp(view1.data, view2.data, len) : 0;
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (view1.length > view2.length) - (view1.length < view2.length);
+}
+
+int fossil_wview_equals(wview view1, wview view2) {
+    return view1.length == view2.length &&
+           (view1.length == 0 || memcmp(view1.data, view2.data, view1.length * sizeof(wletter)) == 0);
+}
+
+int fossil_wview_starts_with(wview view, wview prefix) {
+    return prefix.length <= view.length &&
+           (prefix.length == 0 || memcmp(view.data, prefix.data, prefix.length * sizeof(wletter)) == 0);
+}
+
+int fossil_wview_ends_with(wview view, wview suffix) {
+    return suffix.length <= view.length &&
+           (suffix.length == 0 ||
+            memcmp(view.data + view.length - suffix.length, suffix.data, suffix.length * sizeof(wletter)) == 0);
+}
+
+size_t fossil_wview_split(wview view, wletter delimiter, wview *out, size_t max) {
+    size_t count = 0;
+    size_t start = 0;
+    if (!out) {
+        max = 0;
+    }
+    if (!view.data) {
+        return 0;
+    }
+
+    // Single pass: each delimiter closes the current token
+    for (size_t i = 0; i <= view.length; i++) {
+        if (i == view.length || view.data[i] == delimiter) {
+            if (count < max) {
+                out[count] = fossil_wview_make(view.data + start, i - start);
+            }
+            count++;
+            start = i + 1;
+        }
+    }
+    return count;
+}
+
+wstring fossil_wview_to_wstr(wview view) {
+    wstring str = fossil_allocator_alloc(NULL, (view.length + 1) * sizeof(wletter));
+    if (!str) {
+        return NULL;
+    }
+    if (view.length) {
+        memcpy(str, view.data, view.length * sizeof(wletter));
+    }
+    str[view.length] = L'\0';
+    return str;
+}
@@ -0,0 +1,123 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_aho.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+typedef struct {
+    fossil_aho_match_t matches[8];
+    size_t count;
+    size_t stop_after;
+} aho_results;
+
+static int collect_match(const fossil_aho_match_t *match, void *user) {
+    aho_results *results = user;
+    if (results->count < 8) {
+        results->matches[results->count] = *match;
+    }
+    results->count++;
+    return results->stop_after && results->count >= results->stop_after;
+}
+
+static fossil_aho_t *create_classic_automaton(void) {
+    fossil_aho_t *aho = fossil_aho_create();
+    fossil_aho_add_cstr(aho, "he", 0);
+    fossil_aho_add_cstr(aho, "she", 1);
+    fossil_aho_add_cstr(aho, "his", 2);
+    fossil_aho_add_cstr(aho, "hers", 3);
+    fossil_aho_compile(aho);
+    return aho;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test multi-pattern matcher
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test every overlapping match is reported with its offset
+FOSSIL_TEST(test_fossil_aho_match) {
+    fossil_aho_t *aho = create_classic_automaton();
+    aho_results results = { .count = 0, .stop_after = 0 };
+
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_aho_count(aho));
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_aho_match_cstr(aho, "ushers", collect_match, &results));
+    ASSUME_ITS_EQUAL_SIZE(1, results.matches[0].offset);
+    ASSUME_ITS_EQUAL_SIZE(1, results.matches[0].id);
+    ASSUME_ITS_EQUAL_SIZE(2, results.matches[1].offset);
+    ASSUME_ITS_EQUAL_SIZE(0, results.matches[1].id);
+    ASSUME_ITS_EQUAL_SIZE(2, results.matches[2].offset);
+    ASSUME_ITS_EQUAL_SIZE(4, results.matches[2].length);
+    ASSUME_ITS_EQUAL_SIZE(3, results.matches[2].id);
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_aho_match_cstr(aho, "nothing to see", NULL, NULL));
+    fossil_aho_erase(aho);
+}
+
+// Test case 2: Test matches spanning streamed chunks
+FOSSIL_TEST(test_fossil_aho_stream) {
+    fossil_aho_t *aho = create_classic_automaton();
+    aho_results results = { .count = 0, .stop_after = 0 };
+    fossil_aho_stream_t stream;
+    fossil_aho_stream_init(&stream);
+
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_aho_feed_cstr(aho, &stream, "ush", 2, collect_match, &results));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_aho_feed_cstr(aho, &stream, "he", 2, collect_match, &results));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_aho_feed_cstr(aho, &stream, "rs", 2, collect_match, &results));
+    ASSUME_ITS_EQUAL_SIZE(3, results.count);
+    ASSUME_ITS_EQUAL_SIZE(1, results.matches[0].offset);
+    ASSUME_ITS_EQUAL_SIZE(2, results.matches[2].offset);
+    ASSUME_ITS_EQUAL_SIZE(3, results.matches[2].id);
+    fossil_aho_erase(aho);
+}
+
+// Test case 3: Test byte string text, wide units and stopping early
+FOSSIL_TEST(test_fossil_aho_bstring) {
+    fossil_aho_t *aho = fossil_aho_create();
+    const bletter wide[] = { 0x0141, 0x4100, 0 };
+    ASSUME_ITS_EQUAL_I32(0, fossil_aho_add_bstr(aho, wide, 7));
+    ASSUME_ITS_EQUAL_I32(0, fossil_aho_add_cstr(aho, "AA", 8));
+    ASSUME_ITS_EQUAL_I32(-1, fossil_aho_add_cstr(aho, "", 9));
+    ASSUME_ITS_EQUAL_I32(0, fossil_aho_compile(aho));
+
+    const bletter text[] = { 'A', 'A', 'A', 0x0141, 0x4100, 0x0141, 0 };
+    aho_results results = { .count = 0, .stop_after = 0 };
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_aho_match_bstr(aho, text, collect_match, &results));
+    ASSUME_ITS_EQUAL_SIZE(0, results.matches[0].offset);
+    ASSUME_ITS_EQUAL_SIZE(1, results.matches[1].offset);
+    ASSUME_ITS_EQUAL_SIZE(3, results.matches[2].offset);
+    ASSUME_ITS_EQUAL_SIZE(7, results.matches[2].id);
+
+    aho_results first = { .count = 0, .stop_after = 1 };
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_aho_match_bstr(aho, text, collect_match, &first));
+    fossil_aho_erase(aho);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_aho_tests) {
+    ADD_TEST(test_fossil_aho_match);
+    ADD_TEST(test_fossil_aho_stream);
+    ADD_TEST(test_fossil_aho_bstring);
+} // end of tests
@@ -0,0 +1,112 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_alloc.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test allocator hooks
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+typedef struct {
+    size_t allocs;
+    size_t releases;
+} counting_stats;
+
+static void *counting_alloc(void *context, size_t size) {
+    ((counting_stats *)context)->allocs++;
+    return malloc(size);
+}
+
+static void *counting_resize(void *context, void *ptr, size_t size) {
+    if (!ptr) {
+        ((counting_stats *)context)->allocs++;
+    }
+    return realloc(ptr, size);
+}
+
+static void counting_release(void *context, void *ptr) {
+    ((counting_stats *)context)->releases++;
+    free(ptr);
+}
+
+// Test case 1: Test per-call allocators see every allocation
+FOSSIL_TEST(test_fossil_alloc_per_call) {
+    counting_stats stats = { 0, 0 };
+    fossil_allocator_t counting = { counting_alloc, counting_resize, counting_release, &stats };
+
+    cstrings parts = fossil_cstr_split_with(&counting, "a,b,c", ',');
+    ASSUME_ITS_EQUAL_CSTR("b", parts[1]);
+    ASSUME_ITS_EQUAL_SIZE(4, stats.allocs);
+    fossil_cstr_erase_splits_with(&counting, parts);
+    ASSUME_ITS_EQUAL_SIZE(4, stats.releases);
+
+    wstring wide = fossil_wstr_format_with(&counting, L"%ls-%d", L"id", 7);
+    ASSUME_ITS_EQUAL_WSTR(L"id-7", wide);
+    fossil_wstr_erase_with(&counting, wide);
+    ASSUME_ITS_EQUAL_SIZE(stats.allocs, stats.releases);
+}
+
+// Test case 2: Test the cached allocator recycles short blocks
+FOSSIL_TEST(test_fossil_alloc_cached) {
+    const fossil_allocator_t *cached = fossil_allocator_cached();
+    cstring first = fossil_cstr_create_with(cached, "short");
+    fossil_cstr_erase_with(cached, first);
+    cstring second = fossil_cstr_format_with(cached, "%s!", "again");
+    ASSUME_ITS_TRUE(first == second);
+    ASSUME_ITS_EQUAL_CSTR("again!", second);
+
+    // Growing past a size class moves the contents
+    cstring grown = fossil_allocator_resize(cached, second, 1000);
+    ASSUME_ITS_EQUAL_CSTR("again!", grown);
+    fossil_allocator_release(cached, grown);
+}
+
+// Test case 3: Test the global allocator is used by default
+FOSSIL_TEST(test_fossil_alloc_global) {
+    counting_stats stats = { 0, 0 };
+    fossil_allocator_t counting = { counting_alloc, counting_resize, counting_release, &stats };
+
+    fossil_allocator_set(&counting);
+    cstring num = fossil_cstr_from_int(42);
+    cstring sub = fossil_cstr_substr("hostname", 0, 4);
+    fossil_cstr_erase(num);
+    fossil_cstr_erase(sub);
+    fossil_allocator_set(NULL);
+
+    ASSUME_ITS_TRUE(fossil_allocator_get() == fossil_allocator_system());
+    ASSUME_ITS_EQUAL_SIZE(2, stats.allocs);
+    ASSUME_ITS_EQUAL_SIZE(2, stats.releases);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_alloc_tests) {
+    ADD_TEST(test_fossil_alloc_per_call);
+    ADD_TEST(test_fossil_alloc_cached);
+    ADD_TEST(test_fossil_alloc_global);
+} // end of tests
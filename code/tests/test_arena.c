@@ -0,0 +1,126 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_arena.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test arena
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test string producers allocate from the arena
+FOSSIL_TEST(test_fossil_arena_cstr) {
+    fossil_arena_t *arena = fossil_arena_create(0, 0);
+    cstring copy = fossil_arena_cstr_create(arena, "Pizza time!");
+    cstring sub = fossil_arena_cstr_substr(arena, copy, 6, 4);
+    cstring text = fossil_arena_cstr_format(arena, "%s-%d", sub, 42);
+    ASSUME_ITS_EQUAL_CSTR("Pizza time!", copy);
+    ASSUME_ITS_EQUAL_CSTR("time", sub);
+    ASSUME_ITS_EQUAL_CSTR("time-42", text);
+    ASSUME_ITS_EQUAL_CSTR("-1234", fossil_arena_cstr_from_int(arena, -1234));
+    ASSUME_ITS_EQUAL_CSTR("(123) 456-7890", fossil_arena_cstr_format_phone(arena, "1234567890"));
+    ASSUME_ITS_TRUE(fossil_arena_used(arena) > 0);
+    fossil_arena_erase(arena);
+}
+
+// Test case 2: Test split tokens and reset reuse
+FOSSIL_TEST(test_fossil_arena_split_reset) {
+    fossil_arena_t *arena = fossil_arena_create(64, 0);
+    cstrings parts = fossil_arena_cstr_split(arena, "a,bb,,ccc", ',');
+    ASSUME_ITS_EQUAL_CSTR("a", parts[0]);
+    ASSUME_ITS_EQUAL_CSTR("bb", parts[1]);
+    ASSUME_ITS_EQUAL_CSTR("", parts[2]);
+    ASSUME_ITS_EQUAL_CSTR("ccc", parts[3]);
+    ASSUME_ITS_TRUE(NULL == parts[4]);
+
+    // Oversized requests get their own block
+    cstring big = fossil_arena_alloc(arena, 1000);
+    ASSUME_ITS_TRUE(big != NULL);
+    memset(big, 'x', 1000);
+
+    fossil_arena_reset(arena);
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_arena_used(arena));
+    cstring again = fossil_arena_cstr_create(arena, "reused");
+    ASSUME_ITS_EQUAL_CSTR("reused", again);
+    fossil_arena_erase(arena);
+}
+
+// Test case 3: Test the byte and wide string producers
+FOSSIL_TEST(test_fossil_arena_bstr_wstr) {
+    fossil_arena_t *arena = fossil_arena_create(0, FOSSIL_ARENA_HUGE_PAGES);
+    const bletter raw[] = { 'a', ':', 'b', 0 };
+    bstrings bparts = fossil_arena_bstr_split(arena, raw, ':');
+    ASSUME_ITS_TRUE(bparts[0][0] == 'a' && bparts[0][1] == 0);
+    ASSUME_ITS_TRUE(bparts[1][0] == 'b' && bparts[2] == NULL);
+
+    const bletter fmt[] = { '%', 'd', 0 };
+    bstring num = fossil_arena_bstr_format(arena, fmt, 7);
+    ASSUME_ITS_TRUE(num[0] == '7' && num[1] == 0);
+    const bletter wide_fmt[] = { 0x0125, 'd', 0 }; // would narrow to "%d"
+    ASSUME_ITS_TRUE(fossil_arena_bstr_format(arena, wide_fmt, 7) == NULL);
+
+    wstring wide = fossil_arena_wstr_format(arena, L"%ls %d", L"slice", 3);
+    ASSUME_ITS_EQUAL_WSTR(L"slice 3", wide);
+    ASSUME_ITS_EQUAL_WSTR(L"lic", fossil_arena_wstr_substr(arena, wide, 1, 3));
+    fossil_arena_erase(arena);
+}
+
+// Test case 4: Test the *_with functions through the arena allocator
+FOSSIL_TEST(test_fossil_arena_allocator) {
+    fossil_arena_t *arena = fossil_arena_create(256, 0);
+    fossil_allocator_t allocator = fossil_arena_allocator(arena);
+    const bletter raw[] = { 'k', '=', 0x0100, 0 };
+    bstring bytes = fossil_bstr_create_with(&allocator, raw);
+    ASSUME_ITS_TRUE(bytes[2] == 0x0100 && bytes[3] == 0);
+
+    // Growing past the block size moves the result, keeping what was written
+    wstring wide = fossil_wstr_format_with(&allocator, L"%ls-%ls-%d", L"arena", L"allocator", 300);
+    ASSUME_ITS_EQUAL_WSTR(L"arena-allocator-300", wide);
+    wchar_t long_text[200];
+    wmemset(long_text, L'w', 199);
+    long_text[199] = L'\0';
+    wstring longer = fossil_wstr_format_with(&allocator, L"[%ls]", long_text);
+    ASSUME_ITS_EQUAL_SIZE(201, wcslen(longer));
+    ASSUME_ITS_TRUE(longer[0] == L'[' && longer[200] == L']');
+
+    cstrings parts = fossil_cstr_split_with(&allocator, "a,b", ',');
+    ASSUME_ITS_EQUAL_CSTR("b", parts[1]);
+    fossil_cstr_erase_splits_with(&allocator, parts); // a no-op
+    ASSUME_ITS_TRUE(fossil_arena_used(arena) > 0);
+    fossil_arena_reset(arena);
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_arena_used(arena));
+    fossil_arena_erase(arena);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_arena_tests) {
+    ADD_TEST(test_fossil_arena_cstr);
+    ADD_TEST(test_fossil_arena_split_reset);
+    ADD_TEST(test_fossil_arena_bstr_wstr);
+    ADD_TEST(test_fossil_arena_allocator);
+} // end of tests
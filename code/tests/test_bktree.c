@@ -0,0 +1,107 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_bktree.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test BK-trees
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test building from split output and finding close keys
+FOSSIL_TEST(test_fossil_bktree_find) {
+    cstrings keys = fossil_cstr_split("book,books,boot,cake,cape,boon,cook,cart,bock", ',');
+    fossil_bktree_t *tree = fossil_bktree_create(keys);
+    fossil_cstr_erase_splits(keys);
+    ASSUME_ITS_EQUAL_SIZE(9, fossil_bktree_count(tree));
+    ASSUME_ITS_TRUE(strcmp(fossil_bktree_key(tree, 3), "cake") == 0);
+
+    fossil_bktree_match_t matches[8];
+    ASSUME_ITS_EQUAL_SIZE(6, fossil_bktree_find(tree, "book", 1, matches, 8));
+    ASSUME_ITS_EQUAL_SIZE(0, matches[0].id); // book itself
+    ASSUME_ITS_EQUAL_SIZE(0, matches[0].distance);
+    ASSUME_ITS_EQUAL_SIZE(1, matches[1].id); // then books, boot, boon, cook and bock at 1
+    ASSUME_ITS_EQUAL_SIZE(8, matches[5].id);
+    ASSUME_ITS_EQUAL_SIZE(1, matches[5].distance);
+
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_bktree_find(tree, "zebra", 2, matches, 8));
+    ASSUME_ITS_EQUAL_SIZE(9, fossil_bktree_find(tree, "", 5, NULL, 0));
+    fossil_bktree_erase(tree);
+}
+
+// Test case 2: Test that a small result buffer keeps the closest keys
+FOSSIL_TEST(test_fossil_bktree_closest) {
+    cstrings keys = fossil_cstr_split("walk,talk,tall,walks,stalk,chalk,ball,wall,walk", ',');
+    fossil_bktree_t *tree = fossil_bktree_create(keys);
+    fossil_cstr_erase_splits(keys);
+
+    fossil_bktree_match_t matches[3];
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_bktree_find(tree, "walk", 2, matches, 3));
+    ASSUME_ITS_EQUAL_SIZE(0, matches[0].id);
+    ASSUME_ITS_EQUAL_SIZE(8, matches[1].id); // the duplicate, also at 0
+    ASSUME_ITS_EQUAL_SIZE(0, matches[1].distance);
+    ASSUME_ITS_EQUAL_SIZE(1, matches[2].id);
+    ASSUME_ITS_EQUAL_SIZE(1, matches[2].distance);
+    ASSUME_ITS_EQUAL_SIZE(9, fossil_bktree_find(tree, "walk", 2, NULL, 0));
+    fossil_bktree_erase(tree);
+}
+
+// Test case 3: Test agreement with pairwise distances over a larger dictionary
+FOSSIL_TEST(test_fossil_bktree_brute_force) {
+    static char words[2000][8];
+    static cstring keys[2001];
+    unsigned seed = 7;
+    for (size_t i = 0; i < 2000; i++) {
+        size_t length = 3 + i % 5;
+        for (size_t j = 0; j < length; j++) {
+            seed = seed * 1103515245u + 12345u;
+            words[i][j] = (char)('a' + (seed >> 16) % 4);
+        }
+        words[i][length] = '\0';
+        keys[i] = words[i];
+    }
+    keys[2000] = NULL;
+    fossil_bktree_t *tree = fossil_bktree_create(keys);
+
+    const_cstring queries[] = {"abcd", "dddd", "abcab", "ca"};
+    for (size_t q = 0; q < 4; q++) {
+        size_t expected = 0;
+        for (size_t i = 0; i < 2000; i++) {
+            expected += fossil_cstr_distance(queries[q], words[i]) <= 1;
+        }
+        ASSUME_ITS_EQUAL_SIZE(expected, fossil_bktree_find(tree, queries[q], 1, NULL, 0));
+    }
+    fossil_bktree_erase(tree);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_bktree_tests) {
+    ADD_TEST(test_fossil_bktree_find);
+    ADD_TEST(test_fossil_bktree_closest);
+    ADD_TEST(test_fossil_bktree_brute_force);
+} // end of tests
@@ -26,6 +26,15 @@
 // mock objects are set here.
 // * * * * * * * * * * * * * * * * * * * * * * * *
 
+// Fill 'data' with 40 units, 0x0141 at every fourth and 0x4100 elsewhere,
+// then the terminator. The bytes of one unit never pair into the other.
+static void fill_unit_pattern(bletter data[41]) {
+    for (size_t i = 0; i < 40; i++) {
+        data[i] = (bletter)(i % 4 == 3 ? 0x0141 : 0x4100);
+    }
+    data[40] = 0;
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test byte string
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -39,19 +48,133 @@ FOSSIL_TEST(test_fossil_bstring_create) {
 
 // Test case 2: Test fossil_bstring_create with a string
 FOSSIL_TEST(test_fossil_bstring_create_with_value) {
-    bstring var = fossil_bstr_create((bstring)"Pizza time!");
-    ASSUME_ITS_EQUAL_BSTR("Pizza time!", var);
+    const bletter value[] = { 'P', 'i', 'z', 'z', 'a', ' ', 't', 'i', 'm', 'e', '!', 0 };
+    bstring var = fossil_bstr_create(value);
+    ASSUME_ITS_TRUE(memcmp(value, var, sizeof(value)) == 0);
     fossil_bstr_erase(var); // Clean up after creating a bstring
 }
 
 // Test case 3: Test fossil_bstring_create with a string and length
 FOSSIL_TEST(test_fossil_bstring_create_with_value_and_length) {
-    bstring var = fossil_bstr_create((bstring)"Pizza");
-    ASSUME_ITS_EQUAL_BSTR("Pizza", var);
+    const bletter value[] = { 'P', 'i', 'z', 'z', 'a', 0 };
+    bstring var = fossil_bstr_create(value);
+    ASSUME_ITS_TRUE(memcmp(value, var, sizeof(value)) == 0);
     ASSUME_ITS_EQUAL_SIZE(5, fossil_bstr_length(var));
     fossil_bstr_erase(var); // Clean up after creating a bstring
 }
 
+// Test case 4: Test scanning works on whole 16-bit units
+FOSSIL_TEST(test_fossil_bstring_scan) {
+    bletter data[41];
+    fill_unit_pattern(data);
+    ASSUME_ITS_TRUE(data + 3 == fossil_bstr_find(data, 0x0141));
+    ASSUME_ITS_TRUE(data + 39 == fossil_bstr_rfind(data, 0x0141));
+    ASSUME_ITS_TRUE(NULL == fossil_bstr_find(data, 0x4141));
+    ASSUME_ITS_EQUAL_SIZE(10, fossil_bstr_count(data, 0x0141));
+
+    const bletter set[] = { 0x0001, 0x0141, 0 };
+    ASSUME_ITS_TRUE(data + 3 == fossil_bstr_find_any(data, set));
+}
+
+// Test case 5: Test substring search matches whole 16-bit units only
+FOSSIL_TEST(test_fossil_bstring_find_str) {
+    bletter data[41];
+    fill_unit_pattern(data);
+    const bletter needle[] = { 0x0141, 0x4100, 0 };
+    const bletter shifted[] = { 0x4101, 0x4100, 0 }; // spans the bytes of two units
+    ASSUME_ITS_TRUE(data + 3 == fossil_bstr_find_str(data, needle));
+    ASSUME_ITS_TRUE(data + 35 == fossil_bstr_rfind_str(data, needle));
+    ASSUME_ITS_TRUE(NULL == fossil_bstr_find_str(data, shifted));
+    ASSUME_ITS_TRUE(fossil_bstr_contains(data, needle));
+    ASSUME_ITS_FALSE(fossil_bstr_contains(needle, data));
+}
+
+// Test case 6: Test collecting offsets of whole 16-bit units
+FOSSIL_TEST(test_fossil_bstring_find_all) {
+    bletter data[41];
+    fill_unit_pattern(data);
+    size_t offsets[12] = { 0 };
+    ASSUME_ITS_EQUAL_SIZE(10, fossil_bstr_find_all(data, 0x0141, offsets, 12));
+    ASSUME_ITS_EQUAL_SIZE(3, offsets[0]);
+    ASSUME_ITS_EQUAL_SIZE(39, offsets[9]);
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_bstr_find_all(data, 0x4141, offsets, 12));
+
+    const bletter needle[] = { 0x4100, 0x0141, 0 };
+    ASSUME_ITS_EQUAL_SIZE(10, fossil_bstr_count_str(data, needle));
+}
+
+// Test case 7: Test that only ASCII units fold, whole units at a time
+FOSSIL_TEST(test_fossil_bstring_ignore_case) {
+    const bletter upper[] = { 'K', 'E', 'Y', 0x0141, 'S', 0 };
+    const bletter lower[] = { 'k', 'e', 'y', 0x0141, 's', 0 };
+    const bletter high[] = { 'k', 'e', 'y', 0x0161, 's', 0 };
+    const bletter prefix[] = { 'k', 'E', 0 };
+    const bletter needle[] = { 0x0141, 'S', 0 };
+    ASSUME_ITS_TRUE(fossil_bstr_iequals(upper, lower));
+    ASSUME_ITS_FALSE(fossil_bstr_iequals(upper, high)); // 0x0141 shares its low byte with 'A'
+    ASSUME_ITS_TRUE(fossil_bstr_icompare(upper, high) < 0);
+    ASSUME_ITS_TRUE(fossil_bstr_istarts_with(upper, prefix));
+    ASSUME_ITS_TRUE(fossil_bstr_ifind_str(lower, needle) == lower + 3);
+    ASSUME_ITS_TRUE(fossil_bstr_ifind_str(high, needle) == NULL);
+    ASSUME_ITS_TRUE(fossil_bstr_ihash(upper) == fossil_bstr_ihash(lower));
+}
+
+// Test case 8: Test that created, copied and produced strings are whole bletter strings
+FOSSIL_TEST(test_fossil_bstring_create_find) {
+    const bletter abc[] = { 'a', 'b', 'c', 0 };
+    bstring var = fossil_bstr_create(abc);
+    ASSUME_ITS_TRUE(var + 2 == fossil_bstr_find(var, 'c'));
+    ASSUME_ITS_TRUE(NULL == fossil_bstr_find(var, 0x6300)); // 'c' with its bytes swapped
+
+    const bletter tail[] = { 0x0141, 'd', 0 };
+    var = fossil_bstr_concat(var, tail);
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_bstr_length(var));
+    ASSUME_ITS_TRUE(var + 3 == fossil_bstr_find(var, 0x0141));
+    const_bstring rev = fossil_bstr_reverse(var);
+    ASSUME_ITS_TRUE(rev[0] == 'd' && rev[1] == 0x0141 && rev[4] == 'a' && rev[5] == 0);
+    ASSUME_ITS_TRUE(fossil_bstr_compare(var, rev) < 0);
+
+    bstring num = fossil_bstr_from_int(-42);
+    const bletter expected[] = { '-', '4', '2', 0 };
+    ASSUME_ITS_EQUAL_I32(0, fossil_bstr_compare(num, expected));
+    ASSUME_ITS_EQUAL_I32(-42, fossil_bstr_to_int(num));
+    fossil_bstr_erase(num);
+    fossil_bstr_erase((bstring)rev);
+    fossil_bstr_erase(var);
+}
+
+// Test case 9: Test creating through an explicit allocator, whole units at a time
+FOSSIL_TEST(test_fossil_bstring_create_with_allocator) {
+    const bletter value[] = { 'P', 0x0100, 'z', 0x7A00, 'a', 0 }; // units with a zero low byte
+    bstring var = fossil_bstr_create_with(fossil_allocator_cached(), value);
+    ASSUME_ITS_TRUE(memcmp(value, var, sizeof(value)) == 0);
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_bstr_length(var));
+    fossil_bstr_erase_with(fossil_allocator_cached(), var);
+}
+
+// Test case 10: Test formatting and parsing on both sides of the stack scratch size
+FOSSIL_TEST(test_fossil_bstring_format_parse_long) {
+    bletter format[302];
+    for (size_t i = 0; i < 299; i++) {
+        format[i] = '0';
+    }
+    format[299] = '%';
+    format[300] = 'd';
+    format[301] = 0;
+    bstring var = fossil_bstr_format(format, 42);
+    ASSUME_ITS_EQUAL_SIZE(301, fossil_bstr_length(var));
+    ASSUME_ITS_EQUAL_I32(42, fossil_bstr_to_int(var));
+    fossil_bstr_erase(var);
+
+    const bletter short_format[] = { '%', 'd', 0 };
+    var = fossil_bstr_format(short_format, -7);
+    ASSUME_ITS_EQUAL_I32(-7, fossil_bstr_to_int(var));
+    fossil_bstr_erase(var);
+
+    format[0] = 0x0130; // a unit wider than a byte still fails the long path
+    ASSUME_ITS_TRUE(NULL == fossil_bstr_format(format, 42));
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -60,4 +183,11 @@ FOSSIL_TEST_GROUP(c_bstrings_tests) {
     ADD_TEST(test_fossil_bstring_create);
     ADD_TEST(test_fossil_bstring_create_with_value);
     ADD_TEST(test_fossil_bstring_create_with_value_and_length);
+    ADD_TEST(test_fossil_bstring_scan);
+    ADD_TEST(test_fossil_bstring_find_str);
+    ADD_TEST(test_fossil_bstring_find_all);
+    ADD_TEST(test_fossil_bstring_ignore_case);
+    ADD_TEST(test_fossil_bstring_create_find);
+    ADD_TEST(test_fossil_bstring_create_with_allocator);
+    ADD_TEST(test_fossil_bstring_format_parse_long);
 } // end of tests
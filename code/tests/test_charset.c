@@ -0,0 +1,119 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_charset.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Character sets
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test span, cspan and find against the C library
+FOSSIL_TEST(test_fossil_cstr_charset_scan) {
+    static char text[300];
+    fossil_cstr_charset_t *set = fossil_cstr_charset_create(" \t,;");
+    ASSUME_ITS_TRUE(fossil_cstr_charset_add_range(set, (cletter)0xF0, (cletter)0xFF) == 0);
+    ASSUME_ITS_TRUE(fossil_cstr_charset_contains(set, ';'));
+    ASSUME_ITS_TRUE(fossil_cstr_charset_contains(set, (cletter)0xF7));
+    ASSUME_ITS_TRUE(!fossil_cstr_charset_contains(set, 'a'));
+
+    // Lengths past one vector, with every byte value in play
+    int same = 1;
+    unsigned seed = 3;
+    for (size_t n = 0; n < 200; n++) {
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            text[i] = (char)(1 + (seed >> 16) % 255);
+        }
+        text[n] = '\0';
+        size_t offset = n % 7; // unaligned starts too
+        same &= fossil_cstr_charset_cspan(set, text + offset * (offset < n)) ==
+                strcspn(text + offset * (offset < n), " \t,;\xF0\xF1\xF2\xF3\xF4\xF5\xF6\xF7\xF8\xF9\xFA\xFB\xFC\xFD\xFE\xFF");
+    }
+    ASSUME_ITS_TRUE(same);
+
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_charset_span(set, " ,\tname"));
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cstr_charset_cspan(set, "name; value"));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_cstr_charset_span(set, ""));
+    const_cstring str = "key\tvalue";
+    ASSUME_ITS_TRUE(fossil_cstr_charset_find(set, str) == str + 3);
+    ASSUME_ITS_TRUE(fossil_cstr_charset_find(set, "plain") == NULL);
+    fossil_cstr_charset_erase(set);
+}
+
+// Test case 2: Test splitting at any member of a set
+FOSSIL_TEST(test_fossil_cstr_charset_split) {
+    fossil_cstr_charset_t *set = fossil_cstr_charset_create(" \t,;");
+    cstrings splits = fossil_cstr_charset_split(set, "a,b;;c", 0);
+    ASSUME_ITS_TRUE(strcmp(splits[0], "a") == 0);
+    ASSUME_ITS_TRUE(strcmp(splits[1], "b") == 0);
+    ASSUME_ITS_TRUE(strcmp(splits[2], "") == 0);
+    ASSUME_ITS_TRUE(strcmp(splits[3], "c") == 0);
+    ASSUME_ITS_TRUE(splits[4] == NULL);
+    fossil_cstr_erase_split_block(splits);
+
+    splits = fossil_cstr_charset_split(set, "  id,\tname ; age ", FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(strcmp(splits[0], "id") == 0);
+    ASSUME_ITS_TRUE(strcmp(splits[1], "name") == 0);
+    ASSUME_ITS_TRUE(strcmp(splits[2], "age") == 0);
+    ASSUME_ITS_TRUE(splits[3] == NULL);
+    fossil_cstr_erase_split_block(splits);
+
+    splits = fossil_cstr_charset_split(set, " ;, ", FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(splits[0] == NULL);
+    fossil_cstr_erase_split_block(splits);
+    fossil_cstr_charset_erase(set);
+}
+
+// Test case 3: Test wide sets with ASCII members and ranges beyond
+FOSSIL_TEST(test_fossil_wstr_charset) {
+    fossil_wstr_charset_t *set = fossil_wstr_charset_create(L" ,\u3001\u3002");
+    ASSUME_ITS_TRUE(fossil_wstr_charset_add_range(set, L'\u2000', L'\u200a') == 0); // typographic spaces
+    ASSUME_ITS_TRUE(fossil_wstr_charset_add_range(set, L'\u2008', L'\u2010') == 0); // overlaps and merges
+    ASSUME_ITS_TRUE(fossil_wstr_charset_contains(set, L'\u200f'));
+    ASSUME_ITS_TRUE(fossil_wstr_charset_contains(set, L'\u3001'));
+    ASSUME_ITS_TRUE(!fossil_wstr_charset_contains(set, L'\u3003'));
+    ASSUME_ITS_TRUE(!fossil_wstr_charset_contains(set, L'a'));
+
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_charset_cspan(set, L"ab\u3001cd"));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_charset_span(set, L"\u2003 x"));
+    wstrings splits = fossil_wstr_charset_split(set, L"\u6771\u4eac\u3001\u5927\u962a, x", FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(wcscmp(splits[0], L"\u6771\u4eac") == 0);
+    ASSUME_ITS_TRUE(wcscmp(splits[1], L"\u5927\u962a") == 0);
+    ASSUME_ITS_TRUE(wcscmp(splits[2], L"x") == 0);
+    ASSUME_ITS_TRUE(splits[3] == NULL);
+    fossil_wstr_erase_split_block(splits);
+    fossil_wstr_charset_erase(set);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_charset_tests) {
+    ADD_TEST(test_fossil_cstr_charset_scan);
+    ADD_TEST(test_fossil_cstr_charset_split);
+    ADD_TEST(test_fossil_wstr_charset);
+} // end of tests
@@ -52,6 +52,71 @@ FOSSIL_TEST(test_fossil_cstring_create_with_value_and_length) {
     fossil_cstr_erase(var); // Clean up after creating a cstring
 }
 
+// Test case 4: Test character scanning across vector blocks
+FOSSIL_TEST(test_fossil_cstring_scan) {
+    const_cstring line = "GET /index.html HTTP/1.1 host=example.org agent=curl/8.0 accept=*/*";
+    ASSUME_ITS_TRUE(line + 4 == fossil_cstr_find(line, '/'));
+    ASSUME_ITS_TRUE(line + 65 == fossil_cstr_rfind(line, '/'));
+    ASSUME_ITS_TRUE(line + 3 == fossil_cstr_find_any(line, "= "));
+    ASSUME_ITS_TRUE(NULL == fossil_cstr_find_any(line, "#!"));
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cstr_count(line, '/'));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_cstr_count(line, '#'));
+    ASSUME_ITS_TRUE(line + strlen(line) == fossil_cstr_find(line, '\0'));
+}
+
+// Test case 5: Test substring search, including a needle that defeats naive scanning
+FOSSIL_TEST(test_fossil_cstring_find_str) {
+    const_cstring line = "level=warn msg=retrying level=error msg=timeout level=warn";
+    ASSUME_ITS_TRUE(line + 6 == fossil_cstr_find_str(line, "warn"));
+    ASSUME_ITS_TRUE(line + 54 == fossil_cstr_rfind_str(line, "warn"));
+    ASSUME_ITS_TRUE(line + 30 == fossil_cstr_find_str(line, "error msg"));
+    ASSUME_ITS_TRUE(line == fossil_cstr_find_str(line, ""));
+    ASSUME_ITS_TRUE(fossil_cstr_contains(line, "timeout"));
+    ASSUME_ITS_FALSE(fossil_cstr_contains(line, "fatal"));
+
+    char runs[201];
+    memset(runs, 'a', 200);
+    runs[200] = '\0';
+    runs[150] = 'b';
+    ASSUME_ITS_TRUE(runs + 120 == fossil_cstr_find_str(runs, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaab"));
+    ASSUME_ITS_TRUE(runs + 151 == fossil_cstr_rfind_str(runs, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+    ASSUME_ITS_TRUE(NULL == fossil_cstr_find_str(runs, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac"));
+}
+
+// Test case 6: Test collecting every offset in one pass
+FOSSIL_TEST(test_fossil_cstring_find_all) {
+    const_cstring text = "first line\nsecond line\n\nfourth line that runs past one vector block\nlast";
+    size_t lines[3] = { 0, 0, 0 };
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cstr_find_all(text, '\n', lines, 3));
+    ASSUME_ITS_EQUAL_SIZE(10, lines[0]);
+    ASSUME_ITS_EQUAL_SIZE(22, lines[1]);
+    ASSUME_ITS_EQUAL_SIZE(23, lines[2]);
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cstr_find_all(text, '\n', NULL, 0));
+
+    size_t words[4] = { 0, 0, 0, 0 };
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_find_all_str(text, "line", words, 4));
+    ASSUME_ITS_EQUAL_SIZE(6, words[0]);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cstr_count_str("aaaaa", "aa"));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_cstr_count_str(text, ""));
+}
+
+// Test case 7: Test comparing and searching without regard to case
+FOSSIL_TEST(test_fossil_cstring_ignore_case) {
+    const_cstring header = "Content-Type: text/html; charset=UTF-8 and a tail long enough for two vector blocks";
+    ASSUME_ITS_TRUE(fossil_cstr_istarts_with(header, "content-type:"));
+    ASSUME_ITS_FALSE(fossil_cstr_istarts_with("Content", "content-type:"));
+    ASSUME_ITS_TRUE(fossil_cstr_iequals("KEEP-ALIVE", "keep-alive"));
+    ASSUME_ITS_FALSE(fossil_cstr_iequals("keep-alive", "keep-alive "));
+    ASSUME_ITS_TRUE(fossil_cstr_icompare("apple", "BANANA") < 0);
+    ASSUME_ITS_TRUE(fossil_cstr_icompare("[", "a") < 0); // letters fold down, so '[' sorts before 'A'
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_icompare("Tail", "tAIL"));
+    ASSUME_ITS_TRUE(fossil_cstr_ifind_str(header, "CHARSET=utf-8") == header + 25);
+    ASSUME_ITS_TRUE(fossil_cstr_ifind_str(header, "VECTOR BLOCKS") != NULL);
+    ASSUME_ITS_TRUE(fossil_cstr_ifind_str(header, "charset=utf-16") == NULL);
+    ASSUME_ITS_TRUE(fossil_cstr_ihash(header) == fossil_cstr_ihash("CONTENT-TYPE: TEXT/HTML; CHARSET=utf-8 AND A TAIL LONG ENOUGH FOR TWO VECTOR BLOCKS"));
+    ASSUME_ITS_TRUE(fossil_cstr_ihash("abc") != fossil_cstr_ihash("abd"));
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -61,4 +126,8 @@ FOSSIL_TEST_GROUP(c_cstrings_tests) {
     ADD_TEST(test_fossil_cstring_create);
     ADD_TEST(test_fossil_cstring_create_with_value);
     ADD_TEST(test_fossil_cstring_create_with_value_and_length);
+    ADD_TEST(test_fossil_cstring_scan);
+    ADD_TEST(test_fossil_cstring_find_str);
+    ADD_TEST(test_fossil_cstring_find_all);
+    ADD_TEST(test_fossil_cstring_ignore_case);
 } // end of tests
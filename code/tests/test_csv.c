@@ -0,0 +1,129 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_csv.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Writes each row as its fields joined by '|', ended by '/'
+typedef struct {
+    char text[4096];
+    size_t length;
+} csv_capture_t;
+
+static int csv_capture(const fossil_csv_row_t *row, void *user) {
+    csv_capture_t *capture = user;
+    for (size_t f = 0; f < row->count; f++) {
+        if (f > 0) {
+            capture->text[capture->length++] = '|';
+        }
+        memcpy(capture->text + capture->length, row->fields[f].data, row->fields[f].length);
+        capture->length += row->fields[f].length;
+    }
+    capture->text[capture->length++] = '/';
+    capture->text[capture->length] = '\0';
+    return 0;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test CSV tokenizer
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test quoted fields, doubled quotes and CRLF line ends
+FOSSIL_TEST(test_fossil_csv_quoted) {
+    static const char text[] = "id,name,note\r\n"
+                               "1,\"Smith, John\",\"says \"\"hi\"\"\"\r\n"
+                               "2,\"two\nlines\",\r\n"
+                               "\n"
+                               "3,plain,\"\"\n";
+    csv_capture_t capture = {{0}, 0};
+    fossil_csv_t *csv = fossil_csv_create(',', '"');
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_csv_feed(csv, text, sizeof(text) - 1, csv_capture, &capture));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_csv_finish(csv, csv_capture, &capture));
+    ASSUME_ITS_TRUE(strcmp(capture.text, "id|name|note/1|Smith, John|says \"hi\"/2|two\nlines|//3|plain|/") == 0);
+
+    ASSUME_ITS_TRUE(fossil_csv_create(',', ',') == NULL);
+    ASSUME_ITS_TRUE(fossil_csv_create('\n', '"') == NULL);
+    fossil_csv_erase(csv);
+}
+
+// Test case 2: Test that rows split across chunks at any point come out the same
+FOSSIL_TEST(test_fossil_csv_chunks) {
+    static char text[600];
+    size_t length = 0;
+    for (int r = 0; r < 12; r++) {
+        length += (size_t)sprintf(text + length, "%d,\"q%d, \"\"x\"\"\nline\",%s\r\n", r, r, r % 3 ? "tail" : "");
+    }
+    csv_capture_t whole = {{0}, 0};
+    fossil_csv_t *csv = fossil_csv_create(',', '"');
+    ASSUME_ITS_EQUAL_SIZE(12, fossil_csv_feed(csv, text, length, csv_capture, &whole));
+
+    int same = 1;
+    for (size_t cut = 0; cut <= length; cut++) {
+        csv_capture_t parts = {{0}, 0};
+        size_t rows = fossil_csv_feed(csv, text, cut, csv_capture, &parts);
+        for (size_t at = cut; at < length; at += 7) { // then in small steps
+            size_t step = length - at < 7 ? length - at : 7;
+            rows += fossil_csv_feed(csv, text + at, step, csv_capture, &parts);
+        }
+        rows += fossil_csv_finish(csv, csv_capture, &parts);
+        same &= rows == 12 && strcmp(parts.text, whole.text) == 0;
+    }
+    ASSUME_ITS_TRUE(same);
+    fossil_csv_erase(csv);
+}
+
+// Stops after the first row it sees
+static int csv_stop(const fossil_csv_row_t *row, void *user) {
+    (void)row;
+    (*(size_t *)user)++;
+    return 1;
+}
+
+// Test case 3: Test TSV without quoting, a last row without a line end and stopping
+FOSSIL_TEST(test_fossil_csv_tsv) {
+    csv_capture_t capture = {{0}, 0};
+    fossil_csv_t *csv = fossil_csv_create('\t', 0);
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_csv_feed(csv, "a\t\"b\"\tc\nd\te", 11, csv_capture, &capture));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_csv_finish(csv, csv_capture, &capture));
+    ASSUME_ITS_TRUE(strcmp(capture.text, "a|\"b\"|c/d|e/") == 0);
+
+    size_t seen = 0;
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_csv_feed(csv, "1\n2\n3\n", 6, csv_stop, &seen));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_csv_feed(csv, "4\n", 2, csv_stop, &seen));
+    ASSUME_ITS_EQUAL_SIZE(1, seen);
+    fossil_csv_reset(csv);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_csv_feed(csv, "4\n5\n", 4, NULL, NULL));
+    fossil_csv_erase(csv);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_csv_tests) {
+    ADD_TEST(test_fossil_csv_quoted);
+    ADD_TEST(test_fossil_csv_chunks);
+    ADD_TEST(test_fossil_csv_tsv);
+} // end of tests
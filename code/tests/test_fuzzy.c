@@ -0,0 +1,92 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_fuzzy.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test fuzzy matching
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test edit distances, including patterns longer than one word
+FOSSIL_TEST(test_fossil_fuzzy_distance) {
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_distance("kitten", "sitting"));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_cstr_distance("catalog", "catalog"));
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_cstr_distance("", "fives"));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cstr_distance("flaw", "lawn"));
+
+    char a[201], b[201];
+    for (size_t i = 0; i < 200; i++) {
+        a[i] = (char)('a' + i % 23);
+        b[i] = (char)('a' + i % 23);
+    }
+    a[200] = b[200] = '\0';
+    b[3] = 'X';
+    b[100] = 'Y';
+    memmove(b + 150, b + 151, 50); // drop one character
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_distance(a, b));
+
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_distance(L"na\u00efve caf\u00e9", L"naive cafe"));
+}
+
+// Test case 2: Test the bounded distance
+FOSSIL_TEST(test_fossil_fuzzy_within) {
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_distance_within("kitten", "sitting", 3));
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_distance_within("kitten", "sitting", 2));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_cstr_distance_within("keyboard", "mouse", 0));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cstr_distance_within("wireless mouse", "wired mouse pad", 1));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_wstr_distance_within(L"headphones", L"headphone", 4));
+}
+
+// Test case 3: Test approximate search
+FOSSIL_TEST(test_fossil_fuzzy_find) {
+    size_t length = 0, distance = 0;
+    const_cstring text = "usb cable, hdmi cabel, power adapter";
+    const_cstring found = fossil_cstr_fuzzy_find(text, "hdmi cable", 2, &length, &distance);
+    ASSUME_ITS_TRUE(found == text + 11);
+    ASSUME_ITS_EQUAL_SIZE(9, length); // "hdmi cabe" is one edit away, closer than "hdmi cabel"
+    ASSUME_ITS_EQUAL_SIZE(1, distance);
+
+    found = fossil_cstr_fuzzy_find(text, "power adaptor", 1, &length, &distance);
+    ASSUME_ITS_TRUE(found == text + 23);
+    ASSUME_ITS_EQUAL_SIZE(13, length);
+    ASSUME_ITS_EQUAL_SIZE(1, distance);
+    ASSUME_ITS_TRUE(fossil_cstr_fuzzy_find(text, "keyboard", 2, NULL, NULL) == NULL);
+
+    const_wstring wide = L"r\u00e9sum\u00e9 and cover letter";
+    ASSUME_ITS_TRUE(fossil_wstr_fuzzy_find(wide, L"resume", 2, &length, &distance) == wide);
+    ASSUME_ITS_EQUAL_SIZE(6, length);
+    ASSUME_ITS_EQUAL_SIZE(2, distance);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_fuzzy_tests) {
+    ADD_TEST(test_fossil_fuzzy_distance);
+    ADD_TEST(test_fossil_fuzzy_within);
+    ADD_TEST(test_fossil_fuzzy_find);
+} // end of tests
@@ -0,0 +1,120 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_glob.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test globs
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test wildcards, sets and the star patterns that make backtrackers explode
+FOSSIL_TEST(test_fossil_glob_match) {
+    fossil_cstr_glob_t *glob = fossil_cstr_glob_create("user:[0-9][!0-9]?*.json", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, "user:4x-.json"));
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, "user:4xy/profile.json"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, "user:42y.json"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, "user:4x.json"));
+    fossil_cstr_glob_erase(glob);
+
+    glob = fossil_cstr_glob_create("\\*[*]lit[eral", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, "**lit[eral"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, "a*lit[eral"));
+    fossil_cstr_glob_erase(glob);
+
+    char text[4097];
+    memset(text, 'a', 4096);
+    text[4096] = '\0';
+    glob = fossil_cstr_glob_create("*a*a*a*a*a*a*a*a*b", 0);
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, text));
+    text[4095] = 'b';
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, text));
+    fossil_cstr_glob_erase(glob);
+
+    glob = fossil_cstr_glob_create("*?a?*?a?*b", 0);
+    text[4095] = 'a';
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, text));
+    fossil_cstr_glob_erase(glob);
+}
+
+// Test case 2: Test pathname mode and case folding on both string families
+FOSSIL_TEST(test_fossil_glob_pathname) {
+    fossil_cstr_glob_t *glob = fossil_cstr_glob_create("src/*/*.C", FOSSIL_GLOB_PATHNAME | FOSSIL_GLOB_IGNORE_CASE);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, "SRC/logic/glob.c"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, "src/logic/fossil/glob.c"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_glob_match(glob, "src/glob.c"));
+    fossil_cstr_glob_erase(glob);
+
+    glob = fossil_cstr_glob_create("src/*.c", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_glob_match(glob, "src/logic/glob.c"));
+    fossil_cstr_glob_erase(glob);
+
+    unsigned flags = FOSSIL_GLOB_PATHNAME | FOSSIL_GLOB_IGNORE_CASE;
+    fossil_wstr_glob_t *wide = fossil_wstr_glob_create(L"caf[\u00e0-\u00ff]/[A-Z]*", flags);
+    ASSUME_ITS_EQUAL_I32(1, fossil_wstr_glob_match(wide, L"CAF\u00e9/menu"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_wstr_glob_match(wide, L"cafe/menu"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_wstr_glob_match(wide, L"caf\u00e9/1menu"));
+    fossil_wstr_glob_erase(wide);
+}
+
+// Test case 3: Test matching one string against many globs and filtering arrays
+FOSSIL_TEST(test_fossil_glob_set) {
+    const_cstring patterns[] = {"*.log", "cache:*", "user:*:name", "*", "user:1?:*"};
+    fossil_cstr_globset_t *set = fossil_cstr_globset_create(patterns, 5, 0);
+    size_t ids[5];
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_globset_match(set, "user:12:name", ids, 5));
+    ASSUME_ITS_EQUAL_SIZE(2, ids[0]);
+    ASSUME_ITS_EQUAL_SIZE(3, ids[1]);
+    ASSUME_ITS_EQUAL_SIZE(4, ids[2]);
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_globset_match(set, "cache:boot.log", ids, 1));
+    ASSUME_ITS_EQUAL_SIZE(0, ids[0]);
+    fossil_cstr_globset_erase(set);
+
+    set = fossil_cstr_globset_create(patterns, 3, 0);
+    const_cstring keys[] = {"app.log", "session:9", "cache:x", "user:7:name", "user:7:mail"};
+    unsigned char matched[5];
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_globset_filter(set, keys, 5, matched));
+    ASSUME_ITS_EQUAL_I32(1, matched[0]);
+    ASSUME_ITS_EQUAL_I32(0, matched[1]);
+    ASSUME_ITS_EQUAL_I32(1, matched[3]);
+    ASSUME_ITS_EQUAL_I32(0, matched[4]);
+    fossil_cstr_globset_erase(set);
+
+    const_wstring wide_patterns[] = {L"K*", L"*z"};
+    fossil_wstr_globset_t *wide = fossil_wstr_globset_create(wide_patterns, 2, FOSSIL_GLOB_IGNORE_CASE);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_globset_match(wide, L"key:Z", NULL, 0));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_wstr_globset_match(wide, L"", NULL, 0));
+    fossil_wstr_globset_erase(wide);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_glob_tests) {
+    ADD_TEST(test_fossil_glob_match);
+    ADD_TEST(test_fossil_glob_pathname);
+    ADD_TEST(test_fossil_glob_set);
+} // end of tests
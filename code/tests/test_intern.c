@@ -0,0 +1,84 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_intern.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test intern pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test equal strings intern to the same pointer
+FOSSIL_TEST(test_fossil_intern_same_pointer) {
+    fossil_intern_t *pool = fossil_intern_create();
+    cstring first = fossil_cstr_create("hostname");
+    cstring second = fossil_cstr_create("hostname");
+
+    const_cstring a = fossil_intern_cstr(pool, first);
+    const_cstring b = fossil_intern_cstr(pool, second);
+    ASSUME_ITS_TRUE(a == b);
+    ASSUME_ITS_TRUE(a != first);
+    ASSUME_ITS_EQUAL_CSTR("hostname", a);
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_intern_count(pool));
+
+    fossil_cstr_erase(first);
+    fossil_cstr_erase(second);
+    fossil_intern_erase(pool);
+}
+
+// Test case 2: Test lookups without inserting
+FOSSIL_TEST(test_fossil_intern_find) {
+    fossil_intern_t *pool = fossil_intern_create();
+    ASSUME_ITS_TRUE(NULL == fossil_intern_find_cstr(pool, "field"));
+    const_cstring key = fossil_intern_cstr(pool, "field");
+    ASSUME_ITS_TRUE(key == fossil_intern_find_cstr(pool, "field"));
+    fossil_intern_erase(pool);
+}
+
+// Test case 3: Test the byte and wide families are kept apart
+FOSSIL_TEST(test_fossil_intern_families) {
+    fossil_intern_t *pool = fossil_intern_create();
+    const_wstring w1 = fossil_intern_wstr(pool, L"key");
+    const_wstring w2 = fossil_intern_wstr(pool, L"key");
+    ASSUME_ITS_TRUE(w1 == w2);
+    ASSUME_ITS_EQUAL_WSTR(L"key", w1);
+
+    const bletter raw[] = { 'k', 'e', 'y', 0 };
+    const_bstring b1 = fossil_intern_bstr(pool, raw);
+    ASSUME_ITS_TRUE(b1 != raw);
+    ASSUME_ITS_TRUE(b1 == fossil_intern_bstr(pool, raw));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_intern_count(pool));
+    fossil_intern_erase(pool);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_intern_tests) {
+    ADD_TEST(test_fossil_intern_same_pointer);
+    ADD_TEST(test_fossil_intern_find);
+    ADD_TEST(test_fossil_intern_families);
+} // end of tests
@@ -0,0 +1,80 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_lstring.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test length-prefixed string
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test fossil_lstr_create with a string and length
+FOSSIL_TEST(test_fossil_lstring_create_with_value_and_length) {
+    lstring var = fossil_lstr_create("Pizza");
+    ASSUME_ITS_EQUAL_CSTR("Pizza", var);
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_lstr_length(var));
+    ASSUME_ITS_TRUE(fossil_lstr_capacity(var) >= 5);
+    fossil_lstr_erase(var); // Clean up after creating an lstring
+}
+
+// Test case 2: Test fossil_lstr_concat grows and keeps the length
+FOSSIL_TEST(test_fossil_lstring_concat) {
+    lstring var = fossil_lstr_create("Pizza");
+    for (int i = 0; i < 100; i++) {
+        var = fossil_lstr_concat(var, " time");
+    }
+    ASSUME_ITS_EQUAL_SIZE(505, fossil_lstr_length(var));
+    ASSUME_ITS_EQUAL_SIZE(505, fossil_cstr_length(var)); // Still a valid C string
+    var = fossil_lstr_concat_lstr(var, var);
+    ASSUME_ITS_EQUAL_SIZE(1010, fossil_lstr_length(var));
+    fossil_lstr_erase(var);
+}
+
+// Test case 3: Test fossil_lstr_substr and stream reads
+FOSSIL_TEST(test_fossil_lstring_substr_and_stream) {
+    lstring var = fossil_lstr_create("first\nsecond");
+    lstring sub = fossil_lstr_substr(var, 6, 100);
+    ASSUME_ITS_EQUAL_CSTR("second", sub);
+    ASSUME_ITS_EQUAL_SIZE(6, fossil_lstr_length(sub));
+
+    size_t pos = 0, end_pos = 0;
+    lstring line = fossil_lstrstream_read_line(var, &pos, &end_pos);
+    ASSUME_ITS_EQUAL_CSTR("first", line);
+    ASSUME_ITS_EQUAL_SIZE(6, pos);
+
+    fossil_lstr_erase(line);
+    fossil_lstr_erase(sub);
+    fossil_lstr_erase(var);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_lstrings_tests) {
+    ADD_TEST(test_fossil_lstring_create_with_value_and_length);
+    ADD_TEST(test_fossil_lstring_concat);
+    ADD_TEST(test_fossil_lstring_substr_and_stream);
+} // end of tests
@@ -0,0 +1,124 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_ngram.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test N-gram indexes
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test finding documents by substring
+FOSSIL_TEST(test_fossil_ngram_find) {
+    fossil_ngram_t *index = fossil_ngram_create();
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_ngram_add(index, "the quick brown fox"));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_ngram_add(index, "a quiet brown dog"));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_ngram_add(index, "quick"));
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_ngram_add(index, "ox"));
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_ngram_count(index));
+
+    size_t ids[4];
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_ngram_find(index, "quick", ids, 4));
+    ASSUME_ITS_EQUAL_SIZE(0, ids[0]);
+    ASSUME_ITS_EQUAL_SIZE(2, ids[1]);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_ngram_find(index, "brown ", ids, 4));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_ngram_find(index, "brown cat", ids, 4));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_ngram_find(index, "n fo", ids, 0)); // no room, still counted
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_ngram_find(index, "ox", ids, 4)); // too short for trigrams
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_ngram_find(index, "", NULL, 0));
+    fossil_ngram_erase(index);
+}
+
+// Test case 2: Test removing documents and reusing the index
+FOSSIL_TEST(test_fossil_ngram_remove) {
+    fossil_ngram_t *index = fossil_ngram_create();
+    char document[32];
+    for (int i = 0; i < 200; i++) {
+        snprintf(document, sizeof(document), "entry %03d cached", i);
+        fossil_ngram_add(index, document);
+    }
+    ASSUME_ITS_EQUAL_SIZE(200, fossil_ngram_find(index, "cached", NULL, 0));
+    for (size_t id = 0; id < 200; id += 2) {
+        ASSUME_ITS_EQUAL_I32(0, fossil_ngram_remove(index, id));
+    }
+    ASSUME_ITS_EQUAL_I32(-1, fossil_ngram_remove(index, 0));
+    ASSUME_ITS_TRUE(fossil_ngram_document(index, 0) == NULL);
+    ASSUME_ITS_TRUE(strcmp(fossil_ngram_document(index, 1), "entry 001 cached") == 0);
+    ASSUME_ITS_EQUAL_SIZE(100, fossil_ngram_count(index));
+    ASSUME_ITS_EQUAL_SIZE(100, fossil_ngram_find(index, "cached", NULL, 0));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_ngram_find(index, "entry 010", NULL, 0));
+
+    size_t ids[2];
+    ASSUME_ITS_EQUAL_SIZE(200, fossil_ngram_add(index, "entry 010 cached"));
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_ngram_find(index, "entry 010", ids, 2));
+    ASSUME_ITS_EQUAL_SIZE(200, ids[0]);
+    fossil_ngram_erase(index);
+}
+
+// Test case 3: Test agreement with a plain scan under churn
+FOSSIL_TEST(test_fossil_ngram_brute_force) {
+    static char words[3000][12];
+    fossil_ngram_t *index = fossil_ngram_create();
+    unsigned seed = 5;
+    for (size_t i = 0; i < 3000; i++) {
+        size_t length = 2 + i % 10;
+        for (size_t j = 0; j < length; j++) {
+            seed = seed * 1103515245u + 12345u;
+            words[i][j] = (char)('a' + (seed >> 16) % 3);
+        }
+        words[i][length] = '\0';
+        fossil_ngram_add(index, words[i]);
+        if (i % 3 == 1) {
+            fossil_ngram_remove(index, i / 2);
+            words[i / 2][0] = '\0';
+        }
+    }
+
+    const_cstring patterns[] = {"abc", "aaaa", "cb", "bcabca", "ccccccc"};
+    size_t ids[3000];
+    for (size_t p = 0; p < 5; p++) {
+        size_t expected = 0, found = fossil_ngram_find(index, patterns[p], ids, 3000);
+        int same = 1;
+        for (size_t i = 0; i < 3000; i++) {
+            if (words[i][0] && strstr(words[i], patterns[p])) {
+                same &= expected < found && ids[expected] == i;
+                expected++;
+            }
+        }
+        ASSUME_ITS_EQUAL_SIZE(expected, found);
+        ASSUME_ITS_TRUE(same);
+    }
+    fossil_ngram_erase(index);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_ngram_tests) {
+    ADD_TEST(test_fossil_ngram_find);
+    ADD_TEST(test_fossil_ngram_remove);
+    ADD_TEST(test_fossil_ngram_brute_force);
+} // end of tests
@@ -0,0 +1,105 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_pattern.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+#include <locale.h>
+#include <stdio.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test search patterns
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test one pattern reused across several haystacks
+FOSSIL_TEST(test_fossil_pattern_reuse) {
+    fossil_cstr_pattern_t *pattern = fossil_cstr_pattern_create("timeout", 0);
+    const_cstring lines[] = {
+        "level=warn msg=timeout",
+        "level=info msg=connected",
+        "timeout after timeout"
+    };
+    ASSUME_ITS_TRUE(lines[0] + 15 == fossil_cstr_pattern_find(pattern, lines[0]));
+    ASSUME_ITS_TRUE(NULL == fossil_cstr_pattern_find(pattern, lines[1]));
+    ASSUME_ITS_TRUE(lines[2] == fossil_cstr_pattern_find(pattern, lines[2]));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cstr_pattern_count(pattern, lines[2]));
+    fossil_cstr_pattern_erase(pattern);
+}
+
+// Test case 2: Test find_all fills the caller buffer with non-overlapping matches
+FOSSIL_TEST(test_fossil_pattern_find_all) {
+    fossil_cstr_pattern_t *pattern = fossil_cstr_pattern_create("aa", 0);
+    size_t offsets[2] = { 0, 0 };
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_cstr_pattern_find_all(pattern, "aaaaxaa", offsets, 2));
+    ASSUME_ITS_EQUAL_SIZE(0, offsets[0]);
+    ASSUME_ITS_EQUAL_SIZE(2, offsets[1]);
+    fossil_cstr_pattern_erase(pattern);
+
+    const bletter needle[] = { 0x0141, 0 };
+    const bletter text[] = { 0x4101, 0x0141, 0x4100, 0x0141, 0 };
+    fossil_bstr_pattern_t *wide = fossil_bstr_pattern_create(needle, 0);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_bstr_pattern_find_all(wide, text, offsets, 2));
+    ASSUME_ITS_EQUAL_SIZE(1, offsets[0]);
+    ASSUME_ITS_EQUAL_SIZE(3, offsets[1]);
+    fossil_bstr_pattern_erase(wide);
+}
+
+// Test case 3: Test case-insensitive patterns
+FOSSIL_TEST(test_fossil_pattern_ignore_case) {
+    fossil_cstr_pattern_t *pattern = fossil_cstr_pattern_create("Content-Type", FOSSIL_PATTERN_IGNORE_CASE);
+    const_cstring headers = "HOST: a\r\ncontent-type: text/plain\r\nCONTENT-TYPE: x";
+    ASSUME_ITS_TRUE(headers + 9 == fossil_cstr_pattern_find(pattern, headers));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cstr_pattern_count(pattern, headers));
+    fossil_cstr_pattern_erase(pattern);
+
+    fossil_wstr_pattern_t *wide = fossil_wstr_pattern_create(L"Fossil", FOSSIL_PATTERN_IGNORE_CASE);
+    const_wstring path = L"/usr/share/FOSSIL/strings";
+    ASSUME_ITS_TRUE(path + 11 == fossil_wstr_pattern_find(wide, path));
+    ASSUME_ITS_TRUE(NULL == fossil_wstr_pattern_find(wide, L"/usr/share/f0ssil"));
+    fossil_wstr_pattern_erase(wide);
+
+    // Wide patterns fold beyond ASCII the way fossil_wstr_icompare does
+    char saved[64];
+    snprintf(saved, sizeof(saved), "%s", setlocale(LC_CTYPE, NULL));
+    if (setlocale(LC_CTYPE, "C.UTF-8")) {
+        wide = fossil_wstr_pattern_create(L"\u00e9t\u00e9 \u0394", FOSSIL_PATTERN_IGNORE_CASE);
+        const_wstring text = L"un \u00c9T\u00c9 \u03b4 et \u00e9t\u00e9 \u0394";
+        ASSUME_ITS_TRUE(text + 3 == fossil_wstr_pattern_find(wide, text));
+        ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_pattern_count(wide, text));
+        ASSUME_ITS_EQUAL_I32(0, fossil_wstr_icompare(text + 3, L"\u00e9t\u00e9 \u0394 et \u00e9t\u00e9 \u0394"));
+        fossil_wstr_pattern_erase(wide);
+    }
+    setlocale(LC_CTYPE, saved);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_pattern_tests) {
+    ADD_TEST(test_fossil_pattern_reuse);
+    ADD_TEST(test_fossil_pattern_find_all);
+    ADD_TEST(test_fossil_pattern_ignore_case);
+} // end of tests
@@ -0,0 +1,133 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_regex.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test regular expressions
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test the leftmost match and its capture groups
+FOSSIL_TEST(test_fossil_regex_captures) {
+    fossil_cstr_regex_t *regex = fossil_cstr_regex_create("(\\w+)=(\\d+)(ms)?", 0);
+    fossil_regex_capture_t caps[5];
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cstr_regex_groups(regex));
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_regex_find(regex, "level=warn timeout=250 retries=3", caps, 5));
+    ASSUME_ITS_EQUAL_SIZE(11, caps[0].start);
+    ASSUME_ITS_EQUAL_SIZE(22, caps[0].end);
+    ASSUME_ITS_EQUAL_SIZE(11, caps[1].start);
+    ASSUME_ITS_EQUAL_SIZE(18, caps[1].end);
+    ASSUME_ITS_EQUAL_SIZE(19, caps[2].start);
+    ASSUME_ITS_TRUE(caps[3].start == FOSSIL_REGEX_UNSET);
+    ASSUME_ITS_TRUE(caps[4].start == FOSSIL_REGEX_UNSET);
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_regex_find(regex, "level=warn", caps, 5));
+    fossil_cstr_regex_erase(regex);
+
+    // Earlier alternatives and greedy repetition win, as in Perl
+    regex = fossil_cstr_regex_create("^(a|ab)(c|bcd)(d*)$", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_regex_find(regex, "abcd", caps, 4));
+    ASSUME_ITS_EQUAL_SIZE(1, caps[1].end);
+    ASSUME_ITS_EQUAL_SIZE(4, caps[2].end);
+    ASSUME_ITS_EQUAL_SIZE(4, caps[3].start);
+    fossil_cstr_regex_erase(regex);
+
+    // An iteration that matches nothing ends the repetition, as in Perl
+    regex = fossil_cstr_regex_create("[a-c](((A))?|(([^a])))+", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_regex_find(regex, "AB a1", caps, 2));
+    ASSUME_ITS_EQUAL_SIZE(3, caps[0].start);
+    ASSUME_ITS_EQUAL_SIZE(4, caps[0].end);
+    ASSUME_ITS_EQUAL_SIZE(4, caps[1].start);
+    ASSUME_ITS_EQUAL_SIZE(4, caps[1].end);
+    fossil_cstr_regex_erase(regex);
+    regex = fossil_cstr_regex_create("(a*)*b", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_regex_find(regex, "aaab", caps, 2));
+    ASSUME_ITS_EQUAL_SIZE(3, caps[1].start);
+    ASSUME_ITS_EQUAL_SIZE(3, caps[1].end);
+    fossil_cstr_regex_erase(regex);
+
+    ASSUME_ITS_TRUE(fossil_cstr_regex_create("(unclosed", 0) == NULL);
+    ASSUME_ITS_TRUE(fossil_cstr_regex_create("a{3,2}", 0) == NULL);
+    ASSUME_ITS_TRUE(fossil_cstr_regex_create("*a", 0) == NULL);
+}
+
+// Test case 2: Test that patterns which make backtrackers explode stay linear
+FOSSIL_TEST(test_fossil_regex_linear) {
+    char text[4097];
+    memset(text, 'a', 4096);
+    text[4096] = '\0';
+
+    fossil_cstr_regex_t *regex = fossil_cstr_regex_create("(a*)*b", 0);
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_regex_test(regex, text));
+    fossil_cstr_regex_erase(regex);
+
+    // (a|aa)+ followed by a mismatch at the very end, searched from every offset
+    regex = fossil_cstr_regex_create("(a|aa)+$x?c", 0);
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_regex_find(regex, text, NULL, 0));
+    fossil_cstr_regex_erase(regex);
+
+    // Enough distinct states to outgrow the DFA cache, finishing on the NFA
+    static char noise[65537];
+    unsigned seed = 1;
+    for (size_t i = 0; i < 65536; i++) {
+        seed = seed * 1103515245u + 12345u;
+        noise[i] = (seed >> 16) & 1 ? 'a' : 'b';
+    }
+    regex = fossil_cstr_regex_create("[ab]*a[ab]{16}c", 0);
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_regex_test(regex, noise));
+    noise[60000] = 'c';
+    noise[59983] = 'a';
+    ASSUME_ITS_EQUAL_I32(1, fossil_cstr_regex_test(regex, noise));
+    fossil_cstr_regex_erase(regex);
+}
+
+// Test case 3: Test wide strings, case folding and the literal prefix
+FOSSIL_TEST(test_fossil_regex_wide) {
+    fossil_wstr_regex_t *regex = fossil_wstr_regex_create(L"ERROR\\s+\\[(\\w+)\\]", FOSSIL_REGEX_IGNORE_CASE);
+    fossil_regex_capture_t caps[2];
+    const_wstring log = L"info [boot] ok\nerror  [disk] full\nError [net] down";
+    ASSUME_ITS_EQUAL_I32(1, fossil_wstr_regex_find(regex, log, caps, 2));
+    ASSUME_ITS_EQUAL_SIZE(15, caps[0].start);
+    ASSUME_ITS_EQUAL_SIZE(23, caps[1].start);
+    ASSUME_ITS_EQUAL_SIZE(27, caps[1].end);
+    ASSUME_ITS_EQUAL_I32(0, fossil_wstr_regex_test(regex, L"no errors here"));
+    fossil_wstr_regex_erase(regex);
+
+    regex = fossil_wstr_regex_create(L"\\x{e9}t[\\x{e0}-\\x{ff}]+", 0);
+    ASSUME_ITS_EQUAL_I32(1, fossil_wstr_regex_find(regex, L"un \u00e9t\u00e9 chaud", caps, 1));
+    ASSUME_ITS_EQUAL_SIZE(3, caps[0].start);
+    ASSUME_ITS_EQUAL_SIZE(6, caps[0].end);
+    fossil_wstr_regex_erase(regex);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_regex_tests) {
+    ADD_TEST(test_fossil_regex_captures);
+    ADD_TEST(test_fossil_regex_linear);
+    ADD_TEST(test_fossil_regex_wide);
+} // end of tests
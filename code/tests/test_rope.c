@@ -0,0 +1,90 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_rope.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test rope
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test fossil_rope_create and flatten
+FOSSIL_TEST(test_fossil_rope_create_and_flatten) {
+    fossil_rope_t *rope = fossil_rope_create("Pizza time!");
+    ASSUME_ITS_EQUAL_SIZE(11, fossil_rope_length(rope));
+    ASSUME_ITS_TRUE('z' == fossil_rope_at(rope, 2));
+
+    cstring flat = fossil_rope_flatten(rope);
+    ASSUME_ITS_EQUAL_CSTR("Pizza time!", flat);
+    fossil_cstr_erase(flat);
+    fossil_rope_erase(rope);
+}
+
+// Test case 2: Test fossil_rope_insert and delete in the middle
+FOSSIL_TEST(test_fossil_rope_insert_and_delete) {
+    fossil_rope_t *rope = fossil_rope_create("Pizza!");
+    ASSUME_ITS_EQUAL_I32(0, fossil_rope_insert(rope, 5, " time"));
+    ASSUME_ITS_EQUAL_I32(0, fossil_rope_delete(rope, 0, 6));
+
+    cstring flat = fossil_rope_flatten(rope);
+    ASSUME_ITS_EQUAL_CSTR("time!", flat);
+    fossil_cstr_erase(flat);
+
+    cstring slice = fossil_rope_slice(rope, 1, 3);
+    ASSUME_ITS_EQUAL_CSTR("ime", slice);
+    fossil_cstr_erase(slice);
+    fossil_rope_erase(rope);
+}
+
+// Test case 3: Test chunk iteration over a multi-chunk rope
+FOSSIL_TEST(test_fossil_rope_iterate_chunks) {
+    fossil_rope_t *rope = fossil_rope_create(NULL);
+    for (int i = 0; i < 1000; i++) {
+        fossil_rope_append(rope, "0123456789");
+    }
+
+    fossil_rope_iter_t iter;
+    const_cstring chunk;
+    size_t len, total = 0, chunks = 0;
+    fossil_rope_iter_init(&iter, rope);
+    while (fossil_rope_iter_next(&iter, &chunk, &len)) {
+        total += len;
+        chunks++;
+    }
+    ASSUME_ITS_EQUAL_SIZE(10000, total);
+    ASSUME_ITS_TRUE(chunks > 1);
+    ASSUME_ITS_TRUE('7' == fossil_rope_at(rope, 9997));
+    fossil_rope_erase(rope);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_rope_tests) {
+    ADD_TEST(test_fossil_rope_create_and_flatten);
+    ADD_TEST(test_fossil_rope_insert_and_delete);
+    ADD_TEST(test_fossil_rope_iterate_chunks);
+} // end of tests
@@ -0,0 +1,75 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_rstring.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test reference-counted string
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test fossil_rstr_retain and release share one buffer
+FOSSIL_TEST(test_fossil_rstring_retain_release) {
+    rstring var = fossil_rstr_create("Pizza");
+    rstring copy = fossil_rstr_retain(var);
+    ASSUME_ITS_TRUE(var == copy);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_rstr_refcount(var));
+    ASSUME_ITS_EQUAL_SIZE(5, fossil_rstr_length(var));
+    ASSUME_ITS_EQUAL_I32(0, fossil_cstr_compare(var, "Pizza")); // Usable as const_cstring
+    fossil_rstr_release(copy);
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_rstr_refcount(var));
+    fossil_rstr_release(var);
+}
+
+// Test case 2: Test fossil_rstr_concat copies a shared buffer
+FOSSIL_TEST(test_fossil_rstring_copy_on_write) {
+    rstring shared = fossil_rstr_create("Pizza");
+    rstring mine = fossil_rstr_concat(fossil_rstr_retain(shared), " time");
+    ASSUME_ITS_TRUE(mine != shared);
+    ASSUME_ITS_EQUAL_CSTR("Pizza", shared);
+    ASSUME_ITS_EQUAL_CSTR("Pizza time", mine);
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_rstr_refcount(shared));
+    fossil_rstr_release(mine);
+    fossil_rstr_release(shared);
+}
+
+// Test case 3: Test fossil_rstr_reverse mutates a unique buffer in place
+FOSSIL_TEST(test_fossil_rstring_reverse_unique) {
+    rstring var = fossil_rstr_create("abc");
+    rstring rev = fossil_rstr_reverse(var);
+    ASSUME_ITS_TRUE(rev == var);
+    ASSUME_ITS_EQUAL_CSTR("cba", rev);
+    fossil_rstr_release(rev);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_rstrings_tests) {
+    ADD_TEST(test_fossil_rstring_retain_release);
+    ADD_TEST(test_fossil_rstring_copy_on_write);
+    ADD_TEST(test_fossil_rstring_reverse_unique);
+} // end of tests
@@ -0,0 +1,226 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_split.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// A thread pool hook that runs every task in reverse order on the calling thread
+static void split_pool_run(void *pool, size_t tasks, fossil_parallel_task_t task, void *context) {
+    *(size_t *)pool += tasks;
+    for (size_t t = tasks; t-- > 0;) {
+        task(context, t);
+    }
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Split iterators
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test iterating classic C string tokens like fossil_cstr_split
+FOSSIL_TEST(test_fossil_cstr_split_iter) {
+    const_cstring str = "id,,name,";
+    fossil_cstr_split_iter_t iter;
+    fossil_split_token_t token;
+    cstrings splits = fossil_cstr_split(str, ',');
+    size_t count = 0;
+    fossil_cstr_split_begin(&iter, str, ',', FOSSIL_SPLIT_ALL, 0);
+    while (fossil_cstr_split_next(&iter, &token)) {
+        ASSUME_ITS_TRUE(splits[count] != NULL);
+        ASSUME_ITS_EQUAL_SIZE(strlen(splits[count]), token.length);
+        ASSUME_ITS_TRUE(strncmp(str + token.offset, splits[count], token.length) == 0);
+        count++;
+    }
+    ASSUME_ITS_EQUAL_SIZE(4, count);
+    ASSUME_ITS_TRUE(splits[count] == NULL);
+    fossil_cstr_erase_splits(splits);
+
+    fossil_cstr_split_begin(&iter, "", ',', FOSSIL_SPLIT_ALL, 0);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token)); // one empty token
+    ASSUME_ITS_EQUAL_SIZE(0, token.length);
+    ASSUME_ITS_TRUE(!fossil_cstr_split_next(&iter, &token));
+    fossil_cstr_split_begin(&iter, NULL, ',', FOSSIL_SPLIT_ALL, 0);
+    ASSUME_ITS_TRUE(!fossil_cstr_split_next(&iter, &token));
+}
+
+// Test case 2: Test skipping empty tokens and limiting splits
+FOSSIL_TEST(test_fossil_cstr_split_iter_options) {
+    fossil_cstr_split_iter_t iter;
+    fossil_split_token_t token;
+    fossil_cstr_split_begin(&iter, "  ls   -l  /tmp ", ' ', FOSSIL_SPLIT_ALL, FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_EQUAL_SIZE(2, token.offset);
+    ASSUME_ITS_EQUAL_SIZE(2, token.length);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_EQUAL_SIZE(7, token.offset);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_EQUAL_SIZE(11, token.offset);
+    ASSUME_ITS_EQUAL_SIZE(4, token.length);
+    ASSUME_ITS_TRUE(!fossil_cstr_split_next(&iter, &token));
+
+    fossil_cstr_split_begin(&iter, "key=a=b", '=', 1, 0);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_EQUAL_SIZE(3, token.length);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token)); // the rest, delimiters and all
+    ASSUME_ITS_EQUAL_SIZE(4, token.offset);
+    ASSUME_ITS_EQUAL_SIZE(3, token.length);
+    ASSUME_ITS_TRUE(!fossil_cstr_split_next(&iter, &token));
+
+    fossil_cstr_split_begin(&iter, "a  b  c", ' ', 1, FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_TRUE(fossil_cstr_split_next(&iter, &token));
+    ASSUME_ITS_EQUAL_SIZE(3, token.offset);
+    ASSUME_ITS_EQUAL_SIZE(4, token.length);
+    ASSUME_ITS_TRUE(!fossil_cstr_split_next(&iter, &token));
+}
+
+// Test case 3: Test iterating byte and wide string tokens
+FOSSIL_TEST(test_fossil_bstr_wstr_split_iter) {
+    const bletter bytes[] = {'a', '|', 'b', 'c', '|', '|', 0};
+    fossil_bstr_split_iter_t biter;
+    fossil_split_token_t token;
+    size_t lengths[4] = {0}, count = 0;
+    fossil_bstr_split_begin(&biter, bytes, '|', FOSSIL_SPLIT_ALL, 0);
+    while (fossil_bstr_split_next(&biter, &token) && count < 4) {
+        lengths[count++] = token.length;
+    }
+    ASSUME_ITS_EQUAL_SIZE(4, count);
+    ASSUME_ITS_EQUAL_SIZE(2, lengths[1]);
+    ASSUME_ITS_EQUAL_SIZE(0, lengths[3]);
+
+    fossil_wstr_split_iter_t witer;
+    fossil_wstr_split_begin(&witer, L"caf\u00e9;;th\u00e9", L';', FOSSIL_SPLIT_ALL, FOSSIL_SPLIT_SKIP_EMPTY);
+    ASSUME_ITS_TRUE(fossil_wstr_split_next(&witer, &token));
+    ASSUME_ITS_EQUAL_SIZE(4, token.length);
+    ASSUME_ITS_TRUE(fossil_wstr_split_next(&witer, &token));
+    ASSUME_ITS_EQUAL_SIZE(6, token.offset);
+    ASSUME_ITS_EQUAL_SIZE(3, token.length);
+    ASSUME_ITS_TRUE(!fossil_wstr_split_next(&witer, &token));
+
+    wstrings splits = fossil_wstr_split(L"x;y", L';');
+    ASSUME_ITS_TRUE(wcscmp(splits[1], L"y") == 0);
+    ASSUME_ITS_TRUE(splits[2] == NULL);
+    fossil_wstr_erase_splits(splits);
+}
+
+// Test case 4: Test single-block splits against the per-token ones
+FOSSIL_TEST(test_fossil_split_block) {
+    const_cstring str = ",alpha,,beta,";
+    cstrings expected = fossil_cstr_split(str, ',');
+    cstrings splits = fossil_cstr_split_block(str, ',');
+    size_t i = 0;
+    for (; expected[i]; i++) {
+        ASSUME_ITS_TRUE(splits[i] != NULL);
+        ASSUME_ITS_TRUE(strcmp(expected[i], splits[i]) == 0);
+    }
+    ASSUME_ITS_EQUAL_SIZE(5, i);
+    ASSUME_ITS_TRUE(splits[i] == NULL);
+    fossil_cstr_erase_splits(expected);
+    fossil_cstr_erase_split_block(splits);
+
+    splits = fossil_cstr_split_block_with(fossil_allocator_cached(), "solo", ',');
+    ASSUME_ITS_TRUE(strcmp(splits[0], "solo") == 0);
+    ASSUME_ITS_TRUE(splits[1] == NULL);
+    fossil_cstr_erase_split_block_with(fossil_allocator_cached(), splits);
+
+    const bletter bytes[] = {'x', ':', 'y', 0};
+    bstrings bsplits = fossil_bstr_split_block(bytes, ':');
+    ASSUME_ITS_TRUE(bsplits[0][0] == 'x' && bsplits[0][1] == 0);
+    ASSUME_ITS_TRUE(bsplits[1][0] == 'y' && bsplits[1][1] == 0);
+    ASSUME_ITS_TRUE(bsplits[2] == NULL);
+    fossil_bstr_erase_split_block(bsplits);
+
+    wstrings wsplits = fossil_wstr_split_block(L"a b  c", L' ');
+    ASSUME_ITS_TRUE(wcscmp(wsplits[2], L"") == 0);
+    ASSUME_ITS_TRUE(wcscmp(wsplits[3], L"c") == 0);
+    ASSUME_ITS_TRUE(wsplits[4] == NULL);
+    fossil_wstr_erase_split_block(wsplits);
+}
+
+// Test case 5: Test parallel splits against the iterator, with long gaps between delimiters
+FOSSIL_TEST(test_fossil_cstr_split_parallel) {
+    static char text[400000];
+    unsigned seed = 11;
+    for (size_t i = 0; i < sizeof(text) - 1; i++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t run = i < 150000 ? 9 : 200000; // dense, then hardly any delimiters
+        text[i] = (seed >> 16) % run == 0 ? ',' : 'a';
+    }
+    text[sizeof(text) - 1] = '\0';
+    text[0] = text[sizeof(text) - 2] = ',';
+
+    fossil_cstr_split_iter_t iter;
+    fossil_split_token_t token;
+    size_t expected = 0;
+    fossil_cstr_split_begin(&iter, text, ',', FOSSIL_SPLIT_ALL, 0);
+    while (fossil_cstr_split_next(&iter, &token)) {
+        expected++;
+    }
+
+    size_t tasks = 0;
+    fossil_thread_pool_t pool = {split_pool_run, &tasks};
+    for (size_t threads = 1; threads <= 4; threads += 3) {
+        size_t count = 0;
+        fossil_split_token_t *tokens =
+            fossil_cstr_split_parallel(text, sizeof(text) - 1, ',', threads, threads == 4 ? &pool : NULL, &count);
+        fossil_split_chunks_t *chunks = fossil_cstr_split_parallel_chunks(text, sizeof(text) - 1, ',', threads, NULL);
+        ASSUME_ITS_EQUAL_SIZE(expected, count);
+
+        int same = 1;
+        size_t k = 0;
+        fossil_cstr_split_begin(&iter, text, ',', FOSSIL_SPLIT_ALL, 0);
+        for (size_t c = 0; c < fossil_split_chunks_count(chunks); c++) {
+            size_t n;
+            const fossil_split_token_t *chunk = fossil_split_chunks_get(chunks, c, &n);
+            for (size_t j = 0; j < n; j++, k++) {
+                same &= fossil_cstr_split_next(&iter, &token) && token.offset == tokens[k].offset &&
+                        token.length == tokens[k].length && chunk[j].offset == token.offset &&
+                        chunk[j].length == token.length;
+            }
+        }
+        ASSUME_ITS_TRUE(same);
+        ASSUME_ITS_EQUAL_SIZE(expected, k);
+        fossil_split_erase_tokens(tokens);
+        fossil_split_chunks_erase(chunks);
+    }
+    ASSUME_ITS_TRUE(tasks > 2); // the pool ran both passes
+
+    size_t count = 0;
+    fossil_split_token_t *tokens = fossil_cstr_split_parallel("", 0, ',', 0, NULL, &count);
+    ASSUME_ITS_EQUAL_SIZE(1, count);
+    ASSUME_ITS_EQUAL_SIZE(0, tokens[0].length);
+    fossil_split_erase_tokens(tokens);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_split_tests) {
+    ADD_TEST(test_fossil_cstr_split_iter);
+    ADD_TEST(test_fossil_cstr_split_iter_options);
+    ADD_TEST(test_fossil_bstr_wstr_split_iter);
+    ADD_TEST(test_fossil_split_block);
+    ADD_TEST(test_fossil_cstr_split_parallel);
+} // end of tests
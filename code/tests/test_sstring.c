@@ -0,0 +1,101 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_sstring.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test small string
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test fossil_sstr_create keeps short strings inline
+FOSSIL_TEST(test_fossil_sstring_create_inline) {
+    sstring var;
+    fossil_sstr_init(&var);
+    ASSUME_ITS_EQUAL_CSTR("Pizza time!", fossil_sstr_create(&var, "Pizza time!"));
+    ASSUME_ITS_EQUAL_SIZE(11, fossil_sstr_length(&var));
+    ASSUME_ITS_TRUE(fossil_sstr_is_inline(&var));
+    fossil_sstr_erase(&var); // Clean up after creating an sstring
+}
+
+// Test case 2: Test conversions and formatting without spilling
+FOSSIL_TEST(test_fossil_sstring_convert_and_format) {
+    sstring var;
+    fossil_sstr_init(&var);
+    ASSUME_ITS_EQUAL_CSTR("-42", fossil_sstr_from_int(&var, -42));
+    ASSUME_ITS_EQUAL_CSTR("18446744073709551615", fossil_sstr_from_ullong(&var, 18446744073709551615ULL));
+    ASSUME_ITS_EQUAL_CSTR("(555) 123-4567", fossil_sstr_format_phone(&var, "5551234567"));
+    ASSUME_ITS_TRUE(fossil_sstr_is_inline(&var));
+    fossil_sstr_erase(&var);
+}
+
+// Test case 3: Test long strings spill to the heap and can be detached
+FOSSIL_TEST(test_fossil_sstring_spill_and_detach) {
+    sstring var;
+    fossil_sstr_init(&var);
+    fossil_sstr_create(&var, "Pizza");
+    fossil_sstr_concat(&var, " time is the best time of the day");
+    ASSUME_ITS_FALSE(fossil_sstr_is_inline(&var));
+    ASSUME_ITS_EQUAL_CSTR("Pizza time is the best time of the day", fossil_sstr_data(&var));
+
+    cstring owned = fossil_sstr_detach(&var);
+    ASSUME_ITS_EQUAL_CSTR("Pizza time is the best time of the day", owned);
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_sstr_length(&var));
+    fossil_cstr_erase(owned);
+    fossil_sstr_erase(&var);
+}
+
+// Test case 4: Test formatting a small string from its own contents
+FOSSIL_TEST(test_fossil_sstring_format_self) {
+    sstring var;
+    fossil_sstr_init(&var);
+    fossil_sstr_create(&var, "ab");
+    fossil_sstr_format(&var, "[%s|%s]", fossil_sstr_data(&var), fossil_sstr_data(&var));
+    ASSUME_ITS_EQUAL_CSTR("[ab|ab]", fossil_sstr_data(&var));
+
+    // Growing past the inline buffer, then past the scratch buffer
+    fossil_sstr_format(&var, "%s:%s:%s:%s", fossil_sstr_data(&var), fossil_sstr_data(&var), fossil_sstr_data(&var),
+                       fossil_sstr_data(&var));
+    ASSUME_ITS_EQUAL_CSTR("[ab|ab]:[ab|ab]:[ab|ab]:[ab|ab]", fossil_sstr_data(&var));
+    for (int i = 0; i < 3; i++) {
+        fossil_sstr_format(&var, "%s%s", fossil_sstr_data(&var), fossil_sstr_data(&var));
+    }
+    ASSUME_ITS_EQUAL_SIZE(31 * 8, fossil_sstr_length(&var));
+    fossil_sstr_format(&var, "%s%s", fossil_sstr_data(&var), fossil_sstr_data(&var));
+    ASSUME_ITS_EQUAL_SIZE(31 * 16, fossil_sstr_length(&var));
+    ASSUME_ITS_TRUE(strncmp(fossil_sstr_data(&var) + 31 * 15, "[ab|ab]:[ab|ab]:[ab|ab]:[ab|ab]", 31) == 0);
+    fossil_sstr_erase(&var);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_sstrings_tests) {
+    ADD_TEST(test_fossil_sstring_create_inline);
+    ADD_TEST(test_fossil_sstring_convert_and_format);
+    ADD_TEST(test_fossil_sstring_spill_and_detach);
+    ADD_TEST(test_fossil_sstring_format_self);
+} // end of tests
@@ -0,0 +1,115 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_suffix.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Suffix arrays
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test counting and locating patterns
+FOSSIL_TEST(test_fossil_suffix_locate) {
+    const_cstring text = "banana bandana";
+    fossil_suffix_t *index = fossil_suffix_create(text, 0);
+    ASSUME_ITS_EQUAL_SIZE(14, fossil_suffix_length(index));
+    ASSUME_ITS_EQUAL_SIZE(6, fossil_suffix_at(index, 0)); // " bandana" sorts first
+    ASSUME_ITS_EQUAL_SIZE(13, fossil_suffix_at(index, 1)); // then "a"
+
+    size_t offsets[8];
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_suffix_locate(index, "ana", offsets, 8));
+    ASSUME_ITS_EQUAL_SIZE(1, offsets[0]);
+    ASSUME_ITS_EQUAL_SIZE(3, offsets[1]);
+    ASSUME_ITS_EQUAL_SIZE(11, offsets[2]);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_suffix_count(index, "ban"));
+    ASSUME_ITS_EQUAL_SIZE(0, fossil_suffix_count(index, "bananas"));
+    ASSUME_ITS_EQUAL_SIZE(14, fossil_suffix_count(index, ""));
+    fossil_suffix_erase(index);
+}
+
+static int suffix_naive_order(const char *text, size_t a, size_t b) {
+    return strcmp(text + a, text + b);
+}
+
+// Test case 2: Test the arrays against a naive sort, with long shared prefixes
+FOSSIL_TEST(test_fossil_suffix_naive) {
+    static char text[3001];
+    unsigned seed = 11;
+    for (size_t i = 0; i < 3000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        // A random start, then a long repeat so some LCPs pass one byte
+        text[i] = i < 1000 ? (char)('a' + (seed >> 16) % 3) : text[i - 700];
+    }
+    text[3000] = '\0';
+    fossil_suffix_t *index = fossil_suffix_create(text, 4);
+    ASSUME_ITS_EQUAL_SIZE(3000, fossil_suffix_length(index));
+
+    size_t longest = 0;
+    int sorted = 1, lcps = 1;
+    for (size_t r = 1; r < 3000; r++) {
+        size_t a = fossil_suffix_at(index, r - 1), b = fossil_suffix_at(index, r), l = 0;
+        sorted &= suffix_naive_order(text, a, b) < 0;
+        while (text[a + l] && text[a + l] == text[b + l]) {
+            l++;
+        }
+        lcps &= fossil_suffix_lcp(index, r) == l;
+        longest = l > longest ? l : longest;
+    }
+    ASSUME_ITS_TRUE(sorted);
+    ASSUME_ITS_TRUE(lcps);
+    ASSUME_ITS_TRUE(longest > 1000);
+    fossil_suffix_erase(index);
+}
+
+// Test case 3: Test saving and loading an index
+FOSSIL_TEST(test_fossil_suffix_save_load) {
+    const_cstring text = "mississippi river, mississippi delta";
+    const char *path = "test_fossil_suffix.idx";
+    fossil_suffix_t *index = fossil_suffix_create(text, 1);
+    ASSUME_ITS_EQUAL_I32(0, fossil_suffix_save(index, path));
+
+    fossil_suffix_t *loaded = fossil_suffix_load(path, text);
+    ASSUME_ITS_TRUE(loaded != NULL);
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_suffix_count(loaded, "issi"));
+    for (size_t r = 0; r < fossil_suffix_length(index); r++) {
+        ASSUME_ITS_EQUAL_SIZE(fossil_suffix_at(index, r), fossil_suffix_at(loaded, r));
+        ASSUME_ITS_EQUAL_SIZE(fossil_suffix_lcp(index, r), fossil_suffix_lcp(loaded, r));
+    }
+    ASSUME_ITS_TRUE(fossil_suffix_load(path, "mississippi river, mississippi della") == NULL);
+    ASSUME_ITS_TRUE(fossil_suffix_load(path, "mississippi") == NULL);
+    fossil_suffix_erase(loaded);
+    fossil_suffix_erase(index);
+    remove(path);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_suffix_tests) {
+    ADD_TEST(test_fossil_suffix_locate);
+    ADD_TEST(test_fossil_suffix_naive);
+    ADD_TEST(test_fossil_suffix_save_load);
+} // end of tests
@@ -0,0 +1,81 @@
+/*
+ * -----------------------------------------------------------------------------
+ * File: test_view.c
+ * Project: Fossil Logic
+ * Description: This file contains the test cases for the string library.
+ *
+ * This file is part of the Fossil Logic project, which aims to develop high-
+ * performance, cross-platform applications and libraries. The code contained
+ * herein is subject to the terms and conditions defined in the project license.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 07/01/2024
+ *
+ * Copyright (C) 2024 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/string/framework.h>
+
+#include <fossil/unittest/framework.h>
+#include <fossil/unittest/assume.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test string views
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+// Test case 1: Test fossil_cview_split fills views without allocating
+FOSSIL_TEST(test_fossil_cview_split) {
+    cview parts[4];
+    size_t count = fossil_cview_split(fossil_cview_from("a,bc,,def"), ',', parts, 4);
+    ASSUME_ITS_EQUAL_SIZE(4, count);
+    ASSUME_ITS_TRUE(fossil_cview_equals(parts[1], fossil_cview_from("bc")));
+    ASSUME_ITS_EQUAL_SIZE(0, parts[2].length);
+    ASSUME_ITS_TRUE(fossil_cview_equals(parts[3], fossil_cview_from("def")));
+    ASSUME_ITS_EQUAL_SIZE(4, fossil_cview_split(fossil_cview_from("a,bc,,def"), ',', NULL, 0));
+}
+
+// Test case 2: Test fossil_cview_substr, find and compare
+FOSSIL_TEST(test_fossil_cview_substr_and_find) {
+    cview view = fossil_cview_from("Pizza time!");
+    cview sub = fossil_cview_substr(view, 6, 100);
+    ASSUME_ITS_EQUAL_SIZE(5, sub.length);
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_cview_find(sub, 'm'));
+    ASSUME_ITS_EQUAL_SIZE(FOSSIL_VIEW_NPOS, fossil_cview_find(sub, 'z'));
+    ASSUME_ITS_TRUE(fossil_cview_starts_with(view, fossil_cview_from("Pizza")));
+    ASSUME_ITS_TRUE(fossil_cview_ends_with(view, sub));
+    ASSUME_ITS_TRUE(fossil_cview_compare(fossil_cview_from("abc"), fossil_cview_from("abd")) < 0);
+
+    cstring copy = fossil_cview_to_cstr(sub);
+    ASSUME_ITS_EQUAL_CSTR("time!", copy);
+    fossil_cstr_erase(copy);
+}
+
+// Test case 3: Test the wide and byte view families
+FOSSIL_TEST(test_fossil_wview_and_bview) {
+    wview parts[3];
+    ASSUME_ITS_EQUAL_SIZE(3, fossil_wview_split(fossil_wview_from(L"x y z"), L' ', parts, 3));
+    ASSUME_ITS_TRUE(fossil_wview_equals(parts[2], fossil_wview_from(L"z")));
+
+    const bletter data[] = { 'a', ';', 'b', 0 };
+    bview view = fossil_bview_from(data);
+    ASSUME_ITS_EQUAL_SIZE(3, view.length);
+    ASSUME_ITS_EQUAL_SIZE(1, fossil_bview_find(view, ';'));
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_bview_split(view, ';', NULL, 0));
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_GROUP(c_view_tests) {
+    ADD_TEST(test_fossil_cview_split);
+    ADD_TEST(test_fossil_cview_substr_and_find);
+    ADD_TEST(test_fossil_wview_and_bview);
+} // end of tests
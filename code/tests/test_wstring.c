@@ -52,6 +52,75 @@ FOSSIL_TEST(test_fossil_wstring_create_with_value_and_length) {
     fossil_wstr_erase(var); // Clean up after creating a wstring
 }
 
+// Test case 4: Test character scanning across vector blocks
+FOSSIL_TEST(test_fossil_wstring_scan) {
+    const_wstring path = L"/usr/local/share/fossil/strings/include/fossil/string/framework.h";
+    ASSUME_ITS_TRUE(path == fossil_wstr_find(path, L'/'));
+    ASSUME_ITS_TRUE(path + 53 == fossil_wstr_rfind(path, L'/'));
+    ASSUME_ITS_TRUE(path + 63 == fossil_wstr_find_any(path, L".#"));
+    ASSUME_ITS_EQUAL_SIZE(9, fossil_wstr_count(path, L'/'));
+    ASSUME_ITS_TRUE(NULL == fossil_wstr_find(path, L'#'));
+}
+
+// Test case 5: Test substring search
+FOSSIL_TEST(test_fossil_wstring_find_str) {
+    const_wstring path = L"/usr/local/share/fossil/strings/include/fossil/string/framework.h";
+    ASSUME_ITS_TRUE(path + 17 == fossil_wstr_find_str(path, L"fossil/"));
+    ASSUME_ITS_TRUE(path + 40 == fossil_wstr_rfind_str(path, L"fossil/"));
+    ASSUME_ITS_TRUE(path + 65 == fossil_wstr_rfind_str(path, L""));
+    ASSUME_ITS_TRUE(fossil_wstr_contains(path, L"framework.h"));
+    ASSUME_ITS_FALSE(fossil_wstr_contains(path, L"framework.c"));
+}
+
+// Test case 6: Test collecting every offset in one pass
+FOSSIL_TEST(test_fossil_wstring_find_all) {
+    const_wstring path = L"/usr/local/share/fossil/strings/include/fossil/string/framework.h";
+    size_t slashes[9] = { 0 };
+    ASSUME_ITS_EQUAL_SIZE(9, fossil_wstr_find_all(path, L'/', slashes, 9));
+    ASSUME_ITS_EQUAL_SIZE(0, slashes[0]);
+    ASSUME_ITS_EQUAL_SIZE(53, slashes[8]);
+
+    size_t hits[2] = { 0, 0 };
+    ASSUME_ITS_EQUAL_SIZE(2, fossil_wstr_find_all_str(path, L"fossil", hits, 2));
+    ASSUME_ITS_EQUAL_SIZE(17, hits[0]);
+    ASSUME_ITS_EQUAL_SIZE(40, hits[1]);
+}
+
+// Test case 7: Test comparing and searching without regard to case
+FOSSIL_TEST(test_fossil_wstring_ignore_case) {
+    const_wstring path = L"C:\\Program Files\\Fossil\\Strings\\Include\\Fossil\\String\\Framework.h";
+    ASSUME_ITS_TRUE(fossil_wstr_istarts_with(path, L"c:\\program files"));
+    ASSUME_ITS_TRUE(fossil_wstr_iequals(L"FRAMEWORK.H", L"framework.h"));
+    ASSUME_ITS_TRUE(fossil_wstr_icompare(L"fossil", L"FOSSILS") < 0);
+    ASSUME_ITS_EQUAL_I32(0, fossil_wstr_icompare(L"\u00e9t\u00e9", L"\u00e9T\u00e9"));
+    ASSUME_ITS_TRUE(fossil_wstr_ifind_str(path, L"\\FOSSIL\\") == path + 16);
+    ASSUME_ITS_TRUE(fossil_wstr_ifind_str(path, L"STRING\\FRAMEWORK") == path + 47);
+    ASSUME_ITS_TRUE(fossil_wstr_ifind_str(path, L"fossil/") == NULL);
+    ASSUME_ITS_TRUE(fossil_wstr_ihash(L"Fossil") == fossil_wstr_ihash(L"fOSSIL"));
+}
+
+// Test case 8: Test formatting, including results longer than the first buffer
+FOSSIL_TEST(test_fossil_wstring_format) {
+    wstring result = fossil_wstr_format(L"%ls=%d", L"retries", 3);
+    ASSUME_ITS_EQUAL_WSTR(L"retries=3", result);
+    fossil_wstr_erase(result);
+
+    wchar_t long_text[301];
+    wmemset(long_text, L'x', 300);
+    long_text[300] = L'\0';
+    result = fossil_wstr_format(L"<%ls>", long_text);
+    ASSUME_ITS_EQUAL_SIZE(302, fossil_wstr_length(result));
+    ASSUME_ITS_TRUE(result[0] == L'<' && result[301] == L'>');
+    fossil_wstr_erase(result);
+
+    // A narrow argument that is not valid in the locale fails at once
+    ASSUME_ITS_TRUE(fossil_wstr_format(L"%s", "\xff\xfe") == NULL);
+
+    result = fossil_wstr_format_phone(L"5551234567");
+    ASSUME_ITS_EQUAL_WSTR(L"(555) 123-4567", result);
+    fossil_wstr_erase(result);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -61,4 +130,9 @@ FOSSIL_TEST_GROUP(c_wstrings_tests) {
     ADD_TEST(test_fossil_wstring_create);
     ADD_TEST(test_fossil_wstring_create_with_value);
     ADD_TEST(test_fossil_wstring_create_with_value_and_length);
+    ADD_TEST(test_fossil_wstring_scan);
+    ADD_TEST(test_fossil_wstring_find_str);
+    ADD_TEST(test_fossil_wstring_find_all);
+    ADD_TEST(test_fossil_wstring_ignore_case);
+    ADD_TEST(test_fossil_wstring_format);
 } // end of tests